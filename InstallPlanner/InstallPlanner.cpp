@@ -0,0 +1,301 @@
+#include "stdafx.h"
+
+// Evaluates which components a configuration installs on each machine of a directory of machine
+// snapshots, see DVLib::MachineSnapshot, and writes one line per machine to the standard output.
+// The session is process-wide, machines are evaluated one after another with the installed checks
+// of each machine evaluated in parallel; /parallel:n runs n shards, each in its own process.
+
+static void Usage()
+{
+    std::wcerr << L"InstallPlanner: evaluates the components a configuration installs on machine snapshots" << std::endl
+        << std::endl
+        << L"InstallPlanner.exe configuration.xml snapshots [/shard:i/n|/parallel:n] [/uninstall] [/log:file]" << std::endl
+        << std::endl
+        << L" configuration.xml: dotNetInstaller configuration" << std::endl
+        << L" snapshots: directory of *.snapshot files" << std::endl
+        << L" /shard:i/n: evaluate the i-th of n equal parts of the snapshots, 1-based" << std::endl
+        << L" /parallel:n: evaluate n shards in n processes and combine their reports" << std::endl
+        << L" /uninstall: evaluate the uninstall sequence" << std::endl
+        << L" /log:file: write a detailed log, file.i with /parallel" << std::endl
+        << std::endl
+        << L"Each line of the report lists a machine, the index of the first supported configuration," << std::endl
+        << L"the number of supported and installed components and the ids of components to install." << std::endl;
+}
+
+// reports are UTF-8 in every mode, the parent copies the reports of its shards as is
+static void WriteReportLine(const std::wstring& line)
+{
+    std::string data = DVLib::wstring2UTF8string(line) + "\r\n";
+    std::cout.write(data.c_str(), data.length());
+}
+
+// quote a command line argument, a trailing backslash would escape the closing quote
+static std::wstring QuoteArg(const std::wstring& arg)
+{
+    return L"\"" + arg + (DVLib::endswith(arg, L"\\") ? L"\\" : L"") + L"\"";
+}
+
+// a non-negative decimal number that fits an int
+static bool IsNumber(const std::wstring& s)
+{
+    return ! s.empty() && s.length() <= 9 && s.find_first_not_of(L"0123456789") == s.npos;
+}
+
+// run each shard in a child process with its report written to a temporary file, then write
+// the reports in shard order and count their machines; returns false if a shard failed
+static bool RunShards(const std::wstring& config_filename, const std::wstring& snapshots_path,
+    bool uninstall, const std::wstring& log_filename, int shards, ULONGLONG& evaluated, ULONGLONG& failed)
+{
+    std::wstring module_filename = DVLib::GetModuleFileNameW();
+    std::vector<std::wstring> reports;
+    std::vector<PROCESS_INFORMATION> processes;
+    bool success = true;
+
+    try
+    {
+        for (int shard = 1; shard <= shards; shard++)
+        {
+            std::wstringstream cmd;
+            cmd << QuoteArg(module_filename) << L" " << QuoteArg(config_filename) << L" " << QuoteArg(snapshots_path)
+                << L" /shard:" << shard << L"/" << shards;
+            if (uninstall) cmd << L" /uninstall";
+            if (! log_filename.empty()) cmd << L" /log:" << QuoteArg(log_filename + L"." + DVLib::towstring(shard));
+
+            reports.push_back(DVLib::GetTemporaryFileNameW());
+            SECURITY_ATTRIBUTES sa = { sizeof(sa), NULL, TRUE };
+            auto_hfile report(::CreateFile(reports.back().c_str(), GENERIC_WRITE, FILE_SHARE_READ, & sa,
+                CREATE_ALWAYS, FILE_ATTRIBUTE_TEMPORARY, NULL));
+            CHECK_WIN32_BOOL(get(report) != INVALID_HANDLE_VALUE,
+                L"Error creating " << reports.back());
+
+            STARTUPINFO si = { 0 };
+            si.cb = sizeof(si);
+            si.dwFlags = STARTF_USESTDHANDLES;
+            si.hStdInput = ::GetStdHandle(STD_INPUT_HANDLE);
+            si.hStdOutput = get(report);
+            si.hStdError = ::GetStdHandle(STD_ERROR_HANDLE);
+
+            std::wstring cmdline = cmd.str();
+            PROCESS_INFORMATION pi = { 0 };
+            CHECK_WIN32_BOOL(::CreateProcessW(NULL, & * cmdline.begin(), NULL, NULL, TRUE, 0, NULL, NULL, & si, & pi),
+                L"CreateProcessW: " << cmdline);
+            ::CloseHandle(pi.hThread);
+            processes.push_back(pi);
+        }
+    }
+    catch(std::exception&)
+    {
+        for each (const PROCESS_INFORMATION& pi in processes)
+        {
+            ::TerminateProcess(pi.hProcess, static_cast<UINT>(-1));
+            ::CloseHandle(pi.hProcess);
+        }
+
+        for each (const std::wstring& report in reports)
+            ::DeleteFileW(report.c_str());
+
+        throw;
+    }
+
+    for (size_t i = 0; i < processes.size(); i++)
+    {
+        auto_handle process(processes[i].hProcess);
+        DWORD exit_code = 0;
+        if (::WaitForSingleObject(get(process), INFINITE) != WAIT_OBJECT_0
+            || ! ::GetExitCodeProcess(get(process), & exit_code)
+            || exit_code != 0)
+        {
+            success = false;
+        }
+    }
+
+    for each (const std::wstring& report in reports)
+    {
+        std::vector<char> data = DVLib::FileReadToEnd(report);
+        DVLib::FileDelete(report);
+        if (data.empty())
+            continue;
+
+        std::string lines(data.begin(), data.end());
+        std::cout.write(lines.c_str(), lines.length());
+        for (size_t pos = lines.find('\n'); pos != std::string::npos; pos = lines.find('\n', pos + 1))
+            evaluated++;
+        for (size_t pos = lines.find("\terror\t"); pos != std::string::npos; pos = lines.find("\terror\t", pos + 1))
+            failed++;
+    }
+
+    std::cout.flush();
+    return success;
+}
+
+int wmain(int argc, wchar_t * argv[])
+{
+    // the library uses MFC
+    if (! ::AfxWinInit(::GetModuleHandle(NULL), NULL, ::GetCommandLine(), 0))
+        return -1;
+
+    std::wstring config_filename;
+    std::wstring snapshots_path;
+    std::wstring log_filename;
+    int shard = 1, shards = 1, parallel = 0;
+    bool uninstall = false;
+
+    // reports are written as UTF-8 bytes without newline translation
+    _setmode(_fileno(stdout), _O_BINARY);
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::wstring arg = argv[i];
+        if (DVLib::startswith(arg, L"/shard:"))
+        {
+            std::vector<std::wstring> parts = DVLib::split(arg.substr(7), L"/");
+            if (parts.size() != 2 || ! IsNumber(parts[0]) || ! IsNumber(parts[1]))
+            {
+                Usage();
+                return -1;
+            }
+
+            shard = DVLib::wstring2long(parts[0]);
+            shards = DVLib::wstring2long(parts[1]);
+        }
+        else if (DVLib::startswith(arg, L"/parallel:"))
+        {
+            if (! IsNumber(arg.substr(10)))
+            {
+                Usage();
+                return -1;
+            }
+
+            parallel = DVLib::wstring2long(arg.substr(10));
+        }
+        else if (_wcsicmp(arg.c_str(), L"/uninstall") == 0)
+        {
+            uninstall = true;
+        }
+        else if (DVLib::startswith(arg, L"/log:"))
+        {
+            log_filename = arg.substr(5);
+        }
+        else if (config_filename.empty())
+        {
+            config_filename = arg;
+        }
+        else if (snapshots_path.empty())
+        {
+            snapshots_path = arg;
+        }
+        else
+        {
+            Usage();
+            return -1;
+        }
+    }
+
+    if (config_filename.empty() || snapshots_path.empty() || shards < 1 || shard < 1 || shard > shards
+        || parallel < 0 || (parallel > 0 && shards > 1))
+    {
+        Usage();
+        return -1;
+    }
+
+    int rc = 0;
+
+    if (parallel > 1)
+    {
+        try
+        {
+            DWORD start = ::GetTickCount();
+            ULONGLONG evaluated = 0, failed = 0;
+            if (! RunShards(config_filename, snapshots_path, uninstall, log_filename, parallel, evaluated, failed))
+                rc = -1;
+
+            DWORD elapsed = ::GetTickCount() - start;
+            std::wcerr << L"Evaluated " << evaluated << L" machine(s) in " << parallel << L" process(es), " << failed << L" failed, in " << elapsed << L" ms";
+            if (elapsed > 0) std::wcerr << L" (" << (evaluated * 1000 / elapsed) << L" machine(s)/s)";
+            std::wcerr << std::endl;
+
+            if (failed > 0)
+                rc = -1;
+        }
+        catch(std::exception& ex)
+        {
+            std::wcerr << L"Error: " << DVLib::string2wstring(ex.what()) << std::endl;
+            rc = -1;
+        }
+
+        return rc;
+    }
+
+    try
+    {
+        reset(InstallerLog::Instance, new InstallerLog());
+        reset(InstallerSession::Instance, new InstallerSession());
+        reset(InstallUILevelSetting::Instance, new InstallUILevelSetting());
+        reset(InstallerLauncher::Instance, new InstallerLauncher());
+        reset(WorkerPool::Instance, new WorkerPool());
+
+        if (! log_filename.empty())
+        {
+            InstallerLog::Instance->SetLogFile(log_filename);
+            InstallerLog::Instance->EnableLog();
+        }
+
+        InstallerSession::Instance->sequence = uninstall ? SequenceUninstall : SequenceInstall;
+
+        ConfigFile config;
+        config.LoadFile(config_filename);
+
+        std::list<std::wstring> snapshots = DVLib::GetFiles(snapshots_path, L"*.snapshot");
+        // shards are assigned the same machines on every run
+        snapshots.sort();
+
+        DWORD start = ::GetTickCount();
+        int index = 0;
+        ULONGLONG evaluated = 0, failed = 0;
+        for each (const std::wstring& filename in snapshots)
+        {
+            if (index++ % shards != shard - 1)
+                continue;
+
+            try
+            {
+                DVLib::MachineSnapshotPtr machine(new DVLib::MachineSnapshot());
+                machine->Load(filename);
+                InstallerSession::Instance->SetMachine(machine);
+
+                InstallPlan plan;
+                plan.Evaluate(config);
+                WriteReportLine(plan.GetString());
+            }
+            catch(std::exception& ex)
+            {
+                WriteReportLine(filename + L"\terror\t" + DVLib::string2wstring(ex.what()));
+                failed++;
+            }
+
+            evaluated++;
+        }
+
+        std::cout.flush();
+
+        DWORD elapsed = ::GetTickCount() - start;
+        std::wcerr << L"Evaluated " << evaluated << L" machine(s), " << failed << L" failed, in " << elapsed << L" ms";
+        if (elapsed > 0) std::wcerr << L" (" << (evaluated * 1000 / elapsed) << L" machine(s)/s)";
+        std::wcerr << std::endl;
+
+        if (failed > 0)
+            rc = -1;
+    }
+    catch(std::exception& ex)
+    {
+        std::wcerr << L"Error: " << DVLib::string2wstring(ex.what()) << std::endl;
+        rc = -1;
+    }
+
+    reset(WorkerPool::Instance);
+    reset(InstallerLauncher::Instance);
+    reset(InstallUILevelSetting::Instance);
+    reset(InstallerSession::Instance);
+    reset(InstallerLog::Instance);
+    return rc;
+}
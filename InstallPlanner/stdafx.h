@@ -0,0 +1,10 @@
+#pragma once
+
+#include <dotNetInstaller/StdAfxCommon.h>
+#include <io.h>
+#include <fcntl.h>
+#include <tinyxml2.h>
+#include <ThirdParty/SmartPtr/SmartPtr.h>
+#include <dotNetInstallerToolsLib/Tools.h>
+#include <ThirdParty/Cab/Cab.h>
+#include <dotNetInstallerLib/dotNetInstallerLib.h>
@@ -308,6 +308,28 @@ namespace InstallerLib
             set { m_hide_component_if_installed = value; }
         }
 
+        private string m_depends_on;
+        [Description("Comma-separated ids of components that must complete before this component executes.")]
+        [Category("Runtime")]
+        public string depends_on
+        {
+            get { return m_depends_on; }
+            set { m_depends_on = value; }
+        }
+
+        private ComponentConcurrency m_concurrency = ComponentConcurrency.exclusive;
+        [Description("Concurrency class of the component. An 'exclusive' component executes alone, a 'parallel' component "
+            + "may execute at the same time as other non-exclusive components and an 'msiexec' component may execute at the same time "
+            + "as 'parallel' components, but never with another 'msiexec' component. The maximum number of components executing "
+            + "at the same time is set by the configuration's 'max_concurrent_components'.")]
+        [Category("Runtime")]
+        [Required]
+        public ComponentConcurrency concurrency
+        {
+            get { return m_concurrency; }
+            set { m_concurrency = value; }
+        }
+
         #endregion
 
         #region Events
@@ -367,6 +389,9 @@ namespace InstallerLib
             e.XmlWriter.WriteAttributeString("show_progress_dialog", m_show_progress_dialog.ToString());
             e.XmlWriter.WriteAttributeString("show_cab_dialog", m_show_cab_dialog.ToString());
             e.XmlWriter.WriteAttributeString("hide_component_if_installed", m_hide_component_if_installed.ToString());
+            // execution dependencies and concurrency
+            e.XmlWriter.WriteAttributeString("depends_on", m_depends_on);
+            e.XmlWriter.WriteAttributeString("concurrency", m_concurrency.ToString());
             base.OnXmlWriteTag(e);
         }
 
@@ -417,6 +442,9 @@ namespace InstallerLib
             ReadAttributeValue(e, "show_progress_dialog", ref m_show_progress_dialog);
             ReadAttributeValue(e, "show_cab_dialog", ref m_show_cab_dialog);
             ReadAttributeValue(e, "hide_component_if_installed", ref m_hide_component_if_installed);
+            // execution dependencies and concurrency
+            ReadAttributeValue(e, "depends_on", ref m_depends_on);
+            ReadAttributeValue(e, "concurrency", ref m_concurrency);
             base.OnXmlReadTag(e);
         }
 
@@ -0,0 +1,13 @@
+using System;
+using System.Collections.Generic;
+using System.Text;
+
+namespace InstallerLib
+{
+    public enum ComponentConcurrency
+    {
+        exclusive = 0,
+        parallel = 1,
+        msiexec = 2
+    }
+}
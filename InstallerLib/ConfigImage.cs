@@ -0,0 +1,128 @@
+using System;
+using System.Collections.Generic;
+using System.Text;
+using System.Xml;
+
+namespace InstallerLib
+{
+    /// <summary>
+    /// A compiled configuration, the element tree with names and attribute values as UTF-16.
+    /// The bootstrapper reads it in place instead of parsing xml, the layout matches ConfigImage in dotNetInstallerLib.
+    /// </summary>
+    public class ConfigImage
+    {
+        /// <summary>
+        /// "DNIC"
+        /// </summary>
+        public const uint Magic = 0x43494E44;
+
+        /// <summary>
+        /// Layout version, the bootstrapper loads the xml configuration for images of any other version.
+        /// </summary>
+        public const uint Version = 1;
+
+        private const int HeaderSize = 16;
+        private const int ElementSize = 16;
+        private const int AttributeSize = 8;
+
+        private List<byte> _data = new List<byte>();
+        private Dictionary<string, int> _strings = new Dictionary<string, int>();
+
+        private ConfigImage()
+        {
+        }
+
+        /// <summary>
+        /// Compile an xml element tree.
+        /// </summary>
+        public static byte[] Compile(XmlElement node)
+        {
+            ConfigImage image = new ConfigImage();
+            image._data.AddRange(new byte[HeaderSize]);
+            int root = image.WriteElement(node);
+            image.SetUInt32(0, Magic);
+            image.SetUInt32(4, Version);
+            image.SetUInt32(8, (uint)image._data.Count);
+            image.SetInt32(12, root);
+            return image._data.ToArray();
+        }
+
+        private void SetInt32(int offset, int value)
+        {
+            SetUInt32(offset, (uint)value);
+        }
+
+        private void SetUInt32(int offset, uint value)
+        {
+            byte[] bytes = BitConverter.GetBytes(value);
+            for (int i = 0; i < bytes.Length; i++)
+            {
+                _data[offset + i] = bytes[i];
+            }
+        }
+
+        private int WriteString(string s)
+        {
+            // names and most values repeat, each distinct string is written once
+            int offset;
+            if (_strings.TryGetValue(s, out offset))
+            {
+                return offset;
+            }
+
+            offset = _data.Count;
+            byte[] bytes = Encoding.Unicode.GetBytes(s + '\0');
+            _data.AddRange(bytes);
+            // keep elements that follow DWORD-aligned
+            _data.AddRange(new byte[(4 - (bytes.Length % 4)) % 4]);
+            _strings.Add(s, offset);
+            return offset;
+        }
+
+        private int WriteElement(XmlElement node)
+        {
+            // strings are written ahead of the element, offsets are relative to the element
+            int name = WriteString(node.Name);
+            List<int> attributes = new List<int>();
+            foreach (XmlAttribute attribute in node.Attributes)
+            {
+                attributes.Add(WriteString(attribute.Name));
+                attributes.Add(WriteString(attribute.Value));
+            }
+
+            int offset = _data.Count;
+            _data.AddRange(new byte[ElementSize + (attributes.Count / 2 * AttributeSize)]);
+            SetInt32(offset, name - offset);
+            SetInt32(offset + 12, attributes.Count / 2);
+            for (int i = 0; i < attributes.Count; i++)
+            {
+                SetInt32(offset + ElementSize + (i * 4), attributes[i] - offset);
+            }
+
+            // children follow their parent, each sibling links to the next one
+            int previous = 0;
+            foreach (XmlNode child in node.ChildNodes)
+            {
+                XmlElement child_element = child as XmlElement;
+                if (child_element == null)
+                {
+                    continue;
+                }
+
+                int child_offset = WriteElement(child_element);
+                if (previous == 0)
+                {
+                    SetInt32(offset + 8, child_offset - offset);
+                }
+                else
+                {
+                    SetInt32(previous + 4, child_offset - previous);
+                }
+
+                previous = child_offset;
+            }
+
+            return offset;
+        }
+    }
+}
@@ -225,6 +225,15 @@ namespace InstallerLib
                 ResourceUpdate.WriteFile(h, new ResourceId("CUSTOM"), new ResourceId("RES_CONFIGURATION"),
                     ResourceUtil.NEUTRALLANGID, configFilename);
 
+                // a compiled configuration, loaded in place of the xml at startup
+                XmlDocument configXml = new XmlDocument();
+                configXml.Load(configFilename);
+                byte[] configImage = ConfigImage.Compile(configXml.DocumentElement);
+                args.WriteLine(string.Format("Embedding compiled configuration ({0})",
+                    EmbedFileCollection.FormatBytes(configImage.Length)));
+                ResourceUpdate.Write(h, new ResourceId("CUSTOM"), new ResourceId("RES_CONFIGURATION_IMAGE"),
+                    ResourceUtil.NEUTRALLANGID, configImage);
+
                 #region Embed Resources
 
                 EmbedFileCollection html_files = new EmbedFileCollection(args.apppath);
@@ -594,6 +594,39 @@ namespace InstallerLib
             get { return m_administrator_required_message; }
             set { m_administrator_required_message = value; }
         }
+
+        private int m_max_concurrent_components = 1;
+        [Description("Maximum number of non-exclusive components that execute at the same time. "
+            + "The default value is 1, components execute one after another.")]
+        [Category("Runtime")]
+        [Required]
+        public int max_concurrent_components
+        {
+            get { return m_max_concurrent_components; }
+            set { m_max_concurrent_components = value; }
+        }
+
+        private int m_prefetch_extract_depth = 0;
+        [Description("Number of components ahead of the one being installed whose embedded CABs are extracted "
+            + "in the background. The default value is 0, CABs are extracted when each component executes.")]
+        [Category("Runtime")]
+        [Required]
+        public int prefetch_extract_depth
+        {
+            get { return m_prefetch_extract_depth; }
+            set { m_prefetch_extract_depth = value; }
+        }
+
+        private int m_prefetch_download_depth = 0;
+        [Description("Number of components ahead of the one being installed whose auto-start downloads run "
+            + "in the background. The default value is 0, files are downloaded when each component executes.")]
+        [Category("Runtime")]
+        [Required]
+        public int prefetch_download_depth
+        {
+            get { return m_prefetch_download_depth; }
+            set { m_prefetch_download_depth = value; }
+        }
         #endregion
 
         protected override void OnXmlWriteTag(XmlWriterEventArgs e)
@@ -670,6 +703,11 @@ namespace InstallerLib
             // administrator required
             e.XmlWriter.WriteAttributeString("administrator_required", m_administrator_required.ToString());
             e.XmlWriter.WriteAttributeString("administrator_required_message", m_administrator_required_message);
+            // concurrent component execution
+            e.XmlWriter.WriteAttributeString("max_concurrent_components", m_max_concurrent_components.ToString());
+            // prefetching
+            e.XmlWriter.WriteAttributeString("prefetch_extract_depth", m_prefetch_extract_depth.ToString());
+            e.XmlWriter.WriteAttributeString("prefetch_download_depth", m_prefetch_download_depth.ToString());
             base.OnXmlWriteTag(e);
         }
 
@@ -745,6 +783,11 @@ namespace InstallerLib
                 Template.Template_setupconfiguration tpl = Template.CurrentTemplate.setupConfiguration(m_application_name);
                 m_administrator_required_message = tpl.administrator_required_message;
             }
+            // concurrent component execution
+            ReadAttributeValue(e, "max_concurrent_components", ref m_max_concurrent_components);
+            // prefetching
+            ReadAttributeValue(e, "prefetch_extract_depth", ref m_prefetch_extract_depth);
+            ReadAttributeValue(e, "prefetch_download_depth", ref m_prefetch_download_depth);
             base.OnXmlReadTag(e);
         }
     }
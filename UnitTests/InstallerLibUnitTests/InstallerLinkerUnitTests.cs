@@ -39,12 +39,18 @@ namespace InstallerLibUnitTests
                     ri.Load(args.output);
                     List<Resource> custom = ri.Resources[new ResourceId("CUSTOM")];
                     Assert.IsNotNull(custom);
-                    Assert.AreEqual(2, custom.Count);
+                    Assert.AreEqual(3, custom.Count);
                     // default banner
                     Assert.AreEqual(custom[0].Name, new ResourceId("RES_BANNER"));
                     // embedded configuration
                     Assert.AreEqual(custom[1].Name, new ResourceId("RES_CONFIGURATION"));
                     Assert.AreEqual(custom[1].Size, new FileInfo(args.config).Length);
+                    // compiled configuration
+                    Assert.AreEqual(custom[2].Name, new ResourceId("RES_CONFIGURATION_IMAGE"));
+                    byte[] image = custom[2].WriteAndGetBytes();
+                    Assert.AreEqual(ConfigImage.Magic, BitConverter.ToUInt32(image, 0));
+                    Assert.AreEqual(ConfigImage.Version, BitConverter.ToUInt32(image, 4));
+                    Assert.AreEqual(image.Length, (int)BitConverter.ToUInt32(image, 8));
                 }
             }
             finally
@@ -319,7 +325,8 @@ namespace InstallerLibUnitTests
                     List<Resource> custom = ri.Resources[new ResourceId("CUSTOM")];
                     Assert.AreEqual("RES_BANNER", custom[0].Name.Name);
                     Assert.AreEqual("RES_CONFIGURATION", custom[1].Name.ToString());
-                    Assert.AreEqual("RES_SPLASH", custom[2].Name.ToString());
+                    Assert.AreEqual("RES_CONFIGURATION_IMAGE", custom[2].Name.ToString());
+                    Assert.AreEqual("RES_SPLASH", custom[3].Name.ToString());
                 }
                 // execute with and without splash
                 dotNetInstallerExeUtils.Run(args.output, "/qb");
@@ -368,7 +375,8 @@ namespace InstallerLibUnitTests
                     List<Resource> custom = ri.Resources[new ResourceId("CUSTOM")];
                     Assert.AreEqual("RES_BANNER", custom[0].Name.Name);
                     Assert.AreEqual("RES_CONFIGURATION", custom[1].Name.ToString());
-                    Assert.AreEqual("RES_LICENSE", custom[2].Name.ToString());
+                    Assert.AreEqual("RES_CONFIGURATION_IMAGE", custom[2].Name.ToString());
+                    Assert.AreEqual("RES_LICENSE", custom[3].Name.ToString());
                 }
             }
             finally
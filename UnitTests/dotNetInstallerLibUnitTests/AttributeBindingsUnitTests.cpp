@@ -0,0 +1,86 @@
+#include "StdAfx.h"
+#include "AttributeBindingsUnitTests.h"
+#include "AttributeCallbackImpl.h"
+
+using namespace DVLib::UnitTests;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+void AttributeBindingsUnitTests::testDependsOn()
+{
+    XmlAttribute attribute(L"[a] and [c]");
+    Assert::IsTrue(attribute.DependsOn(ExpansionTemplate::token_user, L"a"));
+    Assert::IsTrue(! attribute.DependsOn(ExpansionTemplate::token_user, L"b"));
+    XmlAttribute path(L"#TEMPPATH\\file.txt");
+    Assert::IsTrue(path.DependsOn(ExpansionTemplate::token_path, L"TEMPPATH"));
+    Assert::IsTrue(! path.DependsOn(ExpansionTemplate::token_path, L"CABPATH"));
+    Assert::IsTrue(! path.DependsOn(ExpansionTemplate::token_environment, L"SystemRoot"));
+    // values of path, registry and environment variables may contain user variables
+    Assert::IsTrue(path.DependsOn(ExpansionTemplate::token_user, L"b"));
+    XmlAttribute environment(L"%SystemRoot%");
+    Assert::IsTrue(environment.DependsOn(ExpansionTemplate::token_environment, L"SystemRoot"));
+    Assert::IsTrue(! environment.DependsOn(ExpansionTemplate::token_environment, L"TEMP"));
+    Assert::IsTrue(environment.DependsOn(ExpansionTemplate::token_path, L"CABPATH"));
+    Assert::IsTrue(environment.DependsOn(ExpansionTemplate::token_user, L"b"));
+    // literals depend on nothing
+    XmlAttribute literal(L"plain text");
+    Assert::IsTrue(! literal.DependsOn(ExpansionTemplate::token_user, L"a"));
+    // values that are expanded in full depend on any variable
+    XmlAttribute nested(L"[#CABPATH]");
+    Assert::IsTrue(nested.DependsOn(ExpansionTemplate::token_user, L"a"));
+}
+
+void AttributeBindingsUnitTests::testOnVariableChanged()
+{
+    InstallerSession::Instance->AdditionalControlArgs[L"a"] = L"a1";
+    InstallerSession::Instance->AdditionalControlArgs[L"b"] = L"b1";
+
+    XmlAttribute attribute_a(L"Install [a]");
+    XmlAttribute attribute_b(L"Install [b]");
+    XmlAttribute attribute_literal(L"Install");
+
+    AttributeCallbackImpl * callback_a = new AttributeCallbackImpl();
+    AttributeCallbackImpl * callback_b = new AttributeCallbackImpl();
+    AttributeCallbackImpl * callback_literal = new AttributeCallbackImpl();
+
+    AttributeBindings bindings;
+    Assert::AreEqual(L"Install a1", bindings.Bind(attribute_a, AttributeCallbackPtr(callback_a)).c_str());
+    Assert::AreEqual(L"Install b1", bindings.Bind(attribute_b, AttributeCallbackPtr(callback_b)).c_str());
+    Assert::AreEqual(L"Install", bindings.Bind(attribute_literal, AttributeCallbackPtr(callback_literal)).c_str());
+    Assert::AreEqual(static_cast<size_t>(3), bindings.size());
+
+    // only attributes that display [a] are re-rendered
+    InstallerSession::Instance->AdditionalControlArgs[L"a"] = L"a2";
+    Assert::AreEqual(1, bindings.OnVariableChanged(ExpansionTemplate::token_user, L"a"));
+    Assert::AreEqual(1, callback_a->changes);
+    Assert::AreEqual(L"Install a2", callback_a->value.c_str());
+    Assert::AreEqual(0, callback_b->changes);
+    Assert::AreEqual(0, callback_literal->changes);
+
+    // an unchanged value is not re-rendered
+    Assert::AreEqual(0, bindings.OnVariableChanged(ExpansionTemplate::token_user, L"a"));
+    Assert::AreEqual(1, callback_a->changes);
+
+    InstallerSession::Instance->AdditionalControlArgs[L"b"] = L"b2";
+    Assert::AreEqual(1, bindings.OnVariableChanged(ExpansionTemplate::token_user, L"b"));
+    Assert::AreEqual(1, callback_a->changes);
+    Assert::AreEqual(1, callback_b->changes);
+    Assert::AreEqual(L"Install b2", callback_b->value.c_str());
+    Assert::AreEqual(0, callback_literal->changes);
+
+    bindings.Clear();
+    Assert::AreEqual(static_cast<size_t>(0), bindings.size());
+}
+
+void AttributeBindingsUnitTests::testRefresh()
+{
+    InstallerSession::Instance->AdditionalControlArgs[L"a"] = L"a1";
+    XmlAttribute attribute_a(L"[a]");
+    AttributeCallbackImpl * callback_a = new AttributeCallbackImpl();
+    AttributeBindings bindings;
+    bindings.Bind(attribute_a, AttributeCallbackPtr(callback_a));
+    Assert::AreEqual(0, bindings.Refresh());
+    InstallerSession::Instance->AdditionalControlArgs[L"a"] = L"a2";
+    Assert::AreEqual(1, bindings.Refresh());
+    Assert::AreEqual(1, callback_a->changes);
+    Assert::AreEqual(L"a2", callback_a->value.c_str());
+}
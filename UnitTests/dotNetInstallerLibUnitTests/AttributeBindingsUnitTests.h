@@ -0,0 +1,25 @@
+#pragma once
+#include "dotNetInstallerLibUnitTestFixture.h"
+
+namespace DVLib
+{
+	namespace UnitTests 
+	{
+		TEST_CLASS(AttributeBindingsUnitTests), public dotNetInstallerLibUnitTestFixture
+		{
+            TEST_METHOD_INITIALIZE( initialize )
+            {
+                setUp();
+            }
+
+            TEST_METHOD_CLEANUP( cleanup )
+            {
+                tearDown();
+            }
+
+			TEST_METHOD( testDependsOn );
+			TEST_METHOD( testOnVariableChanged );
+			TEST_METHOD( testRefresh );
+		};
+	}
+}
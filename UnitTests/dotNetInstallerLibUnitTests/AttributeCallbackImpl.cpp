@@ -0,0 +1,16 @@
+#include "StdAfx.h"
+#include "AttributeCallbackImpl.h"
+
+using namespace DVLib::UnitTests;
+
+AttributeCallbackImpl::AttributeCallbackImpl()
+: changes(0)
+{
+}
+
+void AttributeCallbackImpl::OnAttributeChanged(const std::wstring& value)
+{
+    changes++;
+    this->value = value;
+    std::wcout << std::endl << L"Changed: " << value;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+namespace DVLib
+{
+	namespace UnitTests 
+	{
+		class AttributeCallbackImpl : public IAttributeCallback
+		{
+		public:
+			int changes;
+			std::wstring value;
+		public:
+			AttributeCallbackImpl();
+			void OnAttributeChanged(const std::wstring& value);
+		};
+	}
+}
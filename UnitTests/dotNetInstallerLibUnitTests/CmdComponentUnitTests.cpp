@@ -307,12 +307,14 @@ void CmdComponentUnitTests::testMustReboot()
 void CmdComponentUnitTests::testLoad()
 {
     tinyxml2::XMLDocument doc;
+    ConfigImage image;
     doc.Parse("<component type=\"cmd\" \
               command=\"test install\" \
               uninstall_command=\"test uninstall\" \
               execution_method=\"ShellExecute\"/>");
     CmdComponent component;
-    component.Load(doc.RootElement());
+    image.Compile(doc.RootElement());
+    component.Load(image.GetRoot());
     Assert::IsTrue(component.command.GetValue() == L"test install");
     Assert::IsTrue(component.uninstall_command.GetValue() == L"test uninstall");
     Assert::IsTrue(component.execution_method == DVLib::CemShellExecute);
@@ -16,3 +16,22 @@ void ComponentUnitTests::testGetDisplayName()
     component1.display_name = L"";
     Assert::IsTrue(component1.GetDisplayName() == component1.uninstall_display_name.GetValue());
 }
+
+void ComponentUnitTests::testDependsOn()
+{
+    CmdComponent component;
+    component.display_name = L"Install [product]";
+    Assert::IsTrue(component.DependsOn(ExpansionTemplate::token_user, L"product"));
+    Assert::IsTrue(! component.DependsOn(ExpansionTemplate::token_user, L"folder"));
+    // the installed state depends on the directory checked
+    InstalledCheckDirectory * check = new InstalledCheckDirectory();
+    check->path = L"[folder]\\bin";
+    InstalledCheckOperator * op = new InstalledCheckOperator();
+    op->type = L"Not";
+    op->installedchecks.push_back(InstalledCheckPtr(check));
+    component.installedchecks.push_back(InstalledCheckPtr(op));
+    Assert::IsTrue(component.DependsOn(ExpansionTemplate::token_user, L"folder"));
+    Assert::IsTrue(! component.DependsOn(ExpansionTemplate::token_user, L"other"));
+    InstallerSession::Instance->AdditionalControlArgs[L"folder"] = L"C:\\Program Files";
+    Assert::IsTrue(check->path.GetValue() == L"C:\\Program Files\\bin");
+}
@@ -18,6 +18,7 @@ namespace DVLib
             }
 
 			TEST_METHOD( testGetDisplayName );
+			TEST_METHOD( testDependsOn );
 		};
 	}
 }
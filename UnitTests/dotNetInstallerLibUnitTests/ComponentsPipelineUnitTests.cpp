@@ -0,0 +1,115 @@
+#include "StdAfx.h"
+#include "ComponentsPipelineUnitTests.h"
+
+using namespace DVLib::UnitTests;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+void ComponentsPipelineUnitTests::testPrefetchExtract()
+{
+    Components components;
+    ComponentPtr component(new CmdComponent());
+    component->id = L"TEST";
+    component->checked = true;
+    components.add(component);
+
+    ComponentsPipeline pipeline(GetCurrentModuleHandle(), components, 1, 0);
+    pipeline.Start();
+    Assert::IsTrue(pipeline.EndExtract(component));
+    // the extraction has been consumed
+    Assert::IsTrue(! pipeline.EndExtract(component));
+    std::wstring readmetxt = DVLib::DirectoryCombine(InstallerSession::Instance->GetSessionCabPath(), L"readme.txt");
+    Assert::IsTrue(DVLib::FileExists(readmetxt));
+    DVLib::DirectoryDelete(InstallerSession::Instance->GetSessionCabPath());
+}
+
+// components that each copy this module to a new temporary file
+static void AddDownloadComponents(Components& components, std::vector<std::wstring>& destinations, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        DownloadFilePtr file(new DownloadFile());
+        file->alwaysdownload = false;
+        file->componentname = L"test download";
+        file->sourcepath = DVLib::GetModuleFileNameW();
+        file->destinationpath = DVLib::GetTemporaryDirectoryW();
+        file->destinationfilename = DVLib::GenerateGUIDStringW();
+        destinations.push_back(file->GetDestinationFileName());
+
+        ComponentPtr component(new CmdComponent());
+        component->id = DVLib::GenerateGUIDStringW();
+        component->checked = true;
+        reset(component->downloaddialog, new DownloadDialog(component->id));
+        component->downloaddialog->auto_start = true;
+        component->downloaddialog->downloadfiles.push_back(file);
+        components.add(component);
+    }
+}
+
+static void DeleteDestinations(const std::vector<std::wstring>& destinations)
+{
+    for each(const std::wstring& destination in destinations)
+    {
+        if (DVLib::FileExists(destination)) DVLib::FileDelete(destination);
+    }
+}
+
+void ComponentsPipelineUnitTests::testPrefetchDownload()
+{
+    Components components;
+    std::vector<std::wstring> destinations;
+    AddDownloadComponents(components, destinations, 3);
+
+    // prefetch one component ahead
+    ComponentsPipeline pipeline(GetCurrentModuleHandle(), components, 0, 1);
+    pipeline.Start();
+    // the first component downloads with UI
+    Assert::IsTrue(! pipeline.EndDownload(components[0], true));
+    pipeline.Advance(components[0]);
+    Assert::IsTrue(pipeline.EndDownload(components[1], true));
+    Assert::IsTrue(DVLib::FileExists(destinations[1]));
+    // back-pressure, the third component isn't started before the second one begins
+    Assert::IsTrue(! DVLib::FileExists(destinations[2]));
+    pipeline.Advance(components[1]);
+    Assert::IsTrue(pipeline.EndDownload(components[2], true));
+    Assert::IsTrue(DVLib::FileExists(destinations[2]));
+    DeleteDestinations(destinations);
+}
+
+void ComponentsPipelineUnitTests::testPrefetchOutOfOrder()
+{
+    Components components;
+    std::vector<std::wstring> destinations;
+    AddDownloadComponents(components, destinations, 3);
+
+    // prefetch the second and the third component
+    ComponentsPipeline pipeline(GetCurrentModuleHandle(), components, 0, 2);
+    pipeline.Start();
+    // the third component begins first, the second component is still prefetched
+    Assert::IsTrue(pipeline.EndDownload(components[2], true));
+    pipeline.Advance(components[2]);
+    Assert::IsTrue(pipeline.EndDownload(components[1], true));
+    Assert::IsTrue(DVLib::FileExists(destinations[1]));
+    DeleteDestinations(destinations);
+}
+
+void ComponentsPipelineUnitTests::testFollowDownload()
+{
+    Components components;
+    std::vector<std::wstring> destinations;
+    AddDownloadComponents(components, destinations, 2);
+
+    ComponentsPipeline pipeline(GetCurrentModuleHandle(), components, 0, 1);
+    pipeline.Start();
+    pipeline.Advance(components[0]);
+    // with UI a download in progress is handed to the download dialog instead of starting over
+    if (! pipeline.EndDownload(components[1], false))
+    {
+        Assert::IsTrue(components[1]->downloaddialog->prefetch != NULL);
+        Assert::IsTrue(0 == components[1]->downloaddialog->ExecOnThread());
+        Assert::IsTrue(pipeline.ReleaseDownload(components[1]));
+        Assert::IsTrue(components[1]->downloaddialog->prefetch == NULL);
+    }
+
+    Assert::IsTrue(DVLib::FileExists(destinations[1]));
+    DeleteDestinations(destinations);
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include "dotNetInstallerLibUnitTestFixture.h"
+
+namespace DVLib
+{
+	namespace UnitTests 
+	{
+		TEST_CLASS(ComponentsPipelineUnitTests), public dotNetInstallerLibUnitTestFixture
+		{
+            TEST_METHOD_INITIALIZE( initialize )
+            {
+                setUp();
+            }
+
+            TEST_METHOD_CLEANUP( cleanup )
+            {
+                tearDown();
+            }
+
+			TEST_METHOD( testPrefetchExtract );
+			TEST_METHOD( testPrefetchDownload );
+			TEST_METHOD( testPrefetchOutOfOrder );
+			TEST_METHOD( testFollowDownload );
+		};
+	}
+}
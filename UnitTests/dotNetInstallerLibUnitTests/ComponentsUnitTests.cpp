@@ -160,4 +160,302 @@ void ComponentsUnitTests::testSequenceInstalled()
     Assert::IsTrue(! cmd.IsInstalled());
     InstallerSession::Instance->sequence = SequenceUninstall;
     Assert::IsTrue(cmd.IsInstalled());
-}
\ No newline at end of file
+}
+
+void ComponentsUnitTests::testExecDependencies()
+{
+    // component1 depends on component2, which is executed first
+    Components components;
+    std::wstring check_file = DVLib::DirectoryCombine(DVLib::GetTemporaryDirectoryW(), DVLib::GenerateGUIDStringW());
+    CmdComponent * component1 = new CmdComponent();
+    component1->id = L"component1";
+    component1->command = L"cmd.exe /C echo one>> \"" + check_file + L"\"";
+    component1->depends_on.push_back(L"component2");
+    components.add(ComponentPtr(component1));
+    CmdComponent * component2 = new CmdComponent();
+    component2->id = L"component2";
+    component2->command = L"cmd.exe /C echo two>> \"" + check_file + L"\"";
+    components.add(ComponentPtr(component2));
+    ExecuteComponentCallbackImpl callback;
+    Assert::IsTrue(0 == components.Exec(& callback));
+    Assert::IsTrue(2 == callback.successes);
+    Assert::IsTrue(0 == callback.errors);
+    std::vector<char> data = DVLib::FileReadToEnd(check_file);
+    std::vector<std::string> lines = DVLib::split(std::string(data.begin(), data.end()), "\r\n");
+    Assert::IsTrue(lines[0] == "two");
+    Assert::IsTrue(lines[1] == "one");
+    DVLib::FileDelete(check_file);
+}
+
+void ComponentsUnitTests::testExecDependencyFailed()
+{
+    // component2 depends on component1 which fails, component2 is not executed and
+    // component3 depends on component2, which wasn't executed
+    Components components;
+    CmdComponent * component1 = new CmdComponent();
+    component1->id = L"component1";
+    component1->command = L"foobar.exe";
+    components.add(ComponentPtr(component1));
+    CmdComponent * component2 = new CmdComponent();
+    component2->id = L"component2";
+    component2->command = L"cmd.exe /C exit /b 0";
+    component2->depends_on.push_back(L"component1");
+    components.add(ComponentPtr(component2));
+    CmdComponent * component3 = new CmdComponent();
+    component3->id = L"component3";
+    component3->command = L"cmd.exe /C exit /b 0";
+    component3->depends_on.push_back(L"component2");
+    components.add(ComponentPtr(component3));
+    ExecuteComponentCallbackImpl callback;
+    Assert::IsTrue(0 != components.Exec(& callback));
+    Assert::IsTrue(1 == callback.begins);
+    Assert::IsTrue(0 == callback.successes);
+    // only the component that was executed reports an error
+    Assert::IsTrue(1 == callback.errors);
+}
+
+void ComponentsUnitTests::testExecCircularDependency()
+{
+    Components components;
+    CmdComponent * component1 = new CmdComponent();
+    component1->id = L"component1";
+    component1->command = L"cmd.exe /C exit /b 0";
+    component1->depends_on.push_back(L"component2");
+    components.add(ComponentPtr(component1));
+    CmdComponent * component2 = new CmdComponent();
+    component2->id = L"component2";
+    component2->command = L"cmd.exe /C exit /b 0";
+    component2->depends_on.push_back(L"component1");
+    components.add(ComponentPtr(component2));
+    ExecuteComponentCallbackImpl callback;
+    try
+    {
+        components.Exec(& callback);
+        throw "expected std::exception";
+    }
+    catch(std::exception&)
+    {
+        // expected
+    }
+
+    Assert::IsTrue(0 == callback.begins);
+}
+
+// records the latest process start and the earliest process exit
+class ExecuteOverlapCallbackImpl : public ExecuteComponentCallbackImpl
+{
+public:
+    ULONGLONG last_creation;
+    ULONGLONG first_exit;
+    ExecuteOverlapCallbackImpl() : last_creation(0), first_exit(_UI64_MAX) { }
+
+    bool OnComponentExecSuccess(const ComponentPtr& component)
+    {
+        FILETIME creation_time, exit_time, kernel_time, user_time;
+        ProcessComponent * process = dynamic_cast<ProcessComponent *>(get(component));
+        Assert::IsTrue(process != NULL);
+        Assert::IsTrue(TRUE == ::GetProcessTimes(process->m_process_handle, & creation_time, & exit_time, & kernel_time, & user_time));
+        ULARGE_INTEGER creation = { creation_time.dwLowDateTime, creation_time.dwHighDateTime };
+        ULARGE_INTEGER exit = { exit_time.dwLowDateTime, exit_time.dwHighDateTime };
+        if (creation.QuadPart > last_creation) last_creation = creation.QuadPart;
+        if (exit.QuadPart < first_exit) first_exit = exit.QuadPart;
+        return ExecuteComponentCallbackImpl::OnComponentExecSuccess(component);
+    }
+};
+
+void ComponentsUnitTests::testExecParallel()
+{
+    // independent parallel components all execute, each one waits for about two seconds
+    Components components;
+    for (int i = 0; i < 4; i++)
+    {
+        CmdComponent * component = new CmdComponent();
+        component->id = DVLib::GenerateGUIDStringW();
+        component->command = L"cmd.exe /C ping -n 3 127.0.0.1 > NUL";
+        component->concurrency = component_concurrency_parallel;
+        components.add(ComponentPtr(component));
+    }
+
+    ExecuteOverlapCallbackImpl callback;
+    Assert::IsTrue(0 == components.Exec(& callback, 4));
+    Assert::IsTrue(4 == callback.begins);
+    Assert::IsTrue(4 == callback.waits);
+    Assert::IsTrue(4 == callback.successes);
+    Assert::IsTrue(0 == callback.errors);
+    // all processes were started before any of them exited
+    Assert::IsTrue(callback.last_creation < callback.first_exit);
+}
+
+// records the time between a process exiting and the next component starting
+class ExecuteLatencyCallbackImpl : public ExecuteComponentCallbackImpl
+{
+private:
+    ULONGLONG m_last_exit;
+public:
+    std::vector<ULONGLONG> gaps;
+    ExecuteLatencyCallbackImpl() : m_last_exit(0) { }
+
+    bool OnComponentExecBegin(const ComponentPtr& component)
+    {
+        FILETIME now = { 0 };
+        ::GetSystemTimeAsFileTime(& now);
+        ULARGE_INTEGER begin = { now.dwLowDateTime, now.dwHighDateTime };
+        if (m_last_exit != 0)
+        {
+            gaps.push_back(begin.QuadPart > m_last_exit ? begin.QuadPart - m_last_exit : 0);
+        }
+
+        return ExecuteComponentCallbackImpl::OnComponentExecBegin(component);
+    }
+
+    bool OnComponentExecSuccess(const ComponentPtr& component)
+    {
+        FILETIME creation_time, exit_time, kernel_time, user_time;
+        ProcessComponent * process = dynamic_cast<ProcessComponent *>(get(component));
+        Assert::IsTrue(process != NULL);
+        Assert::IsTrue(TRUE == ::GetProcessTimes(process->m_process_handle, & creation_time, & exit_time, & kernel_time, & user_time));
+        ULARGE_INTEGER exit = { exit_time.dwLowDateTime, exit_time.dwHighDateTime };
+        m_last_exit = exit.QuadPart;
+        return ExecuteComponentCallbackImpl::OnComponentExecSuccess(component);
+    }
+};
+
+void ComponentsUnitTests::testExecLatencyBenchmark()
+{
+    // gap between one component finishing and the next one starting
+    const int count = 25;
+    Components components;
+    for (int i = 0; i < count; i++)
+    {
+        CmdComponent * component = new CmdComponent();
+        component->id = DVLib::GenerateGUIDStringW();
+        component->command = L"cmd.exe /C exit /b 0";
+        components.add(ComponentPtr(component));
+    }
+
+    ExecuteLatencyCallbackImpl callback;
+    Assert::IsTrue(0 == components.Exec(& callback));
+    Assert::IsTrue(count == callback.successes);
+    Assert::IsTrue(count - 1 == static_cast<int>(callback.gaps.size()));
+
+    ULONGLONG total = 0, worst = 0;
+    for each(ULONGLONG gap in callback.gaps)
+    {
+        total += gap;
+        if (gap > worst) worst = gap;
+    }
+
+    // FILETIME units are 100 nanoseconds
+    std::wcout << std::endl << L"Component hand-off latency over " << callback.gaps.size() << L" components: "
+        << L"average " << (total / callback.gaps.size()) / 10 << L" us, "
+        << L"worst " << worst / 10 << L" us";
+
+    // a polling wait sleeps at least a scheduler quantum between components
+    Assert::IsTrue(total / callback.gaps.size() < 100 * 10000);
+}
+
+// an installed check that takes a while to evaluate
+class SlowInstalledCheck : public InstalledCheck
+{
+private:
+    bool m_installed;
+    bool m_fail;
+public:
+    SlowInstalledCheck(bool installed, bool fail = false) : m_installed(installed), m_fail(fail) { }
+    void Load(const ConfigElement *) { }
+
+    bool IsInstalled() const
+    {
+        ::Sleep(250);
+        CHECK_BOOL(! m_fail, L"Installed check failed");
+        return m_installed;
+    }
+};
+
+void ComponentsUnitTests::testLoadInstalled()
+{
+    // checks that take 250 ms each are evaluated concurrently and merged in order
+    const int count = 16;
+    Components components;
+    for (int i = 0; i < count; i++)
+    {
+        CmdComponent * component = new CmdComponent();
+        component->id = DVLib::GenerateGUIDStringW();
+        component->installedchecks.push_back(InstalledCheckPtr(new SlowInstalledCheck(i % 3 == 0)));
+        components.add(ComponentPtr(component));
+    }
+
+    DWORD start = ::GetTickCount();
+    components.LoadInstalled();
+    DWORD elapsed = ::GetTickCount() - start;
+
+    for (int i = 0; i < count; i++)
+    {
+        Assert::IsTrue(components[i]->installed == (i % 3 == 0));
+    }
+
+    std::wcout << std::endl << L"Evaluated " << count << L" installed check(s) on "
+        << WorkerPool::Instance->GetMaxThreads() << L" thread(s): " << elapsed << L" ms";
+
+    // evaluating serially would take at least 4 seconds
+    if (WorkerPool::Instance->GetMaxThreads() > 1)
+    {
+        Assert::IsTrue(elapsed < 250 * count);
+    }
+}
+
+void ComponentsUnitTests::testLoadInstalledError()
+{
+    // the error of the first failed component is thrown once all checks have completed
+    Components components;
+    for (int i = 0; i < 4; i++)
+    {
+        CmdComponent * component = new CmdComponent();
+        component->id = DVLib::GenerateGUIDStringW();
+        component->installedchecks.push_back(InstalledCheckPtr(new SlowInstalledCheck(true, i >= 2)));
+        components.add(ComponentPtr(component));
+    }
+
+    try
+    {
+        components.LoadInstalled();
+        throw "expected std::exception";
+    }
+    catch(std::exception& ex)
+    {
+        std::cout << std::endl << ex.what();
+    }
+
+    Assert::IsTrue(components[0]->installed);
+    Assert::IsTrue(components[1]->installed);
+}
+
+void ComponentsUnitTests::testCopyBenchmark()
+{
+    const int count = 1000;
+    Components components;
+    for (int i = 0; i < count; i++)
+    {
+        ComponentPtr component(new CmdComponent());
+        component->id = DVLib::GenerateGUIDStringW();
+        component->os_filter = L"winXP";
+        components.add(component);
+    }
+
+    const int iterations = 1000;
+    DWORD start = ::GetTickCount();
+    for (int i = 0; i < iterations; i++)
+    {
+        Components copy(components);
+        Assert::IsTrue(copy.size() == components.size());
+    }
+
+    std::wcout << std::endl << L"Copied " << count << L" component(s) " << iterations << L" time(s): "
+        << (::GetTickCount() - start) << L" ms";
+
+    // copies share the components and their values
+    Components copy(components);
+    Assert::IsTrue(get(copy[0]) == get(components[0]));
+    Assert::IsTrue(copy.contains(components[count - 1]->id));
+    Assert::IsTrue(copy[0]->os_filter.IsSameSource(copy[count - 1]->os_filter));
+}
@@ -25,8 +25,16 @@ namespace DVLib
 			TEST_METHOD( testExecNoCallback );
 			TEST_METHOD( testExecWithCallback );
 			TEST_METHOD( testExecWithError );
+			TEST_METHOD( testExecDependencies );
+			TEST_METHOD( testExecDependencyFailed );
+			TEST_METHOD( testExecCircularDependency );
+			TEST_METHOD( testExecParallel );
+			TEST_METHOD( testExecLatencyBenchmark );
 			TEST_METHOD( testLoadUninstallSequence );
 			TEST_METHOD( testSequenceInstalled );
+			TEST_METHOD( testLoadInstalled );
+			TEST_METHOD( testLoadInstalledError );
+			TEST_METHOD( testCopyBenchmark );
 		};
 	}
 }
@@ -0,0 +1,143 @@
+#include "StdAfx.h"
+#include "ConfigArenaUnitTests.h"
+
+using namespace DVLib::UnitTests;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+void ConfigArenaUnitTests::testAllocate()
+{
+    ConfigArena * arena = new ConfigArena();
+    Assert::IsTrue(ConfigArena::GetCurrent() == NULL);
+    ComponentPtr component1, component2;
+    {
+        ConfigArenaScope scope(arena);
+        Assert::IsTrue(ConfigArena::GetCurrent() == arena);
+        component1 = ComponentPtr(new CmdComponent());
+        component1->id = L"component1";
+        {
+            // nested scopes without an arena allocate on the heap
+            ConfigArenaScope heap(NULL);
+            Assert::IsTrue(ConfigArena::GetCurrent() == NULL);
+            component2 = ComponentPtr(new CmdComponent());
+            component2->id = L"component2";
+        }
+        Assert::IsTrue(ConfigArena::GetCurrent() == arena);
+    }
+    Assert::IsTrue(ConfigArena::GetCurrent() == NULL);
+    Assert::IsTrue(arena->GetAllocations() == 1);
+    Assert::IsTrue(arena->GetBlockCount() == 1);
+    Assert::IsTrue(arena->GetSize() >= sizeof(CmdComponent));
+    // objects keep the arena after the owner releases it
+    arena->Release();
+    Assert::IsTrue(component1->id == L"component1");
+    Assert::IsTrue(component2->id == L"component2");
+    reset(component1);
+    reset(component2);
+}
+
+void ConfigArenaUnitTests::testAllocateBlocks()
+{
+    // objects are carved out of a few blocks
+    ConfigArena * arena = new ConfigArena();
+    std::vector<EmbedFilePtr> embedfiles;
+    {
+        ConfigArenaScope scope(arena);
+        for (int i = 0; i < 5000; i++)
+        {
+            embedfiles.push_back(EmbedFilePtr(new EmbedFile()));
+        }
+    }
+    Assert::IsTrue(arena->GetAllocations() == 5000);
+    Assert::IsTrue(arena->GetBlockCount() > 1);
+    Assert::IsTrue(arena->GetBlockCount() < 5000 / 10);
+    arena->Release();
+    embedfiles.clear();
+}
+
+void ConfigArenaUnitTests::testOutliveConfigFile()
+{
+    std::wstring configxml = DVLib::DirectoryCombine(DVLib::GetCurrentModuleDirectoryW(), 
+        L"..\\..\\..\\Samples\\PackagedSetup\\Configuration.xml");
+    Assert::IsTrue(DVLib::FileExists(configxml));
+    std::vector<ConfigurationPtr> configurations;
+    {
+        ConfigFile config;
+        config.LoadFile(configxml);
+        config.Materialize();
+        Assert::IsTrue(config.GetArena()->GetAllocations() > 0);
+        configurations.insert(configurations.end(), config.begin(), config.end());
+    }
+    // configurations and their components outlive the file they were loaded from
+    Assert::IsTrue(configurations.size() == 1);
+    const InstallConfiguration * configuration = reinterpret_cast<InstallConfiguration *>(get(configurations[0]));
+    Assert::IsTrue(configuration->components.size() == 1);
+    Assert::IsTrue(configuration->components[0]->type == component_type_msi);
+}
+
+void ConfigArenaUnitTests::testLoadBenchmark()
+{
+    // a synthetic configuration with one check, embedded file and download per component
+    const int count = 5000;
+    std::stringstream xml;
+    xml << "<configurations><configuration type=\"install\">";
+    for (int i = 0; i < count; i++)
+    {
+        xml << "<component type=\"cmd\" id=\"component" << i << "\" display_name=\"Component " << i << "\" command=\"cmd.exe /C exit /b 0\">"
+            << "<installedcheck type=\"check_registry_value\" rootkey=\"HKEY_LOCAL_MACHINE\" path=\"SOFTWARE\\Vendor\\Product" << i << "\" fieldname=\"Installed\" />"
+            << "<embedfile sourcefilepath=\"file" << i << ".txt\" targetfilepath=\"file" << i << ".txt\" />"
+            << "<downloaddialog dialog_caption=\"Download\"><download componentname=\"component" << i << "\" sourceurl=\"http://localhost/file" << i << ".txt\" /></downloaddialog>"
+            << "</component>";
+    }
+    xml << "</configuration></configurations>";
+
+    ConfigImage image;
+    {
+        std::string data = xml.str();
+        tinyxml2::XMLDocument doc;
+        doc.Parse(data.c_str(), data.size());
+        Assert::IsTrue(! doc.Error());
+        image.Compile(doc.RootElement());
+    }
+
+    const int iterations = 5;
+    DWORD heap_load = 0, heap_teardown = 0, arena_load = 0, arena_teardown = 0;
+    LONG allocations = 0;
+    size_t blocks = 0;
+    for (int i = 0; i < iterations; i++)
+    {
+        // each object on the heap
+        DWORD start = ::GetTickCount();
+        Configurations * heap = new Configurations();
+        heap->Load(image.GetRoot());
+        heap->Materialize();
+        heap_load += ::GetTickCount() - start;
+        Assert::IsTrue(reinterpret_cast<InstallConfiguration *>(get((* heap)[0]))->components.size() == count);
+        start = ::GetTickCount();
+        delete heap;
+        heap_teardown += ::GetTickCount() - start;
+
+        // objects carved out of the arena of the configuration
+        start = ::GetTickCount();
+        ConfigArena * arena = new ConfigArena();
+        Configurations * configurations = new Configurations();
+        {
+            ConfigArenaScope scope(arena);
+            configurations->Load(image.GetRoot());
+        }
+        configurations->Materialize();
+        arena_load += ::GetTickCount() - start;
+        Assert::IsTrue(reinterpret_cast<InstallConfiguration *>(get((* configurations)[0]))->components.size() == count);
+        allocations = arena->GetAllocations();
+        blocks = arena->GetBlockCount();
+        start = ::GetTickCount();
+        arena->Release();
+        delete configurations;
+        arena_teardown += ::GetTickCount() - start;
+    }
+
+    // a component, a check, an embedded file and a download file per component
+    Assert::IsTrue(allocations == count * 4);
+    std::wcout << std::endl << L"Loaded " << count << L" component(s) " << iterations << L" time(s): "
+        << L"heap " << allocations << L" allocation(s), load " << heap_load << L" ms, teardown " << heap_teardown << L" ms; "
+        << L"arena " << blocks << L" block(s), load " << arena_load << L" ms, teardown " << arena_teardown << L" ms";
+}
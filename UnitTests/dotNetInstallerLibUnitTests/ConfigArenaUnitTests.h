@@ -0,0 +1,26 @@
+#pragma once
+#include "dotNetInstallerLibUnitTestFixture.h"
+
+namespace DVLib
+{
+	namespace UnitTests 
+	{
+		TEST_CLASS(ConfigArenaUnitTests), public dotNetInstallerLibUnitTestFixture
+		{
+            TEST_METHOD_INITIALIZE( initialize )
+            {
+                setUp();
+            }
+
+            TEST_METHOD_CLEANUP( cleanup )
+            {
+                tearDown();
+            }
+
+			TEST_METHOD( testAllocate );
+			TEST_METHOD( testAllocateBlocks );
+			TEST_METHOD( testOutliveConfigFile );
+			TEST_METHOD( testLoadBenchmark );
+		};
+	}
+}
@@ -11,6 +11,7 @@ void ConfigFileUnitTests::testLoadPackagedSetup()
     Assert::IsTrue(DVLib::FileExists(configxml));
     ConfigFile config;
     config.LoadFile(configxml);
+    config.Materialize();
     // configurations properties
     Assert::IsTrue(! config.schema.generator.empty());
     Assert::IsTrue(! config.schema.version.empty());
@@ -37,6 +38,7 @@ void ConfigFileUnitTests::testLoadInstallCheckProductSetup()
     Assert::IsTrue(DVLib::FileExists(configxml));
     ConfigFile config;
     config.LoadFile(configxml);
+    config.Materialize();
     // configurations properties
     Assert::IsTrue(! config.schema.generator.empty());
     Assert::IsTrue(! config.schema.version.empty());
@@ -62,6 +64,7 @@ void ConfigFileUnitTests::testLoadInstallCheckOperators()
     Assert::IsTrue(DVLib::FileExists(configxml));
     ConfigFile config;
     config.LoadFile(configxml);
+    config.Materialize();
     // configurations properties
     Assert::IsTrue(! config.schema.generator.empty());
     Assert::IsTrue(! config.schema.version.empty());
@@ -112,6 +115,7 @@ void ConfigFileUnitTests::testLoadDownloadSetup()
     Assert::IsTrue(DVLib::FileExists(configxml));
     ConfigFile config;
     config.LoadFile(configxml);
+    config.Materialize();
     // configurations properties
     Assert::IsTrue(! config.schema.generator.empty());
     Assert::IsTrue(! config.schema.version.empty());
@@ -139,6 +143,7 @@ void ConfigFileUnitTests::testLoadReferenceSetup()
     Assert::IsTrue(DVLib::FileExists(configxml));
     ConfigFile config;
     config.LoadFile(configxml);
+    config.Materialize();
     // configurations properties
     Assert::IsTrue(! config.schema.generator.empty());
     Assert::IsTrue(! config.schema.version.empty());
@@ -160,6 +165,7 @@ void ConfigFileUnitTests::testLoadResource()
 {
     ConfigFile config;
     config.LoadResource(GetCurrentModuleHandle(), L"RES_CONFIGURATION");
+    config.Materialize();
     // configurations properties
     Assert::IsTrue(! config.schema.generator.empty());
     Assert::IsTrue(! config.schema.version.empty());
@@ -200,6 +206,7 @@ void ConfigFileUnitTests::testLoadOsFiltersSetup()
     // there're three components in this sample, but only 1 will show because the os filters don't overlap
     Assert::IsTrue(config.size() == 1);
     Assert::IsTrue(config.GetSupportedConfigurations(0, SequenceInstall).size() == 1);
+    Assert::IsTrue(config[0]->IsMaterialized());
     const InstallConfiguration * configuration = reinterpret_cast<InstallConfiguration *>(get(config[0]));
     Assert::IsTrue(configuration->components.size() == 3);	
 }
@@ -253,6 +260,7 @@ void ConfigFileUnitTests::testLoadLicenseAgreement()
     Assert::IsTrue(DVLib::FileExists(configxml));
     ConfigFile config;
     config.LoadFile(configxml);
+    config.Materialize();
     // there's one configuration in this sample
     Assert::IsTrue(config.size() == 1);
     const InstallConfiguration * configuration = reinterpret_cast<InstallConfiguration *>(get(config[0]));
@@ -269,6 +277,7 @@ void ConfigFileUnitTests::testLoadCustomInputSetup()
     Assert::IsTrue(DVLib::FileExists(configxml));
     ConfigFile config;
     config.LoadFile(configxml);
+    config.Materialize();
     // there's one configuration in this sample
     Assert::IsTrue(config.size() == 1);
     const InstallConfiguration * configuration = reinterpret_cast<InstallConfiguration *>(get(config[0]));
@@ -289,6 +298,7 @@ void ConfigFileUnitTests::testLoadPatchSetup()
     Assert::IsTrue(DVLib::FileExists(configxml));
     ConfigFile config;
     config.LoadFile(configxml);
+    config.Materialize();
     // configurations with components
     Assert::IsTrue(config.size() == 1);
     const InstallConfiguration * configuration = reinterpret_cast<InstallConfiguration *>(get(config[0]));
@@ -306,6 +316,7 @@ void ConfigFileUnitTests::testLoadExeSetup()
     Assert::IsTrue(DVLib::FileExists(configxml));
     ConfigFile config;
     config.LoadFile(configxml);
+    config.Materialize();
     // configurations with components
     Assert::IsTrue(config.size() == 1);
     const InstallConfiguration * configuration = reinterpret_cast<InstallConfiguration *>(get(config[0]));
@@ -313,3 +324,79 @@ void ConfigFileUnitTests::testLoadExeSetup()
     ComponentPtr component_exe = configuration->components[0];
     Assert::IsTrue(component_exe->type == component_type_exe);	
 }
+
+void ConfigFileUnitTests::testLoadFileBenchmark()
+{
+    std::wstring samples = DVLib::DirectoryCombine(DVLib::GetCurrentModuleDirectoryW(), 
+        L"..\\..\\..\\Samples");
+    std::list<std::wstring> configxmls = DVLib::GetFiles(samples, L"Configuration.xml", 
+        DVLib::GET_FILES_FILES | DVLib::GET_FILES_RECURSIVE);
+    Assert::IsTrue(configxmls.size() > 0);
+
+    const int iterations = 100;
+    long bytes = 0;
+    DWORD read_elapsed = 0, mapped_elapsed = 0;
+    for each(const std::wstring& configxml in configxmls)
+    {
+        bytes += DVLib::GetFileSize(configxml);
+
+        // previous load path: read into a buffer, null-terminate and let tinyxml2 copy it
+        DWORD start = ::GetTickCount();
+        for (int i = 0; i < iterations; i++)
+        {
+            std::vector<char> xml = DVLib::FileReadToEnd(configxml);
+            xml.push_back(0);
+            tinyxml2::XMLDocument doc;
+            doc.Parse(& * xml.begin());
+            Assert::IsTrue(! doc.Error());
+        }
+        read_elapsed += ::GetTickCount() - start;
+
+        start = ::GetTickCount();
+        for (int i = 0; i < iterations; i++)
+        {
+            DVLib::MappedFile xml(configxml);
+            tinyxml2::XMLDocument doc;
+            doc.Parse(xml.GetData(), xml.GetSize());
+            Assert::IsTrue(! doc.Error());
+        }
+        mapped_elapsed += ::GetTickCount() - start;
+
+        ConfigFile config;
+        config.LoadFile(configxml);
+        Assert::IsTrue(config.size() > 0);
+    }
+
+    std::wcout << std::endl << L"Parsed " << configxmls.size() << L" configuration(s), "
+        << DVLib::FormatBytesW(bytes) << L", " << iterations << L" time(s): "
+        << L"read " << read_elapsed << L" ms, mapped " << mapped_elapsed << L" ms";
+}
+
+void ConfigFileUnitTests::testLoadLazy()
+{
+    std::wstring configxml = DVLib::DirectoryCombine(DVLib::GetCurrentModuleDirectoryW(), 
+        L"..\\..\\..\\Samples\\MultilingualSetup\\Configuration.xml");
+    Assert::IsTrue(DVLib::FileExists(configxml));
+    ConfigFile config;
+    config.LoadFile(configxml);
+    // configurations are indexed by their filters only
+    Assert::IsTrue(config.size() == 2);
+    Assert::IsTrue(config[0]->lcid_filter == L"1040");
+    Assert::IsTrue(config[1]->lcid_filter == L"!1040");
+    for (size_t i = 0; i < config.size(); i++)
+    {
+        Assert::IsTrue(! config[i]->IsMaterialized());
+        Assert::IsTrue(reinterpret_cast<InstallConfiguration *>(get(config[i]))->components.size() == 0);
+    }
+    // only the supported configuration is materialized
+    std::vector<ConfigurationPtr> supported = config.GetSupportedConfigurations(1040, SequenceInstall);
+    Assert::IsTrue(supported.size() == 1);
+    Assert::IsTrue(config[0]->IsMaterialized());
+    Assert::IsTrue(! config[1]->IsMaterialized());
+    Assert::IsTrue(reinterpret_cast<InstallConfiguration *>(get(config[0]))->components.size() == 1);
+    // materializing again doesn't load children twice
+    config.Materialize();
+    Assert::IsTrue(config[1]->IsMaterialized());
+    Assert::IsTrue(reinterpret_cast<InstallConfiguration *>(get(config[0]))->components.size() == 1);
+    Assert::IsTrue(reinterpret_cast<InstallConfiguration *>(get(config[1]))->components.size() == 1);
+}
@@ -32,6 +32,8 @@ namespace DVLib
 			TEST_METHOD( testLoadMultipleSetup );
 			TEST_METHOD( testLoadPatchSetup );
 			TEST_METHOD( testLoadExeSetup );
+			TEST_METHOD( testLoadFileBenchmark );
+			TEST_METHOD( testLoadLazy );
 		};
 	}
 }
@@ -55,6 +55,98 @@ void ConfigFilesUnitTests::testDownload()
     Assert::IsTrue(cf.GetRuns() == 0);
 }
 
+void ConfigFilesUnitTests::testDownloadCache()
+{
+    std::wstring packagedxml = DVLib::DirectoryCombine(DVLib::GetCurrentModuleDirectoryW(), 
+        L"..\\..\\..\\Samples\\PackagedSetup\\Configuration.xml");
+    Assert::IsTrue(DVLib::FileExists(packagedxml));
+    std::wstring path = DVLib::DirectoryCombine(DVLib::GetTemporaryDirectoryW(), L"ConfigFilesUnitTests_testDownloadCache");
+    if (DVLib::DirectoryExists(path)) DVLib::DirectoryDelete(path);
+    DVLib::DirectoryCreate(path);
+    std::wstring sourcexml = DVLib::DirectoryCombine(path, L"source.xml");
+    DVLib::FileCopy(packagedxml, sourcexml);
+    wchar_t sourceurl[2048] = { 0 };
+    DWORD sourceurl_size = ARRAYSIZE(sourceurl);
+    Assert::IsTrue(SUCCEEDED(::UrlCreateFromPathW(sourcexml.c_str(), sourceurl, & sourceurl_size, 0)));
+    // two sibling references downloaded from the packaged setup sample, always downloaded by default
+    std::wstring xml = L"<configurations>";
+    for (int i = 1; i <= 2; i++)
+    {
+        std::wstring refpath = DVLib::DirectoryCombine(path, L"ref" + DVLib::towstring(i));
+        xml.append(L"<configuration type=\"reference\">");
+        xml.append(L"<configfile filename=\"" + DVLib::DirectoryCombine(refpath, L"configuration.xml") + L"\" />");
+        xml.append(L"<downloaddialog dialog_caption=\"Download\">");
+        xml.append(L"<download componentname=\"ref\" sourceurl=\"" + std::wstring(sourceurl) + L"\" destinationpath=\"" + refpath + 
+            L"\" destinationfilename=\"configuration.xml\" />");
+        xml.append(L"</downloaddialog>");
+        xml.append(L"</configuration>");
+    }
+    xml.append(L"</configurations>");
+    std::string xml_s = DVLib::wstring2string(xml);
+    std::wstring configxml = DVLib::DirectoryCombine(path, L"Configuration.xml");
+    DVLib::FileWrite(configxml, std::vector<char>(xml_s.begin(), xml_s.end()));
+    // first load downloads and caches both references
+    {
+        ConfigFilesImpl cf(configxml);
+        cf.Load();
+        Assert::IsTrue(cf.GetDownloads() == 2);
+        Assert::IsTrue(cf.size() == 2);
+        Assert::IsTrue(DVLib::FileExists(DVLib::DirectoryCombine(path, L"ref1\\configuration.xml.cache")));
+        Assert::IsTrue(DVLib::FileExists(DVLib::DirectoryCombine(path, L"ref2\\configuration.xml.cache")));
+    }
+    // second load uses the cache
+    {
+        ConfigFilesImpl cf(configxml);
+        cf.Load();
+        Assert::IsTrue(cf.GetDownloads() == 0);
+        Assert::IsTrue(cf.size() == 2);
+    }
+    // a modified reference no longer matches its cache and is downloaded again
+    {
+        std::vector<char> data = DVLib::FileReadToEnd(DVLib::DirectoryCombine(path, L"ref1\\configuration.xml"));
+        data.push_back(' ');
+        DVLib::FileWrite(DVLib::DirectoryCombine(path, L"ref1\\configuration.xml"), data);
+        ConfigFilesImpl cf(configxml);
+        cf.Load();
+        Assert::IsTrue(cf.GetDownloads() == 1);
+        Assert::IsTrue(cf.size() == 2);
+        Assert::IsTrue(DVLib::GetFileHash(sourcexml) == DVLib::GetFileHash(DVLib::DirectoryCombine(path, L"ref1\\configuration.xml")));
+    }
+    // a modified source invalidates both references
+    {
+        std::vector<char> data = DVLib::FileReadToEnd(sourcexml);
+        data.push_back(' ');
+        DVLib::FileWrite(sourcexml, data);
+        ConfigFilesImpl cf(configxml);
+        cf.Load();
+        Assert::IsTrue(cf.GetDownloads() == 2);
+        Assert::IsTrue(cf.size() == 2);
+        Assert::IsTrue(DVLib::GetFileHash(sourcexml) == DVLib::GetFileHash(DVLib::DirectoryCombine(path, L"ref1\\configuration.xml")));
+        Assert::IsTrue(DVLib::GetFileHash(sourcexml) == DVLib::GetFileHash(DVLib::DirectoryCombine(path, L"ref2\\configuration.xml")));
+    }
+    // a reference without a download dialog is the user's file, never cached or deleted
+    {
+        std::wstring userxml = DVLib::DirectoryCombine(path, L"user.xml");
+        DVLib::FileCopy(packagedxml, userxml);
+        std::string user_s = DVLib::wstring2string(L"<configurations><configuration type=\"reference\"><configfile filename=\"" 
+            + userxml + L"\" /></configuration></configurations>");
+        std::wstring userconfigxml = DVLib::DirectoryCombine(path, L"UserConfiguration.xml");
+        DVLib::FileWrite(userconfigxml, std::vector<char>(user_s.begin(), user_s.end()));
+        for (int i = 0; i < 2; i++)
+        {
+            ConfigFilesImpl cf(userconfigxml);
+            cf.Load();
+            Assert::IsTrue(cf.size() == 1);
+            Assert::IsTrue(! DVLib::FileExists(userxml + L".cache"));
+            std::vector<char> data = DVLib::FileReadToEnd(userxml);
+            data.push_back(' ');
+            DVLib::FileWrite(userxml, data);
+        }
+        Assert::IsTrue(DVLib::FileExists(userxml));
+    }
+    DVLib::DirectoryDelete(path);
+}
+
 void ConfigFilesUnitTests::testRun()
 {
     std::wstring configxml = DVLib::DirectoryCombine(DVLib::GetCurrentModuleDirectoryW(), 
@@ -20,6 +20,7 @@ namespace DVLib
 			TEST_METHOD( testSaveRestoreAppState );
 			TEST_METHOD( testLoad );
 			TEST_METHOD( testDownload );
+			TEST_METHOD( testDownloadCache );
 			TEST_METHOD( testRun );
 			TEST_METHOD( testSelectLanguageNoSelection );
 			TEST_METHOD( testSelectLanguage1040 );
@@ -0,0 +1,229 @@
+#include "StdAfx.h"
+#include "ConfigImageUnitTests.h"
+
+using namespace DVLib::UnitTests;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+void ConfigImageUnitTests::testCompile()
+{
+    tinyxml2::XMLDocument doc;
+    doc.Parse("<configurations lcid_type=\"UserExe\">\
+              <!-- comment -->\
+              <schema version=\"1.0\" />\
+              <configuration type=\"install\" language=\"fran\xC3\xA7" "ais\">\
+                <component type=\"cmd\" id=\"first\" />\
+                <control type=\"label\" />\
+                <component type=\"cmd\" id=\"second\" />\
+              </configuration>\
+              </configurations>");
+    Assert::IsTrue(! doc.Error());
+    ConfigImage image;
+    image.Compile(doc.RootElement());
+    Assert::IsTrue(! image.empty());
+    Assert::IsTrue(image.GetSize() > sizeof(ConfigImage::Header));
+    const ConfigElement * root = image.GetRoot();
+    Assert::IsTrue(std::wstring(root->Value()) == L"configurations");
+    Assert::IsTrue(std::wstring(root->Attribute("lcid_type")) == L"UserExe");
+    // missing attributes are empty
+    Assert::IsTrue(std::wstring(root->Attribute("ui_level")) == L"");
+    // comments are dropped
+    const ConfigElement * schema = root->FirstChildElement();
+    Assert::IsTrue(std::wstring(schema->Value()) == L"schema");
+    Assert::IsTrue(std::wstring(schema->Attribute("version")) == L"1.0");
+    Assert::IsTrue(schema->FirstChildElement() == NULL);
+    // values are converted from UTF-8 when compiled
+    const ConfigElement * configuration = schema->NextSiblingElement();
+    Assert::IsTrue(configuration == root->FirstChildElement("configuration"));
+    Assert::IsTrue(std::wstring(configuration->Attribute("language")) == L"fran\u00E7ais");
+    Assert::IsTrue(configuration->NextSiblingElement() == NULL);
+    // named lookups skip other elements
+    std::vector<std::wstring> ids;
+    for (const ConfigElement * component = configuration->FirstChildElement("component"); component; component = component->NextSiblingElement("component"))
+        ids.push_back(component->Attribute("id"));
+    Assert::IsTrue(ids.size() == 2);
+    Assert::IsTrue(ids[0] == L"first");
+    Assert::IsTrue(ids[1] == L"second");
+    Assert::IsTrue(configuration->FirstChildElement("control")->NextSiblingElement("control") == NULL);
+    Assert::IsTrue(configuration->FirstChildElement("missing") == NULL);
+}
+
+void ConfigImageUnitTests::testAttach()
+{
+    tinyxml2::XMLDocument doc;
+    doc.Parse("<configurations><configuration type=\"install\"><component type=\"cmd\" /></configuration></configurations>");
+    ConfigImage compiled;
+    compiled.Compile(doc.RootElement());
+    Assert::IsTrue(ConfigImage::IsSupported(compiled.GetData(), compiled.GetSize()));
+    // an image is read in place from a copy of the data, eg. a resource
+    std::vector<char> data(compiled.GetData(), compiled.GetData() + compiled.GetSize());
+    ConfigImage image;
+    image.Attach(& * data.begin(), data.size());
+    Assert::IsTrue(image.GetData() == & * data.begin());
+    Assert::IsTrue(image.GetSize() == compiled.GetSize());
+    const ConfigElement * component = image.GetRoot()->FirstChildElement()->FirstChildElement();
+    Assert::IsTrue(std::wstring(component->Value()) == L"component");
+    Assert::IsTrue(std::wstring(component->Attribute("type")) == L"cmd");
+}
+
+void ConfigImageUnitTests::testAttachInvalid()
+{
+    tinyxml2::XMLDocument doc;
+    doc.Parse("<configurations><configuration type=\"install\" /></configurations>");
+    ConfigImage compiled;
+    compiled.Compile(doc.RootElement());
+    std::vector<char> data(compiled.GetData(), compiled.GetData() + compiled.GetSize());
+    ConfigImage::Header * header = reinterpret_cast<ConfigImage::Header *>(& * data.begin());
+    // xml, other versions and truncated images are not supported
+    const char * xml = "<configurations />";
+    Assert::IsTrue(! ConfigImage::IsSupported(xml, strlen(xml)));
+    Assert::IsTrue(! ConfigImage::IsSupported(& * data.begin(), data.size() - 1));
+    header->version++;
+    Assert::IsTrue(! ConfigImage::IsSupported(& * data.begin(), data.size()));
+    header->version--;
+    // offsets that point outside of the image or back at an element are rejected
+    LONG bad_roots[] = { 0, static_cast<LONG>(data.size()), -1, 2 };
+    LONG root = header->root;
+    for (int i = 0; i < ARRAYSIZE(bad_roots); i++)
+    {
+        header->root = bad_roots[i];
+        try
+        {
+            ConfigImage image;
+            image.Attach(& * data.begin(), data.size());
+            throw "expected std::exception";
+        }
+        catch(std::exception& ex)
+        {
+            std::cout << std::endl << ex.what();
+        }
+    }
+
+    header->root = root;
+    // a sibling that links back to its parent
+    ConfigElement * configurations = reinterpret_cast<ConfigElement *>(& * data.begin() + root);
+    ConfigElement * configuration = reinterpret_cast<ConfigElement *>(& * data.begin() + root + configurations->first_child);
+    configuration->next = -configurations->first_child;
+    try
+    {
+        ConfigImage image;
+        image.Attach(& * data.begin(), data.size());
+        throw "expected std::exception";
+    }
+    catch(std::exception& ex)
+    {
+        std::cout << std::endl << ex.what();
+    }
+}
+
+void ConfigImageUnitTests::testLoadSamples()
+{
+    std::wstring samples = DVLib::DirectoryCombine(DVLib::GetCurrentModuleDirectoryW(), 
+        L"..\\..\\..\\Samples");
+    std::list<std::wstring> configxmls = DVLib::GetFiles(samples, L"Configuration.xml", 
+        DVLib::GET_FILES_FILES | DVLib::GET_FILES_RECURSIVE);
+    Assert::IsTrue(configxmls.size() > 0);
+    for each(const std::wstring& configxml in configxmls)
+    {
+        ConfigFile config;
+        config.LoadFile(configxml);
+        // an attached copy of the image loads the same configurations
+        std::vector<char> data(config.GetImage().GetData(), config.GetImage().GetData() + config.GetImage().GetSize());
+        ConfigImage image;
+        image.Attach(& * data.begin(), data.size());
+        Configurations configurations;
+        configurations.Load(image.GetRoot());
+        configurations.Materialize();
+        std::wcout << std::endl << configxml << L": " << DVLib::FormatBytesW(DVLib::GetFileSize(configxml))
+            << L" xml, " << DVLib::FormatBytesW(image.GetSize()) << L" image";
+        Assert::IsTrue(configurations.size() == config.size());
+        Assert::IsTrue(configurations.fileversion == config.fileversion);
+        for (size_t i = 0; i < config.size(); i++)
+        {
+            Assert::IsTrue(configurations[i]->type == config[i]->type);
+        }
+    }
+}
+
+// reads every attribute as a UTF-16 string the way loading configurations straight from the xml did
+static size_t ReadAttributes(const tinyxml2::XMLElement * node)
+{
+    size_t count = 0;
+    for (const tinyxml2::XMLAttribute * attribute = node->FirstAttribute(); attribute; attribute = attribute->Next())
+    {
+        count += DVLib::UTF8string2wstring(attribute->Value()).length() > 0 ? 1 : 0;
+    }
+
+    for (const tinyxml2::XMLElement * child = node->FirstChildElement(); child; child = child->NextSiblingElement())
+    {
+        count += ReadAttributes(child);
+    }
+
+    return count;
+}
+
+void ConfigImageUnitTests::testLoadBenchmark()
+{
+    std::wstring samples = DVLib::DirectoryCombine(DVLib::GetCurrentModuleDirectoryW(), 
+        L"..\\..\\..\\Samples");
+    std::list<std::wstring> configxmls = DVLib::GetFiles(samples, L"Configuration.xml", 
+        DVLib::GET_FILES_FILES | DVLib::GET_FILES_RECURSIVE);
+    Assert::IsTrue(configxmls.size() > 0);
+
+    const int iterations = 100;
+    DWORD dom_elapsed = 0, xml_elapsed = 0, image_elapsed = 0;
+    for each(const std::wstring& configxml in configxmls)
+    {
+        std::vector<char> xml = DVLib::FileReadToEnd(configxml);
+        ConfigImage compiled;
+        {
+            tinyxml2::XMLDocument doc;
+            doc.Parse(& * xml.begin(), xml.size());
+            compiled.Compile(doc.RootElement());
+        }
+
+        // dom: parse and convert attributes while loading, as before images, the objects are loaded from the
+        // compiled image so that only the work that differs from the xml path below is measured
+        DWORD start = ::GetTickCount();
+        for (int i = 0; i < iterations; i++)
+        {
+            tinyxml2::XMLDocument doc;
+            doc.Parse(& * xml.begin(), xml.size());
+            ReadAttributes(doc.RootElement());
+            ConfigImage image;
+            image.Attach(compiled.GetData(), compiled.GetSize());
+            Configurations configurations;
+            configurations.Load(image.GetRoot());
+            configurations.Materialize();
+        }
+        dom_elapsed += ::GetTickCount() - start;
+
+        // xml: parse, convert and compile at every startup, the fallback without a linked image
+        start = ::GetTickCount();
+        for (int i = 0; i < iterations; i++)
+        {
+            tinyxml2::XMLDocument doc;
+            doc.Parse(& * xml.begin(), xml.size());
+            ConfigImage image;
+            image.Compile(doc.RootElement(), xml.size());
+            Configurations configurations;
+            configurations.Load(image.GetRoot());
+            configurations.Materialize();
+        }
+        xml_elapsed += ::GetTickCount() - start;
+
+        // image: read in place, as linked next to the xml
+        start = ::GetTickCount();
+        for (int i = 0; i < iterations; i++)
+        {
+            ConfigImage image;
+            image.Attach(compiled.GetData(), compiled.GetSize());
+            Configurations configurations;
+            configurations.Load(image.GetRoot());
+            configurations.Materialize();
+        }
+        image_elapsed += ::GetTickCount() - start;
+    }
+
+    std::wcout << std::endl << L"Loaded " << configxmls.size() << L" configuration(s) " << iterations << L" time(s): "
+        << L"dom " << dom_elapsed << L" ms, xml " << xml_elapsed << L" ms, image " << image_elapsed << L" ms";
+}
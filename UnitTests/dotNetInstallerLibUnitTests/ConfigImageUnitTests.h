@@ -0,0 +1,27 @@
+#pragma once
+#include "dotNetInstallerLibUnitTestFixture.h"
+
+namespace DVLib
+{
+	namespace UnitTests 
+	{
+        TEST_CLASS(ConfigImageUnitTests), public dotNetInstallerLibUnitTestFixture
+		{
+            TEST_METHOD_INITIALIZE( initialize )
+            {
+                setUp();
+            }
+
+            TEST_METHOD_CLEANUP( cleanup )
+            {
+                tearDown();
+            }
+
+			TEST_METHOD( testCompile );
+			TEST_METHOD( testAttach );
+			TEST_METHOD( testAttachInvalid );
+			TEST_METHOD( testLoadSamples );
+			TEST_METHOD( testLoadBenchmark );
+		};
+	}
+}
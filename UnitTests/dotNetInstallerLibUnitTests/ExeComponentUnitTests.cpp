@@ -227,6 +227,7 @@ void ExeComponentUnitTests::testReturnCodeSuccess()
 void ExeComponentUnitTests::testLoad()
 {
     tinyxml2::XMLDocument doc;
+    ConfigImage image;
     doc.Parse("<component type=\"exe\" \
               executable=\"test-dir\\test.exe\" \
               exeparameters=\"/i\" \
@@ -234,7 +235,8 @@ void ExeComponentUnitTests::testLoad()
               uninstall_exeparameters=\"/u\" \
               execution_method=\"ShellExecute\"/>");
     ExeComponent component;
-    component.Load(doc.RootElement());
+    image.Compile(doc.RootElement());
+    component.Load(image.GetRoot());
     Assert::IsTrue(component.executable.GetValue() == L"test-dir\\test.exe");
     Assert::IsTrue(component.exeparameters.GetValue() == L"/i");
     Assert::IsTrue(component.uninstall_executable.GetValue() == L"test-dir\\testu.exe");
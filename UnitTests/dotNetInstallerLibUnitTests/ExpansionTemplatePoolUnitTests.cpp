@@ -0,0 +1,71 @@
+#include "StdAfx.h"
+#include "ExpansionTemplatePoolUnitTests.h"
+
+using namespace DVLib::UnitTests;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+void ExpansionTemplatePoolUnitTests::testIntern()
+{
+    ExpansionTemplatePool pool;
+    Assert::IsTrue(pool.Intern(L"") == NULL);
+    const ExpansionTemplate * value = pool.Intern(L"Install [a] in #APPPATH");
+    Assert::IsTrue(value != NULL);
+    Assert::IsTrue(value->GetSource() == L"Install [a] in #APPPATH");
+    Assert::IsTrue(value->GetTokens().size() == 4);
+    Assert::IsTrue(pool.Intern(L"Install [a] in #APPPATH") == value);
+    Assert::IsTrue(pool.Intern(L"Install [b] in #APPPATH") != value);
+    Assert::IsTrue(pool.size() == 2);
+    Assert::IsTrue(pool.GetHits() == 1);
+    Assert::IsTrue(pool.GetMisses() == 2);
+}
+
+void ExpansionTemplatePoolUnitTests::testInternBlocks()
+{
+    // values keep their address as blocks are added
+    ExpansionTemplatePool pool;
+    std::vector<const ExpansionTemplate *> values;
+    for (int i = 0; i < 1000; i++)
+    {
+        values.push_back(pool.Intern(DVLib::towstring(i)));
+    }
+
+    Assert::IsTrue(pool.size() == 1000);
+    for (int i = 0; i < 1000; i++)
+    {
+        Assert::IsTrue(pool.Intern(DVLib::towstring(i)) == values[i]);
+        Assert::IsTrue(values[i]->GetSource() == DVLib::towstring(i));
+    }
+}
+
+void ExpansionTemplatePoolUnitTests::testLoadSamples()
+{
+    std::wstring samples = DVLib::DirectoryCombine(DVLib::GetCurrentModuleDirectoryW(), 
+        L"..\\..\\..\\Samples");
+    std::list<std::wstring> configxmls = DVLib::GetFiles(samples, L"Configuration.xml", 
+        DVLib::GET_FILES_FILES | DVLib::GET_FILES_RECURSIVE);
+    Assert::IsTrue(configxmls.size() > 0);
+
+    // loading the same configurations again shares all values
+    ExpansionTemplatePool& pool = ExpansionTemplatePool::Instance();
+    for each(const std::wstring& configxml in configxmls)
+    {
+        ConfigFile config;
+        config.LoadFile(configxml);
+        config.Materialize();
+    }
+
+    size_t size = pool.size();
+    LONG hits = pool.GetHits();
+    LONG misses = pool.GetMisses();
+    for each(const std::wstring& configxml in configxmls)
+    {
+        ConfigFile config;
+        config.LoadFile(configxml);
+        config.Materialize();
+    }
+
+    Assert::IsTrue(pool.size() == size);
+    Assert::IsTrue(pool.GetMisses() == misses);
+    std::wcout << std::endl << L"Loaded " << configxmls.size() << L" configuration(s): " << size << L" distinct value(s), " 
+        << (pool.GetHits() - hits) << L" shared value(s)";
+}
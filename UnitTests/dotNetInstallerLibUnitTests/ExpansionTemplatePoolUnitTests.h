@@ -0,0 +1,25 @@
+#pragma once
+#include "dotNetInstallerLibUnitTestFixture.h"
+
+namespace DVLib
+{
+	namespace UnitTests 
+	{
+		TEST_CLASS(ExpansionTemplatePoolUnitTests), public dotNetInstallerLibUnitTestFixture
+		{
+            TEST_METHOD_INITIALIZE( initialize )
+            {
+                setUp();
+            }
+
+            TEST_METHOD_CLEANUP( cleanup )
+            {
+                tearDown();
+            }
+
+			TEST_METHOD( testIntern );
+			TEST_METHOD( testInternBlocks );
+			TEST_METHOD( testLoadSamples );
+		};
+	}
+}
@@ -0,0 +1,190 @@
+#include "StdAfx.h"
+#include "ExpansionTemplateUnitTests.h"
+
+using namespace DVLib::UnitTests;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+void ExpansionTemplateUnitTests::testLiteral()
+{
+    const wchar_t * testdata[] = 
+    {
+        L"",
+        L"plain text",
+        L"a]b",
+        L"50%",
+        L"100%% sure",
+        L"#",
+        L"# 1",
+        L"@",
+        L"[]",
+        L"[\\[]x[\\]]",
+    };
+
+    for (int i = 0; i < ARRAYSIZE(testdata); i++)
+    {
+        ExpansionTemplate t(testdata[i]);
+        Assert::IsTrue(t.IsCompiled());
+        Assert::IsTrue(t.IsLiteral());
+        Assert::IsTrue(InstallerSession::Instance->ExpandVariables(testdata[i]) == t.Expand());
+    }
+}
+
+void ExpansionTemplateUnitTests::testTokenize()
+{
+    ExpansionTemplate t(L"%SystemRoot%\\msiexec.exe /i \"#CABPATH\\setup.msi\" TARGETDIR=\"[INSTALLDIR]\" "
+        L"PF=\"@[HKEY_LOCAL_MACHINE\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\ProgramFilesDir,C:\\]\" [\\[]#LANGID[\\]]");
+    Assert::IsTrue(t.IsCompiled());
+    Assert::IsTrue(! t.IsLiteral());
+    const std::vector<ExpansionTemplate::Token>& tokens = t.GetTokens();
+    Assert::AreEqual(static_cast<size_t>(10), tokens.size());
+    Assert::IsTrue(ExpansionTemplate::token_environment == tokens[0].type);
+    Assert::IsTrue(L"SystemRoot" == tokens[0].value);
+    Assert::IsTrue(ExpansionTemplate::token_literal == tokens[1].type);
+    Assert::IsTrue(L"\\msiexec.exe /i \"" == tokens[1].value);
+    Assert::IsTrue(ExpansionTemplate::token_path == tokens[2].type);
+    Assert::IsTrue(L"CABPATH" == tokens[2].value);
+    Assert::IsTrue(tokens[2].trim_backslash);
+    Assert::IsTrue(L"\\setup.msi\" TARGETDIR=\"" == tokens[3].value);
+    Assert::IsTrue(ExpansionTemplate::token_user == tokens[4].type);
+    Assert::IsTrue(L"INSTALLDIR" == tokens[4].value);
+    Assert::IsTrue(L"\" PF=\"" == tokens[5].value);
+    Assert::IsTrue(ExpansionTemplate::token_registry == tokens[6].type);
+    Assert::IsTrue(L"HKEY_LOCAL_MACHINE\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\ProgramFilesDir,C:\\" == tokens[6].value);
+    // escapes are resolved at compile time
+    Assert::IsTrue(L"\" [" == tokens[7].value);
+    Assert::IsTrue(ExpansionTemplate::token_path == tokens[8].type);
+    Assert::IsTrue(L"LANGID" == tokens[8].value);
+    Assert::IsTrue(! tokens[8].trim_backslash);
+    Assert::IsTrue(L"]" == tokens[9].value);
+}
+
+void ExpansionTemplateUnitTests::testNotCompiled()
+{
+    // values where a pass depends on a value substituted by a previous one
+    const wchar_t * testdata[] = 
+    {
+        L"#%PATHVARIABLE%",
+        L"#CABPATH%PATH%",
+        L"%ALLUSERS#PROFILE%",
+        L"@[HKEY_LOCAL_MACHINE\\%KEY%]",
+        L"@[HKEY_LOCAL_MACHINE\\#GUID]",
+        L"@[]@[HKEY_LOCAL_MACHINE\\SOFTWARE\\Value]",
+        L"[#CABPATH]",
+        L"[%USERNAME%]",
+        L"[\\#CABPATH]",
+    };
+
+    for (int i = 0; i < ARRAYSIZE(testdata); i++)
+    {
+        ExpansionTemplate t(testdata[i]);
+        Assert::IsTrue(! t.IsCompiled());
+        Assert::IsTrue(InstallerSession::Instance->ExpandVariables(testdata[i]) == t.Expand());
+    }
+}
+
+void ExpansionTemplateUnitTests::testExpand()
+{
+    InstallerSession::Instance->AdditionalControlArgs[L"test1"] = L"t1";
+    InstallerSession::Instance->AdditionalControlArgs[L"test2"] = L"[t2]";
+    // environment variables that contain other variables are expanded in full
+    Assert::IsTrue(::SetEnvironmentVariableW(L"ExpansionTemplateUnitTests_Path", L"#TEMPPATH"));
+    Assert::IsTrue(::SetEnvironmentVariableW(L"ExpansionTemplateUnitTests_Text", L"text"));
+
+    const wchar_t * testdata[] = 
+    {
+        L"%SystemRoot%",
+        L"%SystemRoot%%SystemRoot%",
+        L"{%SystemRoot%|%SystemRoot%}",
+        L"%ExpansionTemplateUnitTests_Undefined%",
+        L"%ExpansionTemplateUnitTests_Path%\\file.txt",
+        L"%ExpansionTemplateUnitTests_Text%#TEMPPATH",
+        L"#TEMPPATH#TEMPPATH",
+        L"#CABPATH\\s1\\s2",
+        L"#CABPATH\\",
+        L"{#TEMPPATH|#TEMPPATH}",
+        L"#GUID-#PID-#LANGID-#LANGUAGE-#UILEVEL",
+        L"#LANGUAGExxxxx#PID",
+        L"@[HKEY_LOCAL_MACHINE\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\CommonFilesDir]",
+        L"@[HKEY_LOCAL_MACHINE\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\DoesntExist1|HKEY_LOCAL_MACHINE\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\DoesntExist2,DefaultValue]",
+        L"@[HKEY_LOCAL_MACHINE\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\DoesntExist,[test1]]",
+        L"@[HKEY_LOCAL_MACHINE\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\DoesntExist",
+        L"[test1][test2]%SystemRoot%#TEMPPATH",
+        L"[test1][test1]",
+        L"[\\[][test1][\\]]",
+        L"[undefined]",
+        L"[#",
+    };
+
+    for (int i = 0; i < ARRAYSIZE(testdata); i++)
+    {
+        ExpansionTemplate t(testdata[i]);
+        std::wstring expected = InstallerSession::Instance->ExpandVariables(testdata[i]);
+        std::wstring actual = t.Expand();
+        std::wcout << std::endl << testdata[i] << L" => " << actual;
+        Assert::IsTrue(expected == actual);
+    }
+
+    ::SetEnvironmentVariableW(L"ExpansionTemplateUnitTests_Path", NULL);
+    ::SetEnvironmentVariableW(L"ExpansionTemplateUnitTests_Text", NULL);
+}
+
+void ExpansionTemplateUnitTests::testExpandBenchmark()
+{
+    // attribute values of a sample configuration with many components
+    const wchar_t * sample[] = 
+    {
+        L"Microsoft .NET Framework 4.5.2",
+        L"#CABPATH\\NDP452-KB2901907-x86-x64-AllOS-ENU.exe",
+        L"/q /norestart /log \"#TEMPPATH\\dotnet452.htm\"",
+        L"\"%SystemRoot%\\system32\\msiexec.exe\" /i \"#APPPATH\\setup.msi\" TARGETDIR=\"[INSTALLDIR]\" /l*v \"#TEMPPATH\\setup_#GUID.log\"",
+        L"@[HKEY_LOCAL_MACHINE\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\ProgramFilesDir,C:\\Program Files]\\Application",
+        L"Installing %s, please wait ...",
+        L"http://download.microsoft.com/download/E/2/1/E21644B5-2DF2-47C2-91BD-63C560427900/NDP452-KB2901907-x86-x64-AllOS-ENU.exe",
+        L"#LANGID",
+        L"[\\[]optional[\\]] [USERNAME]",
+        L"true",
+    };
+
+    const int components = 250;
+    const int iterations = 20;
+
+    std::vector<XmlAttribute> attributes;
+    for (int c = 0; c < components; c++)
+    {
+        for (int i = 0; i < ARRAYSIZE(sample); i++)
+        {
+            attributes.push_back(XmlAttribute(sample[i]));
+        }
+    }
+
+    // prime the registry and file system caches
+    for each(const XmlAttribute& attribute in attributes)
+    {
+        Assert::IsTrue(InstallerSession::Instance->ExpandVariables(attribute.GetSource()) == attribute.GetValue());
+    }
+
+    DWORD start = ::GetTickCount();
+    for (int i = 0; i < iterations; i++)
+    {
+        for each(const XmlAttribute& attribute in attributes)
+        {
+            InstallerSession::Instance->ExpandVariables(attribute.GetSource());
+        }
+    }
+    DWORD passes_elapsed = ::GetTickCount() - start;
+
+    start = ::GetTickCount();
+    for (int i = 0; i < iterations; i++)
+    {
+        for each(const XmlAttribute& attribute in attributes)
+        {
+            attribute.GetValue();
+        }
+    }
+    DWORD template_elapsed = ::GetTickCount() - start;
+
+    size_t count = attributes.size() * iterations;
+    std::wcout << std::endl << L"Expanded " << count << L" attribute values: "
+        << L"four passes " << passes_elapsed << L" ms (" << (count * 1000 / (passes_elapsed + 1)) << L"/s), "
+        << L"templates " << template_elapsed << L" ms (" << (count * 1000 / (template_elapsed + 1)) << L"/s)";
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "dotNetInstallerLibUnitTestFixture.h"
+
+namespace DVLib
+{
+	namespace UnitTests 
+	{
+		TEST_CLASS(ExpansionTemplateUnitTests), public dotNetInstallerLibUnitTestFixture
+		{
+            TEST_METHOD_INITIALIZE( initialize )
+            {
+                setUp();
+            }
+
+            TEST_METHOD_CLEANUP( cleanup )
+            {
+                tearDown();
+            }
+
+			TEST_METHOD( testLiteral );
+			TEST_METHOD( testTokenize );
+			TEST_METHOD( testNotCompiled );
+			TEST_METHOD( testExpand );
+			TEST_METHOD( testExpandBenchmark );
+		};
+	}
+}
@@ -0,0 +1,178 @@
+#include "StdAfx.h"
+#include "InstallPlanUnitTests.h"
+
+using namespace DVLib::UnitTests;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+// a configuration with a registry, a file and a product installed check
+static void CreateConfiguration(Configurations& config)
+{
+    InstallConfiguration * configuration = new InstallConfiguration();
+    config.push_back(ConfigurationPtr(configuration));
+
+    CmdComponent * component1 = new CmdComponent();
+    component1->id = L"registry";
+    InstalledCheckRegistry * check1 = new InstalledCheckRegistry();
+    check1->rootkey = L"HKEY_LOCAL_MACHINE";
+    check1->path = L"SOFTWARE\\DVLibPlan";
+    check1->fieldname = L"Version";
+    check1->fieldtype = L"REG_SZ";
+    check1->fieldvalue = L"2.0";
+    check1->comparison = L"version";
+    component1->installedchecks.push_back(InstalledCheckPtr(check1));
+    configuration->components.add(ComponentPtr(component1));
+
+    CmdComponent * component2 = new CmdComponent();
+    component2->id = L"file";
+    InstalledCheckFile * check2 = new InstalledCheckFile();
+    check2->filename = L"C:\\Program Files\\DVLibPlan\\DVLibPlan.exe";
+    check2->fileversion = L"1.5";
+    check2->comparison = L"version";
+    component2->installedchecks.push_back(InstalledCheckPtr(check2));
+    configuration->components.add(ComponentPtr(component2));
+
+    CmdComponent * component3 = new CmdComponent();
+    component3->id = L"product";
+    InstalledCheckProduct * check3 = new InstalledCheckProduct();
+    check3->id_type = L"upgradecode";
+    check3->id = L"{2B3A2A0F-4BB3-4C2F-9B7A-8E8C9F1C6E50}";
+    check3->comparison = L"exists";
+    component3->installedchecks.push_back(InstalledCheckPtr(check3));
+    configuration->components.add(ComponentPtr(component3));
+
+    // only on 64-bit machines
+    CmdComponent * component4 = new CmdComponent();
+    component4->id = L"x64";
+    component4->processor_architecture_filter = L"x64";
+    configuration->components.add(ComponentPtr(component4));
+}
+
+void InstallPlanUnitTests::testEvaluate()
+{
+    Configurations config;
+    CreateConfiguration(config);
+
+    // nothing installed
+    DVLib::MachineSnapshotPtr machine1(new DVLib::MachineSnapshot());
+    machine1->name = L"machine1";
+    InstallerSession::Instance->SetMachine(machine1);
+    InstallPlan plan1;
+    plan1.Evaluate(config);
+    std::wcout << std::endl << plan1.GetString();
+    Assert::IsTrue(plan1.machine == L"machine1");
+    Assert::IsTrue(plan1.configuration == 1);
+    Assert::IsTrue(! plan1.reference);
+    Assert::IsTrue(plan1.components.size() == 3);
+    Assert::IsTrue(plan1.GetInstallCount() == 3);
+    Assert::IsTrue(plan1.GetString() == L"machine1\t1\t3\t0\tregistry,file,product");
+
+    // everything installed
+    DVLib::MachineSnapshotPtr machine2(new DVLib::MachineSnapshot());
+    machine2->name = L"machine2";
+    machine2->Parse(
+        L"value\tHKEY_LOCAL_MACHINE\\SOFTWARE\\DVLibPlan\tVersion\tREG_SZ\t2.1\n"
+        L"file\tC:\\Program Files\\DVLibPlan\\DVLibPlan.exe\t1.5.0.1\n"
+        L"product\t{6C961B56-5A27-4CBF-A7F3-EE8AC3E28C9A}\t{2B3A2A0F-4BB3-4C2F-9B7A-8E8C9F1C6E50}\tProduct\t1.0\n");
+    InstallerSession::Instance->SetMachine(machine2);
+    InstallPlan plan2;
+    plan2.Evaluate(config);
+    std::wcout << std::endl << plan2.GetString();
+    Assert::IsTrue(plan2.GetInstallCount() == 0);
+    Assert::IsTrue(plan2.GetString() == L"machine2\t1\t3\t3\t");
+
+    // older versions, evaluated again after another machine
+    DVLib::MachineSnapshotPtr machine3(new DVLib::MachineSnapshot());
+    machine3->name = L"machine3";
+    machine3->Parse(
+        L"value\tHKEY_LOCAL_MACHINE\\SOFTWARE\\DVLibPlan\tVersion\tREG_SZ\t1.9\n"
+        L"file\tC:\\Program Files\\DVLibPlan\\DVLibPlan.exe\t1.4\n"
+        L"product\t{6C961B56-5A27-4CBF-A7F3-EE8AC3E28C9A}\t{2B3A2A0F-4BB3-4C2F-9B7A-8E8C9F1C6E50}\tProduct\t1.0\n");
+    InstallerSession::Instance->SetMachine(machine3);
+    InstallPlan plan3;
+    plan3.Evaluate(config);
+    std::wcout << std::endl << plan3.GetString();
+    Assert::IsTrue(plan3.GetString() == L"machine3\t1\t3\t1\tregistry,file");
+
+    // this machine
+    InstallerSession::Instance->SetMachine(DVLib::MachineSnapshotPtr());
+    Assert::IsTrue(InstallerSession::Instance->GetOperatingSystemVersion() == DVLib::GetOperatingSystemVersion());
+    Assert::IsTrue(InstallerSession::Instance->GetProcessorArchitecture() == DVLib::GetProcessorArchitecture());
+}
+
+void InstallPlanUnitTests::testEvaluateFilters()
+{
+    Configurations config;
+    CreateConfiguration(config);
+    // a configuration for Windows 10 and later only
+    InstallConfiguration * win10 = new InstallConfiguration();
+    win10->os_filter_min = DVLib::win10;
+    config.insert(config.begin(), ConfigurationPtr(win10));
+
+    DVLib::MachineSnapshotPtr machine1(new DVLib::MachineSnapshot());
+    machine1->name = L"win7_x64";
+    machine1->Parse(L"os\twin7sp1\npa\tx64\n");
+    InstallerSession::Instance->SetMachine(machine1);
+    InstallPlan plan1;
+    plan1.Evaluate(config);
+    std::wcout << std::endl << plan1.GetString();
+    Assert::IsTrue(plan1.configuration == 2);
+    Assert::IsTrue(plan1.components.size() == 4);
+    Assert::IsTrue(plan1.components[3].id == L"x64");
+
+    DVLib::MachineSnapshotPtr machine2(new DVLib::MachineSnapshot());
+    machine2->name = L"win10_x86";
+    machine2->Parse(L"os\twin10\npa\tx86\n");
+    InstallerSession::Instance->SetMachine(machine2);
+    InstallPlan plan2;
+    plan2.Evaluate(config);
+    std::wcout << std::endl << plan2.GetString();
+    Assert::IsTrue(plan2.configuration == 1);
+    Assert::IsTrue(plan2.components.empty());
+    Assert::IsTrue(plan2.GetString() == L"win10_x86\t1\t0\t0\t");
+
+    // no supported configuration
+    config.erase(config.begin() + 1);
+    InstallerSession::Instance->SetMachine(machine1);
+    InstallPlan plan3;
+    plan3.Evaluate(config);
+    Assert::IsTrue(plan3.configuration == 0);
+    Assert::IsTrue(plan3.GetString() == L"win7_x64\tnone\t0\t0\t");
+}
+
+void InstallPlanUnitTests::testEvaluateBenchmark()
+{
+    Configurations config;
+    CreateConfiguration(config);
+
+    const int machines = 1000;
+    std::vector<DVLib::MachineSnapshotPtr> snapshots;
+    for (int i = 0; i < machines; i++)
+    {
+        std::wstringstream data;
+        data << L"pa\t" << ((i % 2) ? L"x64" : L"x86") << std::endl;
+        if (i % 3) data << L"value\tHKEY_LOCAL_MACHINE\\SOFTWARE\\DVLibPlan\tVersion\tREG_SZ\t" << (i % 5) << L".0" << std::endl;
+        if (i % 4) data << L"file\tC:\\Program Files\\DVLibPlan\\DVLibPlan.exe\t1." << (i % 9) << std::endl;
+        for (int j = 0; j < 50; j++)
+            data << L"value\tHKEY_LOCAL_MACHINE\\SOFTWARE\\Vendor" << j << L"\tVersion\tREG_SZ\t" << j << std::endl;
+        DVLib::MachineSnapshotPtr machine(new DVLib::MachineSnapshot());
+        machine->name = L"machine" + DVLib::towstring(i);
+        machine->Parse(data.str());
+        snapshots.push_back(machine);
+    }
+
+    DWORD start = ::GetTickCount();
+    size_t install_count = 0;
+    for each (const DVLib::MachineSnapshotPtr& machine in snapshots)
+    {
+        InstallerSession::Instance->SetMachine(machine);
+        InstallPlan plan;
+        plan.Evaluate(config);
+        install_count += plan.GetInstallCount();
+    }
+    DWORD elapsed = ::GetTickCount() - start;
+
+    std::wcout << std::endl << L"Evaluated " << machines << L" machine(s) in " << elapsed << L" ms"
+        << L" (" << (machines * 1000 / (elapsed > 0 ? elapsed : 1)) << L" machine(s)/s), "
+        << install_count << L" component(s) to install";
+    Assert::IsTrue(install_count > 0);
+}
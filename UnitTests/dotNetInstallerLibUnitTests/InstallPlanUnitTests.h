@@ -0,0 +1,25 @@
+#pragma once
+#include "dotNetInstallerLibUnitTestFixture.h"
+
+namespace DVLib
+{
+	namespace UnitTests 
+	{
+        TEST_CLASS(InstallPlanUnitTests), public dotNetInstallerLibUnitTestFixture
+		{
+            TEST_METHOD_INITIALIZE( initialize )
+            {
+                setUp();
+            }
+
+            TEST_METHOD_CLEANUP( cleanup )
+            {
+                tearDown();
+            }
+
+			TEST_METHOD( testEvaluate );
+			TEST_METHOD( testEvaluateFilters );
+			TEST_METHOD( testEvaluateBenchmark );
+		};
+	}
+}
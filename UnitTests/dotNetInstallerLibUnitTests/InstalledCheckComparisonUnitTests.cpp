@@ -0,0 +1,151 @@
+#include "StdAfx.h"
+#include "InstalledCheckComparisonUnitTests.h"
+
+using namespace DVLib::UnitTests;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+void InstalledCheckComparisonUnitTests::testParse()
+{
+    struct TestData
+    {
+        LPCWSTR name;
+        installedcheck_comparison type;
+    };
+
+    TestData testdata[] = 
+    {
+        { L"", installedcheck_comparison_none },
+        { L"exists", installedcheck_comparison_exists },
+        { L"key_exists", installedcheck_comparison_key_exists },
+        { L"value_exists", installedcheck_comparison_value_exists },
+        { L"match", installedcheck_comparison_match },
+        { L"contains", installedcheck_comparison_contains },
+        { L"version", installedcheck_comparison_version },
+        { L"version_patch", installedcheck_comparison_version_patch },
+        { L"version_eq", installedcheck_comparison_version_eq },
+        { L"version_lt", installedcheck_comparison_version_lt },
+        { L"version_le", installedcheck_comparison_version_le },
+        { L"version_gt", installedcheck_comparison_version_gt },
+        { L"version_ge", installedcheck_comparison_version_ge },
+        { L"Match", installedcheck_comparison_invalid },
+        { L"version_ne", installedcheck_comparison_invalid },
+    };
+
+    for (int i = 0; i < ARRAYSIZE(testdata); i++)
+    {
+        InstalledCheckComparison comparison;
+        comparison = testdata[i].name;
+        Assert::IsTrue(comparison.IsLiteral());
+        Assert::IsTrue(comparison.GetType() == testdata[i].type);
+        Assert::IsTrue(comparison.GetValue() == testdata[i].name);
+    }
+}
+
+void InstalledCheckComparisonUnitTests::testTest()
+{
+    InstalledCheckComparison comparison;
+    comparison = L"version_lt";
+    Assert::IsTrue(comparison.Test(-1));
+    Assert::IsTrue(! comparison.Test(0));
+    comparison = L"version_le";
+    Assert::IsTrue(comparison.Test(0));
+    Assert::IsTrue(! comparison.Test(1));
+    comparison = L"version";
+    Assert::IsTrue(comparison.Test(0));
+    Assert::IsTrue(! comparison.Test(-1));
+    comparison = L"version_gt";
+    Assert::IsTrue(comparison.Test(1));
+    Assert::IsTrue(! comparison.Test(0));
+    comparison = L"match";
+    Assert::IsTrue(comparison.Test(0));
+    Assert::IsTrue(! comparison.Test(1));
+
+    try
+    {
+        comparison = L"contains";
+        comparison.Test(0);
+        throw "expected std::exception";
+    }
+    catch(std::exception& ex)
+    {
+        std::cout << std::endl << ex.what();
+    }
+}
+
+void InstalledCheckComparisonUnitTests::testVariables()
+{
+    // comparisons with variables are parsed each time
+    InstalledCheckComparison comparison;
+    comparison = L"[comparison]";
+    Assert::IsTrue(! comparison.IsLiteral());
+    Assert::IsTrue(comparison.GetType() == installedcheck_comparison_none);
+    InstallerSession::Instance->AdditionalControlArgs[L"comparison"] = L"version_gt";
+    Assert::IsTrue(comparison.GetType() == installedcheck_comparison_version_gt);
+    InstallerSession::Instance->AdditionalControlArgs[L"comparison"] = L"match";
+    Assert::IsTrue(comparison.GetType() == installedcheck_comparison_match);
+}
+
+void InstalledCheckComparisonUnitTests::testLoad()
+{
+    tinyxml2::XMLDocument doc;
+    ConfigImage image;
+    doc.Parse("<installedcheck type=\"check_registry_value\" rootkey=\"HKEY_LOCAL_MACHINE\" \
+              path=\"SOFTWARE\\Microsoft\" fieldname=\"Version\" fieldtype=\"REG_MULTI_SZ\" comparison=\"contains\"/>");
+    InstalledCheckRegistry registry;
+    image.Compile(doc.RootElement());
+    registry.Load(image.GetRoot());
+    Assert::IsTrue(registry.comparison.GetType() == installedcheck_comparison_contains);
+    doc.Parse("<installedcheck type=\"check_file\" filename=\"test.exe\" fileversion=\"1.0\" comparison=\"version_le\"/>");
+    InstalledCheckFile file;
+    image.Compile(doc.RootElement());
+    file.Load(image.GetRoot());
+    Assert::IsTrue(file.comparison.GetType() == installedcheck_comparison_version_le);
+    // checked when evaluated
+    doc.Parse("<installedcheck type=\"check_product\" id_type=\"productcode\" id=\"{00000000-0000-0000-0000-000000000000}\" comparison=\"[comparison]\"/>");
+    InstalledCheckProduct product;
+    image.Compile(doc.RootElement());
+    product.Load(image.GetRoot());
+    Assert::IsTrue(! product.comparison.IsLiteral());
+}
+
+void InstalledCheckComparisonUnitTests::testLoadInvalid()
+{
+    // invalid comparisons fail when the check is loaded, not when it is evaluated
+    const char * testdata[] = 
+    {
+        "<installedcheck type=\"check_registry_value\" rootkey=\"HKEY_LOCAL_MACHINE\" path=\"SOFTWARE\" fieldname=\"Version\" fieldtype=\"REG_SZ\" comparison=\"version_ne\"/>",
+        "<installedcheck type=\"check_registry_value\" rootkey=\"HKEY_LOCAL_MACHINE\" path=\"SOFTWARE\" fieldname=\"Version\" fieldtype=\"REG_DWORD\" comparison=\"contains\"/>",
+        "<installedcheck type=\"check_registry_value\" rootkey=\"HKEY_LOCAL_MACHINE\" path=\"SOFTWARE\" fieldname=\"Version\" fieldtype=\"REG_MULTI_SZ\" comparison=\"version\"/>",
+        "<installedcheck type=\"check_file\" filename=\"test.exe\" fileversion=\"1.0\" comparison=\"contains\"/>",
+        "<installedcheck type=\"check_file\" filename=\"test.exe\" fileversion=\"1.0\" comparison=\"version_patch\"/>",
+        "<installedcheck type=\"check_product\" id_type=\"productcode\" id=\"{00000000-0000-0000-0000-000000000000}\" comparison=\"key_exists\"/>",
+        "<installedcheckoperator type=\"Xor\"/>",
+    };
+
+    for (int i = 0; i < ARRAYSIZE(testdata); i++)
+    {
+        tinyxml2::XMLDocument doc;
+        ConfigImage image;
+        doc.Parse(testdata[i]);
+        try
+        {
+            if (strcmp(doc.RootElement()->Value(), "installedcheckoperator") == 0)
+            {
+                InstalledCheckOperator check;
+                image.Compile(doc.RootElement());
+                check.Load(image.GetRoot());
+            }
+            else
+            {
+                InstalledCheckPtr check(InstalledCheck::Create(DVLib::UTF8string2wstring(doc.RootElement()->Attribute("type"))));
+                image.Compile(doc.RootElement());
+                check->Load(image.GetRoot());
+            }
+            throw "expected std::exception";
+        }
+        catch(std::exception& ex)
+        {
+            std::cout << std::endl << ex.what();
+        }
+    }
+}
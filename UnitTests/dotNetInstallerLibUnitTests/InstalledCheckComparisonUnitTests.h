@@ -0,0 +1,27 @@
+#pragma once
+#include "dotNetInstallerLibUnitTestFixture.h"
+
+namespace DVLib
+{
+	namespace UnitTests 
+	{
+        TEST_CLASS(InstalledCheckComparisonUnitTests), public dotNetInstallerLibUnitTestFixture
+		{
+            TEST_METHOD_INITIALIZE( initialize )
+            {
+                setUp();
+            }
+
+            TEST_METHOD_CLEANUP( cleanup )
+            {
+                tearDown();
+            }
+
+			TEST_METHOD( testParse );
+			TEST_METHOD( testTest );
+			TEST_METHOD( testVariables );
+			TEST_METHOD( testLoad );
+			TEST_METHOD( testLoadInvalid );
+		};
+	}
+}
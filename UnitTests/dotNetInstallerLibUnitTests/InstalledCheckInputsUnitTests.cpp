@@ -0,0 +1,263 @@
+#include "StdAfx.h"
+#include "InstalledCheckInputsUnitTests.h"
+
+using namespace DVLib::UnitTests;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+// an installed check that counts evaluations
+template<class T>
+class InstalledCheckCounter : public T
+{
+public:
+    mutable LONG count;
+    InstalledCheckCounter() : count(0) { }
+
+    bool IsInstalled() const
+    {
+        ::InterlockedIncrement(& count);
+        return T::IsInstalled();
+    }
+};
+
+// an installed check that doesn't report its inputs
+class InstalledCheckUnknownInputs : public InstalledCheck
+{
+public:
+    mutable LONG count;
+    InstalledCheckUnknownInputs() : count(0) { }
+    void Load(const ConfigElement * /*node*/) { }
+
+    bool IsInstalled() const
+    {
+        ::InterlockedIncrement(& count);
+        return true;
+    }
+
+    std::wstring GetFingerprint() const
+    {
+        return L"unknown_inputs";
+    }
+};
+
+void InstalledCheckInputsUnitTests::testRegistryKey()
+{
+    DVLib::MemoryRegistryReader * registry = new DVLib::MemoryRegistryReader();
+    registry->SetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLibInputs", L"Version", L"1.0");
+    InstallerSession::Instance->registry.SetReader(DVLib::RegistryReaderPtr(registry));
+
+    InstalledCheckInputs inputs1;
+    inputs1.AddRegistryKey(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLibInputs", 0);
+    inputs1.AddRegistryKey(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLibInputs\\DoesntExist", 0);
+    InstalledCheckInputs inputs2;
+    inputs2.AddRegistryKey(HKEY_LOCAL_MACHINE, L"software\\dvlibinputs", 0);
+    inputs2.AddRegistryKey(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLibInputs\\DoesntExist", 0);
+    Assert::IsTrue(inputs1 == inputs2);
+    Assert::IsTrue(inputs1.GetDifference(inputs2).empty());
+
+    // a value changes
+    registry->SetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLibInputs", L"Version", L"1.1");
+    InstalledCheckInputs inputs3;
+    inputs3.AddRegistryKey(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLibInputs", 0);
+    inputs3.AddRegistryKey(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLibInputs\\DoesntExist", 0);
+    Assert::IsTrue(! (inputs1 == inputs3));
+    std::wcout << std::endl << inputs3.GetDifference(inputs1);
+    Assert::IsTrue(inputs3.GetDifference(inputs1).find(L"registry key") == 0);
+
+    // a key is created
+    registry->CreateKey(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLibInputs\\DoesntExist");
+    InstalledCheckInputs inputs4;
+    inputs4.AddRegistryKey(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLibInputs", 0);
+    inputs4.AddRegistryKey(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLibInputs\\DoesntExist", 0);
+    Assert::IsTrue(! (inputs3 == inputs4));
+
+    // the same key in another registry view
+    InstalledCheckInputs inputs5;
+    inputs5.AddRegistryKey(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLibInputs", KEY_WOW64_64KEY);
+    inputs5.AddRegistryKey(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLibInputs\\DoesntExist", 0);
+    Assert::IsTrue(! (inputs4 == inputs5));
+}
+
+void InstalledCheckInputsUnitTests::testFile()
+{
+    std::wstring filename = DVLib::GetTemporaryFileNameW();
+    InstalledCheckInputs inputs1;
+    inputs1.AddFile(filename);
+    InstalledCheckInputs inputs2;
+    inputs2.AddFile(DVLib::lowercase(filename));
+    Assert::IsTrue(inputs1 == inputs2);
+
+    // a file is written
+    std::vector<char> data(128, 'x');
+    DVLib::FileWrite(filename, data);
+    InstalledCheckInputs inputs3;
+    inputs3.AddFile(filename);
+    Assert::IsTrue(! (inputs1 == inputs3));
+    std::wcout << std::endl << inputs3.GetDifference(inputs1);
+
+    // a file is deleted
+    DVLib::FileDelete(filename);
+    InstalledCheckInputs inputs4;
+    inputs4.AddFile(filename);
+    Assert::IsTrue(! (inputs3 == inputs4));
+    Assert::IsTrue(! DVLib::FileExists(filename));
+}
+
+void InstalledCheckInputsUnitTests::testLoadInstalled()
+{
+    DVLib::MemoryRegistryReader * registry = new DVLib::MemoryRegistryReader();
+    registry->SetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLibInputs", L"Version", L"1.0");
+    InstallerSession::Instance->registry.SetReader(DVLib::RegistryReaderPtr(registry));
+    std::wstring filename = DVLib::GetTemporaryFileNameW();
+    DVLib::FileDelete(filename);
+
+    InstalledCheckCounter<InstalledCheckRegistry> * registry_check = new InstalledCheckCounter<InstalledCheckRegistry>();
+    registry_check->rootkey = L"HKEY_LOCAL_MACHINE";
+    registry_check->path = L"SOFTWARE\\DVLibInputs";
+    registry_check->fieldname = L"Version";
+    registry_check->fieldtype = L"REG_SZ";
+    registry_check->fieldvalue = L"1.0";
+    registry_check->comparison = L"version";
+
+    InstalledCheckCounter<InstalledCheckFile> * file_check = new InstalledCheckCounter<InstalledCheckFile>();
+    file_check->filename = filename;
+    file_check->comparison = L"exists";
+
+    // a component with both checks in an operator and a component with each
+    InstalledCheckOperator * op = new InstalledCheckOperator();
+    op->type = L"And";
+    op->installedchecks.push_back(InstalledCheckPtr(registry_check));
+    op->installedchecks.push_back(InstalledCheckPtr(file_check));
+
+    Components components;
+    CmdComponent * component1 = new CmdComponent();
+    component1->id = L"registry";
+    component1->installedchecks.push_back(InstalledCheckPtr(registry_check));
+    components.add(ComponentPtr(component1));
+    CmdComponent * component2 = new CmdComponent();
+    component2->id = L"file";
+    component2->installedchecks.push_back(InstalledCheckPtr(file_check));
+    components.add(ComponentPtr(component2));
+    CmdComponent * component3 = new CmdComponent();
+    component3->id = L"both";
+    component3->installedchecks.push_back(InstalledCheckPtr(op));
+    components.add(ComponentPtr(component3));
+
+    components.LoadInstalled();
+    Assert::IsTrue(component1->installed);
+    Assert::IsTrue(! component2->installed);
+    Assert::IsTrue(! component3->installed);
+    Assert::IsTrue(get(component1->installed_inputs) != NULL);
+    LONG registry_count = registry_check->count;
+    LONG file_count = file_check->count;
+
+    // nothing changed, nothing is evaluated
+    components.LoadInstalled();
+    Assert::IsTrue(registry_count == registry_check->count);
+    Assert::IsTrue(file_count == file_check->count);
+    Assert::IsTrue(component1->installed);
+    Assert::IsTrue(! component2->installed);
+    Assert::IsTrue(! component3->installed);
+
+    // a file is created, only components with checks that read it are evaluated
+    DVLib::FileCreate(filename);
+    components.LoadInstalled();
+    Assert::IsTrue(file_count < file_check->count);
+    Assert::IsTrue(component1->installed);
+    Assert::IsTrue(component2->installed);
+    Assert::IsTrue(component3->installed);
+    registry_count = registry_check->count;
+
+    // a registry value changes
+    registry->SetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLibInputs", L"Version", L"0.9");
+    components.LoadInstalled();
+    Assert::IsTrue(registry_count < registry_check->count);
+    Assert::IsTrue(! component1->installed);
+    Assert::IsTrue(component2->installed);
+    Assert::IsTrue(! component3->installed);
+    registry_count = registry_check->count;
+
+    // an attribute changes, eg. with the value of a user variable
+    registry_check->fieldvalue = L"0.9";
+    components.LoadInstalled();
+    Assert::IsTrue(registry_count < registry_check->count);
+    Assert::IsTrue(component1->installed);
+    Assert::IsTrue(component3->installed);
+
+    DVLib::FileDelete(filename);
+}
+
+void InstalledCheckInputsUnitTests::testLoadInstalledProduct()
+{
+    DVLib::MemoryMsiProductReader * reader = new DVLib::MemoryMsiProductReader();
+    GUID upgradecode = DVLib::string2guid(DVLib::GenerateGUIDStringW());
+    GUID product1 = DVLib::string2guid(DVLib::GenerateGUIDStringW());
+    reader->AddProduct(product1, upgradecode, L"Product", L"1.0");
+    InstallerSession::Instance->msi_products.SetReader(DVLib::MsiProductReaderPtr(reader));
+
+    InstalledCheckCounter<InstalledCheckProduct> * check = new InstalledCheckCounter<InstalledCheckProduct>();
+    check->id_type = L"upgradecode";
+    check->id = DVLib::guid2wstring(upgradecode);
+    check->propertyname = INSTALLPROPERTY_VERSIONSTRING;
+    check->propertyvalue = L"2.0";
+    check->comparison = L"version";
+
+    Components components;
+    CmdComponent * component = new CmdComponent();
+    component->id = L"product";
+    component->installedchecks.push_back(InstalledCheckPtr(check));
+    components.add(ComponentPtr(component));
+
+    components.LoadInstalled();
+    Assert::IsTrue(! component->installed);
+    Assert::IsTrue(1 == check->count);
+
+    // another product is installed, the inventory is invalidated after each component
+    InstallerSession::Instance->msi_products.Invalidate();
+    components.LoadInstalled();
+    Assert::IsTrue(1 == check->count);
+    GUID product2 = DVLib::string2guid(DVLib::GenerateGUIDStringW());
+    reader->AddProduct(product2, DVLib::string2guid(DVLib::GenerateGUIDStringW()), L"Another Product", L"3.0");
+    InstallerSession::Instance->msi_products.Invalidate();
+    components.LoadInstalled();
+    Assert::IsTrue(1 == check->count);
+
+    // a related product is upgraded
+    reader->SetProductProperty(product1, INSTALLPROPERTY_VERSIONSTRING, L"2.0");
+    InstallerSession::Instance->msi_products.Invalidate();
+    components.LoadInstalled();
+    Assert::IsTrue(2 == check->count);
+    Assert::IsTrue(component->installed);
+}
+
+void InstalledCheckInputsUnitTests::testLoadInstalledUnknownInputs()
+{
+    InstalledCheckUnknownInputs * check = new InstalledCheckUnknownInputs();
+    InstalledCheckOperator * op = new InstalledCheckOperator();
+    op->type = L"Not";
+    op->installedchecks.push_back(InstalledCheckPtr(check));
+
+    Components components;
+    CmdComponent * component1 = new CmdComponent();
+    component1->id = L"unknown";
+    component1->installedchecks.push_back(InstalledCheckPtr(op));
+    components.add(ComponentPtr(component1));
+    // without installed checks
+    CmdComponent * component2 = new CmdComponent();
+    component2->id = L"none";
+    components.add(ComponentPtr(component2));
+
+    // always evaluated
+    for (int i = 1; i <= 3; i++)
+    {
+        components.LoadInstalled();
+        Assert::IsTrue(i == check->count);
+        Assert::IsTrue(get(component1->installed_inputs) == NULL);
+        Assert::IsTrue(! component1->installed);
+        Assert::IsTrue(! component2->installed);
+    }
+
+    // a component without installed checks is installed when uninstalling
+    InstallerSession::Instance->sequence = SequenceUninstall;
+    components.LoadInstalled();
+    Assert::IsTrue(component2->installed);
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "dotNetInstallerLibUnitTestFixture.h"
+
+namespace DVLib
+{
+	namespace UnitTests 
+	{
+        TEST_CLASS(InstalledCheckInputsUnitTests), public dotNetInstallerLibUnitTestFixture
+		{
+            TEST_METHOD_INITIALIZE( initialize )
+            {
+                setUp();
+            }
+
+            TEST_METHOD_CLEANUP( cleanup )
+            {
+                tearDown();
+            }
+
+			TEST_METHOD( testRegistryKey );
+			TEST_METHOD( testFile );
+			TEST_METHOD( testLoadInstalled );
+			TEST_METHOD( testLoadInstalledProduct );
+			TEST_METHOD( testLoadInstalledUnknownInputs );
+		};
+	}
+}
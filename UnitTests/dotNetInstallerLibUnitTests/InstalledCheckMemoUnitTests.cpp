@@ -0,0 +1,159 @@
+#include "StdAfx.h"
+#include "InstalledCheckMemoUnitTests.h"
+
+using namespace DVLib::UnitTests;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+// an installed check that counts evaluations
+class InstalledCheckCount : public InstalledCheck
+{
+private:
+    std::wstring m_name;
+    bool m_installed;
+public:
+    mutable LONG count;
+    InstalledCheckCount(const std::wstring& name, bool installed) : m_name(name), m_installed(installed), count(0) { }
+    void Load(const ConfigElement * /*node*/) { }
+
+    bool IsInstalled() const
+    {
+        ::InterlockedIncrement(& count);
+        return m_installed;
+    }
+
+    std::wstring GetFingerprint() const
+    {
+        std::wstring fingerprint(L"count");
+        AppendFingerprint(fingerprint, m_name);
+        return fingerprint;
+    }
+};
+
+void InstalledCheckMemoUnitTests::testFingerprint()
+{
+    InstalledCheckRegistry check1;
+    check1.rootkey = L"HKEY_LOCAL_MACHINE";
+    check1.path = L"SOFTWARE\\[product]";
+    check1.fieldname = L"Version";
+    check1.fieldtype = L"REG_SZ";
+    check1.fieldvalue = L"1.0";
+    check1.comparison = L"version";
+    InstalledCheckRegistry check2;
+    check2.rootkey = L"HKEY_LOCAL_MACHINE";
+    check2.path = L"SOFTWARE\\[product]";
+    check2.fieldname = L"Version";
+    check2.fieldtype = L"REG_SZ";
+    check2.fieldvalue = L"1.0";
+    check2.comparison = L"version";
+    Assert::IsTrue(! check1.GetFingerprint().empty());
+    Assert::IsTrue(check1.GetFingerprint() == check2.GetFingerprint());
+    // fingerprints are taken after variables are expanded
+    std::wstring fingerprint = check1.GetFingerprint();
+    InstallerSession::Instance->AdditionalControlArgs[L"product"] = L"Product";
+    Assert::IsTrue(fingerprint != check1.GetFingerprint());
+    check2.path = L"SOFTWARE\\Product";
+    Assert::IsTrue(check1.GetFingerprint() == check2.GetFingerprint());
+    // values that concatenate to the same string
+    check2.path = L"SOFTWARE\\ProductV";
+    check2.fieldname = L"ersion";
+    Assert::IsTrue(check1.GetFingerprint() != check2.GetFingerprint());
+    // checks of different types
+    InstalledCheckDirectory directory;
+    directory.path = L"SOFTWARE\\Product";
+    InstalledCheckFile file;
+    file.filename = L"SOFTWARE\\Product";
+    Assert::IsTrue(directory.GetFingerprint() != file.GetFingerprint());
+}
+
+void InstalledCheckMemoUnitTests::testOperatorFingerprint()
+{
+    InstalledCheckOperatorPtr check1(new InstalledCheckOperator());
+    check1->type = L"And";
+    check1->installedchecks.push_back(InstalledCheckPtr(new InstalledCheckCount(L"a", true)));
+    check1->installedchecks.push_back(InstalledCheckPtr(new InstalledCheckCount(L"b", true)));
+    InstalledCheckOperatorPtr check2(new InstalledCheckOperator());
+    check2->type = L"And";
+    check2->installedchecks.push_back(InstalledCheckPtr(new InstalledCheckCount(L"a", false)));
+    check2->installedchecks.push_back(InstalledCheckPtr(new InstalledCheckCount(L"b", false)));
+    Assert::IsTrue(check1->GetFingerprint() == check2->GetFingerprint());
+    check2->type = L"Or";
+    Assert::IsTrue(check1->GetFingerprint() != check2->GetFingerprint());
+    // an operator is memoized only if all its checks are
+    class InstalledCheckNoFingerprint : public InstalledCheck
+    {
+    public:
+        bool IsInstalled() const { return true; }
+        void Load(const ConfigElement * /*node*/) { }
+    };
+    check1->installedchecks.push_back(InstalledCheckPtr(new InstalledCheckNoFingerprint()));
+    Assert::IsTrue(check1->GetFingerprint().empty());
+}
+
+void InstalledCheckMemoUnitTests::testEvaluate()
+{
+    InstalledCheckMemo& memo = InstallerSession::Instance->installed_checks;
+    InstalledCheckCount check1(L"a", true);
+    InstalledCheckCount check2(L"a", true);
+    InstalledCheckCount check3(L"b", false);
+    // outside of a scope every check is evaluated
+    Assert::IsTrue(check1.Evaluate());
+    Assert::IsTrue(check2.Evaluate());
+    Assert::IsTrue(1 == check1.count && 1 == check2.count);
+    {
+        InstalledCheckMemoScope scope(memo);
+        Assert::IsTrue(check1.Evaluate());
+        Assert::IsTrue(check2.Evaluate());
+        Assert::IsTrue(! check3.Evaluate());
+        Assert::IsTrue(! check3.Evaluate());
+        Assert::IsTrue(2 == check1.count);
+        Assert::IsTrue(1 == check2.count);
+        Assert::IsTrue(1 == check3.count);
+        Assert::IsTrue(2 == memo.GetMisses());
+        Assert::IsTrue(2 == memo.GetHits());
+    }
+    // results are discarded with the scope
+    Assert::IsTrue(! memo.IsActive());
+    InstalledCheckMemoScope scope(memo);
+    Assert::IsTrue(check2.Evaluate());
+    Assert::IsTrue(2 == check2.count);
+}
+
+void InstalledCheckMemoUnitTests::testLoadInstalled()
+{
+    // components that repeat the same check, directly or in operators, evaluate it once
+    InstalledCheckCount * check = NULL;
+    Components components;
+    for (int i = 0; i < 10; i++)
+    {
+        CmdComponent * component = new CmdComponent();
+        component->id = DVLib::GenerateGUIDStringW();
+        InstalledCheckCount * count = new InstalledCheckCount(L"a", true);
+        if (i == 0) check = count;
+        if (i % 2)
+        {
+            InstalledCheckOperator * op = new InstalledCheckOperator();
+            op->type = L"Or";
+            op->installedchecks.push_back(InstalledCheckPtr(count));
+            component->installedchecks.push_back(InstalledCheckPtr(op));
+        }
+        else
+        {
+            component->installedchecks.push_back(InstalledCheckPtr(count));
+        }
+        components.add(ComponentPtr(component));
+    }
+
+    // evaluate serially, so that no two checks are evaluated at the same time
+    reset(WorkerPool::Instance);
+    InstalledCheckMemoScope scope(InstallerSession::Instance->installed_checks);
+    components.LoadInstalled();
+    for (size_t i = 0; i < components.size(); i++)
+    {
+        Assert::IsTrue(components[i]->installed);
+    }
+
+    Assert::IsTrue(1 == check->count);
+    // operators are compiled into the programs of components, only the first check is evaluated
+    Assert::IsTrue(1 == InstallerSession::Instance->installed_checks.GetMisses());
+    Assert::IsTrue(9 == InstallerSession::Instance->installed_checks.GetHits());
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include "dotNetInstallerLibUnitTestFixture.h"
+
+namespace DVLib
+{
+	namespace UnitTests 
+	{
+        TEST_CLASS(InstalledCheckMemoUnitTests), public dotNetInstallerLibUnitTestFixture
+		{
+            TEST_METHOD_INITIALIZE( initialize )
+            {
+                setUp();
+            }
+
+            TEST_METHOD_CLEANUP( cleanup )
+            {
+                tearDown();
+            }
+
+			TEST_METHOD( testFingerprint );
+			TEST_METHOD( testOperatorFingerprint );
+			TEST_METHOD( testEvaluate );
+			TEST_METHOD( testLoadInstalled );
+		};
+	}
+}
@@ -9,7 +9,7 @@ class InstalledCheckTrue : public InstalledCheck
 public:
     InstalledCheckTrue() {  }
     bool IsInstalled() const { return true; }
-    void Load(tinyxml2::XMLElement * /*node*/) { }
+    void Load(const ConfigElement * /*node*/) { }
 };
 
 class InstalledCheckFalse : public InstalledCheck
@@ -17,7 +17,7 @@ class InstalledCheckFalse : public InstalledCheck
 public:
     InstalledCheckFalse() {  }
     bool IsInstalled() const { return false; }
-    void Load(tinyxml2::XMLElement * /*node*/) { }
+    void Load(const ConfigElement * /*node*/) { }
 };
 
 void InstalledCheckOperatorUnitTests::testAnd()
@@ -60,4 +60,81 @@ void InstalledCheckOperatorUnitTests::testNot()
     check->installedchecks.clear();
     check->installedchecks.push_back(InstalledCheckPtr(new InstalledCheckFalse()));
     Assert::IsTrue(check->IsInstalled());
+}
+
+// an installed check of a given cost that counts evaluations
+class InstalledCheckCost : public InstalledCheck
+{
+private:
+    bool m_installed;
+    installedcheck_cost m_cost;
+public:
+    mutable int count;
+    InstalledCheckCost(bool installed, installedcheck_cost cost) : m_installed(installed), m_cost(cost), count(0) { }
+    bool IsInstalled() const { count++; return m_installed; }
+    void Load(const ConfigElement * /*node*/) { }
+    installedcheck_cost GetCost() const { return m_cost; }
+};
+
+void InstalledCheckOperatorUnitTests::testSortByCost()
+{
+    std::vector<InstalledCheckPtr> installedchecks;
+    InstalledCheckPtr product(new InstalledCheckCost(true, installedcheck_cost_product));
+    InstalledCheckPtr registry1(new InstalledCheckCost(true, installedcheck_cost_registry));
+    InstalledCheckPtr version(new InstalledCheckCost(true, installedcheck_cost_file_version));
+    InstalledCheckPtr registry2(new InstalledCheckCost(true, installedcheck_cost_registry));
+    InstalledCheckPtr exists(new InstalledCheckCost(true, installedcheck_cost_file_exists));
+    installedchecks.push_back(product);
+    installedchecks.push_back(registry1);
+    installedchecks.push_back(version);
+    installedchecks.push_back(registry2);
+    installedchecks.push_back(exists);
+    std::vector<InstalledCheckPtr> sorted = InstalledCheck::SortByCost(installedchecks);
+    Assert::IsTrue(sorted.size() == 5);
+    Assert::IsTrue(get(sorted[0]) == get(exists));
+    // checks of the same cost keep their order
+    Assert::IsTrue(get(sorted[1]) == get(registry1));
+    Assert::IsTrue(get(sorted[2]) == get(registry2));
+    Assert::IsTrue(get(sorted[3]) == get(version));
+    Assert::IsTrue(get(sorted[4]) == get(product));
+    // file checks cost depends on the comparison
+    InstalledCheckFile file;
+    file.comparison = L"exists";
+    Assert::IsTrue(file.GetCost() == installedcheck_cost_file_exists);
+    file.comparison = L"version";
+    file.fileversion = L"1.0";
+    Assert::IsTrue(file.GetCost() == installedcheck_cost_file_version);
+    // operators cost as much as their most expensive check
+    InstalledCheckOperator op;
+    op.installedchecks.push_back(exists);
+    Assert::IsTrue(op.GetCost() == installedcheck_cost_file_exists);
+    op.installedchecks.push_back(version);
+    Assert::IsTrue(op.GetCost() == installedcheck_cost_file_version);
+}
+
+void InstalledCheckOperatorUnitTests::testShortCircuit()
+{
+    // a cheap check that settles the result is evaluated before an expensive one
+    InstalledCheckCost * product = new InstalledCheckCost(true, installedcheck_cost_product);
+    InstalledCheckCost * exists = new InstalledCheckCost(false, installedcheck_cost_file_exists);
+    InstalledCheckOperatorPtr check(new InstalledCheckOperator());
+    check->type = L"And";
+    check->installedchecks.push_back(InstalledCheckPtr(product));
+    check->installedchecks.push_back(InstalledCheckPtr(exists));
+    Assert::IsTrue(! check->IsInstalled());
+    Assert::IsTrue(1 == exists->count);
+    Assert::IsTrue(0 == product->count);
+    // results are the same as evaluating in document order
+    check->type = L"Or";
+    Assert::IsTrue(check->IsInstalled());
+    Assert::IsTrue(1 == product->count);
+    check->type = L"Not";
+    Assert::IsTrue(! check->IsInstalled());
+    // components stop at the first check that isn't installed
+    CmdComponent component;
+    component.installedchecks.push_back(InstalledCheckPtr(new InstalledCheckCost(true, installedcheck_cost_product)));
+    component.installedchecks.push_back(InstalledCheckPtr(new InstalledCheckCost(false, installedcheck_cost_registry)));
+    Assert::IsTrue(! component.IsInstalled());
+    Assert::IsTrue(0 == static_cast<InstalledCheckCost *>(get(component.installedchecks[0]))->count);
+    Assert::IsTrue(1 == static_cast<InstalledCheckCost *>(get(component.installedchecks[1]))->count);
 }
\ No newline at end of file
@@ -20,6 +20,8 @@ namespace DVLib
 			TEST_METHOD( testAnd );
 			TEST_METHOD( testOr );
 			TEST_METHOD( testNot );
+			TEST_METHOD( testSortByCost );
+			TEST_METHOD( testShortCircuit );
 		};
 	}
 }
@@ -128,6 +128,9 @@ void InstalledCheckProductUnitTests::testDefaultValue()
         { L"match", true, true },
         { L"version", false, false },
         { L"version", true, true },
+        // a missing comparison returns the default value
+        { L"", false, false },
+        { L"", true, true },
     };
 
     for (int i = 0; i < ARRAYSIZE(data); i++)
@@ -136,4 +139,56 @@ void InstalledCheckProductUnitTests::testDefaultValue()
         check->defaultvalue = (data[i].defaultvalue ? L"True" : L"False");
         Assert::IsTrue(data[i].expected_result == check->IsInstalled());
     }
+}
+
+void InstalledCheckProductUnitTests::testMemoryInventory()
+{
+    DVLib::MemoryMsiProductReader * reader = new DVLib::MemoryMsiProductReader();
+    GUID upgradecode = DVLib::string2guid(DVLib::GenerateGUIDStringW());
+    std::vector<GUID> products;
+    for (int i = 0; i < 10; i++)
+    {
+        GUID product = DVLib::string2guid(DVLib::GenerateGUIDStringW());
+        reader->AddProduct(product, upgradecode, L"Product " + DVLib::towstring(i), L"1.0." + DVLib::towstring(i));
+        products.push_back(product);
+    }
+
+    InstallerSession::Instance->msi_products.SetReader(DVLib::MsiProductReaderPtr(reader));
+
+    // all product code checks share one enumeration
+    for (int i = 0; i < 10; i++)
+    {
+        InstalledCheckProductPtr check(new InstalledCheckProduct());
+        check->id_type = L"productcode";
+        check->id = DVLib::guid2wstring(products[i]);
+        check->propertyname = INSTALLPROPERTY_VERSIONSTRING;
+        check->propertyvalue = L"1.0." + DVLib::towstring(i);
+        check->comparison = L"exists";
+        Assert::IsTrue(check->IsInstalled());
+        check->comparison = L"match";
+        Assert::IsTrue(check->IsInstalled());
+        check->comparison = L"version_gt";
+        Assert::IsTrue(! check->IsInstalled());
+    }
+
+    Assert::AreEqual(1L, reader->GetEnumerations());
+
+    InstalledCheckProductPtr check(new InstalledCheckProduct());
+    check->id_type = L"upgradecode";
+    check->id = DVLib::guid2wstring(upgradecode);
+    check->propertyname = INSTALLPROPERTY_VERSIONSTRING;
+    check->propertyvalue = L"1.0.9";
+    check->comparison = L"contains";
+    Assert::IsTrue(check->IsInstalled());
+    check->comparison = L"version_eq";
+    Assert::IsTrue(check->IsInstalled());
+    Assert::AreEqual(2L, reader->GetEnumerations());
+
+    // an installed product is seen once the inventory is invalidated
+    GUID product = DVLib::string2guid(DVLib::GenerateGUIDStringW());
+    reader->AddProduct(product, upgradecode, L"Product", L"2.0");
+    check->propertyvalue = L"2.0";
+    Assert::IsTrue(! check->IsInstalled());
+    InstallerSession::Instance->msi_products.Invalidate();
+    Assert::IsTrue(check->IsInstalled());
 }
\ No newline at end of file
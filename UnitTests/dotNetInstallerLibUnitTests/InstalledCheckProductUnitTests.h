@@ -20,6 +20,7 @@ namespace DVLib
 			TEST_METHOD( testProductCode );
 			TEST_METHOD( testUpgradeCode );
 			TEST_METHOD( testDefaultValue );
+			TEST_METHOD( testMemoryInventory );
 		};
 	}
 }
@@ -0,0 +1,109 @@
+#include "StdAfx.h"
+#include "InstalledCheckProgramUnitTests.h"
+
+using namespace DVLib::UnitTests;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+static InstalledCheckPtr CreateDirectoryCheck(const std::wstring& path)
+{
+    InstalledCheckDirectory * check = new InstalledCheckDirectory();
+    check->path = path;
+    return InstalledCheckPtr(check);
+}
+
+void InstalledCheckProgramUnitTests::testCompile()
+{
+    InstalledCheckPtr system_directory = CreateDirectoryCheck(DVLib::GetSystemDirectoryW());
+    InstalledCheckPtr missing_directory = CreateDirectoryCheck(DVLib::GenerateGUIDStringW());
+    InstalledCheckOperator * or_check = new InstalledCheckOperator();
+    or_check->type = L"Or";
+    or_check->installedchecks.push_back(missing_directory);
+    or_check->installedchecks.push_back(system_directory);
+    InstalledCheckOperator * not_check = new InstalledCheckOperator();
+    not_check->type = L"Not";
+    not_check->installedchecks.push_back(missing_directory);
+    std::vector<InstalledCheckPtr> installedchecks;
+    installedchecks.push_back(InstalledCheckPtr(or_check));
+    installedchecks.push_back(InstalledCheckPtr(not_check));
+
+    InstalledCheckProgram program;
+    program.Compile(installedchecks);
+    std::wcout << std::endl << program.GetString();
+    Assert::IsTrue(program.IsCompiledFrom(installedchecks));
+    // operators are compiled inline into jumps
+    Assert::IsTrue(program.GetSize() == 6);
+    Assert::IsTrue(program[0].opcode == installedcheck_op_directory);
+    Assert::IsTrue(program[0].check == get(missing_directory));
+    Assert::IsTrue(program[1].opcode == installedcheck_op_jump_if_true);
+    Assert::IsTrue(program[1].target == 3);
+    Assert::IsTrue(program[2].opcode == installedcheck_op_directory);
+    Assert::IsTrue(program[2].check == get(system_directory));
+    Assert::IsTrue(program[3].opcode == installedcheck_op_jump_if_false);
+    Assert::IsTrue(program[3].target == 6);
+    Assert::IsTrue(program[4].opcode == installedcheck_op_directory);
+    Assert::IsTrue(program[5].opcode == installedcheck_op_not);
+    Assert::IsTrue(program.Run());
+    // results match evaluating the checks
+    not_check->installedchecks.push_back(system_directory);
+    program.Compile(installedchecks);
+    Assert::IsTrue(! program.Run());
+    Assert::IsTrue(! not_check->IsInstalled());
+    Assert::IsTrue(or_check->IsInstalled());
+    // no checks
+    installedchecks.clear();
+    Assert::IsTrue(! program.IsCompiledFrom(installedchecks));
+    program.Compile(installedchecks);
+    Assert::IsTrue(program.GetSize() == 1);
+    Assert::IsTrue(program[0].opcode == installedcheck_op_false);
+}
+
+void InstalledCheckProgramUnitTests::testCompileVariableOperator()
+{
+    // the type of an operator with variables is known when evaluated
+    InstalledCheckOperator * check = new InstalledCheckOperator();
+    check->type = L"[operator]";
+    check->installedchecks.push_back(CreateDirectoryCheck(DVLib::GetSystemDirectoryW()));
+    std::vector<InstalledCheckPtr> installedchecks;
+    installedchecks.push_back(InstalledCheckPtr(check));
+    InstalledCheckProgram program;
+    program.Compile(installedchecks);
+    Assert::IsTrue(program.GetSize() == 1);
+    Assert::IsTrue(program[0].opcode == installedcheck_op_check);
+    InstallerSession::Instance->AdditionalControlArgs[L"operator"] = L"And";
+    InstallerSession::Instance->InvalidateVariables();
+    Assert::IsTrue(program.Run());
+    InstallerSession::Instance->AdditionalControlArgs[L"operator"] = L"Not";
+    InstallerSession::Instance->InvalidateVariables();
+    Assert::IsTrue(! program.Run());
+    InstallerSession::Instance->AdditionalControlArgs.erase(L"operator");
+}
+
+void InstalledCheckProgramUnitTests::testComponent()
+{
+    std::wstring configxml = DVLib::DirectoryCombine(DVLib::GetCurrentModuleDirectoryW(), 
+        L"..\\..\\..\\Samples\\InstallCheckOperators\\Configuration.xml");
+    ConfigFile config;
+    config.LoadFile(configxml);
+    config.Materialize();
+    const InstallConfiguration * configuration = reinterpret_cast<InstallConfiguration *>(get(config[0]));
+    Assert::IsTrue(configuration->components.size() == 4);
+    for each(const ComponentPtr& component in configuration->components)
+    {
+        // compiled when loaded, operators of a literal type are compiled inline
+        const InstalledCheckProgram& program = component->installedcheck_program;
+        std::wcout << std::endl << component->id << std::endl << program.GetString();
+        Assert::IsTrue(program.IsCompiledFrom(component->installedchecks));
+        for (size_t i = 0; i < program.GetSize(); i++)
+        {
+            Assert::IsTrue(program[i].opcode != installedcheck_op_check);
+        }
+    }
+
+    // checks added later are compiled when evaluated
+    CmdComponent component;
+    component.installedchecks.push_back(CreateDirectoryCheck(DVLib::GetSystemDirectoryW()));
+    Assert::IsTrue(! component.installedcheck_program.IsCompiledFrom(component.installedchecks));
+    Assert::IsTrue(component.IsInstalled());
+    component.installedchecks.push_back(CreateDirectoryCheck(DVLib::GenerateGUIDStringW()));
+    Assert::IsTrue(! component.IsInstalled());
+}
@@ -126,3 +126,182 @@ void InstalledCheckRegistryUnitTests::testIsInstalled()
         Assert::IsTrue(isinstalled == testdata[i].expected_isinstalled);
     }
 }
+
+void InstalledCheckRegistryUnitTests::testIsInstalledMemoryRegistry()
+{
+    DVLib::MemoryRegistryReader * registry = new DVLib::MemoryRegistryReader();
+    registry->SetDWORDValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLibMemory", L"DWORD", 1);
+    registry->SetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLibMemory", L"String", L"1.2.3.4");
+    registry->SetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLibMemory", L"String64", L"2.0", KEY_WOW64_64KEY);
+    InstallerSession::Instance->registry.SetReader(DVLib::RegistryReaderPtr(registry));
+
+    struct TestData
+    {
+        LPCWSTR path;
+        LPCWSTR fieldname;
+        LPCWSTR fieldtype;
+        LPCWSTR fieldvalue;
+        LPCWSTR comparison;
+        LPCWSTR wowoption;
+        bool expected_isinstalled;
+    };
+
+    TestData testdata[] = 
+    {
+        { L"SOFTWARE\\DVLibMemory", L"DWORD", L"REG_DWORD", L"1", L"match", L"", true },
+        { L"SOFTWARE\\DVLibMemory", L"dword", L"REG_DWORD", L"2", L"version_lt", L"", true },
+        { L"SOFTWARE\\DVLibMemory", L"String", L"REG_SZ", L"1.2.3.0", L"version", L"", true },
+        { L"SOFTWARE\\DVLibMemory", L"String", L"REG_SZ", L"1.2.3.4", L"exists", L"", true },
+        { L"software\\dvlibmemory", L"String", L"REG_SZ", L"1.2.3.5", L"version", L"", false },
+        { L"SOFTWARE\\DVLibMemory", L"String64", L"REG_SZ", L"", L"exists", L"", false },
+        { L"SOFTWARE\\DVLibMemory", L"String64", L"REG_SZ", L"2.0", L"match", L"WOW64_64", true },
+        { L"SOFTWARE\\DVLibMemory", L"", L"", L"", L"key_exists", L"WOW64_32", false },
+        { L"SOFTWARE\\DVLibMemory\\DoesntExist", L"", L"", L"", L"key_exists", L"", false },
+    };
+
+    // each key is read once
+    {
+        DVLib::RegistrySnapshotScope snapshot(InstallerSession::Instance->registry);
+        for (int i = 0; i < ARRAYSIZE(testdata); i++)
+        {
+            InstalledCheckRegistry check;
+            check.rootkey = L"HKEY_LOCAL_MACHINE";
+            check.path = testdata[i].path;
+            check.fieldname = testdata[i].fieldname;
+            check.fieldtype = testdata[i].fieldtype;
+            check.fieldvalue = testdata[i].fieldvalue;
+            check.comparison = testdata[i].comparison;
+            check.wowoption = testdata[i].wowoption;
+            Assert::IsTrue(check.IsInstalled() == testdata[i].expected_isinstalled);
+        }
+
+        Assert::AreEqual(4L, registry->GetReads());
+    }
+
+    // keys are discarded when the scope ends
+    Assert::IsTrue(! InstallerSession::Instance->registry.IsActive());
+    InstalledCheckRegistry check;
+    check.rootkey = L"HKEY_LOCAL_MACHINE";
+    check.path = L"SOFTWARE\\DVLibMemory";
+    check.comparison = L"key_exists";
+    Assert::IsTrue(check.IsInstalled());
+    Assert::AreEqual(5L, registry->GetReads());
+}
+
+void InstalledCheckRegistryUnitTests::testIsInstalledVersion()
+{
+    DVLib::MemoryRegistryReader * registry = new DVLib::MemoryRegistryReader();
+    registry->SetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLibMemory", L"Beta", L"2.1.0-beta.2");
+    registry->SetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLibMemory", L"Long", L"10.0.19041.1.5");
+    registry->SetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLibMemory", L"Invalid", L"2.1 beta");
+    InstallerSession::Instance->registry.SetReader(DVLib::RegistryReaderPtr(registry));
+
+    struct TestData
+    {
+        LPCWSTR fieldname;
+        LPCWSTR fieldvalue;
+        LPCWSTR comparison;
+        bool expected_isinstalled;
+    };
+
+    TestData testdata[] = 
+    {
+        { L"Beta", L"2.1", L"version", false },
+        { L"Beta", L"2.1.0-beta.2", L"version_eq", true },
+        { L"Beta", L"2.1.0-beta.10", L"version_lt", true },
+        { L"Beta", L"2.1.0-alpha", L"version_gt", true },
+        { L"Beta", L"2.0.65536", L"version_ge", true },
+        { L"Long", L"10.0.19041.1", L"version_gt", true },
+        { L"Long", L"10.0.19041.1.5+build", L"version_eq", true },
+        { L"Long", L"10.0.19041.2", L"version", false },
+        // not compared as versions
+        { L"Invalid", L"2.1 beta", L"match", true },
+        { L"Invalid", L"beta", L"contains", true },
+    };
+
+    for (int i = 0; i < ARRAYSIZE(testdata); i++)
+    {
+        InstalledCheckRegistry check;
+        check.rootkey = L"HKEY_LOCAL_MACHINE";
+        check.path = L"SOFTWARE\\DVLibMemory";
+        check.fieldname = testdata[i].fieldname;
+        check.fieldtype = L"REG_SZ";
+        check.fieldvalue = testdata[i].fieldvalue;
+        check.comparison = testdata[i].comparison;
+        bool isinstalled = check.IsInstalled();
+        std::wcout << std::endl << check.fieldname << L" " << check.comparison << L" " << check.fieldvalue
+            << L": " << (isinstalled ? L"yes" : L"no");
+        Assert::IsTrue(isinstalled == testdata[i].expected_isinstalled);
+    }
+
+    // a value that isn't a version, compared as one
+    InstalledCheckRegistry check;
+    check.rootkey = L"HKEY_LOCAL_MACHINE";
+    check.path = L"SOFTWARE\\DVLibMemory";
+    check.fieldname = L"Invalid";
+    check.fieldtype = L"REG_SZ";
+    check.fieldvalue = L"2.1";
+    check.comparison = L"version";
+    try
+    {
+        check.IsInstalled();
+        throw "expected std::exception";
+    }
+    catch(std::exception& ex)
+    {
+        std::cout << std::endl << ex.what();
+    }
+}
+
+void InstalledCheckRegistryUnitTests::testAttributes()
+{
+    // literal types, root keys and WOW options are parsed once
+    InstalledCheckRegistry check;
+    check.fieldtype = L"REG_MULTI_SZ";
+    Assert::IsTrue(check.fieldtype.GetType() == REG_MULTI_SZ);
+    check.fieldtype = L"REG_BINARY";
+    Assert::IsTrue(check.fieldtype.GetType() == REG_NONE);
+    check.rootkey = L"HKEY_CURRENT_USER";
+    Assert::IsTrue(check.rootkey.GetKey() == HKEY_CURRENT_USER);
+    check.wowoption = L"WOW64_32";
+    Assert::IsTrue(check.wowoption.GetOption() == KEY_WOW64_32KEY);
+    check.wowoption = L"none";
+    Assert::IsTrue(check.wowoption.GetOption() == 0);
+    // invalid literals fail when evaluated
+    check.rootkey = L"HKEY_INVALID";
+    try
+    {
+        check.rootkey.GetKey();
+        throw "expected std::exception";
+    }
+    catch(std::exception& ex)
+    {
+        std::cout << std::endl << ex.what();
+    }
+    check.wowoption = L"WOW64_16";
+    try
+    {
+        check.wowoption.GetOption();
+        throw "expected std::exception";
+    }
+    catch(std::exception& ex)
+    {
+        std::cout << std::endl << ex.what();
+    }
+    // values with variables are parsed each time
+    check.fieldtype = L"[fieldtype]";
+    check.rootkey = L"[rootkey]";
+    check.wowoption = L"[wowoption]";
+    InstallerSession::Instance->AdditionalControlArgs[L"fieldtype"] = L"REG_DWORD";
+    InstallerSession::Instance->AdditionalControlArgs[L"rootkey"] = L"HKEY_LOCAL_MACHINE";
+    InstallerSession::Instance->AdditionalControlArgs[L"wowoption"] = L"WOW64_64";
+    Assert::IsTrue(check.fieldtype.GetType() == REG_DWORD);
+    Assert::IsTrue(check.rootkey.GetKey() == HKEY_LOCAL_MACHINE);
+    Assert::IsTrue(check.wowoption.GetOption() == KEY_WOW64_64KEY);
+    InstallerSession::Instance->AdditionalControlArgs[L"fieldtype"] = L"REG_SZ";
+    InstallerSession::Instance->AdditionalControlArgs[L"rootkey"] = L"HKEY_CURRENT_USER";
+    InstallerSession::Instance->AdditionalControlArgs[L"wowoption"] = L"WOW64_32";
+    Assert::IsTrue(check.fieldtype.GetType() == REG_SZ);
+    Assert::IsTrue(check.rootkey.GetKey() == HKEY_CURRENT_USER);
+    Assert::IsTrue(check.wowoption.GetOption() == KEY_WOW64_32KEY);
+}
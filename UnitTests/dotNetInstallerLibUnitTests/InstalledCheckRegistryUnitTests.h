@@ -18,6 +18,9 @@ namespace DVLib
             }
 
 			TEST_METHOD( testIsInstalled );
+			TEST_METHOD( testIsInstalledMemoryRegistry );
+			TEST_METHOD( testIsInstalledVersion );
+			TEST_METHOD( testAttributes );
 			// \todo: WOW options tests
 			// TEST_METHOD( testWOW64_64 );
 			// TEST_METHOD( testWOW64_32 );
@@ -236,3 +236,54 @@ void InstallerSessionUnitTests::testGetRestartCommandLine()
         Assert::IsTrue(cmd == testdata[i].cmd);
     }
 }
+
+void InstallerSessionUnitTests::testVariablesCache()
+{
+    LONG hits = InstallerSession::Instance->GetVariablesHits();
+    LONG misses = InstallerSession::Instance->GetVariablesMisses();
+    // first lookup resolves, subsequent lookups are cached
+    Assert::IsTrue(DVLib::GetTemporaryDirectoryW() == InstallerSession::Instance->ExpandPathVariables(L"#TEMPPATH"));
+    Assert::IsTrue(misses + 1 == InstallerSession::Instance->GetVariablesMisses());
+    LONG generation = InstallerSession::Instance->GetVariablesGeneration();
+    Assert::IsTrue(DVLib::GetTemporaryDirectoryW() == InstallerSession::Instance->ExpandPathVariables(L"#TEMPPATH"));
+    Assert::IsTrue(hits + 1 == InstallerSession::Instance->GetVariablesHits());
+    Assert::IsTrue(generation == InstallerSession::Instance->GetVariablesGeneration());
+    // registry values
+    std::wstring common_files_dir = DVLib::RegistryGetStringValue(
+        HKEY_LOCAL_MACHINE, L"SOFTWARE\\Microsoft\\Windows\\CurrentVersion", L"CommonFilesDir");
+    std::wstring common_files_dir_variable = L"HKEY_LOCAL_MACHINE\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\CommonFilesDir";
+    Assert::IsTrue(common_files_dir == InstallerSession::Instance->GetRegistryVariable(common_files_dir_variable));
+    Assert::IsTrue(common_files_dir == InstallerSession::Instance->GetRegistryVariable(common_files_dir_variable));
+    Assert::IsTrue(hits + 2 == InstallerSession::Instance->GetVariablesHits());
+    // changing the session language discards cached values
+    InstallerSession::Instance->languageid = 1036;
+    Assert::IsTrue(L"1036" == InstallerSession::Instance->ExpandPathVariables(L"#LANGID"));
+    Assert::IsTrue(generation + 1 == InstallerSession::Instance->GetVariablesGeneration());
+    InstallerSession::Instance->languageid = 1033;
+    Assert::IsTrue(L"1033" == InstallerSession::Instance->ExpandPathVariables(L"#LANGID"));
+    Assert::IsTrue(generation + 2 == InstallerSession::Instance->GetVariablesGeneration());
+    // changing the UI level discards cached values
+    InstallUILevelState uilevel_state;
+    InstallUILevelSetting::Instance->SetRuntimeLevel(InstallUILevelSilent);
+    Assert::IsTrue(L"silent" == InstallerSession::Instance->ExpandPathVariables(L"#UILEVEL"));
+    InstallUILevelSetting::Instance->SetRuntimeLevel(InstallUILevelBasic);
+    Assert::IsTrue(L"basic" == InstallerSession::Instance->ExpandPathVariables(L"#UILEVEL"));
+    // explicit invalidation
+    LONG invalidated_generation = InstallerSession::Instance->GetVariablesGeneration();
+    InstallerSession::Instance->InvalidateVariables();
+    Assert::IsTrue(invalidated_generation + 1 == InstallerSession::Instance->GetVariablesGeneration());
+    misses = InstallerSession::Instance->GetVariablesMisses();
+    Assert::IsTrue(common_files_dir == InstallerSession::Instance->GetRegistryVariable(common_files_dir_variable));
+    Assert::IsTrue(misses + 1 == InstallerSession::Instance->GetVariablesMisses());
+}
+
+void InstallerSessionUnitTests::testInvalidateMachineState()
+{
+    LONG variables_generation = InstallerSession::Instance->GetVariablesGeneration();
+    LONG msi_products_generation = InstallerSession::Instance->msi_products.GetGeneration();
+    LONG file_versions_generation = InstallerSession::Instance->file_versions.GetGeneration();
+    InstallerSession::Instance->InvalidateMachineState();
+    Assert::IsTrue(variables_generation + 1 == InstallerSession::Instance->GetVariablesGeneration());
+    Assert::IsTrue(msi_products_generation + 1 == InstallerSession::Instance->msi_products.GetGeneration());
+    Assert::IsTrue(file_versions_generation + 1 == InstallerSession::Instance->file_versions.GetGeneration());
+}
@@ -28,6 +28,8 @@ namespace DVLib
 			TEST_METHOD( testGetRestartCommandLine );
 			TEST_METHOD( testEnableRunOnReboot );
 			TEST_METHOD( testExpandPathVariablesBackslashes );
+			TEST_METHOD( testVariablesCache );
+			TEST_METHOD( testInvalidateMachineState );
 		};
 	}
 }
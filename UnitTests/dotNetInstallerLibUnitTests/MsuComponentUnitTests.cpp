@@ -148,12 +148,14 @@ void MsuComponentUnitTests::testMustReboot()
 void MsuComponentUnitTests::testLoad()
 {
     tinyxml2::XMLDocument doc;
+    ConfigImage image;
     doc.Parse("<component type=\"msu\" \
               package=\"test-dir\\test.msu\" \
               cmdparameters=\"/forcereboot\" \
               execution_method=\"ShellExecute\"/>");
     MsuComponent component;
-    component.Load(doc.RootElement());
+    image.Compile(doc.RootElement());
+    component.Load(image.GetRoot());
     Assert::IsTrue(component.package.GetValue() == L"test-dir\\test.msu");
     Assert::IsTrue(component.cmdparameters.GetValue() == L"/forcereboot");
     Assert::IsTrue(component.execution_method == DVLib::CemShellExecute);
@@ -2,6 +2,7 @@
 #include "ThreadComponentUnitTests.h"
 
 using namespace DVLib::UnitTests;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
 class ThreadComponentImpl : public ThreadComponent
 {
@@ -35,4 +36,15 @@ void ThreadComponentUnitTests::testExecWithError()
     catch(std::exception&)
     {
     }
+}
+
+void ThreadComponentUnitTests::testCompletionHandle()
+{
+    ThreadComponentImpl component(0);
+    // nothing is executing, the completion handle is signaled
+    Assert::IsTrue(WAIT_OBJECT_0 == ::WaitForSingleObject(component.GetCompletionHandle(), 0));
+    component.BeginExec();
+    Assert::IsTrue(WAIT_OBJECT_0 == ::WaitForSingleObject(component.GetCompletionHandle(), INFINITE));
+    Assert::IsTrue(! component.IsExecuting());
+    component.EndExec();
 }
\ No newline at end of file
@@ -19,6 +19,7 @@ namespace DVLib
 
 			TEST_METHOD( testExec );
 			TEST_METHOD( testExecWithError );
+			TEST_METHOD( testCompletionHandle );
 		};
 	}
 }
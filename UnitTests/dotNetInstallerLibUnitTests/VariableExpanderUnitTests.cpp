@@ -0,0 +1,164 @@
+#include "StdAfx.h"
+#include "VariableExpanderUnitTests.h"
+
+using namespace DVLib::UnitTests;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+// expands variables with the environment, path, registry and user passes in sequence
+static std::wstring ExpandVariablesInPasses(const std::wstring& value)
+{
+    std::wstring result = DVLib::ExpandEnvironmentVariables(value);
+    result = InstallerSession::Instance->ExpandPathVariables(result);
+    result = InstallerSession::Instance->ExpandRegistryVariables(result);
+    result = InstallerSession::Instance->ExpandUserVariables(result);
+    return result;
+}
+
+void VariableExpanderUnitTests::testExpand()
+{
+    InstallerSession::Instance->AdditionalControlArgs[L"test1"] = L"t1";
+    InstallerSession::Instance->AdditionalControlArgs[L"test2"] = L"t2";
+    VariableExpander expander(* get(InstallerSession::Instance));
+    Assert::IsTrue(L"" == expander.Expand(L""));
+    Assert::IsTrue(L"plain text" == expander.Expand(L"plain text"));
+    Assert::IsTrue(L"100%% sure, 50%" == expander.Expand(L"100%% sure, 50%"));
+    Assert::IsTrue(L"%VariableExpanderUnitTests_Undefined%" == expander.Expand(L"%VariableExpanderUnitTests_Undefined%"));
+    Assert::IsTrue(L"t1t2" + DVLib::GetWindowsDirectoryW() + DVLib::GetTemporaryDirectoryW() == 
+        expander.Expand(L"[test1][test2]%SystemRoot%#TEMPPATH"));
+    Assert::IsTrue(L"{" + DVLib::GetWindowsDirectoryW() + L"|" + DVLib::GetTemporaryDirectoryW() + L"}" == 
+        expander.Expand(L"{%SystemRoot%|#TEMPPATH}"));
+    Assert::IsTrue(L"DefaultValue" == expander.Expand(L"@[HKEY_LOCAL_MACHINE\\SOFTWARE\\" + DVLib::GenerateGUIDStringW() + L",DefaultValue]"));
+    Assert::IsTrue(L"# @ @[] []" == expander.Expand(L"# @ @[] []"));
+    Assert::IsTrue(L"@[unterminated" == expander.Expand(L"@[unterminated"));
+    Assert::IsTrue(L"[unterminated" == expander.Expand(L"[unterminated"));
+    // a bracket within a variable name is part of the name
+    InstallerSession::Instance->AdditionalControlArgs[L"test[1"] = L"nested";
+    Assert::IsTrue(L"nested" == expander.Expand(L"[test[1]"));
+}
+
+void VariableExpanderUnitTests::testExpandUserVariablesEscapes()
+{
+    VariableExpander expander(* get(InstallerSession::Instance));
+    Assert::IsTrue(L"[]" == expander.Expand(L"[\\[][\\]]"));
+    InstallerSession::Instance->AdditionalControlArgs[L"test1"] = L"t1";
+    Assert::IsTrue(L"[t1]" == expander.Expand(L"[\\[][test1][\\]]"));
+    Assert::IsTrue(L"[\\" == expander.Expand(L"[\\"));
+    Assert::IsTrue(L"[\\[" == expander.Expand(L"[\\["));
+    // escaped brackets within a variable name
+    InstallerSession::Instance->AdditionalControlArgs[L"a]b"] = L"ab";
+    Assert::IsTrue(L"ab" == expander.Expand(L"[a[\\]]b]"));
+}
+
+void VariableExpanderUnitTests::testExpandPathVariablesBackslashes()
+{
+    VariableExpander expander(* get(InstallerSession::Instance));
+    std::wstring path_without_bs = DVLib::trimright(DVLib::GetTemporaryDirectoryW(), L"\\");
+    Assert::IsTrue(path_without_bs + L"\\s1\\s2" == expander.Expand(L"#TEMPPATH\\s1\\s2"));
+    Assert::IsTrue(path_without_bs + L"\\" == expander.Expand(L"#TEMPPATH\\"));
+    Assert::IsTrue(DVLib::GetTemporaryDirectoryW() + L"/s1" == expander.Expand(L"#TEMPPATH/s1"));
+    Assert::IsTrue(DVLib::GetTemporaryDirectoryW() == expander.Expand(L"#TEMPPATH"));
+}
+
+void VariableExpanderUnitTests::testExpandSubstitutedValues()
+{
+    // values of earlier variables are expanded by subsequent ones
+    InstallerSession::Instance->AdditionalControlArgs[L"test1"] = L"t1";
+    Assert::IsTrue(::SetEnvironmentVariableW(L"VariableExpanderUnitTests_Path", L"#TEMPPATH"));
+    Assert::IsTrue(::SetEnvironmentVariableW(L"VariableExpanderUnitTests_User", L"[test1]"));
+    Assert::IsTrue(::SetEnvironmentVariableW(L"VariableExpanderUnitTests_Name", L"TEMP"));
+    VariableExpander expander(* get(InstallerSession::Instance));
+    Assert::IsTrue(DVLib::GetTemporaryDirectoryW() == expander.Expand(L"%VariableExpanderUnitTests_Path%"));
+    Assert::IsTrue(L"t1" == expander.Expand(L"%VariableExpanderUnitTests_User%"));
+    Assert::IsTrue(DVLib::GetTemporaryDirectoryW() == expander.Expand(L"#%VariableExpanderUnitTests_Name%PATH"));
+    ::SetEnvironmentVariableW(L"VariableExpanderUnitTests_Path", NULL);
+    ::SetEnvironmentVariableW(L"VariableExpanderUnitTests_User", NULL);
+    ::SetEnvironmentVariableW(L"VariableExpanderUnitTests_Name", NULL);
+}
+
+void VariableExpanderUnitTests::testExpandDifferential()
+{
+    // random values assembled from fragments of variable syntax must expand
+    // exactly as with separate passes, including the values that fail to expand
+    const wchar_t * environment[][2] = 
+    {
+        { L"VariableExpanderUnitTests_A", L"#TEMPPATH" },
+        { L"VariableExpanderUnitTests_B", L"[u1]" },
+        { L"VariableExpanderUnitTests_C", L"@[" },
+        { L"VariableExpanderUnitTests_D", L"]" },
+        { L"VariableExpanderUnitTests_E", L"\\" },
+        { L"VariableExpanderUnitTests_F", L"#" },
+        { L"VariableExpanderUnitTests_G", L"[\\" },
+        { L"VariableExpanderUnitTests_H", L"%VariableExpanderUnitTests_A%" },
+    };
+
+    for (int i = 0; i < ARRAYSIZE(environment); i++)
+    {
+        Assert::IsTrue(::SetEnvironmentVariableW(environment[i][0], environment[i][1]));
+    }
+
+    const wchar_t * fragments[] = 
+    {
+        L"%", L"#", L"@", L"[", L"]", L"\\", L",", L"|", L" ", L"a",
+        L"[\\[]", L"[\\]]", L"@[", L"@[]", L"[]",
+        L"TEMPPATH", L"CABPATH", L"GUID", L"LANGUAGE", L"#TEMPPATH", L"#LANGUAGE",
+        L"%VariableExpanderUnitTests_A%", L"%VariableExpanderUnitTests_B%", L"%VariableExpanderUnitTests_C%",
+        L"%VariableExpanderUnitTests_D%", L"%VariableExpanderUnitTests_E%", L"%VariableExpanderUnitTests_F%",
+        L"%VariableExpanderUnitTests_G%", L"%VariableExpanderUnitTests_H%", L"%VariableExpanderUnitTests_Undefined%",
+        L"VariableExpanderUnitTests_A", L"u1", L"u2", L"[u1]", L"[u2]",
+        L"HKEY_LOCAL_MACHINE\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\CommonFilesDir",
+        L"HKEY_LOCAL_MACHINE\\SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\DoesntExist",
+    };
+
+    InstallerSession::Instance->AdditionalControlArgs[L"u1"] = L"[v1]";
+    InstallerSession::Instance->AdditionalControlArgs[L"u2"] = L"@[v2]";
+
+    const int iterations = 20000;
+    const int max_fragments = 10;
+    srand(1);
+    int failures = 0;
+    for (int i = 0; i < iterations; i++)
+    {
+        std::wstring value;
+        int count = rand() % (max_fragments + 1);
+        for (int f = 0; f < count; f++)
+        {
+            value.append(fragments[rand() % ARRAYSIZE(fragments)]);
+        }
+
+        std::wstring expected, actual;
+        bool expected_error = false, actual_error = false;
+
+        try
+        {
+            expected = ExpandVariablesInPasses(value);
+        }
+        catch(std::exception&)
+        {
+            expected_error = true;
+        }
+
+        try
+        {
+            actual = InstallerSession::Instance->ExpandVariables(value);
+        }
+        catch(std::exception&)
+        {
+            actual_error = true;
+        }
+
+        if (expected_error != actual_error || expected != actual)
+        {
+            std::wcout << std::endl << L"Mismatch: '" << value << L"' => '" << expected << L"'" << (expected_error ? L" (error)" : L"")
+                << L", '" << actual << L"'" << (actual_error ? L" (error)" : L"");
+            failures++;
+        }
+    }
+
+    for (int i = 0; i < ARRAYSIZE(environment); i++)
+    {
+        ::SetEnvironmentVariableW(environment[i][0], NULL);
+    }
+
+    std::wcout << std::endl << L"Compared " << iterations << L" random values, " << failures << L" mismatch(es)";
+    Assert::AreEqual(0, failures);
+}
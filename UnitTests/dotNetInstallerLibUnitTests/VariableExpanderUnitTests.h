@@ -0,0 +1,27 @@
+#pragma once
+#include "dotNetInstallerLibUnitTestFixture.h"
+
+namespace DVLib
+{
+	namespace UnitTests 
+	{
+		TEST_CLASS(VariableExpanderUnitTests), public dotNetInstallerLibUnitTestFixture
+		{
+            TEST_METHOD_INITIALIZE( initialize )
+            {
+                setUp();
+            }
+
+            TEST_METHOD_CLEANUP( cleanup )
+            {
+                tearDown();
+            }
+
+			TEST_METHOD( testExpand );
+			TEST_METHOD( testExpandUserVariablesEscapes );
+			TEST_METHOD( testExpandPathVariablesBackslashes );
+			TEST_METHOD( testExpandSubstitutedValues );
+			TEST_METHOD( testExpandDifferential );
+		};
+	}
+}
@@ -0,0 +1,151 @@
+#include "StdAfx.h"
+#include "WorkerPoolUnitTests.h"
+
+using namespace DVLib::UnitTests;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+class WorkerTaskImpl : public WorkerTask
+{
+private:
+    HANDLE m_hBlock;
+public:
+    volatile LONG executed;
+    WorkerTaskImpl(HANDLE hBlock = NULL);
+    int ExecOnThread();
+};
+
+WorkerTaskImpl::WorkerTaskImpl(HANDLE hBlock)
+: m_hBlock(hBlock)
+, executed(0)
+{
+
+}
+
+int WorkerTaskImpl::ExecOnThread()
+{
+    if (m_hBlock != NULL) ::WaitForSingleObject(m_hBlock, INFINITE);
+    ::InterlockedIncrement(& executed);
+    return 0;
+}
+
+// submits an inner task to the same pool and waits for it
+class NestedWorkerTaskImpl : public WorkerTask
+{
+public:
+    WorkerPool * pool;
+    WorkerTaskImpl inner;
+    int ExecOnThread()
+    {
+        pool->Submit(& inner);
+        inner.Wait();
+        return inner.executed == 1 ? 0 : -1;
+    }
+};
+
+void WorkerPoolUnitTests::testSubmit()
+{
+    WorkerPool pool(2);
+    WorkerTaskImpl tasks[16];
+    for (int i = 0; i < ARRAYSIZE(tasks); i++)
+    {
+        pool.Submit(& tasks[i]);
+    }
+
+    for (int i = 0; i < ARRAYSIZE(tasks); i++)
+    {
+        Assert::IsTrue(tasks[i].Wait());
+        Assert::IsTrue(1 == tasks[i].executed);
+        Assert::IsTrue(0 == tasks[i].GetResult());
+    }
+
+    // threads are reused up to the bound
+    Assert::IsTrue(pool.GetThreadCount() <= 2);
+}
+
+void WorkerPoolUnitTests::testContinueWith()
+{
+    WorkerPool pool(2);
+    WorkerTaskImpl first;
+    WorkerTaskImpl second;
+    first.ContinueWith(& second);
+    pool.Submit(& first);
+    Assert::IsTrue(second.Wait());
+    Assert::IsTrue(1 == first.executed);
+    Assert::IsTrue(1 == second.executed);
+    // a continuation added after completion runs right away
+    WorkerTaskImpl third;
+    first.ContinueWith(& third);
+    Assert::IsTrue(third.Wait());
+    Assert::IsTrue(1 == third.executed);
+}
+
+void WorkerPoolUnitTests::testCancel()
+{
+    auto_event hBlock(::CreateEvent(NULL, TRUE, FALSE, NULL));
+    WorkerPool pool(1);
+    WorkerTaskImpl running(get(hBlock));
+    WorkerTaskImpl queued;
+    pool.Submit(& running);
+    pool.Submit(& queued);
+    // the only worker is busy, the second task is still queued
+    queued.Cancel();
+    Assert::IsTrue(queued.IsComplete());
+    Assert::IsTrue(queued.IsCancelled());
+    Assert::IsTrue(0 == queued.executed);
+    Assert::IsTrue(-1 == queued.GetResult());
+    ::SetEvent(get(hBlock));
+    Assert::IsTrue(running.Wait());
+    Assert::IsTrue(1 == running.executed);
+}
+
+void WorkerPoolUnitTests::testNestedWait()
+{
+    // a task waiting for another task on a single worker runs it inline instead of deadlocking
+    WorkerPool pool(1);
+    NestedWorkerTaskImpl outer;
+    outer.pool = & pool;
+    pool.Submit(& outer);
+    // doesn't run the outer task on this thread
+    Assert::IsTrue(outer.IsComplete(INFINITE));
+    Assert::IsTrue(0 == outer.GetResult());
+    Assert::IsTrue(1 == outer.inner.executed);
+}
+
+void WorkerPoolUnitTests::testOutlivePool()
+{
+    // the pool is drained when destroyed, a task that outlives it no longer references it
+    WorkerTaskImpl task;
+    {
+        WorkerPool pool(1);
+        pool.Submit(& task);
+    }
+    Assert::IsTrue(1 == task.executed);
+    task.Cancel();
+    Assert::IsTrue(task.Wait());
+    Assert::IsTrue(0 == task.GetResult());
+}
+
+static DWORD WINAPI SetEventLater(LPVOID pParam)
+{
+    ::Sleep(500);
+    ::SetEvent(static_cast<HANDLE>(pParam));
+    return 0;
+}
+
+void WorkerPoolUnitTests::testContinueWithShutdown()
+{
+    // a continuation of a task that completes while the pool is shutting down runs on the worker
+    auto_event hBlock(::CreateEvent(NULL, TRUE, FALSE, NULL));
+    WorkerTaskImpl first(get(hBlock));
+    WorkerTaskImpl second;
+    first.ContinueWith(& second);
+    {
+        WorkerPool pool(1);
+        pool.Submit(& first);
+        auto_thread hThread(::CreateThread(NULL, 0, SetEventLater, get(hBlock), 0, NULL));
+        Assert::IsTrue(get(hThread) != NULL);
+    }
+    Assert::IsTrue(1 == first.executed);
+    Assert::IsTrue(second.IsComplete());
+    Assert::IsTrue(1 == second.executed);
+}
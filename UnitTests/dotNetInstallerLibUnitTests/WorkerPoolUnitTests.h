@@ -0,0 +1,28 @@
+#pragma once
+#include "dotNetInstallerLibUnitTestFixture.h"
+
+namespace DVLib
+{
+	namespace UnitTests 
+	{
+		TEST_CLASS(WorkerPoolUnitTests), public dotNetInstallerLibUnitTestFixture
+		{
+            TEST_METHOD_INITIALIZE( initialize )
+            {
+                setUp();
+            }
+
+            TEST_METHOD_CLEANUP( cleanup )
+            {
+                tearDown();
+            }
+
+			TEST_METHOD( testSubmit );
+			TEST_METHOD( testContinueWith );
+			TEST_METHOD( testCancel );
+			TEST_METHOD( testNestedWait );
+			TEST_METHOD( testOutlivePool );
+			TEST_METHOD( testContinueWithShutdown );
+		};
+	}
+}
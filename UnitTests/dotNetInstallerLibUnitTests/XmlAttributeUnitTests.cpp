@@ -24,3 +24,26 @@ void XmlAttributeUnitTests::testGetValue()
     Assert::IsTrue(L"4" == attr.GetValue());
     Assert::IsTrue(4 == attr.GetLongValue());
 }
+
+void XmlAttributeUnitTests::testCopy()
+{
+    XmlAttribute attr(L"Install [a]");
+    XmlAttribute copy(attr);
+    Assert::IsTrue(copy.IsSameSource(attr));
+    Assert::IsTrue(copy.GetSource() == L"Install [a]");
+    // values assigned separately share one template
+    XmlAttribute same(std::wstring(L"Install [a]"));
+    Assert::IsTrue(same.IsSameSource(attr));
+    Assert::IsTrue(& same.GetSource() == & attr.GetSource());
+    copy = L"Install [b]";
+    Assert::IsTrue(! copy.IsSameSource(attr));
+    Assert::IsTrue(attr.GetSource() == L"Install [a]");
+    // empty values
+    XmlAttribute empty;
+    Assert::IsTrue(empty.empty());
+    Assert::IsTrue(empty.IsLiteral());
+    Assert::IsTrue(empty.GetSource().empty());
+    copy = L"";
+    Assert::IsTrue(copy.empty());
+    Assert::IsTrue(copy.IsSameSource(empty));
+}
@@ -19,6 +19,7 @@ namespace DVLib
 
 			TEST_METHOD( testEmpty );
 			TEST_METHOD( testGetValue );
+			TEST_METHOD( testCopy );
 		};
 	}
 }
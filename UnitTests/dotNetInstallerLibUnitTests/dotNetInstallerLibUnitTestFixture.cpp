@@ -7,10 +7,12 @@ void dotNetInstallerLibUnitTestFixture::setUp()
     InstallerSession::Instance = shared_any<InstallerSession *, close_delete>(new InstallerSession());
     InstallUILevelSetting::Instance = shared_any<InstallUILevelSetting *, close_delete>(new InstallUILevelSetting());
     InstallerLauncher::Instance = shared_any<InstallerLauncher *, close_delete>(new InstallerLauncher());
+    WorkerPool::Instance = shared_any<WorkerPool *, close_delete>(new WorkerPool());
 }
 
 void dotNetInstallerLibUnitTestFixture::tearDown()
 {
+    reset(WorkerPool::Instance);
     reset(InstallerLauncher::Instance);
     reset(InstallerLog::Instance);
     reset(InstallerSession::Instance);
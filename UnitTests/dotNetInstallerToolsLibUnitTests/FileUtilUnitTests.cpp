@@ -160,6 +160,18 @@ void FileUtilUnitTests::testFileReadToEnd()
     DVLib::FileDelete(tmpfile);
 }
 
+void FileUtilUnitTests::testGetFileHash()
+{
+    std::wstring tmpfile = DVLib::GetTemporaryFileNameW();
+    Assert::IsTrue(DVLib::FileExists(tmpfile));
+    Assert::IsTrue(DVLib::GetFileHash(tmpfile) == L"da39a3ee5e6b4b0d3255bfef95601890afd80709");
+    std::ofstream f(DVLib::wstring2string(tmpfile).c_str(), std::ios::binary);
+    f << "abc";
+    f.close();
+    Assert::IsTrue(DVLib::GetFileHash(tmpfile) == L"a9993e364706816aba3e25717850c26c9cd0d89d");
+    DVLib::FileDelete(tmpfile);
+}
+
 void FileUtilUnitTests::testGetFileVersionInfo()
 {
     std::wstring userexepath = DVLib::DirectoryCombine(DVLib::GetSystemDirectoryW(), L"user.exe");
@@ -190,6 +202,29 @@ void FileUtilUnitTests::testLoadResourceData()
     Assert::IsTrue(data.size() == 3390);
 }
 
+void FileUtilUnitTests::testGetResourceView()
+{
+    HMODULE hm = GetCurrentModuleHandle();
+    DVLib::ResourceView<char> view = DVLib::GetResourceView<char>(hm, L"RES_TEST", L"CUSTOM");
+    Assert::IsTrue(view.size == 3390);
+    // the view points into the image, a copy has the same data
+    std::vector<char> data = DVLib::LoadResourceData<char>(hm, L"RES_TEST", L"CUSTOM");
+    Assert::IsTrue(memcmp(view.data, & * data.begin(), view.size) == 0);
+    Assert::IsTrue(view.data == DVLib::GetResourceView<char>(hm, L"RES_TEST", L"CUSTOM").data);
+    // a view of wide characters counts characters
+    DVLib::ResourceView<wchar_t> wview = DVLib::GetResourceView<wchar_t>(hm, L"RES_TEST", L"CUSTOM");
+    Assert::IsTrue(wview.size == view.size / sizeof(wchar_t));
+    try
+    {
+        DVLib::GetResourceView<char>(hm, L"ResourceDoesntExist", L"CUSTOM");
+        throw "expected std::exception";
+    }
+    catch(std::exception& ex)
+    {
+        std::cout << std::endl << ex.what();
+    }
+}
+
 void FileUtilUnitTests::testResourceExists()
 {
     HMODULE hm = GetCurrentModuleHandle();
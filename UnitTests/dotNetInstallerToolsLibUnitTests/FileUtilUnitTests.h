@@ -15,9 +15,11 @@ namespace DVLib
 			TEST_METHOD( testFileWrite );
 			TEST_METHOD( testFileCreate );
 			TEST_METHOD( testFileReadToEnd );
+			TEST_METHOD( testGetFileHash );
 			TEST_METHOD( testGetFileVersionInfo );
 			TEST_METHOD( testGetFileVersion );
 			TEST_METHOD( testLoadResourceData );
+			TEST_METHOD( testGetResourceView );
 			TEST_METHOD( testResourceExists );
 			TEST_METHOD( testwstring2fileversion );
 			TEST_METHOD( testfileversion2wstring );
@@ -0,0 +1,90 @@
+#include "StdAfx.h"
+#include "FileVersionCacheUnitTests.h"
+
+using namespace DVLib::UnitTests;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+void FileVersionCacheUnitTests::testGetFileVersion()
+{
+    DVLib::FileVersionCache cache;
+    std::wstring filename = DVLib::DirectoryCombine(DVLib::GetSystemDirectoryW(), L"kernel32.dll");
+    std::wstring version = DVLib::GetFileVersion(filename);
+    Assert::IsTrue(cache.GetFileVersion(filename) == version);
+    Assert::IsTrue(0 == cache.GetHits());
+    Assert::IsTrue(1 == cache.GetMisses());
+    Assert::IsTrue(cache.GetFileVersion(filename) == version);
+    // paths are normalized
+    Assert::IsTrue(cache.GetFileVersion(DVLib::DirectoryCombine(DVLib::GetSystemDirectoryW(), L"KERNEL32.DLL")) == version);
+    Assert::IsTrue(cache.GetFileVersion(DVLib::DirectoryCombine(DVLib::GetSystemDirectoryW(), L"..\\System32\\kernel32.dll")) == version);
+    Assert::IsTrue(3 == cache.GetHits());
+    Assert::IsTrue(1 == cache.GetMisses());
+}
+
+void FileVersionCacheUnitTests::testModified()
+{
+    DVLib::FileVersionCache cache;
+    std::wstring filename = DVLib::DirectoryCombine(DVLib::GetTemporaryDirectoryW(), DVLib::GenerateGUIDStringW() + L".dll");
+    DVLib::FileCopy(DVLib::DirectoryCombine(DVLib::GetSystemDirectoryW(), L"kernel32.dll"), filename);
+    std::wstring version = cache.GetFileVersion(filename);
+    Assert::IsTrue(version == cache.GetFileVersion(filename));
+    Assert::IsTrue(1 == cache.GetMisses());
+
+    // a file replaced with another version
+    DVLib::FileCopy(DVLib::DirectoryCombine(DVLib::GetSystemDirectoryW(), L"msi.dll"), filename);
+    Assert::IsTrue(DVLib::GetFileVersion(filename) == cache.GetFileVersion(filename));
+    Assert::IsTrue(2 == cache.GetMisses());
+
+    // a file touched without changing its size
+    {
+        auto_hfile file(::CreateFile(filename.c_str(), FILE_WRITE_ATTRIBUTES, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL));
+        Assert::IsTrue(get(file) != INVALID_HANDLE_VALUE);
+        FILETIME ft = { 0 };
+        ::GetSystemTimeAsFileTime(& ft);
+        Assert::IsTrue(TRUE == ::SetFileTime(get(file), NULL, NULL, & ft));
+    }
+
+    cache.GetFileVersion(filename);
+    Assert::IsTrue(3 == cache.GetMisses());
+    Assert::IsTrue(1 == cache.GetHits());
+    DVLib::FileDelete(filename);
+}
+
+void FileVersionCacheUnitTests::testInvalidate()
+{
+    DVLib::FileVersionCache cache;
+    std::wstring filename = DVLib::DirectoryCombine(DVLib::GetSystemDirectoryW(), L"kernel32.dll");
+    cache.GetFileVersion(filename);
+    cache.GetFileVersion(filename);
+    Assert::IsTrue(1 == cache.GetMisses());
+    cache.Invalidate();
+    Assert::IsTrue(1 == cache.GetGeneration());
+    cache.GetFileVersion(filename);
+    Assert::IsTrue(2 == cache.GetMisses());
+    Assert::IsTrue(1 == cache.GetHits());
+}
+
+void FileVersionCacheUnitTests::testCacheBenchmark()
+{
+    // files probed by several components, on every refresh
+    LPCWSTR files[] = { L"kernel32.dll", L"user32.dll", L"msi.dll", L"ole32.dll", L"shell32.dll" };
+    const int count = 200;
+
+    DWORD start = ::GetTickCount();
+    for (int i = 0; i < count; i++)
+    {
+        DVLib::GetFileVersion(DVLib::DirectoryCombine(DVLib::GetSystemDirectoryW(), files[i % ARRAYSIZE(files)]));
+    }
+    DWORD uncached_ticks = ::GetTickCount() - start;
+
+    DVLib::FileVersionCache cache;
+    start = ::GetTickCount();
+    for (int i = 0; i < count; i++)
+    {
+        cache.GetFileVersion(DVLib::DirectoryCombine(DVLib::GetSystemDirectoryW(), files[i % ARRAYSIZE(files)]));
+    }
+    DWORD cached_ticks = ::GetTickCount() - start;
+
+    Assert::IsTrue(ARRAYSIZE(files) == cache.GetMisses());
+    std::wcout << std::endl << L"Read " << count << L" file version(s): " << uncached_ticks << L" ms, "
+        << cached_ticks << L" ms with a cache";
+}
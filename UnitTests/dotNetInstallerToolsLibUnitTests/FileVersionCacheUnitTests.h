@@ -0,0 +1,15 @@
+#pragma once
+
+namespace DVLib
+{
+	namespace UnitTests 
+	{
+		TEST_CLASS(FileVersionCacheUnitTests)
+		{
+			TEST_METHOD( testGetFileVersion );
+			TEST_METHOD( testModified );
+			TEST_METHOD( testInvalidate );
+			TEST_METHOD( testCacheBenchmark );
+		};
+	}
+}
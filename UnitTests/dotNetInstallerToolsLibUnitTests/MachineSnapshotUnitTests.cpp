@@ -0,0 +1,127 @@
+#include "StdAfx.h"
+#include "MachineSnapshotUnitTests.h"
+
+using namespace DVLib::UnitTests;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+void MachineSnapshotUnitTests::testParse()
+{
+    std::wstring productcode = L"{6C961B56-5A27-4CBF-A7F3-EE8AC3E28C9A}";
+    std::wstring upgradecode = L"{2B3A2A0F-4BB3-4C2F-9B7A-8E8C9F1C6E50}";
+    std::wstringstream data;
+    data << L"# machine snapshot" << std::endl
+        << L"os\twin7sp1" << std::endl
+        << L"pa\tx64" << std::endl
+        << L"lcid\t1036" << std::endl
+        << std::endl
+        << L"key\tHKEY_LOCAL_MACHINE\\SOFTWARE\\DVLib\\Empty" << std::endl
+        << L"value\tHKEY_LOCAL_MACHINE\\SOFTWARE\\DVLib\tVersion\tREG_SZ\t1.2.3.4" << std::endl
+        << L"value\tHKEY_LOCAL_MACHINE\\SOFTWARE\\DVLib\t\tREG_SZ\tdefault" << std::endl
+        << L"value\tHKEY_LOCAL_MACHINE\\SOFTWARE\\DVLib\tInstalled\tREG_DWORD\t1" << std::endl
+        << L"value\tHKEY_LOCAL_MACHINE\\SOFTWARE\\DVLib\tPaths\tREG_MULTI_SZ\ta\tb" << std::endl
+        << L"value\tHKEY_LOCAL_MACHINE:WOW64_64\\SOFTWARE\\DVLib\tVersion\tREG_SZ\t2.0\r" << std::endl
+        << L"product\t" << productcode << L"\t" << upgradecode << L"\tProduct\t1.0" << std::endl
+        << L"property\t" << productcode << L"\tLanguage\t1033" << std::endl
+        << L"file\tC:\\Windows\\System32\\msi.dll\t5.0.7601.17514" << std::endl
+        << L"file\tC:\\Windows\\System32\\none.txt" << std::endl
+        << L"directory\tC:\\Program Files\\DVLib\\" << std::endl;
+
+    DVLib::MachineSnapshot machine;
+    machine.Parse(data.str());
+    Assert::IsTrue(DVLib::win7sp1 == machine.os);
+    Assert::IsTrue(PROCESSOR_ARCHITECTURE_AMD64 == machine.processor_architecture);
+    Assert::IsTrue(1036 == machine.lcid);
+
+    // registry
+    DVLib::RegistrySnapshot registry(machine.registry);
+    Assert::IsTrue(registry.KeyExists(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib\\Empty"));
+    Assert::IsTrue(! registry.KeyExists(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib\\DoesntExist"));
+    Assert::IsTrue(registry.GetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib", L"Version") == L"1.2.3.4");
+    Assert::IsTrue(registry.GetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib") == L"default");
+    Assert::IsTrue(registry.GetDWORDValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib", L"Installed") == 1);
+    std::vector<std::wstring> paths = registry.GetMultiStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib", L"Paths");
+    Assert::IsTrue(paths.size() == 2);
+    Assert::IsTrue(paths[0] == L"a");
+    Assert::IsTrue(paths[1] == L"b");
+    Assert::IsTrue(registry.GetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib", L"Version", KEY_WOW64_64KEY) == L"2.0");
+
+    // products
+    DVLib::MsiProductInventory msi_products(machine.msi_products);
+    Assert::IsTrue(msi_products.IsProductInstalled(DVLib::string2guid(productcode)));
+    Assert::IsTrue(msi_products.GetRelatedProducts(DVLib::string2guid(upgradecode)).size() == 1);
+    Assert::IsTrue(msi_products.GetVersionString(DVLib::string2guid(productcode)) == L"1.0");
+    Assert::IsTrue(msi_products.GetProductProperty(DVLib::string2guid(productcode), L"Language") == L"1033");
+
+    // files
+    DVLib::FileVersionCache file_versions;
+    file_versions.SetReader(machine.files);
+    Assert::IsTrue(file_versions.FileExists(L"c:\\windows\\system32\\MSI.DLL"));
+    Assert::IsTrue(file_versions.GetFileVersion(L"C:\\Windows\\System32\\msi.dll") == L"5.0.7601.17514");
+    Assert::IsTrue(file_versions.FileExists(L"C:\\Windows\\System32\\none.txt"));
+    Assert::IsTrue(! file_versions.FileExists(L"C:\\Windows\\System32\\kernel32.dll"));
+
+    // directories, added or holding files
+    Assert::IsTrue(file_versions.DirectoryExists(L"c:\\program files\\dvlib"));
+    Assert::IsTrue(file_versions.DirectoryExists(L"C:\\Program Files"));
+    Assert::IsTrue(file_versions.DirectoryExists(L"C:\\Windows\\System32\\"));
+    Assert::IsTrue(file_versions.DirectoryExists(L"C:\\Windows"));
+    Assert::IsTrue(! file_versions.DirectoryExists(L"C:\\Windows\\System"));
+    Assert::IsTrue(! file_versions.DirectoryExists(L"C:\\Windows\\System32\\msi.dll"));
+
+    try
+    {
+        file_versions.GetFileVersion(L"C:\\Windows\\System32\\none.txt");
+        throw "expected std::exception";
+    }
+    catch(std::exception& ex)
+    {
+        std::cout << std::endl << ex.what();
+    }
+}
+
+void MachineSnapshotUnitTests::testParseInvalid()
+{
+    const wchar_t * invalid[] = 
+    {
+        L"os\twin99",
+        L"pa\tz80",
+        L"unknown\tvalue",
+        L"os",
+        L"key\tHKEY_LOCAL_MACHINE",
+        L"key\tHKEY_UNKNOWN\\SOFTWARE",
+        L"key\tHKEY_LOCAL_MACHINE:WOW64_128\\SOFTWARE",
+        L"value\tHKEY_LOCAL_MACHINE\\SOFTWARE\\DVLib\tValue\tREG_BINARY\t00",
+        L"product\tnot a guid\t{2B3A2A0F-4BB3-4C2F-9B7A-8E8C9F1C6E50}\tProduct\t1.0",
+        L"property\t{6C961B56-5A27-4CBF-A7F3-EE8AC3E28C9A}\tLanguage\t1033",
+        L"file\tC:\\Windows\\System32\\msi.dll\tnot a version",
+        L"directory\t\\",
+    };
+
+    for (int i = 0; i < ARRAYSIZE(invalid); i++)
+    {
+        try
+        {
+            DVLib::MachineSnapshot machine;
+            machine.Parse(invalid[i]);
+            throw "expected std::exception";
+        }
+        catch(std::exception& ex)
+        {
+            std::cout << std::endl << ex.what();
+        }
+    }
+}
+
+void MachineSnapshotUnitTests::testLoad()
+{
+    std::wstring filename = DVLib::GetTemporaryFileNameW();
+    std::string data = "os\twin10\r\npa\tx86\r\nfile\tC:\\Program Files\\DVLib\\DVLib.exe\t1.0\r\n";
+    DVLib::FileWrite(filename, std::vector<char>(data.begin(), data.end()));
+    DVLib::MachineSnapshot machine;
+    machine.Load(filename);
+    DVLib::FileDelete(filename);
+    Assert::IsTrue(machine.name == filename);
+    Assert::IsTrue(DVLib::win10 == machine.os);
+    Assert::IsTrue(PROCESSOR_ARCHITECTURE_INTEL == machine.processor_architecture);
+    Assert::IsTrue(machine.GetFiles().FileExists(L"C:\\Program Files\\DVLib\\DVLib.exe"));
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+namespace DVLib
+{
+	namespace UnitTests 
+	{
+		TEST_CLASS(MachineSnapshotUnitTests)
+		{
+			TEST_METHOD( testParse );
+			TEST_METHOD( testParseInvalid );
+			TEST_METHOD( testLoad );
+		};
+	}
+}
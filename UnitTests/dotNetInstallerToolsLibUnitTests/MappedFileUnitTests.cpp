@@ -0,0 +1,48 @@
+#include "StdAfx.h"
+#include "MappedFileUnitTests.h"
+
+using namespace DVLib::UnitTests;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+void MappedFileUnitTests::testMapFile()
+{
+    std::wstring tmpfile = DVLib::GetTemporaryFileNameW();
+    std::string guid = DVLib::GenerateGUIDStringA();
+    std::vector<char> data(guid.begin(), guid.end());
+    DVLib::FileWrite(tmpfile, data);
+    {
+        DVLib::MappedFile mapped(tmpfile);
+        Assert::IsTrue(mapped.GetSize() == static_cast<long>(data.size()));
+        Assert::IsTrue(mapped.GetData() != NULL);
+        Assert::IsTrue(std::string(mapped.GetData(), mapped.GetSize()) == guid);
+    }
+    // the view is released with the object
+    DVLib::FileDelete(tmpfile);
+    Assert::IsTrue(! DVLib::FileExists(tmpfile));
+}
+
+void MappedFileUnitTests::testMapEmptyFile()
+{
+    std::wstring tmpfile = DVLib::GetTemporaryFileNameW();
+    {
+        DVLib::MappedFile mapped(tmpfile);
+        Assert::IsTrue(mapped.GetSize() == 0);
+        Assert::IsTrue(mapped.GetData() == NULL);
+    }
+    DVLib::FileDelete(tmpfile);
+}
+
+void MappedFileUnitTests::testMapMissingFile()
+{
+    std::wstring tmpfile = DVLib::GetTemporaryFileNameW();
+    DVLib::FileDelete(tmpfile);
+    try
+    {
+        DVLib::MappedFile mapped(tmpfile);
+        throw "expected std::exception";
+    }
+    catch(std::exception& ex)
+    {
+        std::cout << std::endl << ex.what();
+    }
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+namespace DVLib
+{
+	namespace UnitTests 
+	{
+		TEST_CLASS(MappedFileUnitTests)
+		{
+			TEST_METHOD( testMapFile );
+			TEST_METHOD( testMapEmptyFile );
+			TEST_METHOD( testMapMissingFile );
+		};
+	}
+}
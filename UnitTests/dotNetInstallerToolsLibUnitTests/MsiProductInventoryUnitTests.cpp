@@ -0,0 +1,172 @@
+#include "StdAfx.h"
+#include "MsiProductInventoryUnitTests.h"
+
+using namespace DVLib::UnitTests;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+void MsiProductInventoryUnitTests::testIsProductInstalled()
+{
+    DVLib::MemoryMsiProductReader * reader = new DVLib::MemoryMsiProductReader();
+    GUID product1 = DVLib::string2guid(DVLib::GenerateGUIDStringW());
+    GUID product2 = DVLib::string2guid(DVLib::GenerateGUIDStringW());
+    GUID upgradecode = DVLib::string2guid(DVLib::GenerateGUIDStringW());
+    reader->AddProduct(product1, upgradecode, L"Product 1", L"1.0.0.0");
+    DVLib::MsiProductInventory inventory((DVLib::MsiProductReaderPtr(reader)));
+    Assert::AreEqual(0L, reader->GetEnumerations());
+    // the inventory is built on first use
+    Assert::IsTrue(inventory.IsProductInstalled(product1));
+    Assert::IsTrue(! inventory.IsProductInstalled(product2));
+    Assert::IsTrue(! inventory.IsProductInstalled(upgradecode));
+    Assert::AreEqual(1L, reader->GetEnumerations());
+    Assert::AreEqual(1L, inventory.GetMisses());
+    Assert::AreEqual(2L, inventory.GetHits());
+}
+
+void MsiProductInventoryUnitTests::testGetRelatedProducts()
+{
+    DVLib::MemoryMsiProductReader * reader = new DVLib::MemoryMsiProductReader();
+    GUID product1 = DVLib::string2guid(DVLib::GenerateGUIDStringW());
+    GUID product2 = DVLib::string2guid(DVLib::GenerateGUIDStringW());
+    GUID product3 = DVLib::string2guid(DVLib::GenerateGUIDStringW());
+    GUID upgradecode1 = DVLib::string2guid(DVLib::GenerateGUIDStringW());
+    GUID upgradecode2 = DVLib::string2guid(DVLib::GenerateGUIDStringW());
+    reader->AddProduct(product1, upgradecode1, L"Product 1", L"1.0.0.0");
+    reader->AddProduct(product2, upgradecode1, L"Product 2", L"2.0.0.0");
+    reader->AddProduct(product3, upgradecode2, L"Product 3", L"3.0.0.0");
+    DVLib::MsiProductInventory inventory((DVLib::MsiProductReaderPtr(reader)));
+    for (int i = 0; i < 3; i++)
+    {
+        std::vector<GUID> related = inventory.GetRelatedProducts(upgradecode1);
+        Assert::AreEqual(static_cast<size_t>(2), related.size());
+        Assert::IsTrue(related[0] == product1);
+        Assert::IsTrue(related[1] == product2);
+        Assert::AreEqual(static_cast<size_t>(1), inventory.GetRelatedProducts(upgradecode2).size());
+        Assert::AreEqual(static_cast<size_t>(0), inventory.GetRelatedProducts(product1).size());
+    }
+    // one enumeration for each upgrade code
+    Assert::AreEqual(3L, reader->GetEnumerations());
+}
+
+void MsiProductInventoryUnitTests::testGetProductProperty()
+{
+    DVLib::MemoryMsiProductReader * reader = new DVLib::MemoryMsiProductReader();
+    GUID product = DVLib::string2guid(DVLib::GenerateGUIDStringW());
+    reader->AddProduct(product, DVLib::string2guid(DVLib::GenerateGUIDStringW()), L"Product", L"1.2.3.4");
+    reader->SetProductProperty(product, INSTALLPROPERTY_PUBLISHER, L"Publisher");
+    DVLib::MsiProductInventory inventory((DVLib::MsiProductReaderPtr(reader)));
+    for (int i = 0; i < 3; i++)
+    {
+        Assert::IsTrue(inventory.GetProductName(product) == L"Product");
+        Assert::IsTrue(inventory.GetVersionString(product) == L"1.2.3.4");
+        Assert::IsTrue(inventory.GetProductProperty(product, INSTALLPROPERTY_PUBLISHER) == L"Publisher");
+    }
+    Assert::AreEqual(3L, reader->GetPropertyReads());
+    // errors are not remembered
+    for (int i = 0; i < 2; i++)
+    {
+        try
+        {
+            inventory.GetProductProperty(product, INSTALLPROPERTY_HELPLINK);
+            throw "expected std::exception";
+        }
+        catch(std::exception& ex)
+        {
+            std::wcout << std::endl << L"Expected exception: " << DVLib::string2wstring(ex.what());
+        }
+    }
+    Assert::AreEqual(5L, reader->GetPropertyReads());
+}
+
+void MsiProductInventoryUnitTests::testInvalidate()
+{
+    DVLib::MemoryMsiProductReader * reader = new DVLib::MemoryMsiProductReader();
+    GUID product = DVLib::string2guid(DVLib::GenerateGUIDStringW());
+    GUID upgradecode = DVLib::string2guid(DVLib::GenerateGUIDStringW());
+    DVLib::MsiProductInventory inventory((DVLib::MsiProductReaderPtr(reader)));
+    Assert::IsTrue(! inventory.IsProductInstalled(product));
+    Assert::AreEqual(static_cast<size_t>(0), inventory.GetRelatedProducts(upgradecode).size());
+    // not seen until the inventory is invalidated
+    reader->AddProduct(product, upgradecode, L"Product", L"1.0.0.0");
+    Assert::IsTrue(! inventory.IsProductInstalled(product));
+    Assert::AreEqual(static_cast<size_t>(0), inventory.GetRelatedProducts(upgradecode).size());
+    LONG generation = inventory.GetGeneration();
+    inventory.Invalidate();
+    Assert::AreEqual(generation + 1, inventory.GetGeneration());
+    Assert::IsTrue(inventory.IsProductInstalled(product));
+    Assert::AreEqual(static_cast<size_t>(1), inventory.GetRelatedProducts(upgradecode).size());
+    Assert::IsTrue(inventory.GetVersionString(product) == L"1.0.0.0");
+    // removed
+    reader->RemoveProduct(product);
+    inventory.Invalidate();
+    Assert::IsTrue(! inventory.IsProductInstalled(product));
+    Assert::AreEqual(static_cast<size_t>(0), inventory.GetRelatedProducts(upgradecode).size());
+    Assert::AreEqual(6L, reader->GetEnumerations());
+}
+
+void MsiProductInventoryUnitTests::testSystemInventory()
+{
+    DVLib::MsiProductInventory inventory;
+    std::vector<DVLib::MsiProductInfo> installedproducts = DVLib::MsiGetInstalledProducts();
+    Assert::IsTrue(installedproducts.size() > 0);
+    for each(const DVLib::MsiProductInfo& product in installedproducts)
+    {
+        Assert::IsTrue(inventory.IsProductInstalled(product.product_id));
+        Assert::IsTrue(inventory.GetProductName(product.product_id) == product.GetProductName());
+    }
+    Assert::IsTrue(! inventory.IsProductInstalled(DVLib::string2guid(DVLib::GenerateGUIDStringW())));
+    Assert::AreEqual(1L, inventory.GetMisses() - static_cast<LONG>(installedproducts.size()));
+}
+
+void MsiProductInventoryUnitTests::testInventoryBenchmark()
+{
+    // 400 installed products, 30 product code checks
+    DVLib::MemoryMsiProductReader * reader = new DVLib::MemoryMsiProductReader();
+    std::vector<GUID> products;
+    for (int i = 0; i < 400; i++)
+    {
+        GUID product = DVLib::string2guid(DVLib::GenerateGUIDStringW());
+        reader->AddProduct(product, DVLib::string2guid(DVLib::GenerateGUIDStringW()), L"Product", L"1.0.0.0");
+        products.push_back(product);
+    }
+
+    const int checks = 30;
+    const int iterations = 100;
+
+    DWORD start = ::GetTickCount();
+    for (int n = 0; n < iterations; n++)
+    {
+        for (int i = 0; i < checks; i++)
+        {
+            // one enumeration and linear search for each check
+            std::vector<GUID> installed = reader->GetInstalledProducts();
+            bool found = false;
+            for each(const GUID& product in installed)
+            {
+                if (product == products[i * 10])
+                {
+                    found = true;
+                    break;
+                }
+            }
+            Assert::IsTrue(found);
+        }
+    }
+    DWORD direct = ::GetTickCount() - start;
+
+    DVLib::MsiProductInventory inventory((DVLib::MsiProductReaderPtr(reader)));
+    LONG enumerations = reader->GetEnumerations();
+    start = ::GetTickCount();
+    for (int n = 0; n < iterations; n++)
+    {
+        inventory.Invalidate();
+        for (int i = 0; i < checks; i++)
+        {
+            Assert::IsTrue(inventory.IsProductInstalled(products[i * 10]));
+        }
+    }
+    DWORD indexed = ::GetTickCount() - start;
+
+    std::wcout << std::endl << iterations << L" x " << checks << L" checks: direct " << direct << L" ms, " 
+        << L"inventory " << indexed << L" ms";
+    Assert::AreEqual(static_cast<LONG>(iterations), reader->GetEnumerations() - enumerations);
+}
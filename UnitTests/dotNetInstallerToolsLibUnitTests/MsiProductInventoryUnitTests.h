@@ -0,0 +1,17 @@
+#pragma once
+
+namespace DVLib
+{
+	namespace UnitTests 
+	{
+		TEST_CLASS(MsiProductInventoryUnitTests)
+		{
+			TEST_METHOD( testIsProductInstalled );
+			TEST_METHOD( testGetRelatedProducts );
+			TEST_METHOD( testGetProductProperty );
+			TEST_METHOD( testInvalidate );
+			TEST_METHOD( testSystemInventory );
+			TEST_METHOD( testInventoryBenchmark );
+		};
+	}
+}
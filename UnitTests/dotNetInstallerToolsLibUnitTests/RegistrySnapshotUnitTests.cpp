@@ -0,0 +1,188 @@
+#include "StdAfx.h"
+#include "RegistrySnapshotUnitTests.h"
+
+using namespace DVLib::UnitTests;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+void RegistrySnapshotUnitTests::testGetValues()
+{
+    std::wstring path = L"SOFTWARE\\DVLib\\" + DVLib::GenerateGUIDStringW();
+    DVLib::RegistryValues values;
+    Assert::IsTrue(! DVLib::RegistryGetValues(HKEY_CURRENT_USER, path, values));
+    DVLib::RegistryCreateKey(HKEY_CURRENT_USER, path);
+    Assert::IsTrue(DVLib::RegistryGetValues(HKEY_CURRENT_USER, path, values));
+    Assert::IsTrue(values.empty());
+    DVLib::RegistrySetStringValue(HKEY_CURRENT_USER, path, L"", L"default");
+    DVLib::RegistrySetStringValue(HKEY_CURRENT_USER, path, L"String", L"value");
+    DVLib::RegistrySetDWORDValue(HKEY_CURRENT_USER, path, L"DWORD", 42);
+    std::vector<std::wstring> multistring;
+    multistring.push_back(L"abc");
+    multistring.push_back(L"");
+    multistring.push_back(L"def");
+    DVLib::RegistrySetMultiStringValue(HKEY_CURRENT_USER, path, L"MultiString", multistring);
+    Assert::IsTrue(DVLib::RegistryGetValues(HKEY_CURRENT_USER, path, values));
+    Assert::AreEqual(static_cast<size_t>(4), values.size());
+    // names are lowercase
+    Assert::IsTrue(values.find(L"string") != values.end());
+    Assert::IsTrue(DVLib::RegistryValue2wstring(values[L""]) == L"default");
+    Assert::IsTrue(DVLib::RegistryValue2wstring(values[L"string"]) == L"value");
+    Assert::IsTrue(values[L"dword"].type == REG_DWORD);
+    Assert::IsTrue(DVLib::RegistryValue2multistring(values[L"multistring"]) == multistring);
+    DVLib::RegistryDeleteKey(HKEY_CURRENT_USER, L"SOFTWARE\\DVLib");
+}
+
+void RegistrySnapshotUnitTests::testSystemRegistry()
+{
+    std::wstring path = L"SOFTWARE\\DVLib\\" + DVLib::GenerateGUIDStringW();
+    DVLib::RegistrySetStringValue(HKEY_CURRENT_USER, path, L"String", L"value");
+    DVLib::RegistrySetDWORDValue(HKEY_CURRENT_USER, path, L"DWORD", 42);
+    DVLib::RegistrySnapshot snapshot;
+    // same results as direct reads
+    Assert::IsTrue(snapshot.KeyExists(HKEY_CURRENT_USER, path) == DVLib::RegistryKeyExists(HKEY_CURRENT_USER, path));
+    Assert::IsTrue(snapshot.ValueExists(HKEY_CURRENT_USER, path, L"String"));
+    Assert::IsTrue(! snapshot.ValueExists(HKEY_CURRENT_USER, path, L""));
+    Assert::IsTrue(snapshot.GetValueType(HKEY_CURRENT_USER, path, L"DWORD") == DVLib::RegistryGetValueType(HKEY_CURRENT_USER, path, L"DWORD"));
+    Assert::IsTrue(snapshot.GetStringValue(HKEY_CURRENT_USER, path, L"String") == DVLib::RegistryGetStringValue(HKEY_CURRENT_USER, path, L"String"));
+    Assert::IsTrue(snapshot.GetDWORDValue(HKEY_CURRENT_USER, path, L"DWORD") == DVLib::RegistryGetDWORDValue(HKEY_CURRENT_USER, path, L"DWORD"));
+    DVLib::RegistryDeleteKey(HKEY_CURRENT_USER, L"SOFTWARE\\DVLib");
+    Assert::IsTrue(! snapshot.KeyExists(HKEY_CURRENT_USER, path));
+}
+
+void RegistrySnapshotUnitTests::testMemoryRegistry()
+{
+    DVLib::MemoryRegistryReader * registry = new DVLib::MemoryRegistryReader();
+    DVLib::RegistrySnapshot snapshot((DVLib::RegistryReaderPtr(registry)));
+    Assert::IsTrue(! snapshot.KeyExists(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib"));
+    registry->SetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib\\Key", L"String", L"value");
+    registry->SetDWORDValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib\\Key", L"DWORD", 42);
+    std::vector<std::wstring> multistring;
+    multistring.push_back(L"abc");
+    multistring.push_back(L"def");
+    registry->SetMultiStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib\\Key", L"MultiString", multistring);
+    // parent keys are created
+    Assert::IsTrue(snapshot.KeyExists(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib"));
+    Assert::IsTrue(! snapshot.KeyExists(HKEY_CURRENT_USER, L"SOFTWARE\\DVLib"));
+    Assert::IsTrue(snapshot.KeyExists(HKEY_LOCAL_MACHINE, L"software\\dvlib\\key"));
+    Assert::IsTrue(snapshot.ValueExists(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib\\Key", L"string"));
+    Assert::IsTrue(! snapshot.ValueExists(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib\\Key", L""));
+    Assert::IsTrue(snapshot.GetValueType(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib\\Key", L"DWORD") == REG_DWORD);
+    Assert::IsTrue(snapshot.GetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib\\Key", L"String") == L"value");
+    Assert::IsTrue(snapshot.GetDWORDValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib\\Key", L"DWORD") == 42);
+    Assert::IsTrue(snapshot.GetMultiStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib\\Key", L"MultiString") == multistring);
+
+    // errors
+    try
+    {
+        snapshot.GetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib\\Key", L"DWORD");
+        throw "expected std::exception";
+    }
+    catch(std::exception& ex)
+    {
+        std::wcout << std::endl << L"Expected exception: " << DVLib::string2wstring(ex.what());
+    }
+
+    try
+    {
+        snapshot.GetDWORDValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib\\DoesntExist", L"DWORD");
+        throw "expected std::exception";
+    }
+    catch(std::exception& ex)
+    {
+        std::wcout << std::endl << L"Expected exception: " << DVLib::string2wstring(ex.what());
+    }
+
+    registry->DeleteKey(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib");
+    Assert::IsTrue(! snapshot.KeyExists(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib\\Key"));
+    Assert::IsTrue(snapshot.KeyExists(HKEY_LOCAL_MACHINE, L"SOFTWARE"));
+}
+
+void RegistrySnapshotUnitTests::testSnapshot()
+{
+    DVLib::MemoryRegistryReader * registry = new DVLib::MemoryRegistryReader();
+    registry->SetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib", L"String", L"value");
+    DVLib::RegistrySnapshot snapshot((DVLib::RegistryReaderPtr(registry)));
+    // outside of a snapshot every query reads the key
+    Assert::IsTrue(! snapshot.IsActive());
+    Assert::IsTrue(snapshot.KeyExists(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib"));
+    Assert::IsTrue(snapshot.ValueExists(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib", L"String"));
+    Assert::AreEqual(2L, registry->GetReads());
+    // within a snapshot a key is read once
+    {
+        DVLib::RegistrySnapshotScope scope(snapshot);
+        Assert::IsTrue(snapshot.IsActive());
+        Assert::IsTrue(snapshot.KeyExists(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib"));
+        Assert::IsTrue(snapshot.ValueExists(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib", L"String"));
+        Assert::IsTrue(snapshot.GetValueType(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib\\", L"String") == REG_SZ);
+        Assert::IsTrue(snapshot.GetStringValue(HKEY_LOCAL_MACHINE, L"software\\dvlib", L"String") == L"value");
+        // missing keys are remembered too
+        Assert::IsTrue(! snapshot.KeyExists(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib\\DoesntExist"));
+        Assert::IsTrue(! snapshot.ValueExists(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib\\DoesntExist", L"String"));
+        Assert::AreEqual(4L, registry->GetReads());
+        // changes are not seen until the snapshot ends
+        registry->SetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib", L"String", L"changed");
+        Assert::IsTrue(snapshot.GetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib", L"String") == L"value");
+        // nested
+        snapshot.Begin();
+        snapshot.End();
+        Assert::IsTrue(snapshot.IsActive());
+        Assert::AreEqual(4L, registry->GetReads());
+    }
+
+    Assert::IsTrue(! snapshot.IsActive());
+    Assert::IsTrue(snapshot.GetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib", L"String") == L"changed");
+    Assert::AreEqual(5L, registry->GetReads());
+}
+
+void RegistrySnapshotUnitTests::testWow64Views()
+{
+    DVLib::MemoryRegistryReader * registry = new DVLib::MemoryRegistryReader();
+    registry->SetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib", L"String", L"default");
+    registry->SetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib", L"String", L"64", KEY_WOW64_64KEY);
+    registry->SetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib", L"String", L"32", KEY_WOW64_32KEY);
+    DVLib::RegistrySnapshot snapshot((DVLib::RegistryReaderPtr(registry)));
+    DVLib::RegistrySnapshotScope scope(snapshot);
+    Assert::IsTrue(snapshot.GetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib", L"String", KEY_READ) == L"default");
+    Assert::IsTrue(snapshot.GetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib", L"String", KEY_READ | KEY_WOW64_64KEY) == L"64");
+    Assert::IsTrue(snapshot.GetStringValue(HKEY_LOCAL_MACHINE, L"SOFTWARE\\DVLib", L"String", KEY_WOW64_32KEY) == L"32");
+    Assert::AreEqual(3L, registry->GetReads());
+    Assert::IsTrue(! snapshot.KeyExists(HKEY_CURRENT_USER, L"SOFTWARE\\DVLib", KEY_WOW64_64KEY));
+}
+
+void RegistrySnapshotUnitTests::testSnapshotBenchmark()
+{
+    // 200 products with 10 checks on each uninstall key
+    DVLib::MemoryRegistryReader * registry = new DVLib::MemoryRegistryReader();
+    std::vector<std::wstring> keys;
+    for (int i = 0; i < 200; i++)
+    {
+        std::wstring key = L"SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Uninstall\\" + DVLib::GenerateGUIDStringW();
+        for (int j = 0; j < 10; j++)
+        {
+            registry->SetStringValue(HKEY_LOCAL_MACHINE, key, L"Value" + DVLib::towstring(j), DVLib::towstring(j));
+        }
+        keys.push_back(key);
+    }
+
+    DVLib::RegistrySnapshot snapshot((DVLib::RegistryReaderPtr(registry)));
+    for (int pass = 0; pass < 2; pass++)
+    {
+        DWORD start = ::GetTickCount();
+        LONG reads = registry->GetReads();
+        if (pass > 0) snapshot.Begin();
+        for each (const std::wstring& key in keys)
+        {
+            for (int j = 0; j < 10; j++)
+            {
+                std::wstring name = L"Value" + DVLib::towstring(j);
+                Assert::IsTrue(snapshot.KeyExists(HKEY_LOCAL_MACHINE, key));
+                Assert::IsTrue(snapshot.ValueExists(HKEY_LOCAL_MACHINE, key, name));
+                Assert::IsTrue(snapshot.GetValueType(HKEY_LOCAL_MACHINE, key, name) == REG_SZ);
+                Assert::IsTrue(snapshot.GetStringValue(HKEY_LOCAL_MACHINE, key, name) == DVLib::towstring(j));
+            }
+        }
+        if (pass > 0) snapshot.End();
+        std::wcout << std::endl << (pass > 0 ? L"Snapshot: " : L"Direct: ") 
+            << (registry->GetReads() - reads) << L" key(s) read in " << (::GetTickCount() - start) << L" ms";
+        Assert::AreEqual(pass > 0 ? 200L : 8000L, registry->GetReads() - reads);
+    }
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+namespace DVLib
+{
+	namespace UnitTests 
+	{
+		TEST_CLASS(RegistrySnapshotUnitTests)
+		{
+			TEST_METHOD( testGetValues );
+			TEST_METHOD( testSystemRegistry );
+			TEST_METHOD( testMemoryRegistry );
+			TEST_METHOD( testSnapshot );
+			TEST_METHOD( testWow64Views );
+			TEST_METHOD( testSnapshotBenchmark );
+		};
+	}
+}
@@ -508,4 +508,21 @@ void StringUtilUnitTests::testUTF82wstring()
         std::wstring output = DVLib::UTF8string2wstring(testData[i].testIn);
         Assert::IsTrue(output.length() == testData[i].len);
     }
+}
+
+void StringUtilUnitTests::testwstring2UTF8()
+{
+    LPCSTR testData[] = 
+    {
+        "",
+        "plain",
+        "\xe6\x97\xa5\xd1\x88",
+        "\xe6\x97\xa5\xd1\x88\xf0\x9d\x84\x9e"
+    };
+
+    for( unsigned int i = 0; i < ARRAYSIZE(testData); i++ )
+    {
+        std::string output = DVLib::wstring2UTF8string(DVLib::UTF8string2wstring(testData[i]));
+        Assert::IsTrue(output == testData[i]);
+    }
 }
\ No newline at end of file
@@ -22,6 +22,7 @@ namespace DVLib
 				TEST_METHOD( teststartswith );
 				TEST_METHOD( testendswith );
 				TEST_METHOD( testUTF82wstring );
+				TEST_METHOD( testwstring2UTF8 );
 			};
 		}
 	}
@@ -0,0 +1,86 @@
+#include "StdAfx.h"
+#include "VersionResourceUnitTests.h"
+
+using namespace DVLib::UnitTests;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+// a copy of a system image, the image itself may be open without read sharing
+static std::vector<char> ReadSystemImage(const std::wstring& name)
+{
+    std::wstring filename = DVLib::GetTemporaryFileNameW();
+    DVLib::FileCopy(DVLib::DirectoryCombine(DVLib::GetSystemDirectoryW(), name), filename);
+    std::vector<char> data = DVLib::FileReadToEnd(filename);
+    DVLib::FileDelete(filename);
+    return data;
+}
+
+void VersionResourceUnitTests::testParseImageVersionInfo()
+{
+    LPCWSTR images[] = { L"kernel32.dll", L"user32.dll", L"msi.dll", L"notepad.exe" };
+    for (int i = 0; i < ARRAYSIZE(images); i++)
+    {
+        std::vector<char> image = ReadSystemImage(images[i]);
+        DVLib::FileVersionInfo info = { 0 };
+        Assert::IsTrue(DVLib::ParseImageVersionInfo(reinterpret_cast<const BYTE *>(& * image.begin()), image.size(), info));
+        DVLib::FileVersionInfo expected = DVLib::GetFileVersionInfo(DVLib::DirectoryCombine(DVLib::GetSystemDirectoryW(), images[i]));
+        std::wcout << std::endl << images[i] << L": "
+            << HIWORD(info.fixed_info.dwFileVersionMS) << L"." << LOWORD(info.fixed_info.dwFileVersionMS) << L"."
+            << HIWORD(info.fixed_info.dwFileVersionLS) << L"." << LOWORD(info.fixed_info.dwFileVersionLS);
+        Assert::IsTrue(0 == memcmp(& info.fixed_info, & expected.fixed_info, sizeof(VS_FIXEDFILEINFO)));
+        Assert::IsTrue(info.translation_info.wLanguage == expected.translation_info.wLanguage);
+        Assert::IsTrue(info.translation_info.wCodePage == expected.translation_info.wCodePage);
+    }
+}
+
+void VersionResourceUnitTests::testParseMalformed()
+{
+    std::vector<char> image = ReadSystemImage(L"kernel32.dll");
+    const BYTE * data = reinterpret_cast<const BYTE *>(& * image.begin());
+    size_t offset = 0, length = 0;
+    Assert::IsTrue(DVLib::FindVersionResource(data, image.size(), offset, length));
+
+    // every truncated version resource is rejected without reading past its end
+    std::vector<BYTE> resource(data + offset, data + offset + length);
+    DVLib::FileVersionInfo info = { 0 };
+    Assert::IsTrue(DVLib::ParseVersionResource(& * resource.begin(), resource.size(), info));
+    for (size_t size = 0; size < 128; size++)
+    {
+        std::vector<BYTE> truncated(resource.begin(), resource.begin() + size);
+        Assert::IsTrue(! DVLib::ParseVersionResource(truncated.empty() ? NULL : & * truncated.begin(), truncated.size(), info));
+    }
+
+    // images without a resource section, or that aren't images
+    Assert::IsTrue(! DVLib::FindVersionResource(data, 0x40, offset, length));
+    std::vector<BYTE> text(1024, 'A');
+    Assert::IsTrue(! DVLib::ParseImageVersionInfo(& * text.begin(), text.size(), info));
+    // a corrupt resource directory
+    std::vector<BYTE> corrupt(data, data + image.size());
+    for (size_t i = offset > 512 ? offset - 512 : 0; i < offset; i++)
+        corrupt[i] = 0xFF;
+    DVLib::ParseImageVersionInfo(& * corrupt.begin(), corrupt.size(), info);
+}
+
+void VersionResourceUnitTests::testParseBenchmark()
+{
+    const int count = 1000;
+    std::wstring filename = DVLib::DirectoryCombine(DVLib::GetSystemDirectoryW(), L"kernel32.dll");
+    std::vector<char> image = ReadSystemImage(L"kernel32.dll");
+    DVLib::FileVersionInfo info = { 0 };
+
+    DWORD start = ::GetTickCount();
+    for (int i = 0; i < count; i++)
+    {
+        info = DVLib::GetFileVersionInfo(filename);
+    }
+    DWORD api_ticks = ::GetTickCount() - start;
+
+    start = ::GetTickCount();
+    for (int i = 0; i < count; i++)
+    {
+        Assert::IsTrue(DVLib::ParseImageVersionInfo(reinterpret_cast<const BYTE *>(& * image.begin()), image.size(), info));
+    }
+    DWORD parse_ticks = ::GetTickCount() - start;
+
+    std::wcout << std::endl << L"Read version of " << filename << L" " << count << L" time(s): "
+        << api_ticks << L" ms from the file, " << parse_ticks << L" ms parsing an image in memory";
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+namespace DVLib
+{
+	namespace UnitTests 
+	{
+		TEST_CLASS(VersionResourceUnitTests)
+		{
+			TEST_METHOD( testParseImageVersionInfo );
+			TEST_METHOD( testParseMalformed );
+			TEST_METHOD( testParseBenchmark );
+		};
+	}
+}
@@ -0,0 +1,231 @@
+#include "StdAfx.h"
+#include "VersionUnitTests.h"
+
+using namespace DVLib::UnitTests;
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+void VersionUnitTests::testParse()
+{
+    struct TestData
+    {
+        LPCWSTR version_s;
+        bool packed;
+        LPCWSTR normalized;
+    };
+
+    TestData testdata[] = 
+    {
+        { L"", true, L"0.0.0.0" },
+        { L"v", true, L"0.0.0.0" },
+        { L"1", true, L"1.0.0.0" },
+        { L"V0.1", true, L"0.1.0.0" },
+        { L"01.002.0003", true, L"1.2.3.0" },
+        { L"1.2.3.4", true, L"1.2.3.4" },
+        { L"10.0.19041.1", true, L"10.0.19041.1" },
+        { L"65535.65535.65535.65535", true, L"65535.65535.65535.65535" },
+        { L"1.2.3+build.5", true, L"1.2.3.0" },
+        { L"1.65536", false, L"1.65536" },
+        { L"1.2.3.4.5", false, L"1.2.3.4.5" },
+        { L"4294967295", false, L"4294967295" },
+        { L"1.2.3-beta", false, L"1.2.3-beta" },
+        { L"v1.2.3-rc.1+x86", false, L"1.2.3-rc.1" },
+        { L"1-0.3.7", false, L"1-0.3.7" },
+        { L"1.0.0-x-y-z.--", false, L"1.0.0-x-y-z.--" },
+    };
+
+    for (int i = 0; i < ARRAYSIZE(testdata); i++)
+    {
+        DVLib::Version version(testdata[i].version_s);
+        std::wcout << std::endl << testdata[i].version_s << L" => " << version.ToString()
+            << (version.IsPacked() ? L" (packed)" : L"");
+        Assert::IsTrue(version.IsPacked() == testdata[i].packed);
+        Assert::IsTrue(version.ToString() == testdata[i].normalized);
+    }
+
+    DVLib::Version version(L"1.2.3.4");
+    Assert::IsTrue(version.GetPacked() == 0x0001000200030004ULL);
+    Assert::IsTrue(version.GetPart(3) == 4);
+    Assert::IsTrue(version.GetPart(4) == 0);
+}
+
+void VersionUnitTests::testParseInvalid()
+{
+    LPCWSTR testdata[] = 
+    {
+        L".", L"1.", L".1", L"1..2", L"1.2.", L"vv1", L" 1", L"1 ", L"-1", L"1.-2", L"1.a", L"a.1",
+        L"1.2.3-", L"1.2.3+", L"1.2.3-beta+", L"1.2.3-.beta", L"1.2.3-beta.", L"1.2.3-be..ta",
+        L"1.2.3-be ta", L"1.2.3beta", L"1.2.3_4", L"4294967296", L"1.99999999999",
+    };
+
+    for (int i = 0; i < ARRAYSIZE(testdata); i++)
+    {
+        DVLib::Version version(L"9.9");
+        Assert::IsTrue(! DVLib::Version::TryParse(testdata[i], version));
+        Assert::IsTrue(version.ToString() == L"9.9.0.0");
+
+        try
+        {
+            DVLib::Version invalid(testdata[i]);
+            throw "expected std::exception";
+        }
+        catch(std::exception& ex)
+        {
+            std::cout << std::endl << ex.what();
+        }
+    }
+}
+
+void VersionUnitTests::testCompare()
+{
+    struct TestData
+    {
+        LPCWSTR l;
+        LPCWSTR r;
+        int cmp;
+    };
+
+    TestData testdata[] = 
+    {
+        // packed and unpacked
+        { L"1.65536", L"1.65535", 1 },
+        { L"1.65536", L"2", -1 },
+        { L"1.2.3.4.5", L"1.2.3.4", 1 },
+        { L"1.2.3.4.0", L"1.2.3.4", 0 },
+        { L"1.2.3.4.0.0.1", L"1.2.3.4.0.0", 1 },
+        { L"10.0.19041.1", L"10.0.19041.1.1", -1 },
+        { L"10.0.22000", L"10.0.19041.1", 1 },
+        // pre-release versions precede the release
+        { L"1.2.3-beta", L"1.2.3", -1 },
+        { L"1.2.3-beta", L"1.2.2", 1 },
+        { L"1.2.3-beta", L"1.2.2.9", 1 },
+        { L"1.2.3-alpha", L"1.2.3-beta", -1 },
+        { L"1.2.3-beta.2", L"1.2.3-beta.10", -1 },
+        { L"1.2.3-beta.02", L"1.2.3-beta.2", 0 },
+        { L"1.2.3-1", L"1.2.3-alpha", -1 },
+        { L"1.2.3-rc.1", L"1.2.3-rc.1.1", -1 },
+        { L"1.2.3-RC", L"1.2.3-rc", -1 },
+        { L"1.2.3-beta", L"1.2.3.0-beta", 0 },
+        { L"1.0.0-alpha", L"1.0.0-alpha.1", -1 },
+        { L"1.0.0-alpha.beta", L"1.0.0-beta", -1 },
+        { L"1.0.0-beta.11", L"1.0.0-rc.1", -1 },
+        // build metadata is ignored
+        { L"1.2.3+build.5", L"1.2.3", 0 },
+        { L"1.2.3+5", L"1.2.3+6", 0 },
+        { L"1.2.3-beta+5", L"1.2.3-beta", 0 },
+        { L"v1.2.3-beta+5", L"V1.2.3-beta+6", 0 },
+    };
+
+    for (int i = 0; i < ARRAYSIZE(testdata); i++)
+    {
+        DVLib::Version l(testdata[i].l);
+        DVLib::Version r(testdata[i].r);
+        int cmp = l.Compare(r);
+        std::wcout << std::endl << testdata[i].l << L" vs. " << testdata[i].r << L" => " << cmp;
+        Assert::IsTrue(cmp == testdata[i].cmp);
+        Assert::IsTrue(r.Compare(l) == - testdata[i].cmp);
+        Assert::IsTrue(DVLib::CompareVersion(testdata[i].l, testdata[i].r) == testdata[i].cmp);
+    }
+}
+
+// every pair of versions accepted by wstring2fileversion compares as it did
+void VersionUnitTests::testCompareFileVersion()
+{
+    LPCWSTR values[] = { L"0", L"1", L"10", L"65535", L"65536", L"2147483647" };
+    std::vector<std::wstring> versions;
+    std::vector<std::wstring> parts(1, L"");
+    for (int length = 1; length <= 4; length++)
+    {
+        std::vector<std::wstring> longer;
+        for each (const std::wstring& part in parts)
+        {
+            for (int i = 0; i < ARRAYSIZE(values); i++)
+            {
+                std::wstring version = part.empty() ? values[i] : part + L"." + values[i];
+                longer.push_back(version);
+                versions.push_back((versions.size() % 3 == 0 ? L"v" : L"") + version);
+            }
+        }
+
+        parts = longer;
+    }
+
+    versions.push_back(L"");
+    versions.push_back(L"v");
+
+    std::vector<DVLib::FileVersion> fileversions;
+    std::vector<DVLib::Version> parsed;
+    for each (const std::wstring& version in versions)
+    {
+        fileversions.push_back(DVLib::wstring2fileversion(version));
+        parsed.push_back(DVLib::Version(version));
+    }
+
+    for (size_t l = 0; l < versions.size(); l++)
+    {
+        for (size_t r = 0; r < versions.size(); r++)
+        {
+            int expected = DVLib::CompareVersion(fileversions[l], fileversions[r]);
+            int cmp = parsed[l].Compare(parsed[r]);
+            if (cmp != expected)
+            {
+                std::wcout << std::endl << versions[l] << L" vs. " << versions[r] << L" => " << cmp << L", expected " << expected;
+            }
+
+            Assert::IsTrue(cmp == expected);
+        }
+    }
+
+    std::wcout << std::endl << L"Compared " << versions.size() * versions.size() << L" pair(s) of versions";
+}
+
+void VersionUnitTests::testFixedFileInfo()
+{
+    VS_FIXEDFILEINFO info = { 0 };
+    info.dwFileVersionMS = MAKELONG(2, 1);
+    info.dwFileVersionLS = MAKELONG(4, 3);
+    DVLib::Version version(info);
+    Assert::IsTrue(version.ToString() == L"1.2.3.4");
+    Assert::IsTrue(version == DVLib::Version(L"1.2.3.4"));
+    Assert::IsTrue(DVLib::Version(L"1.2.3.3.9") < version);
+    Assert::IsTrue(version < DVLib::Version(L"1.2.3.5-beta"));
+}
+
+void VersionUnitTests::testCompareBenchmark()
+{
+    const int count = 100000;
+    std::wstring l = L"10.0.19041.1";
+    std::wstring r = L"10.0.19041.2";
+
+    DWORD start = ::GetTickCount();
+    int total = 0;
+    for (int i = 0; i < count; i++)
+    {
+        total += DVLib::CompareVersion(DVLib::wstring2fileversion(l), DVLib::wstring2fileversion(r));
+    }
+    DWORD string_ticks = ::GetTickCount() - start;
+    Assert::IsTrue(total == -count);
+
+    DVLib::Version l_v(l);
+    DVLib::Version r_v(r);
+    DVLib::Version p_v(L"10.0.19041.1-beta.2");
+    start = ::GetTickCount();
+    total = 0;
+    for (int i = 0; i < count; i++)
+    {
+        total += l_v.Compare(r_v);
+    }
+    DWORD packed_ticks = ::GetTickCount() - start;
+    Assert::IsTrue(total == -count);
+
+    start = ::GetTickCount();
+    total = 0;
+    for (int i = 0; i < count; i++)
+    {
+        total += p_v.Compare(l_v);
+    }
+    DWORD parts_ticks = ::GetTickCount() - start;
+    Assert::IsTrue(total == -count);
+
+    std::wcout << std::endl << count << L" comparison(s): " << string_ticks << L" ms parsing strings, "
+        << packed_ticks << L" ms packed, " << parts_ticks << L" ms part by part";
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+namespace DVLib
+{
+	namespace UnitTests 
+	{
+		TEST_CLASS(VersionUnitTests)
+		{
+			TEST_METHOD( testParse );
+			TEST_METHOD( testParseInvalid );
+			TEST_METHOD( testCompare );
+			TEST_METHOD( testCompareFileVersion );
+			TEST_METHOD( testFixedFileInfo );
+			TEST_METHOD( testCompareBenchmark );
+		};
+	}
+}
@@ -144,6 +144,7 @@ void CComponentsList::Exec(const ComponentPtr& component)
             return;
 
         component->Wait();
+        InstallerSession::Instance->InvalidateMachineState();
 
         LOG(L"*** Component '" << component->id << L"' (" << component->GetDisplayName() << L"): SUCCESS");
 
@@ -152,6 +153,8 @@ void CComponentsList::Exec(const ComponentPtr& component)
     }
     catch(std::exception& ex)
     {
+        InstallerSession::Instance->InvalidateMachineState();
+
         LOG(L"*** Component '" << component->id << L"' (" << component->GetDisplayName() << L"): ERROR - " 
             << DVLib::string2wstring(ex.what()));
 
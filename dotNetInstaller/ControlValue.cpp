@@ -12,6 +12,15 @@ ControlValue::~ControlValue()
 
 }
 
+void ControlValue::OnValueChanged(CWnd * control)
+{
+    CWnd * parent = control->GetParent();
+    if (parent != NULL)
+    {
+        parent->SendMessage(WM_USER_CONTROLVALUECHANGED, 0, reinterpret_cast<LPARAM>(this));
+    }
+}
+
 ControlValueBrowse::ControlValueBrowse(const ControlBrowse& control)
 : ControlValue(control)
 {
@@ -23,12 +32,22 @@ std::wstring ControlValueBrowse::GetValue() const
     return DVLib::StripPathTerminator((LPCTSTR) CBrowseCtrl::GetPathName());
 }
 
+BEGIN_MESSAGE_MAP(ControlValueEdit, CEdit)
+    ON_CONTROL_REFLECT_EX(EN_CHANGE, OnChange)
+END_MESSAGE_MAP()
+
 ControlValueEdit::ControlValueEdit(const ControlEdit& control)
 : ControlValue(control)
 {
 
 }
 
+BOOL ControlValueEdit::OnChange()
+{
+    OnValueChanged(this);
+    return FALSE;
+}
+
 std::wstring ControlValueEdit::GetValue() const 
 {
     CString value;
@@ -36,6 +55,10 @@ std::wstring ControlValueEdit::GetValue() const
     return std::wstring((LPCTSTR) value);
 }
 
+BEGIN_MESSAGE_MAP(ControlValueCheckBox, CButton)
+    ON_CONTROL_REFLECT_EX(BN_CLICKED, OnClicked)
+END_MESSAGE_MAP()
+
 ControlValueCheckBox::ControlValueCheckBox(const ControlCheckBox& checkbox)
 : ControlValue(checkbox)
 , checked_value(checkbox.checked_value)
@@ -44,6 +67,12 @@ ControlValueCheckBox::ControlValueCheckBox(const ControlCheckBox& checkbox)
 
 }
 
+BOOL ControlValueCheckBox::OnClicked()
+{
+    OnValueChanged(this);
+    return FALSE;
+}
+
 std::wstring ControlValueCheckBox::GetValue() const 
 {
     return CButton::GetCheck() ? checked_value : unchecked_value;
@@ -1,6 +1,9 @@
 #pragma once
 #include "BrowseCtrl.h"
 
+// sent to the parent window when the value of a control changes, LPARAM is the ControlValue
+#define WM_USER_CONTROLVALUECHANGED (WM_USER+2)
+
 class ControlValue
 {
 private:
@@ -12,6 +15,9 @@ public:
 	virtual std::wstring GetValue() const = 0;
 	ControlValue(const Control& parent);
 	virtual ~ControlValue();
+protected:
+	// notify the parent window that the value has changed
+	void OnValueChanged(CWnd * control);
 };
 
 class ControlValueBrowse : public CBrowseCtrl, public ControlValue
@@ -26,6 +32,9 @@ class ControlValueEdit : public CEdit, public ControlValue
 public:
 	ControlValueEdit(const ControlEdit& parent);
 	std::wstring GetValue() const;
+protected:
+	afx_msg BOOL OnChange();
+	DECLARE_MESSAGE_MAP()
 };
 
 class ControlValueCheckBox : public CButton, public ControlValue
@@ -36,6 +45,9 @@ private:
 public:
 	ControlValueCheckBox(const ControlCheckBox& parent);
 	std::wstring GetValue() const;
+protected:
+	afx_msg BOOL OnClicked();
+	DECLARE_MESSAGE_MAP()
 };
 
 class ControlValueLicense : public CButton, public ControlValue
@@ -0,0 +1,16 @@
+#include "StdAfx.h"
+#include "WindowTextCallback.h"
+
+WindowTextCallback::WindowTextCallback(CWnd * wnd)
+: m_wnd(wnd)
+{
+
+}
+
+void WindowTextCallback::OnAttributeChanged(const std::wstring& value)
+{
+    if (m_wnd->GetSafeHwnd() != NULL)
+    {
+        m_wnd->SetWindowText(value.c_str());
+    }
+}
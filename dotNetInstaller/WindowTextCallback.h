@@ -0,0 +1,11 @@
+#pragma once
+
+// re-renders the text of a window when the attribute it displays changes
+class WindowTextCallback : public IAttributeCallback
+{
+private:
+	CWnd * m_wnd;
+public:
+	WindowTextCallback(CWnd * wnd);
+	void OnAttributeChanged(const std::wstring& value);
+};
@@ -30,6 +30,7 @@ BOOL CdotNetInstallerApp::InitInstance()
         reset(InstallerLog::Instance, new InstallerLog());
         reset(InstallerSession::Instance, new InstallerSession());
         reset(InstallUILevelSetting::Instance, new InstallUILevelSetting());
+        reset(WorkerPool::Instance, new WorkerPool());
 
         ParseCommandLine(* get(InstallerCommandLineInfo::Instance));
 
@@ -53,6 +54,7 @@ BOOL CdotNetInstallerApp::InitInstance()
         // propagate command line arguments during execution
         InstallerSession::Instance->AdditionalCmdLineArgs = InstallerCommandLineInfo::Instance->componentCmdArgs;
         InstallerSession::Instance->AdditionalControlArgs = InstallerCommandLineInfo::Instance->controlCmdArgs;
+        InstallerSession::Instance->InvalidateVariables();
 
         if (InstallerCommandLineInfo::Instance->DisplayHelp())
         {
@@ -99,6 +101,7 @@ BOOL CdotNetInstallerApp::InitInstance()
 int CdotNetInstallerApp::ExitInstance() 
 {
     TRYLOG(L"dotNetInstaller finished, return code: " << m_rc << DVLib::FormatMessage(L" (0x%x)", m_rc));
+    reset(WorkerPool::Instance);
     reset(InstallerCommandLineInfo::Instance);
     reset(InstallerLauncher::Instance);
     reset(InstallerLog::Instance);
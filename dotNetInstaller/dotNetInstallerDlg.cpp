@@ -36,6 +36,7 @@ BEGIN_MESSAGE_MAP(CdotNetInstallerDlg, CDialog)
     ON_BN_CLICKED(IDC_INSTALL, OnBnClickedInstall)
     ON_WM_DESTROY()
     ON_BN_CLICKED(IDCANCEL, OnBnClickedCancel)
+    ON_MESSAGE(WM_USER_CONTROLVALUECHANGED, OnControlValueChanged)
 END_MESSAGE_MAP()
 
 bool CdotNetInstallerDlg::Run()
@@ -82,12 +83,12 @@ BOOL CdotNetInstallerDlg::OnInitDialog()
         switch(InstallerSession::Instance->sequence)
         {
         case SequenceInstall:
-            m_btnInstall.SetWindowText(p_configuration->install_caption.GetValue().c_str());
-            m_lblMessage.SetWindowText(p_configuration->dialog_message.GetValue().c_str());
+            m_btnInstall.SetWindowText(Bind(p_configuration->install_caption, & m_btnInstall).c_str());
+            m_lblMessage.SetWindowText(Bind(p_configuration->dialog_message, & m_lblMessage).c_str());
             break;
         case SequenceUninstall:
-            m_btnInstall.SetWindowText(p_configuration->uninstall_caption.GetValue().c_str());
-            m_lblMessage.SetWindowText(p_configuration->dialog_message_uninstall.GetValue().c_str());
+            m_btnInstall.SetWindowText(Bind(p_configuration->uninstall_caption, & m_btnInstall).c_str());
+            m_lblMessage.SetWindowText(Bind(p_configuration->dialog_message_uninstall, & m_lblMessage).c_str());
             break;
         }
 
@@ -238,7 +239,7 @@ void CdotNetInstallerDlg::OnBnClickedInstall()
         Components components = p_configuration->GetSupportedComponents(
             InstallerSession::Instance->lcidtype, InstallerSession::Instance->sequence);
 
-        int rc = components.Exec(this);
+        int rc = ExecComponents(components, this);
         InstallerUI::AfterInstall(rc);
     }
     catch(std::exception& ex)
@@ -285,6 +286,8 @@ void CdotNetInstallerDlg::OnDestroy()
 
     CDialog::OnDestroy();
 
+    m_bindings.Clear();
+
     // destroy custom dialog controls
     for each(CWnd * control in m_custom_controls)
     {
@@ -371,13 +374,28 @@ bool CdotNetInstallerDlg::RunDownloadConfiguration(const DownloadDialogPtr& p_Co
     return downloaddlg.IsDownloadCompleted();
 }
 
+bool CdotNetInstallerDlg::IsComponentExecModal(const Components& components) const
+{
+    if (! InstallUILevelSetting::Instance->IsAnyUI())
+        return false;
+
+    InstallConfiguration * p_configuration = reinterpret_cast<InstallConfiguration *>(get(m_configuration));
+    if (p_configuration == NULL || ! p_configuration->show_progress_dialog)
+        return false;
+
+    for each(const ComponentPtr& component in components)
+    {
+        if (component->checked && component->show_progress_dialog)
+            return true;
+    }
+
+    return false;
+}
+
 // IExecuteCallback
 bool CdotNetInstallerDlg::OnComponentExecBegin(const ComponentPtr& component)
 {
-    bool rc = InstallerUI::ComponentExecBegin(component);
-    reset(m_pComponentDlg, new InstallComponentDlg(this));
-    m_pComponentDlg->LoadComponent(m_configuration, component);
-    return rc;
+    return InstallerUI::ComponentExecBegin(component);
 }
 
 bool CdotNetInstallerDlg::OnComponentExecWait(const ComponentPtr& component)
@@ -389,6 +407,9 @@ bool CdotNetInstallerDlg::OnComponentExecWait(const ComponentPtr& component)
 
         if (p_configuration->show_progress_dialog && component->show_progress_dialog)
         {
+            // components execute one at a time while progress dialogs are shown, see IsComponentExecModal
+            reset(m_pComponentDlg, new InstallComponentDlg(this));
+            m_pComponentDlg->LoadComponent(m_configuration, component);
             m_pComponentDlg->DoModal();
             LOG(L"--- Component '" << component->id << L" (" << component->GetDisplayName() << L"): DIALOG CLOSED");
         }
@@ -410,7 +431,7 @@ bool CdotNetInstallerDlg::OnComponentExecError(const ComponentPtr& component, st
 void CdotNetInstallerDlg::AddControl(const ControlLabel& label)
 {
     CStatic * p_static = new CStatic();
-    p_static->Create(label.text.GetValue().c_str(), WS_CHILD | WS_VISIBLE | WS_TABSTOP | SS_NOPREFIX, label.position.ToRect(), this);
+    p_static->Create(Bind(label.text, p_static).c_str(), WS_CHILD | WS_VISIBLE | WS_TABSTOP | SS_NOPREFIX, label.position.ToRect(), this);
     p_static->EnableWindow(label.IsEnabled());
     p_static->SetFont(CreateFont(label));
     m_custom_controls.push_back(p_static);
@@ -429,7 +450,7 @@ CFont * CdotNetInstallerDlg::CreateFont(const ControlText& text)
 void CdotNetInstallerDlg::AddControl(const ControlCheckBox& checkbox)
 {
     ControlValueCheckBox * p_checkbox = new ControlValueCheckBox(checkbox);
-    p_checkbox->Create(checkbox.text.GetValue().c_str(), WS_CHILD | WS_VISIBLE | WS_TABSTOP | BS_AUTOCHECKBOX, checkbox.position.ToRect(), this, 0);
+    p_checkbox->Create(Bind(checkbox.text, p_checkbox).c_str(), WS_CHILD | WS_VISIBLE | WS_TABSTOP | BS_AUTOCHECKBOX, checkbox.position.ToRect(), this, 0);
     p_checkbox->EnableWindow(checkbox.IsEnabled());
     p_checkbox->SetFont(CreateFont(checkbox));
     p_checkbox->SetCheck(checkbox.checked);
@@ -506,7 +527,7 @@ void CdotNetInstallerDlg::AddControl(const ControlLicense& license)
     CHyperlinkStatic * p_link = new CHyperlinkStatic();
     CRect link_rect = license.position.ToRect();
     link_rect.left += 20;
-    p_link->Create(license.text.GetValue().c_str(), WS_CHILD | WS_VISIBLE | WS_TABSTOP | SS_NOPREFIX, link_rect, this, 0);
+    p_link->Create(Bind(license.text, p_link).c_str(), WS_CHILD | WS_VISIBLE | WS_TABSTOP | SS_NOPREFIX, link_rect, this, 0);
     p_link->SetHyperlink(license.license_file);
     p_link->SetFont(CreateFont(license));
     m_custom_controls.push_back(p_link);
@@ -515,7 +536,7 @@ void CdotNetInstallerDlg::AddControl(const ControlLicense& license)
 void CdotNetInstallerDlg::AddControl(const ControlHyperlink& hyperlink)
 {
     CHyperlinkStatic * p_link = new CHyperlinkStatic();
-    p_link->Create(hyperlink.text.GetValue().c_str(), WS_CHILD | WS_VISIBLE | WS_TABSTOP | SS_NOPREFIX, hyperlink.position.ToRect(), this, 0);
+    p_link->Create(Bind(hyperlink.text, p_link).c_str(), WS_CHILD | WS_VISIBLE | WS_TABSTOP | SS_NOPREFIX, hyperlink.position.ToRect(), this, 0);
     p_link->SetHyperlink(hyperlink.uri);
     p_link->SetFont(CreateFont(hyperlink));
     m_custom_controls.push_back(p_link);
@@ -532,6 +553,40 @@ void CdotNetInstallerDlg::AddControl(const ControlImage& image)
     m_custom_controls.push_back(p_image);
 }
 
+std::wstring CdotNetInstallerDlg::Bind(const XmlAttribute& attribute, CWnd * wnd)
+{
+    return m_bindings.Bind(attribute, AttributeCallbackPtr(new WindowTextCallback(wnd)));
+}
+
+LRESULT CdotNetInstallerDlg::OnControlValueChanged(WPARAM, LPARAM lParam)
+{
+    ControlValue * p_control_value = reinterpret_cast<ControlValue *>(lParam);
+    std::map<std::wstring, ControlValue *>::const_iterator iter;
+    for(iter = m_custom_control_values.begin(); iter != m_custom_control_values.end(); ++iter)
+    {
+        if (iter->second != p_control_value)
+            continue;
+
+        if (! p_control_value->IsVisible() || ! p_control_value->IsEnabled())
+            break;
+
+        std::wstring value = p_control_value->GetValue();
+        std::wstring& current_value = InstallerSession::Instance->AdditionalControlArgs[iter->first];
+        if (current_value == value)
+            break;
+
+        current_value = value;
+        InstallerSession::Instance->InvalidateVariables();
+
+        // re-render only the captions and components that display this value
+        m_bindings.OnVariableChanged(ExpansionTemplate::token_user, iter->first);
+        InstallerUI::OnVariableChanged(ExpansionTemplate::token_user, iter->first);
+        break;
+    }
+
+    return 0;
+}
+
 void CdotNetInstallerDlg::SetControlValues()
 {
     std::map<std::wstring, ControlValue *>::const_iterator iter;
@@ -554,6 +609,9 @@ void CdotNetInstallerDlg::SetControlValues()
             LOG(L"--- Skipping user-defined value '" << iter->first << L"', control hidden");
         }
     }
+
+    // user-defined values have changed
+    InstallerSession::Instance->InvalidateVariables();
 }
 
 DWORD CdotNetInstallerDlg::SetDefaultButton(const DWORD id) 
@@ -4,6 +4,7 @@
 #include "ComponentsList.h"
 #include "InstallComponentDlg.h"
 #include "ControlValue.h"
+#include "WindowTextCallback.h"
 #include "resource.h"
 
 // finestra di dialogo CdotNetInstallerDlg
@@ -44,8 +45,10 @@ public:
 	afx_msg void OnDestroy();
 	afx_msg void OnBnClickedCancel();
 	afx_msg void OnBnClickedSkip();
+	afx_msg LRESULT OnControlValueChanged(WPARAM wParam, LPARAM lParam);
 	// IExecuteCallback
 	void OnExecBegin();
+	bool IsComponentExecModal(const Components& components) const;
 	bool OnComponentExecBegin(const ComponentPtr& component);
 	bool OnComponentExecWait(const ComponentPtr& component);
 	bool OnComponentExecSuccess(const ComponentPtr& component);
@@ -54,6 +57,9 @@ private:
 	std::map<std::wstring, ControlValue *> m_custom_control_values; 
 	std::list<CFont *> m_custom_fonts;
 	std::list<CWnd *> m_custom_controls;
+	// captions that display attributes with user-defined variables
+	AttributeBindings m_bindings;
+	std::wstring Bind(const XmlAttribute& attribute, CWnd * wnd);
 	CFont * CreateFont(const ControlText&);
 	void AddControl(const ControlLabel&);
 	void AddControl(const ControlCheckBox&);
@@ -0,0 +1,51 @@
+#include "StdAfx.h"
+#include "AttributeBindings.h"
+
+std::wstring AttributeBindings::Bind(const XmlAttribute& attribute, const AttributeCallbackPtr& callback)
+{
+    Binding binding;
+    binding.attribute = & attribute;
+    binding.callback = callback;
+    binding.value = attribute.GetValue();
+    m_bindings.push_back(binding);
+    return binding.value;
+}
+
+int AttributeBindings::OnVariableChanged(ExpansionTemplate::token_type type, const std::wstring& name)
+{
+    int count = 0;
+    for (size_t i = 0; i < m_bindings.size(); i++)
+    {
+        if (m_bindings[i].attribute->DependsOn(type, name) && Refresh(m_bindings[i]))
+            count++;
+    }
+
+    return count;
+}
+
+int AttributeBindings::Refresh()
+{
+    int count = 0;
+    for (size_t i = 0; i < m_bindings.size(); i++)
+    {
+        if (Refresh(m_bindings[i]))
+            count++;
+    }
+
+    return count;
+}
+
+bool AttributeBindings::Refresh(Binding& binding)
+{
+    std::wstring value = binding.attribute->GetValue();
+    if (value == binding.value)
+        return false;
+
+    binding.value = value;
+    if (get(binding.callback) != NULL)
+    {
+        binding.callback->OnAttributeChanged(value);
+    }
+
+    return true;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "XmlAttribute.h"
+#include "AttributeCallback.h"
+
+// attributes displayed by the UI, re-expanded and re-rendered only when a variable they depend on changes
+class AttributeBindings
+{
+private:
+	struct Binding
+	{
+		const XmlAttribute * attribute;
+		AttributeCallbackPtr callback;
+		// last rendered value
+		std::wstring value;
+	};
+	std::vector<Binding> m_bindings;
+public:
+	// bind an attribute to a UI element, the attribute must outlive the binding, returns the current value
+	std::wstring Bind(const XmlAttribute& attribute, const AttributeCallbackPtr& callback);
+	// a variable has changed, re-renders dependent attributes whose value has changed, returns their number
+	int OnVariableChanged(ExpansionTemplate::token_type type, const std::wstring& name);
+	// re-renders all attributes whose value has changed, returns their number
+	int Refresh();
+	void Clear() { m_bindings.clear(); }
+	size_t size() const { return m_bindings.size(); }
+private:
+	bool Refresh(Binding& binding);
+};
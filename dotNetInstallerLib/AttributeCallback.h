@@ -0,0 +1,11 @@
+#pragma once
+
+class IAttributeCallback
+{
+public:
+	// the expanded value of a bound attribute has changed, re-render it
+	virtual void OnAttributeChanged(const std::wstring& value) = 0;
+	virtual ~IAttributeCallback() { }
+};
+
+typedef shared_any<IAttributeCallback *, close_delete> AttributeCallbackPtr;
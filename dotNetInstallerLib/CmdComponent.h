@@ -1,6 +1,6 @@
 #pragma once
 #include "ProcessComponent.h"
-#include <tinyxml2.h>
+#include "ConfigElement.h"
 
 class CmdComponent : public ProcessComponent
 {
@@ -24,7 +24,7 @@ public:
 	XmlAttribute returncodes_success;
 	XmlAttribute returncodes_reboot;
 	void Exec();
-	void Load(tinyxml2::XMLElement * node);
+	void Load(const ConfigElement * node);
 	void Wait(DWORD tt = INFINITE);
 	bool IsRebootRequired() const;
 private:
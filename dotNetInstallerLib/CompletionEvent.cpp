@@ -0,0 +1,45 @@
+#include "StdAfx.h"
+#include "CompletionEvent.h"
+
+CompletionEvent::CompletionEvent()
+: m_event(::CreateEvent(NULL, TRUE, TRUE, NULL))
+{
+    CHECK_WIN32_BOOL(get(m_event) != NULL,
+        L"CreateEvent");
+}
+
+void CompletionEvent::Reset()
+{
+    CHECK_WIN32_BOOL(::ResetEvent(get(m_event)),
+        L"ResetEvent");
+}
+
+void CompletionEvent::Signal()
+{
+    CHECK_WIN32_BOOL(::SetEvent(get(m_event)),
+        L"SetEvent");
+}
+
+bool CompletionEvent::Wait(DWORD dwTimeout) const
+{
+    DWORD dwWait = ::WaitForSingleObject(get(m_event), dwTimeout);
+    CHECK_WIN32_BOOL(dwWait != WAIT_FAILED,
+        L"WaitForSingleObject");
+    return (dwWait == WAIT_OBJECT_0);
+}
+
+size_t CompletionEvent::WaitForAny(const std::vector<HANDLE>& handles, DWORD dwTimeout)
+{
+    CHECK_BOOL(! handles.empty() && handles.size() <= MAXIMUM_WAIT_OBJECTS,
+        L"Invalid number of handles: " << handles.size());
+
+    DWORD dwWait = ::WaitForMultipleObjects(handles.size(), & * handles.begin(), FALSE, dwTimeout);
+    CHECK_WIN32_BOOL(dwWait != WAIT_FAILED,
+        L"WaitForMultipleObjects");
+    CHECK_BOOL(dwWait != WAIT_TIMEOUT,
+        L"Timeout waiting for completion");
+    CHECK_BOOL(dwWait >= WAIT_OBJECT_0 && dwWait < WAIT_OBJECT_0 + handles.size(),
+        L"Unexpected wait result: " << dwWait);
+
+    return dwWait - WAIT_OBJECT_0;
+}
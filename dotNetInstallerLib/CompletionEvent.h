@@ -0,0 +1,22 @@
+#pragma once
+
+// a manual-reset event signaled when an asynchronous operation completes,
+// waiters block on the event handle instead of polling for completion
+class CompletionEvent
+{
+private:
+	shared_event m_event;
+public:
+	// a new completion event is signaled, nothing is executing
+	CompletionEvent();
+	// the operation has started, waiters block until Signal
+	void Reset();
+	// the operation has completed, releases all waiters
+	void Signal();
+	// returns true if the operation has completed, false if the wait timed out
+	bool Wait(DWORD dwTimeout = INFINITE) const;
+	bool IsSignaled() const { return Wait(0); }
+	HANDLE GetHandle() const { return get(m_event); }
+	// waits for any of the completion handles, returns the index of the signaled handle
+	static size_t WaitForAny(const std::vector<HANDLE>& handles, DWORD dwTimeout = INFINITE);
+};
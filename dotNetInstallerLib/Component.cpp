@@ -32,6 +32,7 @@ show_progress_dialog(true),
 show_cab_dialog(true),
 installed(false),
 hide_component_if_installed(false),
+concurrency(component_concurrency_exclusive),
 main_window(NULL)
 {
 
@@ -66,17 +67,64 @@ bool Component::IsInstalled() const
         }
     }
 
-    bool installed = true;
+    // all checks must pass, the cheapest ones are evaluated first
+    if (installedcheck_program.IsCompiledFrom(installedchecks))
+        return installedcheck_program.Run();
 
-    for (size_t j = 0; j < installedchecks.size(); j++)
+    // checks added after the component was loaded
+    InstalledCheckProgram program;
+    program.Compile(installedchecks);
+    return program.Run();
+}
+
+InstalledCheckInputsPtr Component::GetInstalledInputs() const
+{
+    // without installed checks the result depends on the install sequence
+    if (installedchecks.size() == 0)
+        return InstalledCheckInputsPtr();
+
+    InstalledCheckInputsPtr inputs(new InstalledCheckInputs());
+    for each(const InstalledCheckPtr& installedcheck in installedchecks)
     {
-        installed &= installedchecks[j]->IsInstalled();
+        std::wstring fingerprint = installedcheck->GetFingerprint();
+        if (fingerprint.empty() || ! installedcheck->GetInputs(* inputs))
+            return InstalledCheckInputsPtr();
+
+        inputs->AddFingerprint(fingerprint);
     }
 
-    return installed;
+    return inputs;
 }
 
-void Component::Load(tinyxml2::XMLElement * node)
+bool Component::RefreshInstalled(InstalledCheckInputsPtr& inputs) const
+{
+    // inputs are read before the checks, a change in between is seen on the next refresh
+    try
+    {
+        inputs = GetInstalledInputs();
+    }
+    catch(std::exception& ex)
+    {
+        LOG(L"*** Error reading inputs of installed checks of " << id << L": " << DVLib::string2wstring(ex.what()));
+        reset(inputs);
+    }
+
+    if (get(inputs) != NULL && get(installed_inputs) != NULL)
+    {
+        std::wstring difference = inputs->GetDifference(* installed_inputs);
+        if (difference.empty())
+        {
+            inputs = installed_inputs;
+            return installed;
+        }
+
+        LOG(L"Evaluating installed checks of " << id << L": " << difference);
+    }
+
+    return IsInstalled();
+}
+
+void Component::Load(const ConfigElement * node)
 {
     id = node->Attribute("id");
     display_name = node->Attribute("display_name");
@@ -107,19 +155,23 @@ void Component::Load(tinyxml2::XMLElement * node)
     show_progress_dialog = XmlAttribute(node->Attribute("show_progress_dialog")).GetBoolValue(true);
     show_cab_dialog = XmlAttribute(node->Attribute("show_cab_dialog")).GetBoolValue(true);
     hide_component_if_installed = XmlAttribute(node->Attribute("hide_component_if_installed")).GetBoolValue(false);
+    // execution dependencies and concurrency
+    std::vector<std::wstring> depends_on_ids = DVLib::split(XmlAttribute(node->Attribute("depends_on")).GetValue(), L",");
+    for each (const std::wstring& depends_on_id in depends_on_ids)
+    {
+        std::wstring depends_on_id_trimmed = DVLib::trim(depends_on_id);
+        if (! depends_on_id_trimmed.empty())
+            depends_on.push_back(depends_on_id_trimmed);
+    }
+    concurrency = wstring2concurrency(XmlAttribute(node->Attribute("concurrency")).GetValue());
     // install checks, embed files, etc.
-    for (tinyxml2::XMLNode* child = node->FirstChildElement(); child; child = child->NextSibling())
+    for (const ConfigElement * child_element = node->FirstChildElement(); child_element; child_element = child_element->NextSiblingElement())
     {
-        tinyxml2::XMLElement * child_element = child->ToElement();
-
-        if (child_element == NULL)
-            continue;
-
-        std::wstring type = DVLib::UTF8string2wstring(child_element->Value());
+        std::wstring type = child_element->Value();
 
         if (type == L"installedcheck")
         {
-            std::wstring installedcheck_type = DVLib::UTF8string2wstring(child_element->Attribute("type"));
+            std::wstring installedcheck_type = child_element->Attribute("type");
             InstalledCheckPtr installedcheck(InstalledCheck::Create(installedcheck_type));
             installedcheck->Load(child_element);
             installedchecks.push_back(installedcheck);
@@ -154,23 +206,30 @@ void Component::Load(tinyxml2::XMLElement * node)
         }
     }
 
+    installedcheck_program.Compile(installedchecks);
     LOG(L"Loaded " << GetString());
 }
 
 void Component::Wait(DWORD tt)
 {
-    // \todo: change active wait to a semaphore
-    while(IsExecuting())
-    {
-        Sleep(tt);
-    }
+    HANDLE hCompletion = GetCompletionHandle();
+    if (hCompletion == NULL)
+        return;
+
+    CHECK_WIN32_BOOL(WAIT_OBJECT_0 == ::WaitForSingleObject(hCompletion, tt),
+        L"WaitForSingleObject");
+}
+
+HANDLE Component::GetCompletionHandle() const
+{
+    return NULL;
 }
 
 bool Component::IsSupported(LCID lcid) const
 {
     return DVLib::IsOperatingSystemLCIDValue(lcid, os_filter_lcid) &&
-        DVLib::IsProcessorArchitecture(DVLib::GetProcessorArchitecture(), processor_architecture_filter) &&
-        DVLib::IsInOperatingSystemInRange(DVLib::GetOperatingSystemVersion(), os_filter, os_filter_min, os_filter_max);
+        DVLib::IsProcessorArchitecture(InstallerSession::Instance->GetProcessorArchitecture(), processor_architecture_filter) &&
+        DVLib::IsInOperatingSystemInRange(InstallerSession::Instance->GetOperatingSystemVersion(), os_filter, os_filter_min, os_filter_max);
 }
 
 std::wstring Component::GetString(int indent) const
@@ -188,6 +247,10 @@ std::wstring Component::GetString(int indent) const
         ss << L", os_filter_min=" << DVLib::os2wstring(os_filter_min);
     if (os_filter_max != DVLib::winNone)
         ss << L", os_filter_max=" << DVLib::os2wstring(os_filter_max);
+    if (! depends_on.empty())
+        ss << L", depends_on=" << DVLib::join(depends_on, L",");
+    if (concurrency != component_concurrency_exclusive)
+        ss << L", concurrency=" << concurrency2wstring(concurrency);
     return ss.str();
 }
 
@@ -220,6 +283,23 @@ std::wstring Component::GetAdditionalCmd() const
     return cmd;
 }
 
+bool Component::DependsOn(ExpansionTemplate::token_type type, const std::wstring& name) const
+{
+    if (display_name.DependsOn(type, name)
+        || uninstall_display_name.DependsOn(type, name)
+        || status_installed.DependsOn(type, name)
+        || status_notinstalled.DependsOn(type, name))
+        return true;
+
+    for each(const InstalledCheckPtr& installedcheck in installedchecks)
+    {
+        if (installedcheck->DependsOn(type, name))
+            return true;
+    }
+
+    return false;
+}
+
 std::wstring Component::GetDisplayName() const
 {
     switch(InstallerSession::Instance->sequence)
@@ -232,3 +312,32 @@ std::wstring Component::GetDisplayName() const
         THROW_EX(L"Unsupported install sequence: " << InstallerSession::Instance->sequence << L".");
     }
 }
+
+component_concurrency Component::wstring2concurrency(const std::wstring& name, component_concurrency defaultValue)
+{
+    if (name.empty())
+        return defaultValue;
+    else if (name == L"exclusive")
+        return component_concurrency_exclusive;
+    else if (name == L"parallel")
+        return component_concurrency_parallel;
+    else if (name == L"msiexec")
+        return component_concurrency_msiexec;
+
+    THROW_EX(L"Invalid component concurrency: " << name);
+}
+
+std::wstring Component::concurrency2wstring(component_concurrency concurrency)
+{
+    switch(concurrency)
+    {
+    case component_concurrency_exclusive:
+        return L"exclusive";
+    case component_concurrency_parallel:
+        return L"parallel";
+    case component_concurrency_msiexec:
+        return L"msiexec";
+    default:
+        THROW_EX(L"Invalid component concurrency: " << concurrency);
+    }
+}
@@ -4,7 +4,10 @@
 #include "EmbedFile.h"
 #include "EmbedFolder.h"
 #include "InstalledCheck.h"
-#include <tinyxml2.h>
+#include "InstalledCheckInputs.h"
+#include "InstalledCheckProgram.h"
+#include "ConfigElement.h"
+#include "ConfigNode.h"
 
 enum component_type
 {
@@ -17,7 +20,14 @@ enum component_type
 	component_type_exe, // executable component
 };
 
-class Component
+enum component_concurrency
+{
+	component_concurrency_exclusive = 0, // runs alone, no other component executes at the same time
+	component_concurrency_parallel, // runs alongside any other non-exclusive component
+	component_concurrency_msiexec, // runs alongside parallel components, but never with another msiexec component
+};
+
+class Component : public ConfigNode
 {
 public:
     Component(component_type t);
@@ -70,6 +80,8 @@ public:
     bool selected_uninstall;
     // manages the verification of whether the component is installed or not
 	std::vector<InstalledCheckPtr> installedchecks;
+	// installedchecks compiled when the component is loaded
+	InstalledCheckProgram installedcheck_program;
     // the nested download dialog within a Component
 	DownloadDialogPtr downloaddialog;
 	// handle to main window of installator for use in calls to ShellExecute and similar
@@ -86,14 +98,25 @@ public:
 	bool show_progress_dialog;
 	bool show_cab_dialog;
     bool hide_component_if_installed;
+	// ids of components that must complete before this component executes
+	std::vector<std::wstring> depends_on;
+	// concurrency class, defines which components may execute at the same time
+	component_concurrency concurrency;
 	// virtual functions specific for the type of component
 	virtual void Exec() = 0;
 	virtual void Wait(DWORD tt = INFINITE);
 	virtual bool IsRebootRequired() const;
 	virtual bool IsExecuting() const = 0;
+	// a waitable handle signaled when execution completes, NULL when nothing is executing
+	virtual HANDLE GetCompletionHandle() const;
 	virtual bool IsInstalled() const;
+	// fingerprints and current inputs of the installed checks, NULL when the checks may read anything else
+	InstalledCheckInputsPtr GetInstalledInputs() const;
+	// IsInstalled, unless the inputs of the installed checks are unchanged since installed was evaluated
+	// from installed_inputs; returns the inputs the result was evaluated from
+	bool RefreshInstalled(InstalledCheckInputsPtr& inputs) const;
 	// load a component from an xml node
-	virtual void Load(tinyxml2::XMLElement * node);
+	virtual void Load(const ConfigElement * node);
 	// returns true if this component is supported on this operating system/lcid
 	virtual bool IsSupported(LCID lcid) const;
 	virtual bool IsRequired() const;
@@ -101,10 +124,17 @@ public:
 	virtual std::wstring GetString(int indent = 0) const;
 	std::wstring GetAdditionalCmd() const;
 	std::wstring GetDisplayName() const;
+	// true if the name, status or installed state displayed in the components list may change with the value of a variable
+	bool DependsOn(ExpansionTemplate::token_type type, const std::wstring& name) const;
+	// concurrency class conversion
+	static component_concurrency wstring2concurrency(const std::wstring& name, component_concurrency defaultValue = component_concurrency_exclusive);
+	static std::wstring concurrency2wstring(component_concurrency concurrency);
 	// component state
 	bool checked;
 	bool disabled;
 	bool installed;
+	// inputs of the installed checks when installed was evaluated, NULL if unknown
+	InstalledCheckInputsPtr installed_inputs;
 	std::wstring description;
 };
 
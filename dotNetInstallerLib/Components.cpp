@@ -2,6 +2,8 @@
 #include "Components.h"
 #include "InstallerLog.h"
 #include "InstallerSession.h"
+#include "ComponentsScheduler.h"
+#include "InstalledCheckTask.h"
 
 Components::Components()
 {
@@ -9,13 +11,18 @@ Components::Components()
 
 void Components::add(const ComponentPtr& component)
 {
-    components_map.insert(std::make_pair(component->id, component));
     push_back(component);
 }
 
 bool Components::contains(const std::wstring& id) const
 {
-    return components_map.find(id) != components_map.end();
+    for each (const ComponentPtr& component in * this)
+    {
+        if (component->id == id)
+            return true;
+    }
+
+    return false;
 }
 
 Components::Components(const Components& rhs)
@@ -25,7 +32,6 @@ Components::Components(const Components& rhs)
 
 Components& Components::operator=(const Components& rhs)
 {
-    components_map = rhs.components_map;
     std::vector<ComponentPtr>::operator=(rhs);
     return * this;
 }
@@ -43,7 +49,7 @@ ComponentPtr Components::GetComponentPtr(Component * pc) const
 
 Components Components::GetSupportedComponents(DVLib::LcidType lcidtype, InstallSequence sequence) const
 {
-    LCID lcid = DVLib::GetOperatingSystemLCID(lcidtype);
+    LCID lcid = InstallerSession::Instance->GetOperatingSystemLCID(lcidtype);
     LOG(L"-- Loading supported components (lcid=" << lcid << L")");
     Components result;
     for each (const ComponentPtr& component in * this)
@@ -84,55 +90,55 @@ Components Components::GetSupportedComponents(DVLib::LcidType lcidtype, InstallS
     return result;
 }
 
-int Components::Exec(IExecuteCallback * callback)
+int Components::Exec(IExecuteCallback * callback, int max_concurrency)
 {
-    if (callback)
-    {
-        callback->OnExecBegin();
-    }
+    ComponentsScheduler scheduler(* this, callback, max_concurrency);
+    return scheduler.Exec();
+}
 
-    int rc = 0;
-    for each(const ComponentPtr& component in * this)
+void Components::LoadInstalled()
+{
+    DWORD start = ::GetTickCount();
+
+    if (get(WorkerPool::Instance) == NULL || size() < 2)
     {
-        if (! component->checked)
+        for each (const ComponentPtr& component in * this)
         {
-            LOG(L"--- Component '" << component->id << L"' (" << component->GetDisplayName() << L"): SKIPPED");
-            continue;
+            InstalledCheckInputsPtr inputs;
+            component->installed = component->RefreshInstalled(inputs);
+            component->installed_inputs = inputs;
         }
+        return;
+    }
 
-        try
-        {
-            LOG(L"--- Component '" << component->id << L"' (" << component->GetDisplayName() << L"): EXECUTING");
-
-            if (callback && ! callback->OnComponentExecBegin(component))
-                break;
-
-            component->Exec();
-
-            if (callback && ! callback->OnComponentExecWait(component))
-                break;
-
-            component->Wait();
-
-            LOG(L"*** Component '" << component->id << L"' (" << component->GetDisplayName() << L"): SUCCESS");
-
-            if (callback && ! callback->OnComponentExecSuccess(component))
-                break;
-        }
-        catch(std::exception& ex)
-        {
-            if (rc == 0) rc = component->GetExitCode();
-            if (rc == 0) rc = -1;
+    std::vector<InstalledCheckTaskPtr> tasks;
+    tasks.reserve(size());
+    for each (const ComponentPtr& component in * this)
+    {
+        InstalledCheckTaskPtr task(new InstalledCheckTask(component));
+        tasks.push_back(task);
+        WorkerPool::Instance->Submit(get(task));
+    }
 
-            LOG(L"*** Component '" << component->id << L"' (" << component->GetDisplayName() << L"): ERROR - " 
-                << DVLib::string2wstring(ex.what()));
+    // wait for all checks before merging, an error leaves no check running
+    for each (const InstalledCheckTaskPtr& task in tasks)
+    {
+        task->Wait();
+    }
 
-            if (callback && ! callback->OnComponentExecError(component, ex))
-                break;
-        }
+    int unchanged = 0;
+    for each (const InstalledCheckTaskPtr& task in tasks)
+    {
+        const ComponentPtr& component = task->GetComponent();
+        component->installed = task->IsInstalled();
+        // the same inputs are returned when the checks weren't evaluated
+        if (get(task->GetInputs()) != NULL && get(task->GetInputs()) == get(component->installed_inputs))
+            unchanged++;
+        component->installed_inputs = task->GetInputs();
     }
 
-    return rc;
+    LOG(L"--- Refreshed installed state of " << size() << L" component(s) in " << (::GetTickCount() - start) << L" ms, "
+        << unchanged << L" unchanged component(s) not evaluated");
 }
 
 std::wstring Components::GetString(int indent) const
@@ -6,8 +6,6 @@
 
 class Components : private std::vector<ComponentPtr>
 {
-private:
-	std::map<std::wstring, ComponentPtr> components_map;
 public:
 	Components();
 	Components(const Components& rhs);
@@ -24,8 +22,13 @@ public:
 	ComponentPtr GetComponentPtr(Component * pc) const;
 	// reference
 	const_reference operator[](size_type pos) const { return std::vector<ComponentPtr>::operator[](pos); }
-	// synchronously execute components, returns true if all succeeded
-	int Exec(IExecuteCallback * callback);
+	// synchronously execute components in dependency order, running up to max_concurrency
+	// non-exclusive components at the same time, returns 0 if all succeeded
+	int Exec(IExecuteCallback * callback, int max_concurrency = 1);
+	// evaluate installed checks of all components concurrently on the worker pool and set each
+	// component's installed state in order, throws the error of the first failed component; checks
+	// of components whose inputs haven't changed since last evaluated aren't evaluated again
+	void LoadInstalled();
 	virtual std::wstring GetString(int indent = 0) const;
 	// return iterator for beginning of mutable sequence
 	iterator begin() { return std::vector<ComponentPtr>::begin(); }
@@ -0,0 +1,353 @@
+#include "StdAfx.h"
+#include "ComponentsPipeline.h"
+#include "InstallerLog.h"
+
+ComponentsPipeline::ExtractStage::ExtractStage(HMODULE h, const std::wstring& id)
+: ExtractComponent(h, id)
+{
+
+}
+
+ComponentsPipeline::DownloadStage::DownloadStage(const DownloadDialogPtr& downloaddialog)
+: m_downloaddialog(downloaddialog)
+, m_download_cancelled(0)
+, m_follower(NULL)
+, m_follower_ended(false)
+{
+    ::InitializeCriticalSection(& m_cs);
+}
+
+ComponentsPipeline::DownloadStage::~DownloadStage()
+{
+    // the download reports progress until it completes, wait before the lock goes away
+    Cancel();
+    Wait();
+    ::DeleteCriticalSection(& m_cs);
+}
+
+void ComponentsPipeline::DownloadStage::CancelDownload()
+{
+    ::InterlockedExchange(& m_download_cancelled, 1);
+}
+
+int ComponentsPipeline::DownloadStage::ExecOnThread()
+{
+    // the download dialog is not shown until the pipeline is done with it, its callback is left alone
+    return m_downloaddialog->Download(this);
+}
+
+void ComponentsPipeline::DownloadStage::DownloadingFile(const std::wstring& filename)
+{
+    ::EnterCriticalSection(& m_cs);
+    if (m_follower != NULL) m_follower->DownloadingFile(filename);
+    ::LeaveCriticalSection(& m_cs);
+}
+
+void ComponentsPipeline::DownloadStage::CopyingFile(const std::wstring& filename)
+{
+    ::EnterCriticalSection(& m_cs);
+    if (m_follower != NULL) m_follower->CopyingFile(filename);
+    ::LeaveCriticalSection(& m_cs);
+}
+
+void ComponentsPipeline::DownloadStage::Connecting(const std::wstring& host)
+{
+    ::EnterCriticalSection(& m_cs);
+    if (m_follower != NULL) m_follower->Connecting(host);
+    ::LeaveCriticalSection(& m_cs);
+}
+
+void ComponentsPipeline::DownloadStage::SendingRequest(const std::wstring& host)
+{
+    ::EnterCriticalSection(& m_cs);
+    if (m_follower != NULL) m_follower->SendingRequest(host);
+    ::LeaveCriticalSection(& m_cs);
+}
+
+void ComponentsPipeline::DownloadStage::Status(ULONG progress_current, ULONG progress_max, const std::wstring& description)
+{
+    ::EnterCriticalSection(& m_cs);
+    if (m_follower != NULL) m_follower->Status(progress_current, progress_max, description);
+    ::LeaveCriticalSection(& m_cs);
+}
+
+void ComponentsPipeline::DownloadStage::DownloadComplete()
+{
+    ::EnterCriticalSection(& m_cs);
+    if (m_follower != NULL)
+    {
+        m_follower->DownloadComplete();
+        m_follower_ended = true;
+    }
+    ::LeaveCriticalSection(& m_cs);
+}
+
+void ComponentsPipeline::DownloadStage::DownloadError(const std::wstring& message)
+{
+    ::EnterCriticalSection(& m_cs);
+    if (m_follower != NULL)
+    {
+        m_follower->DownloadError(message);
+        m_follower_ended = true;
+    }
+    ::LeaveCriticalSection(& m_cs);
+}
+
+bool ComponentsPipeline::DownloadStage::IsDownloadCancelled() const
+{
+    if (m_download_cancelled != 0)
+        return true;
+
+    ::EnterCriticalSection(const_cast<CRITICAL_SECTION *>(& m_cs));
+    bool cancelled = (m_follower != NULL && m_follower->IsDownloadCancelled());
+    ::LeaveCriticalSection(const_cast<CRITICAL_SECTION *>(& m_cs));
+    return cancelled;
+}
+
+int ComponentsPipeline::DownloadStage::Follow(IDownloadCallback * callback)
+{
+    ::EnterCriticalSection(& m_cs);
+    m_follower = callback;
+    ::LeaveCriticalSection(& m_cs);
+
+    Wait();
+
+    ::EnterCriticalSection(& m_cs);
+    bool ended = m_follower_ended;
+    m_follower = NULL;
+    ::LeaveCriticalSection(& m_cs);
+
+    // the download may have ended before it was followed
+    if (! ended && callback != NULL)
+    {
+        if (! m_error.empty()) callback->DownloadError(m_error);
+        else if (m_rc == 0) callback->DownloadComplete();
+    }
+
+    CHECK_BOOL(m_error.empty(), m_error);
+    return m_rc;
+}
+
+ComponentsPipeline::ComponentsPipeline(HMODULE h, const Components& components, int extract_depth, int download_depth)
+: m_h(h)
+, m_next_extract(0)
+, m_next_download(0)
+, m_extract_depth(extract_depth)
+, m_download_depth(download_depth)
+{
+    for each(const ComponentPtr& component in components)
+    {
+        if (component->checked)
+        {
+            m_components.push_back(component);
+        }
+    }
+}
+
+ComponentsPipeline::~ComponentsPipeline()
+{
+    // stop work in progress, stages wait for their task to finish when destroyed
+    for (std::map<Component *, ExtractStagePtr>::iterator it = m_extracts.begin(); it != m_extracts.end(); it++)
+    {
+        it->second->cancelled = true;
+        it->second->Cancel();
+    }
+
+    for (std::map<Component *, DownloadStagePtr>::iterator it = m_downloads.begin(); it != m_downloads.end(); it++)
+    {
+        it->second->CancelDownload();
+        it->second->Cancel();
+    }
+
+    // a download dialog that failed never released its download
+    for (std::map<Component *, DownloadStagePtr>::iterator it = m_followed.begin(); it != m_followed.end(); it++)
+    {
+        it->first->downloaddialog->prefetch = NULL;
+        it->second->CancelDownload();
+    }
+
+    m_extracts.clear();
+    m_downloads.clear();
+    m_followed.clear();
+}
+
+void ComponentsPipeline::Start()
+{
+    // the first component downloads right away with its own progress UI, there's nothing to overlap with
+    if (m_next_download == 0) m_next_download = 1;
+    Fill();
+}
+
+bool ComponentsPipeline::EndExtract(const ComponentPtr& component)
+{
+    std::map<Component *, ExtractStagePtr>::iterator it = m_extracts.find(get(component));
+    if (it == m_extracts.end())
+        return false;
+
+    ExtractStagePtr stage = it->second;
+    m_extracts.erase(it);
+
+    try
+    {
+        stage->EndExec();
+    }
+    catch(std::exception& ex)
+    {
+        LOG(L"--- Component '" << component->id << L"' (" << component->GetDisplayName() << L"): PREFETCH EXTRACT FAILED - "
+            << DVLib::string2wstring(ex.what()));
+        return false;
+    }
+
+    LOG(L"--- Component '" << component->id << L"' (" << component->GetDisplayName() << L"): PREFETCHED EXTRACT ("
+        << stage->GetQueuedTime() << L"ms queued, " << stage->GetRunTime() << L"ms running)");
+    return true;
+}
+
+bool ComponentsPipeline::EndDownload(const ComponentPtr& component, bool wait)
+{
+    std::map<Component *, DownloadStagePtr>::iterator it = m_downloads.find(get(component));
+    if (it == m_downloads.end())
+        return false;
+
+    DownloadStagePtr stage = it->second;
+    m_downloads.erase(it);
+
+    if (! wait && ! stage->IsComplete())
+    {
+        // the download dialog shows the progress of the download in progress instead of starting over
+        LOG(L"--- Component '" << component->id << L"' (" << component->GetDisplayName() << L"): PREFETCH DOWNLOAD HANDED TO DIALOG");
+        component->downloaddialog->prefetch = get(stage);
+        m_followed[get(component)] = stage;
+        return false;
+    }
+
+    try
+    {
+        stage->EndExec();
+    }
+    catch(std::exception& ex)
+    {
+        LOG(L"--- Component '" << component->id << L"' (" << component->GetDisplayName() << L"): PREFETCH DOWNLOAD FAILED - "
+            << DVLib::string2wstring(ex.what()));
+        return false;
+    }
+
+    if (stage->IsDownloadCancelled())
+        return false;
+
+    LOG(L"--- Component '" << component->id << L"' (" << component->GetDisplayName() << L"): PREFETCHED DOWNLOAD ("
+        << stage->GetQueuedTime() << L"ms queued, " << stage->GetRunTime() << L"ms running)");
+    return true;
+}
+
+bool ComponentsPipeline::ReleaseDownload(const ComponentPtr& component)
+{
+    std::map<Component *, DownloadStagePtr>::iterator it = m_followed.find(get(component));
+    if (it == m_followed.end())
+        return true;
+
+    DownloadStagePtr stage = it->second;
+    m_followed.erase(it);
+    component->downloaddialog->prefetch = NULL;
+
+    try
+    {
+        // the dialog may not have followed the download, eg. when its files were already there
+        stage->EndExec();
+    }
+    catch(std::exception& ex)
+    {
+        LOG(L"--- Component '" << component->id << L"' (" << component->GetDisplayName() << L"): PREFETCH DOWNLOAD FAILED - "
+            << DVLib::string2wstring(ex.what()));
+        return false;
+    }
+
+    LOG(L"--- Component '" << component->id << L"' (" << component->GetDisplayName() << L"): PREFETCHED DOWNLOAD ("
+        << stage->GetQueuedTime() << L"ms queued, " << stage->GetRunTime() << L"ms running)");
+    return true;
+}
+
+void ComponentsPipeline::Advance(const ComponentPtr& component)
+{
+    if (std::find(m_components.begin(), m_components.end(), component) == m_components.end())
+        return;
+
+    // components can begin out of order, those that follow this one may not have begun yet
+    m_begun.insert(get(component));
+
+    // the component is no longer prefetched, its work would be repeated with UI
+    std::map<Component *, ExtractStagePtr>::iterator extract = m_extracts.find(get(component));
+    if (extract != m_extracts.end())
+    {
+        extract->second->cancelled = true;
+        extract->second->Cancel();
+        m_extracts.erase(extract);
+    }
+
+    std::map<Component *, DownloadStagePtr>::iterator download = m_downloads.find(get(component));
+    if (download != m_downloads.end())
+    {
+        download->second->CancelDownload();
+        download->second->Cancel();
+        m_downloads.erase(download);
+    }
+
+    Fill();
+}
+
+bool ComponentsPipeline::IsBegun(const ComponentPtr& component) const
+{
+    return m_begun.find(get(component)) != m_begun.end();
+}
+
+void ComponentsPipeline::Fill()
+{
+    // back-pressure: each stage takes another component only while it has room
+    while (m_next_extract < m_components.size() && static_cast<int>(m_extracts.size()) < m_extract_depth)
+    {
+        FillExtract(m_components[m_next_extract++]);
+    }
+
+    while (m_next_download < m_components.size() && static_cast<int>(m_downloads.size()) < m_download_depth)
+    {
+        FillDownload(m_components[m_next_download++]);
+    }
+}
+
+bool ComponentsPipeline::FillExtract(const ComponentPtr& component)
+{
+    if (IsBegun(component))
+        return false;
+
+    ExtractStagePtr stage(new ExtractStage(m_h, component->id));
+
+    // components without an embedded CAB don't take room in the stage
+    if (stage->GetCabCount() == 0)
+        return false;
+
+    LOG(L"--- Component '" << component->id << L"' (" << component->GetDisplayName() << L"): PREFETCHING EXTRACT");
+    stage->cab_path = cab_path;
+    stage->cab_cancelled_message = cab_cancelled_message;
+    stage->BeginExec();
+    m_extracts[get(component)] = stage;
+    return true;
+}
+
+bool ComponentsPipeline::FillDownload(const ComponentPtr& component)
+{
+    if (IsBegun(component))
+        return false;
+
+    // downloads that wait for the user to press start are never prefetched
+    if (get(component->downloaddialog) == NULL || ! component->downloaddialog->auto_start)
+        return false;
+
+    if (! component->downloaddialog->IsRequired())
+        return false;
+
+    LOG(L"--- Component '" << component->id << L"' (" << component->GetDisplayName() << L"): PREFETCHING DOWNLOAD");
+    DownloadStagePtr stage(new DownloadStage(component->downloaddialog));
+    stage->BeginExec();
+    m_downloads[get(component)] = stage;
+    return true;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Component.h"
+#include "Components.h"
+#include "DownloadCallback.h"
+#include "DownloadPrefetch.h"
+#include "ExtractComponent.h"
+#include "ThreadComponent.h"
+
+// prefetches embedded CABs and downloads of the components that follow the one being
+// installed on the worker pool; each stage keeps a bounded number of components ahead
+// and only takes more work as the install stage consumes it
+class ComponentsPipeline
+{
+private:
+	// extracts a component's embedded CAB without UI
+	class ExtractStage : public ExtractComponent
+	{
+	public:
+		ExtractStage(HMODULE h, const std::wstring& id);
+	protected:
+		void OnStatus(const std::wstring&) { }
+	};
+
+	// downloads or copies a component's files without UI, can be cancelled or
+	// followed by a download dialog that reports progress from then on
+	class DownloadStage : public ThreadComponent, public IDownloadCallback, public IDownloadPrefetch
+	{
+	private:
+		DownloadDialogPtr m_downloaddialog;
+		volatile LONG m_download_cancelled;
+		CRITICAL_SECTION m_cs;
+		IDownloadCallback * m_follower;
+		// the follower was told that the download completed or failed
+		bool m_follower_ended;
+	public:
+		DownloadStage(const DownloadDialogPtr& downloaddialog);
+		~DownloadStage();
+		void CancelDownload();
+		// IDownloadCallback
+		void DownloadingFile(const std::wstring& filename);
+		void CopyingFile(const std::wstring& filename);
+		void Connecting(const std::wstring& host);
+		void SendingRequest(const std::wstring& host);
+		void Status(ULONG progress_current, ULONG progress_max, const std::wstring& description);
+		void DownloadComplete();
+		void DownloadError(const std::wstring& message);
+		bool IsDownloadCancelled() const;
+		// IDownloadPrefetch
+		int Follow(IDownloadCallback * callback);
+	protected:
+		int ExecOnThread();
+	};
+
+	typedef shared_any<ExtractStage *, close_delete> ExtractStagePtr;
+	typedef shared_any<DownloadStage *, close_delete> DownloadStagePtr;
+
+	HMODULE m_h;
+	std::vector<ComponentPtr> m_components;
+	// components that have begun installing, in any order
+	std::set<Component *> m_begun;
+	// next component each stage considers
+	size_t m_next_extract;
+	size_t m_next_download;
+	int m_extract_depth;
+	int m_download_depth;
+	std::map<Component *, ExtractStagePtr> m_extracts;
+	std::map<Component *, DownloadStagePtr> m_downloads;
+	// downloads in progress handed to the components' download dialogs
+	std::map<Component *, DownloadStagePtr> m_followed;
+public:
+	std::wstring cab_path;
+	std::wstring cab_cancelled_message;
+public:
+	ComponentsPipeline(HMODULE h, const Components& components, int extract_depth, int download_depth);
+	~ComponentsPipeline();
+	// start prefetching the first components
+	void Start();
+	// returns true if the component's embedded CAB was extracted by the pipeline, waits for extraction in progress
+	bool EndExtract(const ComponentPtr& component);
+	// returns true if the component's files were downloaded by the pipeline; a download in progress
+	// is either waited for or handed to the component's download dialog, which follows it with progress UI
+	bool EndDownload(const ComponentPtr& component, bool wait);
+	// the download dialog is done, waits for a download handed to it and returns false if that download failed
+	bool ReleaseDownload(const ComponentPtr& component);
+	// the component begins installing, stop prefetching it and prefetch the components that follow
+	void Advance(const ComponentPtr& component);
+private:
+	bool IsBegun(const ComponentPtr& component) const;
+	void Fill();
+	bool FillExtract(const ComponentPtr& component);
+	bool FillDownload(const ComponentPtr& component);
+};
+
+typedef shared_any<ComponentsPipeline *, close_delete> ComponentsPipelinePtr;
@@ -0,0 +1,310 @@
+#include "StdAfx.h"
+#include "ComponentsScheduler.h"
+#include "InstallerLog.h"
+#include "InstallerSession.h"
+
+ComponentsScheduler::ComponentsScheduler(const Components& components, IExecuteCallback * callback, int max_concurrency)
+: m_callback(callback)
+, m_max_concurrency(max_concurrency)
+, m_rc(0)
+, m_stop(false)
+{
+    // WaitForMultipleObjects can wait on a limited number of handles
+    if (m_max_concurrency < 1) m_max_concurrency = 1;
+    if (m_max_concurrency > MAXIMUM_WAIT_OBJECTS) m_max_concurrency = MAXIMUM_WAIT_OBJECTS;
+
+    for each(const ComponentPtr& component in components)
+    {
+        ScheduledComponent scheduled;
+        scheduled.component = component;
+        scheduled.state = scheduled_state_pending;
+        m_scheduled_index.insert(std::make_pair(component->id.GetValue(), m_scheduled.size()));
+        m_scheduled.push_back(scheduled);
+    }
+}
+
+void ComponentsScheduler::Validate() const
+{
+    // 0: not visited, 1: being visited, 2: visited
+    std::vector<int> visited(m_scheduled.size(), 0);
+    for (size_t i = 0; i < m_scheduled.size(); i++)
+    {
+        ValidateDependencies(i, visited);
+    }
+}
+
+void ComponentsScheduler::ValidateDependencies(size_t index, std::vector<int>& visited) const
+{
+    if (visited[index] == 2)
+        return;
+
+    const ComponentPtr& component = m_scheduled[index].component;
+
+    CHECK_BOOL(visited[index] == 0,
+        L"Circular dependency on component '" << component->id << L"'");
+
+    visited[index] = 1;
+    for each(const std::wstring& depends_on_id in component->depends_on)
+    {
+        std::map<std::wstring, size_t>::const_iterator dependency = m_scheduled_index.find(depends_on_id);
+        if (dependency != m_scheduled_index.end())
+        {
+            ValidateDependencies(dependency->second, visited);
+        }
+    }
+
+    visited[index] = 2;
+}
+
+int ComponentsScheduler::Exec()
+{
+    Validate();
+
+    if (m_callback)
+    {
+        m_callback->OnExecBegin();
+    }
+
+    while (true)
+    {
+        if (! m_stop)
+        {
+            StartReady();
+        }
+
+        if (GetRunningCount() == 0)
+        {
+            if (m_stop || ! HasPending())
+                break;
+
+            // nothing is running and nothing can be started
+            THROW_EX(L"Error scheduling components, unresolved dependencies");
+        }
+
+        WaitForAny();
+    }
+
+    return m_rc;
+}
+
+void ComponentsScheduler::StartReady()
+{
+    for (size_t i = 0; i < m_scheduled.size() && ! m_stop; i++)
+    {
+        ScheduledComponent& scheduled = m_scheduled[i];
+
+        if (scheduled.state != scheduled_state_pending)
+            continue;
+
+        const ComponentPtr& component = scheduled.component;
+
+        if (! component->checked)
+        {
+            LOG(L"--- Component '" << component->id << L"' (" << component->GetDisplayName() << L"): SKIPPED");
+            scheduled.state = scheduled_state_skipped;
+            continue;
+        }
+
+        std::wstring failed_depends_on;
+        bool ready = IsReady(i, failed_depends_on);
+
+        if (! failed_depends_on.empty())
+        {
+            // the component never ran, it doesn't report an error of its own
+            LOG(L"--- Component '" << component->id << L"' (" << component->GetDisplayName() << L"): SKIPPED, depends on '"
+                << failed_depends_on << L"', which failed");
+            scheduled.state = scheduled_state_blocked;
+            continue;
+        }
+
+        if (! ready)
+            continue;
+
+        if (CanStart(i))
+        {
+            Start(i);
+        }
+        else if (component->concurrency == component_concurrency_exclusive)
+        {
+            // a ready exclusive component is a barrier, components that follow don't start before it
+            break;
+        }
+    }
+}
+
+bool ComponentsScheduler::IsReady(size_t index, std::wstring& failed_depends_on) const
+{
+    bool ready = true;
+    const ComponentPtr& component = m_scheduled[index].component;
+    for each(const std::wstring& depends_on_id in component->depends_on)
+    {
+        std::map<std::wstring, size_t>::const_iterator dependency = m_scheduled_index.find(depends_on_id);
+
+        // dependencies that are not supported on this system are satisfied
+        if (dependency == m_scheduled_index.end())
+            continue;
+
+        switch(m_scheduled[dependency->second].state)
+        {
+        case scheduled_state_succeeded:
+        case scheduled_state_skipped:
+            break;
+        case scheduled_state_failed:
+        case scheduled_state_blocked:
+            failed_depends_on = depends_on_id;
+            return false;
+        default:
+            ready = false;
+            break;
+        }
+    }
+
+    return ready;
+}
+
+bool ComponentsScheduler::CanStart(size_t index) const
+{
+    int running = 0;
+    const ComponentPtr& component = m_scheduled[index].component;
+    for each(const ScheduledComponent& scheduled in m_scheduled)
+    {
+        if (scheduled.state != scheduled_state_running)
+            continue;
+
+        running++;
+
+        if (component->concurrency == component_concurrency_exclusive
+            || scheduled.component->concurrency == component_concurrency_exclusive)
+            return false;
+
+        if (component->concurrency == component_concurrency_msiexec
+            && scheduled.component->concurrency == component_concurrency_msiexec)
+            return false;
+    }
+
+    return running < m_max_concurrency;
+}
+
+void ComponentsScheduler::Start(size_t index)
+{
+    ScheduledComponent& scheduled = m_scheduled[index];
+    const ComponentPtr& component = scheduled.component;
+
+    try
+    {
+        LOG(L"--- Component '" << component->id << L"' (" << component->GetDisplayName() << L"): EXECUTING");
+
+        if (m_callback && ! m_callback->OnComponentExecBegin(component))
+        {
+            scheduled.state = scheduled_state_skipped;
+            m_stop = true;
+            return;
+        }
+
+        component->Exec();
+
+        if (m_callback && ! m_callback->OnComponentExecWait(component))
+        {
+            scheduled.state = scheduled_state_skipped;
+            m_stop = true;
+            return;
+        }
+
+        // the component runs on its own and signals its completion handle when done
+        scheduled.state = scheduled_state_running;
+    }
+    catch(std::exception& ex)
+    {
+        Fail(index, ex);
+    }
+}
+
+void ComponentsScheduler::WaitForAny()
+{
+    std::vector<HANDLE> handles;
+    std::vector<size_t> indexes;
+    for (size_t i = 0; i < m_scheduled.size(); i++)
+    {
+        if (m_scheduled[i].state != scheduled_state_running)
+            continue;
+
+        HANDLE hCompletion = m_scheduled[i].component->GetCompletionHandle();
+
+        // components without a completion handle have nothing to wait for
+        if (hCompletion == NULL)
+        {
+            Complete(i);
+            return;
+        }
+
+        handles.push_back(hCompletion);
+        indexes.push_back(i);
+    }
+
+    Complete(indexes[CompletionEvent::WaitForAny(handles)]);
+}
+
+void ComponentsScheduler::Complete(size_t index)
+{
+    ScheduledComponent& scheduled = m_scheduled[index];
+    const ComponentPtr& component = scheduled.component;
+
+    InstallerSession::Instance->InvalidateMachineState();
+
+    try
+    {
+        // returns immediately once the completion handle is signaled, checks the result
+        component->Wait();
+
+        LOG(L"*** Component '" << component->id << L"' (" << component->GetDisplayName() << L"): SUCCESS");
+        scheduled.state = scheduled_state_succeeded;
+
+        if (! m_stop && m_callback && ! m_callback->OnComponentExecSuccess(component))
+            m_stop = true;
+    }
+    catch(std::exception& ex)
+    {
+        Fail(index, ex);
+    }
+}
+
+void ComponentsScheduler::Fail(size_t index, std::exception& ex)
+{
+    ScheduledComponent& scheduled = m_scheduled[index];
+    const ComponentPtr& component = scheduled.component;
+
+    scheduled.state = scheduled_state_failed;
+
+    if (m_rc == 0) m_rc = component->GetExitCode();
+    if (m_rc == 0) m_rc = -1;
+
+    LOG(L"*** Component '" << component->id << L"' (" << component->GetDisplayName() << L"): ERROR - "
+        << DVLib::string2wstring(ex.what()));
+
+    // once execution was stopped, components still running are drained without callbacks
+    if (! m_stop && m_callback && ! m_callback->OnComponentExecError(component, ex))
+        m_stop = true;
+}
+
+int ComponentsScheduler::GetRunningCount() const
+{
+    int running = 0;
+    for each(const ScheduledComponent& scheduled in m_scheduled)
+    {
+        if (scheduled.state == scheduled_state_running)
+            running++;
+    }
+
+    return running;
+}
+
+bool ComponentsScheduler::HasPending() const
+{
+    for each(const ScheduledComponent& scheduled in m_scheduled)
+    {
+        if (scheduled.state == scheduled_state_pending)
+            return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Component.h"
+#include "Components.h"
+#include "ExecuteCallback.h"
+#include "CompletionEvent.h"
+
+// executes components in dependency order, running independent non-exclusive
+// components at the same time on a bounded number of execution slots
+class ComponentsScheduler
+{
+private:
+	enum scheduled_state
+	{
+		scheduled_state_pending = 0, // waiting for dependencies or a free slot
+		scheduled_state_running, // executing
+		scheduled_state_succeeded, // executed successfully
+		scheduled_state_failed, // failed
+		scheduled_state_skipped, // not checked, or abandoned by the callback
+		scheduled_state_blocked, // not executed because one of its dependencies failed or was blocked
+	};
+
+	struct ScheduledComponent
+	{
+		ComponentPtr component;
+		scheduled_state state;
+	};
+
+	std::vector<ScheduledComponent> m_scheduled;
+	std::map<std::wstring, size_t> m_scheduled_index;
+	IExecuteCallback * m_callback;
+	int m_max_concurrency;
+	int m_rc;
+	bool m_stop;
+public:
+	ComponentsScheduler(const Components& components, IExecuteCallback * callback, int max_concurrency = 1);
+	// execute all checked components, returns the first error code or 0 if all succeeded
+	int Exec();
+	// throws if the dependencies between components are circular
+	void Validate() const;
+private:
+	void ValidateDependencies(size_t index, std::vector<int>& visited) const;
+	void StartReady();
+	void Start(size_t index);
+	void WaitForAny();
+	void Complete(size_t index);
+	void Fail(size_t index, std::exception& ex);
+	bool CanStart(size_t index) const;
+	int GetRunningCount() const;
+	bool HasPending() const;
+	// returns true when all dependencies have completed, sets failed_depends_on when any of them has failed
+	bool IsReady(size_t index, std::wstring& failed_depends_on) const;
+};
@@ -0,0 +1,105 @@
+#include "StdAfx.h"
+#include "ConfigArena.h"
+
+__declspec(thread) ConfigArena * ConfigArena::current = NULL;
+
+ConfigArena::ConfigArena()
+: m_next(NULL)
+, m_available(0)
+, m_size(0)
+, m_refs(1)
+, m_allocations(0)
+{
+}
+
+ConfigArena::~ConfigArena()
+{
+    for each(void * block in m_blocks)
+    {
+        ::operator delete(block);
+    }
+}
+
+void ConfigArena::AddRef()
+{
+    ::InterlockedIncrement(& m_refs);
+}
+
+void ConfigArena::Release()
+{
+    if (::InterlockedDecrement(& m_refs) == 0)
+    {
+        delete this;
+    }
+}
+
+void * ConfigArena::Allocate(size_t size)
+{
+    size = (size + MEMORY_ALLOCATION_ALIGNMENT - 1) & ~(MEMORY_ALLOCATION_ALIGNMENT - 1);
+    char * result = NULL;
+    if (size > block_size / 4)
+    {
+        // a block of its own, keep filling the current one
+        m_blocks.reserve(m_blocks.size() + 1);
+        result = static_cast<char *>(::operator new(size));
+        m_blocks.push_back(result);
+    }
+    else
+    {
+        if (size > m_available)
+        {
+            m_blocks.reserve(m_blocks.size() + 1);
+            m_next = static_cast<char *>(::operator new(block_size));
+            m_blocks.push_back(m_next);
+            m_available = block_size;
+        }
+
+        result = m_next;
+        m_next += size;
+        m_available -= size;
+    }
+
+    m_size += size;
+    m_allocations++;
+    AddRef();
+    return result;
+}
+
+void * ConfigArena::New(size_t size)
+{
+    ConfigArena * arena = current;
+    char * p = static_cast<char *>(arena ? arena->Allocate(header_size + size) : ::operator new(header_size + size));
+    * reinterpret_cast<ConfigArena **>(p) = arena;
+    return p + header_size;
+}
+
+void ConfigArena::Delete(void * p)
+{
+    if (p == NULL)
+        return;
+
+    char * header = static_cast<char *>(p) - header_size;
+    ConfigArena * arena = * reinterpret_cast<ConfigArena **>(header);
+    if (arena)
+    {
+        arena->Release();
+    }
+    else
+    {
+        ::operator delete(header);
+    }
+}
+
+ConfigArenaScope::ConfigArenaScope(ConfigArena * arena)
+: m_arena(arena)
+, m_previous(ConfigArena::current)
+{
+    if (m_arena) m_arena->AddRef();
+    ConfigArena::current = m_arena;
+}
+
+ConfigArenaScope::~ConfigArenaScope()
+{
+    ConfigArena::current = m_previous;
+    if (m_arena) m_arena->Release();
+}
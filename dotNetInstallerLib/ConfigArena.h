@@ -0,0 +1,56 @@
+#pragma once
+
+// monotonic allocator for the objects of a configuration, objects allocated while the arena is
+// current on a thread are carved out of large blocks, blocks are freed all at once when the owner
+// and every object allocated from the arena have released it
+class ConfigArena
+{
+private:
+	// blocks are allocated in this size, larger objects get a block of their own
+	static const size_t block_size = 64 * 1024;
+	// every object is preceded by the arena it was allocated from, NULL for the heap
+	static const size_t header_size = MEMORY_ALLOCATION_ALIGNMENT;
+	static __declspec(thread) ConfigArena * current;
+	std::vector<void *> m_blocks;
+	char * m_next;
+	size_t m_available;
+	size_t m_size;
+	LONG m_refs;
+	LONG m_allocations;
+	~ConfigArena();
+	void * Allocate(size_t size);
+public:
+	// the arena is created with a reference held by the caller
+	ConfigArena();
+	void AddRef();
+	void Release();
+	// number of objects allocated from the arena
+	LONG GetAllocations() const { return m_allocations; }
+	// number of blocks and bytes carved out of them
+	size_t GetBlockCount() const { return m_blocks.size(); }
+	size_t GetSize() const { return m_size; }
+	// arena objects are allocated from on this thread, NULL for the heap
+	static ConfigArena * GetCurrent() { return current; }
+	// allocate an object from the current arena, objects are allocated from one thread at a time
+	static void * New(size_t size);
+	// release an object, safe to call from any thread
+	static void Delete(void * p);
+private:
+	ConfigArena(const ConfigArena&);
+	ConfigArena& operator=(const ConfigArena&);
+	friend class ConfigArenaScope;
+};
+
+// makes an arena current on this thread within a scope, NULL allocates objects on the heap
+class ConfigArenaScope
+{
+private:
+	ConfigArena * m_arena;
+	ConfigArena * m_previous;
+public:
+	ConfigArenaScope(ConfigArena * arena);
+	~ConfigArenaScope();
+private:
+	ConfigArenaScope(const ConfigArenaScope&);
+	ConfigArenaScope& operator=(const ConfigArenaScope&);
+};
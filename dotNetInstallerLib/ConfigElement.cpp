@@ -0,0 +1,56 @@
+#include "StdAfx.h"
+#include "ConfigElement.h"
+
+const wchar_t * ConfigElement::Attribute(const char * attribute_name) const
+{
+    const ConfigAttribute * attributes = GetAttributes();
+    for (DWORD i = 0; i < attribute_count; i++)
+    {
+        if (NameEquals(GetString(attributes[i].name), attribute_name))
+            return GetString(attributes[i].value);
+    }
+
+    return L"";
+}
+
+const ConfigElement * ConfigElement::FirstChildElement(const char * element_name) const
+{
+    if (first_child == 0)
+        return NULL;
+
+    const ConfigElement * child = reinterpret_cast<const ConfigElement *>(
+        reinterpret_cast<const char *>(this) + first_child);
+
+    return NameEquals(child->Value(), element_name)
+        ? child
+        : child->NextSiblingElement(element_name);
+}
+
+const ConfigElement * ConfigElement::NextSiblingElement(const char * element_name) const
+{
+    const ConfigElement * sibling = this;
+    while (sibling->next != 0)
+    {
+        sibling = reinterpret_cast<const ConfigElement *>(
+            reinterpret_cast<const char *>(sibling) + sibling->next);
+
+        if (NameEquals(sibling->Value(), element_name))
+            return sibling;
+    }
+
+    return NULL;
+}
+
+bool ConfigElement::NameEquals(const wchar_t * name, const char * ascii_name)
+{
+    if (ascii_name == NULL)
+        return true;
+
+    while (* name != 0 && * name == static_cast<unsigned char>(* ascii_name))
+    {
+        name++;
+        ascii_name++;
+    }
+
+    return * name == static_cast<unsigned char>(* ascii_name);
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+struct ConfigAttribute
+{
+	// string offsets, relative to the element
+	LONG name;
+	LONG value;
+};
+
+// an element of a compiled configuration read in place, see ConfigImage
+// strings are null-terminated UTF-16, attributes follow the element
+struct ConfigElement
+{
+	// offsets relative to this element, next and first_child are 0 when there's none
+	LONG name;
+	LONG next;
+	LONG first_child;
+	DWORD attribute_count;
+	// element name
+	const wchar_t * Value() const { return GetString(name); }
+	// attribute value, empty when the attribute is missing
+	const wchar_t * Attribute(const char * attribute_name) const;
+	// first child element, optionally with a given name
+	const ConfigElement * FirstChildElement(const char * element_name = NULL) const;
+	// next sibling element, optionally with a given name
+	const ConfigElement * NextSiblingElement(const char * element_name = NULL) const;
+	const ConfigAttribute * GetAttributes() const { return reinterpret_cast<const ConfigAttribute *>(this + 1); }
+	const wchar_t * GetString(LONG offset) const { return reinterpret_cast<const wchar_t *>(reinterpret_cast<const char *>(this) + offset); }
+	// compares a name to an ascii one, any name matches NULL
+	static bool NameEquals(const wchar_t * name, const char * ascii_name);
+};
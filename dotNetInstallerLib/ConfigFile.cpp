@@ -4,34 +4,69 @@
 #include "InstallerLog.h"
 
 ConfigFile::ConfigFile()
+: m_arena(new ConfigArena())
 {
 
 }
 
+ConfigFile::~ConfigFile()
+{
+    // the arena is freed when the last of its objects is released
+    m_arena->Release();
+}
+
+void ConfigFile::LoadImage()
+{
+    ConfigArenaScope scope(m_arena);
+    Load(m_image.GetRoot());
+}
+
+void ConfigFile::LoadXml(const char * xml, size_t size, const std::wstring& error)
+{
+    // the xml document is only needed to compile the configuration image
+    tinyxml2::XMLDocument doc;
+    doc.Parse(xml, size);
+    CHECK_BOOL(! doc.Error(),
+        error << DVLib::string2wstring(doc.ErrorStr())
+        << L" at line " << doc.ErrorLineNum());
+    m_image.Compile(doc.FirstChildElement(), size);
+}
+
 void ConfigFile::LoadFile(const std::wstring& filename)
 {
     LOG(L"Loading configuration file: " << filename);
-    std::vector<char> xml = DVLib::FileReadToEnd(filename);
-    xml.push_back(0); // null-terminate
-    LOG(L"Parsing: " << DVLib::FormatBytesW(xml.size()));
-    if (xml.size() == 0) THROW_EX(L"Error loading file: " << filename << L", file is empty");
-    m_XmlDocument.Parse(& * xml.begin());
-    CHECK_BOOL(! m_XmlDocument.Error(),
-        L"Error loading configuration: " << DVLib::string2wstring(m_XmlDocument.ErrorStr())
-        << L" at line " << m_XmlDocument.ErrorLineNum());
-    Load(m_XmlDocument.FirstChildElement());
+    // parse straight from the mapped view, tinyxml2 makes the only copy of the data
+    DVLib::MappedFile xml(filename);
+    LOG(L"Parsing: " << DVLib::FormatBytesW(xml.GetSize()));
+    if (xml.GetSize() == 0) THROW_EX(L"Error loading file: " << filename << L", file is empty");
+    LoadXml(xml.GetData(), xml.GetSize(), L"Error loading configuration: ");
+    LoadImage();
     m_filename = filename;
 }
 
 void ConfigFile::LoadResource(HMODULE h, const std::wstring& res_name, const std::wstring& res_type)
 {
-    std::vector<char> data = DVLib::LoadResourceData<char>(h, res_name, res_type);
-    data.push_back(0); // null-terminate
-    m_XmlDocument.Parse(& * data.begin());
-    CHECK_BOOL(! m_XmlDocument.Error(),
-        L"Error parsing '" << res_name << L" resource: " << DVLib::string2wstring(m_XmlDocument.ErrorStr())
-        << L" at line " << m_XmlDocument.ErrorLineNum());
+    std::wstring image_name = res_name + L"_IMAGE";
+    if (DVLib::ResourceExists(h, image_name, res_type))
+    {
+        // the image is read in place from the resource mapped in the module
+        DVLib::ResourceView<char> image = DVLib::GetResourceView<char>(h, image_name, res_type);
+        if (ConfigImage::IsSupported(image.data, image.size))
+        {
+            m_image.Attach(image.data, image.size);
+            LOG(L"Loaded compiled configuration from embedded resource '" << image_name << L"'");
+            LoadImage();
+            m_filename = L"Resource: " + res_name;
+            return;
+        }
+
+        LOG(L"Skipping '" << image_name << L"', unsupported compiled configuration version");
+    }
+
+    // parse straight from the resource mapped in the image, tinyxml2 makes the only copy of the data
+    DVLib::ResourceView<char> data = DVLib::GetResourceView<char>(h, res_name, res_type);
+    LoadXml(data.data, data.size, L"Error parsing '" + res_name + L" resource: ");
     LOG(L"Loaded configuration from embedded resource '" << res_name << L"'");
-    Load(m_XmlDocument.FirstChildElement());
+    LoadImage();
     m_filename = L"Resource: " + res_name;
 }
@@ -2,16 +2,27 @@
 
 #include "FileAttributes.h"
 #include "Configurations.h"
-#include <tinyxml2.h>
+#include "ConfigImage.h"
+#include "ConfigArena.h"
 
 class ConfigFile : public Configurations
 {
 private:
 	std::wstring m_filename;
-    tinyxml2::XMLDocument m_XmlDocument;
+	ConfigImage m_image;
+	// components, checks, controls and files of the configurations are allocated from the arena
+	ConfigArena * m_arena;
+	void LoadXml(const char * xml, size_t size, const std::wstring& error);
+	void LoadImage();
+	ConfigFile(const ConfigFile&);
+	ConfigFile& operator=(const ConfigFile&);
 public:
 	ConfigFile();
+	~ConfigFile();
 	void LoadFile(const std::wstring& filename);
+	// loads a compiled image linked next to the resource as <res_name>_IMAGE when there's one of this version
 	void LoadResource(HINSTANCE h, const std::wstring& res_name, const std::wstring& res_type = L"CUSTOM");
 	const std::wstring& GetFilename() const { return m_filename; }
+	const ConfigImage& GetImage() const { return m_image; }
+	const ConfigArena * GetArena() const { return m_arena; }
 };
@@ -1,6 +1,8 @@
 #include "StdAfx.h"
 #include "ConfigFiles.h"
 #include "ReferenceConfiguration.h"
+#include "ReferenceConfigurationTask.h"
+#include "ReferenceCacheTask.h"
 #include "InstallerLog.h"
 #include "InstallerSession.h"
 #include <Version/Version.h>
@@ -19,20 +21,51 @@ std::vector<ConfigurationPtr> ConfigFiles::DownloadReferenceConfigurations(
             << L" reached. Do you have a circular reference?");
     }
 
-    std::vector<ConfigurationPtr> result;
+    // the sources of sibling cached references are checked concurrently
+    std::vector<ReferenceCacheTaskPtr> cache_tasks(configurations.size());
     for (size_t i = 0; i < configurations.size(); i++)
     {
-        if (configurations[i]->type == configuration_reference)
+        if (configurations[i]->type != configuration_reference)
+            continue;
+
+        ReferenceConfiguration * p = reinterpret_cast<ReferenceConfiguration *>(get(configurations[i]));
+        if (! p->IsCacheable())
+            continue;
+
+        cache_tasks[i] = ReferenceCacheTaskPtr(new ReferenceCacheTask(configurations[i]));
+        cache_tasks[i]->Start();
+    }
+
+    // sibling references are downloaded and loaded concurrently, download dialogs run on this thread
+    std::vector<ReferenceConfigurationTaskPtr> tasks(configurations.size());
+    for (size_t i = 0; i < configurations.size(); i++)
+    {
+        if (configurations[i]->type != configuration_reference)
+            continue;
+
+        ReferenceConfiguration * p = reinterpret_cast<ReferenceConfiguration *>(get(configurations[i]));
+        bool cached = get(cache_tasks[i]) != NULL && cache_tasks[i]->IsCached();
+        std::wstring sources = (get(cache_tasks[i]) != NULL && ! cached) ? cache_tasks[i]->GetSources() : L"";
+        std::wstring file_version = DownloadFile::GetSourceFileVersion(p->filename);
+        bool download = false;
+        if (! cached)
         {
-            ReferenceConfiguration * p = reinterpret_cast<ReferenceConfiguration *>(get(configurations[i]));
             LOG(L"Downloading reference configuration to '" << p->filename << L"'");
-            if (! OnDownload(configurations[i]))
-            {
-                p->Exec();
-            }
+            download = ! OnDownload(configurations[i]);
+        }
 
-            ConfigFile downloadedconfig;
-            downloadedconfig.LoadFile(p->filename);
+        tasks[i] = ReferenceConfigurationTaskPtr(new ReferenceConfigurationTask(configurations[i], download, sources, file_version));
+        tasks[i]->Start();
+    }
+
+    // merge in the original order
+    std::vector<ConfigurationPtr> result;
+    for (size_t i = 0; i < configurations.size(); i++)
+    {
+        if (get(tasks[i]) != NULL)
+        {
+            ReferenceConfiguration * p = reinterpret_cast<ReferenceConfiguration *>(get(configurations[i]));
+            ConfigFile& downloadedconfig = tasks[i]->GetConfigFile();
 
             if (downloadedconfig.schema.version != TEXT(VERSION_VALUE))
             {
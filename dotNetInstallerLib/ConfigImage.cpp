@@ -0,0 +1,179 @@
+#include "StdAfx.h"
+#include "ConfigImage.h"
+
+ConfigImage::ConfigImage()
+    : m_image(NULL)
+    , m_size(0)
+{
+
+}
+
+void ConfigImage::Compile(const tinyxml2::XMLElement * node, size_t xml_size)
+{
+    CHECK_BOOL(node != NULL,
+        L"Missing configuration root node");
+
+    m_image = NULL;
+    m_size = 0;
+    m_data.clear();
+    // UTF-16 takes at most twice the space of the UTF-8 it's converted from, repeated strings are written once
+    m_data.reserve(sizeof(Header) + xml_size * 2);
+    m_data.resize(sizeof(Header));
+
+    // names and most values repeat, each distinct string is converted and written once
+    StringOffsets strings;
+    LONG root = WriteElement(node, strings);
+
+    Header * header = reinterpret_cast<Header *>(& * m_data.begin());
+    header->magic = image_magic;
+    header->version = image_version;
+    header->size = static_cast<DWORD>(m_data.size());
+    header->root = root;
+
+    m_image = & * m_data.begin();
+    m_size = m_data.size();
+}
+
+LONG ConfigImage::WriteString(const char * s, StringOffsets& strings)
+{
+    // the document outlives the compilation, its strings are looked up without a copy
+    StringOffsets::const_iterator iter = strings.find(s);
+    if (iter != strings.end())
+        return iter->second;
+
+    // convert straight into the image, a UTF-8 string never has more UTF-16 characters than bytes
+    LONG offset = static_cast<LONG>(m_data.size());
+    int length = static_cast<int>(strlen(s)) + 1;
+    m_data.resize(offset + length * sizeof(wchar_t));
+    length = ::MultiByteToWideChar(CP_UTF8, 0, s, -1, reinterpret_cast<wchar_t *>(& m_data[offset]), length);
+    CHECK_WIN32_BOOL(0 != length, L"MultiByteToWideChar");
+    // keep elements that follow DWORD-aligned
+    m_data.resize(offset + ((length * sizeof(wchar_t) + sizeof(DWORD) - 1) & ~(sizeof(DWORD) - 1)), 0);
+    strings[s] = offset;
+    return offset;
+}
+
+LONG ConfigImage::WriteElement(const tinyxml2::XMLElement * node, StringOffsets& strings)
+{
+    // strings are written ahead of the element, offsets are relative to the element
+    LONG name = WriteString(node->Name(), strings);
+    std::vector<ConfigAttribute> attributes;
+    for (const tinyxml2::XMLAttribute * attribute = node->FirstAttribute(); attribute; attribute = attribute->Next())
+    {
+        ConfigAttribute a = { 0 };
+        a.name = WriteString(attribute->Name(), strings);
+        a.value = WriteString(attribute->Value(), strings);
+        attributes.push_back(a);
+    }
+
+    LONG offset = static_cast<LONG>(m_data.size());
+    ConfigElement element = { 0 };
+    element.name = name - offset;
+    element.attribute_count = static_cast<DWORD>(attributes.size());
+    for (size_t i = 0; i < attributes.size(); i++)
+    {
+        attributes[i].name -= offset;
+        attributes[i].value -= offset;
+    }
+
+    m_data.resize(m_data.size() + sizeof(ConfigElement) + attributes.size() * sizeof(ConfigAttribute));
+    if (! attributes.empty())
+    {
+        memcpy(& m_data[offset + sizeof(ConfigElement)], & * attributes.begin(), attributes.size() * sizeof(ConfigAttribute));
+    }
+
+    // children follow their parent, each sibling links to the next one
+    LONG previous = 0;
+    for (const tinyxml2::XMLElement * child = node->FirstChildElement(); child; child = child->NextSiblingElement())
+    {
+        LONG child_offset = WriteElement(child, strings);
+        if (previous == 0) element.first_child = child_offset - offset;
+        else reinterpret_cast<ConfigElement *>(& m_data[previous])->next = child_offset - previous;
+        previous = child_offset;
+    }
+
+    memcpy(& m_data[offset], & element, sizeof(ConfigElement));
+    return offset;
+}
+
+bool ConfigImage::IsSupported(const char * data, size_t size)
+{
+    if (data == NULL || size < sizeof(Header) || reinterpret_cast<ULONG_PTR>(data) % sizeof(DWORD) != 0)
+        return false;
+
+    const Header * header = reinterpret_cast<const Header *>(data);
+    return header->magic == image_magic
+        && header->version == image_version
+        && header->size >= sizeof(Header)
+        && header->size <= size;
+}
+
+void ConfigImage::Attach(const char * data, size_t size)
+{
+    CHECK_BOOL(IsSupported(data, size),
+        L"Unsupported configuration image");
+
+    m_data.clear();
+    m_image = data;
+    m_size = reinterpret_cast<const Header *>(data)->size;
+    Validate();
+}
+
+void ConfigImage::Validate() const
+{
+    // every element is reached once and only through offsets that point forward
+    std::vector<bool> visited(m_size / sizeof(DWORD));
+    std::vector<LONGLONG> elements;
+    elements.push_back(reinterpret_cast<const Header *>(m_image)->root);
+    while (! elements.empty())
+    {
+        LONGLONG offset = elements.back();
+        elements.pop_back();
+
+        CHECK_BOOL(offset >= static_cast<LONGLONG>(sizeof(Header))
+            && offset % sizeof(DWORD) == 0
+            && offset + static_cast<LONGLONG>(sizeof(ConfigElement)) <= static_cast<LONGLONG>(m_size)
+            && ! visited[static_cast<size_t>(offset / sizeof(DWORD))],
+            L"Invalid configuration image, bad element at " << offset);
+
+        visited[static_cast<size_t>(offset / sizeof(DWORD))] = true;
+
+        const ConfigElement * element = reinterpret_cast<const ConfigElement *>(m_image + offset);
+        CHECK_BOOL(element->attribute_count <= (m_size - offset - sizeof(ConfigElement)) / sizeof(ConfigAttribute),
+            L"Invalid configuration image, bad attributes at " << offset);
+
+        ValidateString(offset + element->name);
+        const ConfigAttribute * attributes = element->GetAttributes();
+        for (DWORD i = 0; i < element->attribute_count; i++)
+        {
+            ValidateString(offset + attributes[i].name);
+            ValidateString(offset + attributes[i].value);
+        }
+
+        CHECK_BOOL(element->next >= 0 && element->first_child >= 0,
+            L"Invalid configuration image, bad links at " << offset);
+
+        if (element->next != 0) elements.push_back(offset + element->next);
+        if (element->first_child != 0) elements.push_back(offset + element->first_child);
+    }
+}
+
+void ConfigImage::ValidateString(LONGLONG offset) const
+{
+    CHECK_BOOL(offset >= static_cast<LONGLONG>(sizeof(Header))
+        && offset % sizeof(wchar_t) == 0
+        && offset < static_cast<LONGLONG>(m_size),
+        L"Invalid configuration image, bad string at " << offset);
+
+    const wchar_t * s = reinterpret_cast<const wchar_t *>(m_image + offset);
+    CHECK_BOOL(NULL != wmemchr(s, 0, static_cast<size_t>((m_size - offset) / sizeof(wchar_t))),
+        L"Invalid configuration image, unterminated string at " << offset);
+}
+
+const ConfigElement * ConfigImage::GetRoot() const
+{
+    CHECK_BOOL(m_image != NULL,
+        L"Missing configuration image");
+
+    return reinterpret_cast<const ConfigElement *>(m_image + reinterpret_cast<const Header *>(m_image)->root);
+}
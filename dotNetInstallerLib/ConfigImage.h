@@ -0,0 +1,54 @@
+#pragma once
+
+#include "ConfigElement.h"
+#include <tinyxml2.h>
+
+// a compiled configuration, the element tree with names and attribute values as UTF-16
+// loaded in place without parsing xml or converting strings, the linker embeds one next to the xml
+class ConfigImage
+{
+public:
+	struct Header
+	{
+		DWORD magic;
+		// layout version, images of any other version are rejected
+		DWORD version;
+		// image size in bytes
+		DWORD size;
+		// offset of the root element from the start of the image
+		LONG root;
+	};
+	// "DNIC"
+	static const DWORD image_magic = 0x43494E44;
+	static const DWORD image_version = 1;
+private:
+	// UTF-8 strings of the xml document being compiled, compared by value
+	struct StringLess
+	{
+		bool operator()(const char * left, const char * right) const { return strcmp(left, right) < 0; }
+	};
+
+	typedef std::map<const char *, LONG, StringLess> StringOffsets;
+	// data compiled from xml, empty when reading an image in place
+	std::vector<char> m_data;
+	const char * m_image;
+	size_t m_size;
+	LONG WriteString(const char * s, StringOffsets& strings);
+	LONG WriteElement(const tinyxml2::XMLElement * node, StringOffsets& strings);
+	void Validate() const;
+	void ValidateString(LONGLONG offset) const;
+	ConfigImage(const ConfigImage&);
+	ConfigImage& operator=(const ConfigImage&);
+public:
+	ConfigImage();
+	// compile an xml element tree, the size of the xml is a hint for the size of the image
+	void Compile(const tinyxml2::XMLElement * node, size_t xml_size = 0);
+	// read an image in place, the data must outlive this object, throws if the image is invalid
+	void Attach(const char * data, size_t size);
+	// true if the data is an image of this version
+	static bool IsSupported(const char * data, size_t size);
+	const ConfigElement * GetRoot() const;
+	const char * GetData() const { return m_image; }
+	size_t GetSize() const { return m_size; }
+	bool empty() const { return m_image == NULL; }
+};
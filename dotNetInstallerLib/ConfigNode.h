@@ -0,0 +1,10 @@
+#pragma once
+#include "ConfigArena.h"
+
+// base of configuration objects, allocated from the arena current while they're loaded
+class ConfigNode
+{
+public:
+	static void * operator new(size_t size) { return ConfigArena::New(size); }
+	static void operator delete(void * p) { ConfigArena::Delete(p); }
+};
@@ -9,23 +9,25 @@ Configuration::Configuration(configuration_type t)
 os_filter_min(DVLib::winNone),
 os_filter_max(DVLib::winNone),
 supports_install(false),
-supports_uninstall(false)
+supports_uninstall(false),
+m_element(NULL),
+m_arena(NULL)
 {
 
 }
 
 Configuration::~Configuration()
 {
-
+    if (m_arena) m_arena->Release();
 }
 
-void Configuration::Load(tinyxml2::XMLElement * node)
+void Configuration::Load(const ConfigElement * node)
 {
     CHECK_BOOL(node != NULL,
         L"Expected 'configuration' node");
 
-    CHECK_BOOL(0 == strcmp(node->Value(), "configuration"),
-        L"Expected 'configuration' node, got '" << DVLib::string2wstring(node->Value()) << L"'");
+    CHECK_BOOL(0 == wcscmp(node->Value(), L"configuration"),
+        L"Expected 'configuration' node, got '" << node->Value() << L"'");
 
     // locale
     lcid_filter = node->Attribute("lcid_filter");
@@ -43,11 +45,30 @@ void Configuration::Load(tinyxml2::XMLElement * node)
     supports_uninstall = XmlAttribute(node->Attribute("supports_uninstall")).GetBoolValue(true);
 }
 
+void Configuration::LoadIndex(const ConfigElement * node)
+{
+    Configuration::Load(node);
+    m_element = node;
+    m_arena = ConfigArena::GetCurrent();
+    if (m_arena) m_arena->AddRef();
+}
+
+void Configuration::Materialize()
+{
+    if (m_element == NULL)
+        return;
+
+    const ConfigElement * node = m_element;
+    m_element = NULL;
+    ConfigArenaScope scope(m_arena);
+    Load(node);
+}
+
 bool Configuration::IsSupported(LCID lcid) const
 {
     return DVLib::IsOperatingSystemLCIDValue(lcid, lcid_filter) &&
-        DVLib::IsProcessorArchitecture(DVLib::GetProcessorArchitecture(), processor_architecture_filter) &&
-        DVLib::IsInOperatingSystemInRange(DVLib::GetOperatingSystemVersion(), os_filter, os_filter_min, os_filter_max);
+        DVLib::IsProcessorArchitecture(InstallerSession::Instance->GetProcessorArchitecture(), processor_architecture_filter) &&
+        DVLib::IsInOperatingSystemInRange(InstallerSession::Instance->GetOperatingSystemVersion(), os_filter, os_filter_min, os_filter_max);
 }
 
 std::wstring Configuration::GetLanguageString() const
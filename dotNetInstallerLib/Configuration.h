@@ -4,7 +4,8 @@ class Component;
 
 #include "WidgetPosition.h"
 #include "XmlAttribute.h"
-#include <tinyxml2.h>
+#include "ConfigElement.h"
+#include "ConfigArena.h"
 
 enum configuration_type
 {
@@ -33,10 +34,22 @@ public:
 	// install mode
 	bool supports_install;
 	bool supports_uninstall;
+private:
+	// element of an indexed configuration until it's materialized
+	const ConfigElement * m_element;
+	// arena current when the configuration was indexed, its objects are allocated from it
+	ConfigArena * m_arena;
+	Configuration(const Configuration&);
+	Configuration& operator=(const Configuration&);
 public:
 	Configuration(configuration_type t);
 	virtual ~Configuration();
-	virtual void Load(tinyxml2::XMLElement * node);
+	virtual void Load(const ConfigElement * node);
+	// loads the filters only, the element must outlive the configuration until Materialize
+	void LoadIndex(const ConfigElement * node);
+	// loads the rest of a configuration indexed with LoadIndex
+	void Materialize();
+	bool IsMaterialized() const { return m_element == NULL; }
 	// returns true if this configuration is supported on this operating system/lcid
 	virtual bool IsSupported(LCID lcid) const;
 	virtual std::wstring GetLanguageString() const;
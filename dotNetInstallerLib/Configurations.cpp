@@ -19,39 +19,34 @@ Configurations::~Configurations()
 {
 }
 
-void Configurations::Load(tinyxml2::XMLElement * node)
+void Configurations::Load(const ConfigElement * node)
 {
     CHECK_BOOL(node != NULL,
         L"Expected 'configurations' node");
 
-    CHECK_BOOL(0 == strcmp(node->Value(), "configurations"),
-        L"Expected 'configurations' node, got '" << DVLib::string2wstring(node->Value()) << L"'");
+    CHECK_BOOL(0 == wcscmp(node->Value(), L"configurations"),
+        L"Expected 'configurations' node, got '" << node->Value() << L"'");
 
-    uilevel = InstallUILevelSetting::ToUILevel(DVLib::UTF8string2wstring(node->Attribute("ui_level")));
-    lcidtype = DVLib::wstring2lcidtype(DVLib::UTF8string2wstring(node->Attribute("lcid_type")));
-    fileversion = DVLib::UTF8string2wstring(node->Attribute("fileversion"));
-    productversion = DVLib::UTF8string2wstring(node->Attribute("productversion"));
+    uilevel = InstallUILevelSetting::ToUILevel(node->Attribute("ui_level"));
+    lcidtype = DVLib::wstring2lcidtype(node->Attribute("lcid_type"));
+    fileversion = node->Attribute("fileversion");
+    productversion = node->Attribute("productversion");
     // auto-enabled log options
-    log_enabled = DVLib::wstring2bool(DVLib::UTF8string2wstring(node->Attribute("log_enabled")), false);
+    log_enabled = DVLib::wstring2bool(node->Attribute("log_enabled"), false);
     log_file = node->Attribute("log_file");
     // language selection
-    show_language_selector = DVLib::wstring2bool(DVLib::UTF8string2wstring(node->Attribute("show_language_selector")), false);;
+    show_language_selector = DVLib::wstring2bool(node->Attribute("show_language_selector"), false);;
     language_selector_title = node->Attribute("language_selector_title");
     language_selector_ok = node->Attribute("language_selector_ok");
     language_selector_cancel = node->Attribute("language_selector_cancel");
     // no matching configuration message
-    configuration_no_match_message = DVLib::UTF8string2wstring(node->Attribute("configuration_no_match_message"));
+    configuration_no_match_message = node->Attribute("configuration_no_match_message");
 
-    for (tinyxml2::XMLNode* child = node->FirstChildElement(); child; child = child->NextSibling())
+    for (const ConfigElement * child_element = node->FirstChildElement(); child_element; child_element = child_element->NextSiblingElement())
     {
-        tinyxml2::XMLElement * child_element = child->ToElement();
-
-        if (child_element == NULL)
-            continue;
-
-        if (strcmp(child_element->Value(), "configuration") == 0)
+        if (wcscmp(child_element->Value(), L"configuration") == 0)
         {
-            std::wstring type = DVLib::UTF8string2wstring(child_element->Attribute("type"));
+            std::wstring type = child_element->Attribute("type");
             ConfigurationPtr configuration;
             if (type == L"reference") configuration = ConfigurationPtr(new ReferenceConfiguration());
             else if (type == L"install") configuration = ConfigurationPtr(new InstallConfiguration());
@@ -60,14 +55,14 @@ void Configurations::Load(tinyxml2::XMLElement * node)
                 THROW_EX(L"Invalid configuration type '" << type << L"'");
             }
 
-            configuration->Load(child_element);
+            configuration->LoadIndex(child_element);
             push_back(configuration);
         }
-        else if (strcmp(child_element->Value(), "schema") == 0)
+        else if (wcscmp(child_element->Value(), L"schema") == 0)
         {
             schema.Load(child_element);
         }
-        else if (strcmp(child_element->Value(), "fileattributes") == 0)
+        else if (wcscmp(child_element->Value(), L"fileattributes") == 0)
         {
             fileattributes.Load(child_element);
         }
@@ -80,11 +75,19 @@ void Configurations::Load(tinyxml2::XMLElement * node)
     LOG(L"--- Read " << size() << L" configuration(s)");
 }
 
+void Configurations::Materialize()
+{
+    for each(const ConfigurationPtr& configuration in (* this))
+    {
+        configuration->Materialize();
+    }
+}
+
 std::vector<ConfigurationPtr> Configurations::GetSupportedConfigurations(LCID lcid, InstallSequence sequence) const
 {
     if (lcid == 0) 
     {
-        lcid = DVLib::GetOperatingSystemLCID(lcidtype);
+        lcid = InstallerSession::Instance->GetOperatingSystemLCID(lcidtype);
     }
 
     LOG(L"-- Loading supported configurations (lcid=" << lcid << L")");
@@ -94,6 +97,7 @@ std::vector<ConfigurationPtr> Configurations::GetSupportedConfigurations(LCID lc
     {
         if (configuration->IsSupported(lcid))
         {
+            configuration->Materialize();
             switch(sequence)
             {
             case SequenceInstall:
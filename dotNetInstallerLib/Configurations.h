@@ -5,7 +5,7 @@
 #include "InstallUILevel.h"
 #include "FileAttributes.h"
 #include "InstallSequence.h"
-#include <tinyxml2.h>
+#include "ConfigElement.h"
 
 class Configurations : public std::vector< ConfigurationPtr >
 {
@@ -29,7 +29,10 @@ public:
 public:
 	Configurations();
 	virtual ~Configurations();
-	virtual void Load(tinyxml2::XMLElement * node);
+	// indexes configurations by their filters, children are loaded when a configuration is supported
+	virtual void Load(const ConfigElement * node);
+	// loads the children of all configurations
+	void Materialize();
 	// returns configurations that match current platform, lcid and processor architecture
 	std::vector<ConfigurationPtr> GetSupportedConfigurations(LCID lcid, InstallSequence sequence) const;
 	std::vector<std::wstring> GetLanguages() const;
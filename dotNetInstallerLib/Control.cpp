@@ -19,27 +19,22 @@ Control::~Control(void)
 {
 }
 
-void Control::Load(tinyxml2::XMLElement * node)
+void Control::Load(const ConfigElement * node)
 {
-    position.FromString(DVLib::UTF8string2wstring(node->Attribute("position")));
-    enabled = DVLib::wstring2bool(DVLib::UTF8string2wstring(node->Attribute("enabled")));
-    display_install = DVLib::wstring2bool(DVLib::UTF8string2wstring(node->Attribute("display_install")));
-    display_uninstall = DVLib::wstring2bool(DVLib::UTF8string2wstring(node->Attribute("display_uninstall")));
-    check = wstring2controlcheck(DVLib::UTF8string2wstring(node->Attribute("check")));
-    has_value_disabled = DVLib::wstring2bool(DVLib::UTF8string2wstring(node->Attribute("has_value_disabled")));
+    position.FromString(node->Attribute("position"));
+    enabled = DVLib::wstring2bool(node->Attribute("enabled"));
+    display_install = DVLib::wstring2bool(node->Attribute("display_install"));
+    display_uninstall = DVLib::wstring2bool(node->Attribute("display_uninstall"));
+    check = wstring2controlcheck(node->Attribute("check"));
+    has_value_disabled = DVLib::wstring2bool(node->Attribute("has_value_disabled"));
     // install checks, embed files, etc.
-    for (tinyxml2::XMLNode* child = node->FirstChildElement(); child; child = child->NextSibling())
+    for (const ConfigElement * child_element = node->FirstChildElement(); child_element; child_element = child_element->NextSiblingElement())
     {
-        tinyxml2::XMLElement * child_element = child->ToElement();
-
-        if (child_element == NULL)
-            continue;
-
-        std::wstring type = DVLib::UTF8string2wstring(child_element->Value());
+        std::wstring type = child_element->Value();
 
         if (type == L"installedcheck")
         {
-            std::wstring installedcheck_type = DVLib::UTF8string2wstring(child_element->Attribute("type"));
+            std::wstring installedcheck_type = child_element->Attribute("type");
             InstalledCheckPtr installedcheck(InstalledCheck::Create(installedcheck_type));
             installedcheck->Load(child_element);
             installedchecks.push_back(installedcheck);
@@ -71,7 +66,7 @@ bool Control::IsEnabled() const
     {
         for (size_t j = 0; j < installedchecks.size(); j++)
         {
-            if (! installedchecks[j]->IsInstalled())
+            if (! installedchecks[j]->Evaluate())
                 return false;
         }
     }
@@ -91,7 +86,7 @@ bool Control::IsVisible() const
     {
         for (size_t j = 0; j < installedchecks.size(); j++)
         {
-            if (! installedchecks[j]->IsInstalled())
+            if (! installedchecks[j]->Evaluate())
                 return false;
         }
     }
@@ -2,6 +2,7 @@
 #include "WidgetPosition.h"
 #include "InstalledCheck.h"
 #include "InstalledCheckOperator.h"
+#include "ConfigNode.h"
 
 enum control_type
 {
@@ -22,7 +23,7 @@ enum control_check
 	control_check_both, // both display and enabled
 };
 
-class Control
+class Control : public ConfigNode
 {
 public:
     Control(control_type t);
@@ -46,7 +47,7 @@ public:
 	// visible
 	bool IsVisible() const;
 	// load a control from an xml node
-	virtual void Load(tinyxml2::XMLElement * node);
+	virtual void Load(const ConfigElement * node);
 	// string representation of the control
 	virtual std::wstring GetString() const;
 	// convert a string into a check type
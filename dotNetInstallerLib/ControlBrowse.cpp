@@ -14,7 +14,7 @@ allow_edit(false)
 
 }
 
-void ControlBrowse::Load(tinyxml2::XMLElement * node)
+void ControlBrowse::Load(const ConfigElement * node)
 {
     id = node->Attribute("id");
     filter = node->Attribute("filter");
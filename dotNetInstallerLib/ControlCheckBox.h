@@ -1,6 +1,6 @@
 #pragma once
 #include "ControlText.h"
-#include <tinyxml2.h>
+#include "ConfigElement.h"
 
 class ControlCheckBox : public ControlText
 {
@@ -14,7 +14,7 @@ public:
 	// values
 	XmlAttribute checked_value;
 	XmlAttribute unchecked_value;
-	void Load(tinyxml2::XMLElement * node);
+	void Load(const ConfigElement * node);
 	std::wstring GetString() const;
 };
 
@@ -10,7 +10,7 @@ ControlEdit::ControlEdit()
 
 }
 
-void ControlEdit::Load(tinyxml2::XMLElement * node)
+void ControlEdit::Load(const ConfigElement * node)
 {
     id = node->Attribute("id");
     ControlText::Load(node);
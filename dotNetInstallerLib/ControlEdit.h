@@ -8,7 +8,7 @@ public:
 public:
 	// id
 	XmlAttribute id;
-	void Load(tinyxml2::XMLElement * node);
+	void Load(const ConfigElement * node);
 	std::wstring GetString() const;
 };
 
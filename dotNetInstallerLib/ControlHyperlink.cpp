@@ -10,7 +10,7 @@ ControlHyperlink::ControlHyperlink()
 
 }
 
-void ControlHyperlink::Load(tinyxml2::XMLElement * node)
+void ControlHyperlink::Load(const ConfigElement * node)
 {
     uri = node->Attribute("uri");
     ControlText::Load(node);
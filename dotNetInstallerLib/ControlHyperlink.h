@@ -7,7 +7,7 @@ public:
     ControlHyperlink();
 public:
 	XmlAttribute uri;
-	void Load(tinyxml2::XMLElement * node);
+	void Load(const ConfigElement * node);
 	std::wstring GetString() const;
 };
 
@@ -9,7 +9,7 @@ public:
 	XmlAttribute resource_id;
 	XmlAttribute image_file;
 	bool center;
-	void Load(tinyxml2::XMLElement * node);
+	void Load(const ConfigElement * node);
 	std::wstring GetString() const;
 };
 
@@ -10,7 +10,7 @@ ControlLabel::ControlLabel()
 
 }
 
-void ControlLabel::Load(tinyxml2::XMLElement * node)
+void ControlLabel::Load(const ConfigElement * node)
 {
     ControlText::Load(node);
 }
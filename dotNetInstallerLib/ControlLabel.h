@@ -6,7 +6,7 @@ class ControlLabel : public ControlText
 public:
     ControlLabel();
 public:
-	void Load(tinyxml2::XMLElement * node);
+	void Load(const ConfigElement * node);
 	std::wstring GetString() const;
 };
 
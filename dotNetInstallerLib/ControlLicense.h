@@ -11,7 +11,7 @@ public:
 	XmlAttribute license_file;
 	XmlAttribute accept_message;
 	bool accepted;
-	void Load(tinyxml2::XMLElement * node);
+	void Load(const ConfigElement * node);
 	std::wstring GetString() const;
 };
 
@@ -8,18 +8,19 @@
 DownloadDialog::DownloadDialog(const std::wstring& id)
 : auto_start(true)
 , callback(NULL)
+, prefetch(NULL)
 , component_id(id)
 {
 
 }
 
-void DownloadDialog::Load(tinyxml2::XMLElement * node)
+void DownloadDialog::Load(const ConfigElement * node)
 {
     CHECK_BOOL(node != NULL,
         L"Expected 'downloaddialog' node");
 
-    CHECK_BOOL(0 == strcmp(node->Value(), "downloaddialog"),
-        L"Expected 'downloaddialog' node, got '" << DVLib::string2wstring(node->Value()) << L"'");
+    CHECK_BOOL(0 == wcscmp(node->Value(), L"downloaddialog"),
+        L"Expected 'downloaddialog' node, got '" << node->Value() << L"'");
 
     caption = node->Attribute("dialog_caption");
     help_message = node->Attribute("dialog_message");
@@ -29,14 +30,10 @@ void DownloadDialog::Load(tinyxml2::XMLElement * node)
     sendingrequest_message = node->Attribute("dialog_message_sendingrequest");
     start_caption = node->Attribute("buttonstart_caption");
     cancel_caption = node->Attribute("buttoncancel_caption");
-    auto_start = DVLib::wstring2bool(DVLib::UTF8string2wstring(node->Attribute("autostartdownload")), false);
+    auto_start = DVLib::wstring2bool(node->Attribute("autostartdownload"), false);
 
-    for (tinyxml2::XMLNode* child = node->FirstChildElement(); child; child = child->NextSibling())
+    for (const ConfigElement * node_element = node->FirstChildElement(); node_element; node_element = node_element->NextSiblingElement())
     {
-        tinyxml2::XMLElement * node_element = child->ToElement();
-        if (node_element == NULL)
-            continue;
-
         auto_any<DownloadFile *, close_delete> downloadfile(new DownloadFile());
         downloadfile->Load(node_element);
         downloadfiles.push_back(downloadfile);
@@ -51,6 +48,16 @@ void DownloadDialog::Load(tinyxml2::XMLElement * node)
 }
 
 int DownloadDialog::ExecOnThread()
+{
+    if (prefetch != NULL)
+    {
+        return prefetch->Follow(callback);
+    }
+
+    return Download(callback);
+}
+
+int DownloadDialog::Download(IDownloadCallback * download_callback)
 {
     if (IsRequired())
     {
@@ -58,24 +65,24 @@ int DownloadDialog::ExecOnThread()
         {
             for (size_t i = 0; i < downloadfiles.size(); i++)
             {
-                if (callback && callback->IsDownloadCancelled())
+                if (download_callback && download_callback->IsDownloadCancelled())
                 {
                     return -2;
                 }
 
-                downloadfiles[i]->Exec(callback);
+                downloadfiles[i]->Exec(download_callback);
             }
 
-            if (callback)
+            if (download_callback)
             {
-                callback->DownloadComplete();
+                download_callback->DownloadComplete();
             }
         }
         catch(std::exception& ex)
         {
-            if (callback)
+            if (download_callback)
             {
-                callback->DownloadError(DVLib::string2wstring(ex.what()).c_str());
+                download_callback->DownloadError(DVLib::string2wstring(ex.what()).c_str());
             }
 
             throw;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "DownloadCallback.h"
+#include "DownloadPrefetch.h"
 #include "ThreadComponent.h"
 #include "DownloadFile.h"
 
@@ -9,6 +10,8 @@ class DownloadDialog : public ThreadComponent
 public:
 	// download callback
 	IDownloadCallback * callback;
+	// a download of the same files already in progress, followed instead of starting over
+	IDownloadPrefetch * prefetch;
 	// download window caption
 	XmlAttribute caption;
 	// component name
@@ -33,8 +36,10 @@ public:
 	bool IsDownloadRequired() const;
 	bool IsRequired() const;
 	DownloadDialog(const std::wstring& name = L"");
-	void Load(tinyxml2::XMLElement * node);
+	void Load(const ConfigElement * node);
 	int ExecOnThread();
+	// download or copy all files reporting progress to a callback other than the dialog's
+	int Download(IDownloadCallback * download_callback);
 	std::wstring GetString(int indent = 0) const;
 };
 
@@ -4,6 +4,7 @@
 #include "InstallConfiguration.h"
 #include "InstallerLog.h"
 #include "InstallerSession.h"
+#include <wininet.h>
 
 DownloadFile::DownloadFile()
 : callback(NULL)
@@ -18,21 +19,21 @@ DownloadFile::~DownloadFile()
 
 }
 
-void DownloadFile::Load(tinyxml2::XMLElement * node)
+void DownloadFile::Load(const ConfigElement * node)
 {
     CHECK_BOOL(node != NULL,
         L"Expected 'download' node");
 
-    CHECK_BOOL(0 == strcmp(node->Value(), "download"),
-        L"Expected 'download' node, got '" << DVLib::string2wstring(node->Value()) << L"'");
+    CHECK_BOOL(0 == wcscmp(node->Value(), L"download"),
+        L"Expected 'download' node, got '" << node->Value() << L"'");
 
     componentname = node->Attribute("componentname");
     sourceurl = node->Attribute("sourceurl");
     sourcepath = node->Attribute("sourcepath");
     destinationpath = node->Attribute("destinationpath");
     destinationfilename = node->Attribute("destinationfilename");
-    alwaysdownload = DVLib::wstring2bool(DVLib::UTF8string2wstring(node->Attribute("alwaysdownload")), true);		
-    clear_cache = DVLib::wstring2bool(DVLib::UTF8string2wstring(node->Attribute("clear_cache")), false);		
+    alwaysdownload = DVLib::wstring2bool(node->Attribute("alwaysdownload"), true);		
+    clear_cache = DVLib::wstring2bool(node->Attribute("clear_cache"), false);		
 
     LOG(L"Loaded 'download' dialog component '" << componentname 
         << L"', source=" << (sourceurl.empty() ? sourcepath : sourceurl));
@@ -191,6 +192,131 @@ bool DownloadFile::ClearCache()
     return true;
 }
 
+std::wstring DownloadFile::GetSourceVersion() const
+{
+    if (! sourcepath.empty() && DVLib::FileExists(sourcepath))
+    {
+        return GetSourceFileVersion(sourcepath);
+    }
+
+    if (! sourceurl.empty())
+    {
+        return GetSourceUrlVersion();
+    }
+
+    return L"";
+}
+
+std::wstring DownloadFile::GetSourceFileVersion(const std::wstring& filename)
+{
+    WIN32_FILE_ATTRIBUTE_DATA data = { 0 };
+    if (! ::GetFileAttributesEx(filename.c_str(), GetFileExInfoStandard, & data))
+        return L"";
+
+    ULARGE_INTEGER size = { data.nFileSizeLow, data.nFileSizeHigh };
+    ULARGE_INTEGER modified = { data.ftLastWriteTime.dwLowDateTime, data.ftLastWriteTime.dwHighDateTime };
+    std::wstringstream ss;
+    ss << L"size=" << size.QuadPart << L",modified=" << modified.QuadPart;
+    return ss.str();
+}
+
+std::wstring DownloadFile::GetSourceUrlVersion() const
+{
+    const std::wstring& url = sourceurl.GetValue();
+
+    // file:// urls are checked like a source path
+    if (DVLib::startswith(DVLib::lowercase(url), L"file:"))
+    {
+        wchar_t filename[MAX_PATH] = { 0 };
+        DWORD filename_size = ARRAYSIZE(filename);
+        if (FAILED(::PathCreateFromUrlW(url.c_str(), filename, & filename_size, 0)))
+            return L"";
+        return GetSourceFileVersion(filename);
+    }
+
+    // WinINet functions supported on Windows 2000 and later
+    typedef BOOL (WINAPI * pInternetCrackUrl) (LPCWSTR lpszUrl, DWORD dwUrlLength, DWORD dwFlags, LPURL_COMPONENTSW lpUrlComponents);
+    typedef HINTERNET (WINAPI * pInternetOpen) (LPCWSTR lpszAgent, DWORD dwAccessType, LPCWSTR lpszProxy, LPCWSTR lpszProxyBypass, DWORD dwFlags);
+    typedef HINTERNET (WINAPI * pInternetConnect) (HINTERNET hInternet, LPCWSTR lpszServerName, INTERNET_PORT nServerPort, LPCWSTR lpszUserName, LPCWSTR lpszPassword, DWORD dwService, DWORD dwFlags, DWORD_PTR dwContext);
+    typedef HINTERNET (WINAPI * pHttpOpenRequest) (HINTERNET hConnect, LPCWSTR lpszVerb, LPCWSTR lpszObjectName, LPCWSTR lpszVersion, LPCWSTR lpszReferrer, LPCWSTR * lplpszAcceptTypes, DWORD dwFlags, DWORD_PTR dwContext);
+    typedef BOOL (WINAPI * pHttpSendRequest) (HINTERNET hRequest, LPCWSTR lpszHeaders, DWORD dwHeadersLength, LPVOID lpOptional, DWORD dwOptionalLength);
+    typedef BOOL (WINAPI * pHttpQueryInfo) (HINTERNET hRequest, DWORD dwInfoLevel, LPVOID lpBuffer, LPDWORD lpdwBufferLength, LPDWORD lpdwIndex);
+    typedef BOOL (WINAPI * pInternetCloseHandle) (HINTERNET hInternet);
+    DllFunction<pInternetCrackUrl> internetCrackUrl(L"wininet.dll", "InternetCrackUrlW");
+    DllFunction<pInternetOpen> internetOpen(L"wininet.dll", "InternetOpenW");
+    DllFunction<pInternetConnect> internetConnect(L"wininet.dll", "InternetConnectW");
+    DllFunction<pHttpOpenRequest> httpOpenRequest(L"wininet.dll", "HttpOpenRequestW");
+    DllFunction<pHttpSendRequest> httpSendRequest(L"wininet.dll", "HttpSendRequestW");
+    DllFunction<pHttpQueryInfo> httpQueryInfo(L"wininet.dll", "HttpQueryInfoW");
+    DllFunction<pInternetCloseHandle> internetCloseHandle(L"wininet.dll", "InternetCloseHandle");
+    if (NULL == internetCrackUrl || NULL == internetOpen || NULL == internetConnect || NULL == httpOpenRequest
+        || NULL == httpSendRequest || NULL == httpQueryInfo || NULL == internetCloseHandle)
+    {
+        LOG(L"Skipping checking '" << url << L"', function not available.");
+        return L"";
+    }
+
+    wchar_t host[INTERNET_MAX_HOST_NAME_LENGTH] = { 0 };
+    wchar_t path[INTERNET_MAX_URL_LENGTH] = { 0 };
+    wchar_t extra[INTERNET_MAX_URL_LENGTH] = { 0 };
+    URL_COMPONENTSW components = { 0 };
+    components.dwStructSize = sizeof(components);
+    components.lpszHostName = host;
+    components.dwHostNameLength = ARRAYSIZE(host);
+    components.lpszUrlPath = path;
+    components.dwUrlPathLength = ARRAYSIZE(path);
+    components.lpszExtraInfo = extra;
+    components.dwExtraInfoLength = ARRAYSIZE(extra);
+    if (! internetCrackUrl(url.c_str(), 0, 0, & components)
+        || (components.nScheme != INTERNET_SCHEME_HTTP && components.nScheme != INTERNET_SCHEME_HTTPS))
+    {
+        LOG(L"Skipping checking '" << url << L"', not an http url.");
+        return L"";
+    }
+
+    std::wstring error = L"Ignoring error checking '" + url + L"'";
+    std::wstringstream ss;
+    HINTERNET hInternet = internetOpen(L"dotNetInstaller", INTERNET_OPEN_TYPE_PRECONFIG, NULL, NULL, 0);
+    HINTERNET hConnect = (hInternet == NULL) ? NULL : internetConnect(hInternet, host, components.nPort, NULL, NULL, INTERNET_SERVICE_HTTP, 0, 0);
+    // only the response headers are transferred
+    std::wstring object = std::wstring(path) + extra;
+    DWORD flags = INTERNET_FLAG_RELOAD | INTERNET_FLAG_NO_CACHE_WRITE | INTERNET_FLAG_NO_UI
+        | (components.nScheme == INTERNET_SCHEME_HTTPS ? INTERNET_FLAG_SECURE : 0);
+    HINTERNET hRequest = (hConnect == NULL) ? NULL : httpOpenRequest(hConnect, L"HEAD", object.c_str(), NULL, NULL, NULL, flags, 0);
+    if (hRequest == NULL || ! httpSendRequest(hRequest, NULL, 0, NULL, 0))
+    {
+        LOG(DVLib::GetLastErrorStringW(error.c_str()));
+    }
+    else
+    {
+        DWORD status = 0;
+        DWORD status_size = sizeof(status);
+        wchar_t etag[1024] = { 0 };
+        DWORD etag_size = sizeof(etag);
+        wchar_t modified[256] = { 0 };
+        DWORD modified_size = sizeof(modified);
+        if (! httpQueryInfo(hRequest, HTTP_QUERY_STATUS_CODE | HTTP_QUERY_FLAG_NUMBER, & status, & status_size, NULL)
+            || status < 200 || status >= 300)
+        {
+            LOG(L"Ignoring checking '" << url << L"', status " << status);
+        }
+        else
+        {
+            bool has_etag = httpQueryInfo(hRequest, HTTP_QUERY_ETAG, etag, & etag_size, NULL) ? true : false;
+            bool has_modified = httpQueryInfo(hRequest, HTTP_QUERY_LAST_MODIFIED, modified, & modified_size, NULL) ? true : false;
+            if (has_etag || has_modified)
+            {
+                ss << L"etag=" << etag << L",modified=" << modified;
+            }
+        }
+    }
+
+    if (hRequest != NULL) internetCloseHandle(hRequest);
+    if (hConnect != NULL) internetCloseHandle(hConnect);
+    if (hInternet != NULL) internetCloseHandle(hInternet);
+    return ss.str();
+}
+
 HRESULT DownloadFile::OnProgress(ULONG ulProgress, ULONG ulProgressMax, ULONG ulStatusCode, LPCWSTR /* wszStatusText */)
 {
     if (! callback)
@@ -2,9 +2,10 @@
 
 #include "DownloadCallback.h"
 #include "XmlAttribute.h"
-#include <tinyxml2.h>
+#include "ConfigElement.h"
+#include "ConfigNode.h"
 
-class DownloadFile : public IBindStatusCallback
+class DownloadFile : public IBindStatusCallback, public ConfigNode
 {
 public:
 	IDownloadCallback * callback;
@@ -30,11 +31,17 @@ public:
 	std::wstring GetDestinationFileName() const;
 	DownloadFile();
 	virtual ~DownloadFile();
-	void Load(tinyxml2::XMLElement * node);
+	void Load(const ConfigElement * node);
 	void Exec(IDownloadCallback * callback);
 	std::wstring GetString(int indent = 0) const;
 	// delete downloaded file cache
 	bool ClearCache();
+	// describes the current state of the source: size and modification time of the source path
+	// file, or ETag and Last-Modified of the source url from a HEAD request; empty when it can't be
+	// determined
+	std::wstring GetSourceVersion() const;
+	// size and modification time of a file, empty if it doesn't exist
+	static std::wstring GetSourceFileVersion(const std::wstring& filename);
 public:
 	// IBindStatusCallback
 	STDMETHOD(OnStartBinding)(DWORD dwReserved, IBinding __RPC_FAR *pib);
@@ -52,6 +59,7 @@ public:
 private:
 	void CopyFromSourcePath();
 	void DownloadFromSourceUrl();
+	std::wstring GetSourceUrlVersion() const;
 };
 
 typedef shared_any<DownloadFile *, close_delete> DownloadFilePtr;
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "DownloadCallback.h"
+
+// a download already in progress in the background
+class IDownloadPrefetch
+{
+public:
+	// reports the remaining progress to a callback and waits for the download to complete
+	virtual int Follow(IDownloadCallback * callback) = 0;
+};
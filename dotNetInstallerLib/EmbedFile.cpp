@@ -10,13 +10,13 @@ EmbedFile::EmbedFile()
 
 }
 
-void EmbedFile::Load(tinyxml2::XMLElement * node)
+void EmbedFile::Load(const ConfigElement * node)
 {
     CHECK_BOOL(node != NULL,
         L"Expected 'embedfile' node");
 
-    CHECK_BOOL(0 == strcmp(node->Value(), "embedfile"),
-        L"Expected 'embedfile' node, got '" << DVLib::string2wstring(node->Value()) << L"'");
+    CHECK_BOOL(0 == wcscmp(node->Value(), L"embedfile"),
+        L"Expected 'embedfile' node, got '" << node->Value() << L"'");
 
     sourcefilepath = node->Attribute("sourcefilepath");
     targetfilepath = node->Attribute("targetfilepath");
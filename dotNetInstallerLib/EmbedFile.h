@@ -1,14 +1,15 @@
 #pragma once
-#include <tinyxml2.h>
+#include "ConfigElement.h"
+#include "ConfigNode.h"
 
-class EmbedFile
+class EmbedFile : public ConfigNode
 {
 public:
 	XmlAttribute sourcefilepath;
 	XmlAttribute targetfilepath;
 public:
 	EmbedFile();
-	virtual void Load(tinyxml2::XMLElement * node);
+	virtual void Load(const ConfigElement * node);
 };
 
 typedef shared_any<EmbedFile *, close_delete> EmbedFilePtr;
\ No newline at end of file
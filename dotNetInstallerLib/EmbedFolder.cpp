@@ -10,13 +10,13 @@ EmbedFolder::EmbedFolder()
 
 }
 
-void EmbedFolder::Load(tinyxml2::XMLElement * node)
+void EmbedFolder::Load(const ConfigElement * node)
 {
     CHECK_BOOL(node != NULL,
         L"Expected 'embedfolder' node");
 
-    CHECK_BOOL(0 == strcmp(node->Value(), "embedfolder"),
-        L"Expected 'embedfolder' node, got '" << DVLib::string2wstring(node->Value()) << L"'");
+    CHECK_BOOL(0 == wcscmp(node->Value(), L"embedfolder"),
+        L"Expected 'embedfolder' node, got '" << node->Value() << L"'");
 
     sourcefolderpath = node->Attribute("sourcefolderpath");
     targetfolderpath = node->Attribute("targetfolderpath");
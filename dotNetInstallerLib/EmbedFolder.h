@@ -1,14 +1,15 @@
 #pragma once
-#include <tinyxml2.h>
+#include "ConfigElement.h"
+#include "ConfigNode.h"
 
-class EmbedFolder
+class EmbedFolder : public ConfigNode
 {
 public:
 	XmlAttribute sourcefolderpath;
 	XmlAttribute targetfolderpath;
 public:
 	EmbedFolder();
-	virtual void Load(tinyxml2::XMLElement * node);
+	virtual void Load(const ConfigElement * node);
 };
 
 typedef shared_any<EmbedFolder *, close_delete> EmbedFolderPtr;
\ No newline at end of file
@@ -0,0 +1,271 @@
+#include "StdAfx.h"
+#include "ExpansionTemplate.h"
+#include "InstallerSession.h"
+
+// stand-ins for variables while tokenizing user variables, noncharacters never appear in configuration text
+static const wchar_t variable_placeholder = 0xFFFF;
+static const wchar_t user_placeholder = 0xFFFE;
+static const wchar_t placeholders[] = { variable_placeholder, user_placeholder, 0 };
+
+ExpansionTemplate::ExpansionTemplate()
+: m_compiled(true)
+{
+}
+
+ExpansionTemplate::ExpansionTemplate(const std::wstring& source)
+: m_compiled(true)
+{
+    Compile(source);
+}
+
+void ExpansionTemplate::Compile(const std::wstring& source)
+{
+    m_source = source;
+    m_tokens.clear();
+    m_compiled = Tokenize(source);
+    if (! m_compiled)
+    {
+        m_tokens.clear();
+    }
+}
+
+void ExpansionTemplate::AddToken(token_type type, const std::wstring& value, bool trim_backslash)
+{
+    Token token;
+    token.type = type;
+    token.value = value;
+    token.trim_backslash = trim_backslash;
+    m_tokens.push_back(token);
+}
+
+// Tokenizes a value the way InstallerSession::ExpandVariables expands it, environment variables first,
+// then path, registry and user variables. Returns false when the result of a pass may depend on a value
+// substituted by an earlier one, eg. #%NAME% or [#CABPATH], the template is then expanded in full.
+bool ExpansionTemplate::Tokenize(const std::wstring& s)
+{
+    if (s.find_first_of(L"%#@[]") == s.npos)
+    {
+        if (! s.empty()) AddToken(token_literal, s);
+        return true;
+    }
+
+    if (s.find_first_of(placeholders) != s.npos)
+        return false;
+
+    // environment variables are pairs of %'s, left to right
+    std::vector<std::wstring::size_type> env_close(s.size(), s.npos);
+    std::wstring::size_type i = 0, j = 0;
+    while (((i = s.find(L"%", i)) != s.npos) && ((j = s.find(L"%", i + 1)) != s.npos))
+    {
+        if (i + 1 != j) env_close[i] = j;
+        i = j + 1;
+    }
+
+    // environment, path and registry variables
+    std::vector<Token> variables;
+    std::wstring skeleton;
+    i = 0;
+    while (i < s.size())
+    {
+        Token variable;
+        variable.trim_backslash = false;
+        if (env_close[i] != s.npos)
+        {
+            variable.type = token_environment;
+            variable.value = s.substr(i + 1, env_close[i] - i - 1);
+            // an undefined variable is left as is and must not form other variables
+            if (variable.value.find_first_of(L"#@[]") != s.npos)
+                return false;
+            i = env_close[i] + 1;
+        }
+        else if (s[i] == L'#')
+        {
+            j = i + 1;
+            while(j != s.size() && isalpha(s[j]))
+                j++;
+
+            // the name would run into the value of an environment variable
+            if (j != s.size() && env_close[j] != s.npos)
+                return false;
+
+            if (i + 1 == j)
+            {
+                skeleton.append(1, s[i++]);
+                continue;
+            }
+
+            variable.type = token_path;
+            variable.value = s.substr(i + 1, j - i - 1);
+            variable.trim_backslash = (j != s.size() && s[j] == L'\\');
+            i = j;
+        }
+        else if (s.compare(i, 2, L"@[") == 0 && (j = s.find(L"]", i + 2)) != s.npos)
+        {
+            variable.type = token_registry;
+            variable.value = s.substr(i + 2, j - i - 2);
+            // @[] skips what follows, variables within a registry path are expanded first
+            if (variable.value.empty() || variable.value.find_first_of(L"%#[") != s.npos)
+                return false;
+            i = j + 1;
+        }
+        else
+        {
+            skeleton.append(1, s[i++]);
+            continue;
+        }
+
+        variables.push_back(variable);
+        skeleton.append(1, variable_placeholder);
+    }
+
+    // an escape sequence may be completed by a variable value
+    if (skeleton.find(std::wstring(L"[") + variable_placeholder) != skeleton.npos)
+        return false;
+
+    // user variables and escapes, as in InstallerSession::ExpandUserVariables
+    static wchar_t const openBracketEscape[] = L"[\\[]";
+    static size_t const openBracketEscapeSize = sizeof(openBracketEscape) / sizeof(openBracketEscape[0])- 1;
+    static wchar_t const closeBracketEscape[] = L"[\\]]";
+    static size_t const closeBracketEscapeSize = sizeof(closeBracketEscape) / sizeof(closeBracketEscape[0]) - 1;
+
+    std::vector<std::wstring> users;
+    std::wstring::size_type current = 0, open = skeleton.npos;
+    while ((current = skeleton.find_first_of(L"[]", current)) != skeleton.npos) {
+        if (skeleton[current] == L'[') {
+            if (skeleton.compare(current, openBracketEscapeSize, openBracketEscape, openBracketEscapeSize) == 0) {
+                skeleton.erase(++current, openBracketEscapeSize - 1);
+            } else if (skeleton.compare(current, closeBracketEscapeSize, closeBracketEscape, closeBracketEscapeSize) == 0) {
+                skeleton.erase(current++, closeBracketEscapeSize - 1);
+            } else if (open == skeleton.npos) {
+                open = current++;
+            } else {
+                ++current;
+            }
+        } else if (open != skeleton.npos) {
+            if (open + 1 == current) {
+                ++current;
+            } else {
+                std::wstring name = skeleton.substr(open + 1, current - open - 1);
+                // the name of a user variable contains another variable
+                if (name.find(variable_placeholder) != name.npos)
+                    return false;
+                users.push_back(name);
+                skeleton.replace(open, current - open + 1, 1, user_placeholder);
+                current = open + 1;
+            }
+            open = skeleton.npos;
+        } else {
+            ++current;
+        }
+    }
+
+    std::vector<Token>::const_iterator variable = variables.begin();
+    std::vector<std::wstring>::const_iterator user = users.begin();
+    std::wstring literal;
+    for (i = 0; i < skeleton.size(); i++)
+    {
+        if (skeleton[i] != variable_placeholder && skeleton[i] != user_placeholder)
+        {
+            literal.append(1, skeleton[i]);
+            continue;
+        }
+
+        if (! literal.empty())
+        {
+            AddToken(token_literal, literal);
+            literal.clear();
+        }
+
+        if (skeleton[i] == variable_placeholder)
+        {
+            m_tokens.push_back(* variable++);
+        }
+        else
+        {
+            AddToken(token_user, * user++);
+        }
+    }
+
+    if (! literal.empty())
+    {
+        AddToken(token_literal, literal);
+    }
+
+    return true;
+}
+
+bool ExpansionTemplate::DependsOn(token_type type, const std::wstring& name) const
+{
+    if (! m_compiled)
+        return true;
+
+    for each(const Token& token in m_tokens)
+    {
+        if (token.type == type && token.value == name)
+            return true;
+
+        // eg. an environment variable whose value contains [name]
+        if (token.type != token_literal && token.type < type)
+            return true;
+    }
+
+    return false;
+}
+
+std::wstring ExpansionTemplate::Expand() const
+{
+    if (! m_compiled)
+        return InstallerSession::Instance->ExpandVariables(m_source);
+
+    if (m_tokens.empty())
+        return L"";
+
+    if (m_tokens.size() == 1 && m_tokens[0].type == token_literal)
+        return m_tokens[0].value;
+
+    std::wstring result;
+    for each(const Token& token in m_tokens)
+    {
+        std::wstring value;
+        switch(token.type)
+        {
+        case token_literal:
+            result.append(token.value);
+            break;
+        case token_environment:
+            value = DVLib::GetEnvironmentVariable(token.value);
+            // undefined variables are left for the command interpreter
+            if (value.empty())
+            {
+                result.append(L"%").append(token.value).append(L"%");
+                break;
+            }
+            // variable values that contain variables are expanded by subsequent passes
+            if (value.find_first_of(L"#@[]") != value.npos)
+                return InstallerSession::Instance->ExpandVariables(m_source);
+            result.append(value);
+            break;
+        case token_path:
+            CHECK_BOOL(InstallerSession::Instance->GetPathVariable(token.value, value),
+                L"Invalid variable #" << token.value << L" in '" << m_source << L"'");
+            // don't introduce double-backslashes for paths, bug 4378
+            if (token.trim_backslash)
+                value = DVLib::trimright(value, L"\\");
+            if (value.find_first_of(L"@[]") != value.npos)
+                return InstallerSession::Instance->ExpandVariables(m_source);
+            result.append(value);
+            break;
+        case token_registry:
+            value = InstallerSession::Instance->GetRegistryVariable(token.value);
+            if (value.find_first_of(L"[]") != value.npos)
+                return InstallerSession::Instance->ExpandVariables(m_source);
+            result.append(value);
+            break;
+        case token_user:
+            result.append(InstallerSession::Instance->GetUserVariable(token.value));
+            break;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+// an attribute value tokenized once into literals and typed variable references,
+// expanding a compiled template is a single concatenation pass over its tokens
+class ExpansionTemplate
+{
+public:
+	// in the order in which variables are expanded
+	enum token_type
+	{
+		token_literal = 0, // text copied as is
+		token_environment, // %name%
+		token_path, // #NAME
+		token_registry, // @[key|key,default]
+		token_user, // [name]
+	};
+
+	struct Token
+	{
+		token_type type;
+		// literal text or variable name
+		std::wstring value;
+		// a #NAME followed by a backslash, trailing backslashes are trimmed from the value
+		bool trim_backslash;
+	};
+private:
+	std::wstring m_source;
+	std::vector<Token> m_tokens;
+	bool m_compiled;
+public:
+	ExpansionTemplate();
+	ExpansionTemplate(const std::wstring& source);
+	// tokenize a value, values that can't be tokenized unambiguously are expanded in full
+	void Compile(const std::wstring& source);
+	// expand the value in the current session, equivalent to InstallerSession::ExpandVariables
+	std::wstring Expand() const;
+	const std::wstring& GetSource() const { return m_source; }
+	const std::vector<Token>& GetTokens() const { return m_tokens; }
+	// false when the template falls back to InstallerSession::ExpandVariables
+	bool IsCompiled() const { return m_compiled; }
+	// true when the value has no variables
+	bool IsLiteral() const { return m_compiled && (m_tokens.empty() || (m_tokens.size() == 1 && m_tokens[0].type == token_literal)); }
+	bool empty() const { return m_source.empty(); }
+	// true if the expanded value may change with the value of a variable, values that are
+	// expanded in full and values of variables expanded earlier may depend on any variable
+	bool DependsOn(token_type type, const std::wstring& name) const;
+private:
+	bool Tokenize(const std::wstring& source);
+	void AddToken(token_type type, const std::wstring& value, bool trim_backslash = false);
+};
@@ -0,0 +1,74 @@
+#include "StdAfx.h"
+#include "ExpansionTemplatePool.h"
+
+ExpansionTemplatePool::ExpansionTemplatePool()
+: m_used(block_size)
+, m_hits(0)
+, m_misses(0)
+{
+    ::InitializeCriticalSection(& m_cs);
+}
+
+ExpansionTemplatePool::~ExpansionTemplatePool()
+{
+    for each(ExpansionTemplate * block in m_blocks)
+    {
+        delete[] block;
+    }
+
+    ::DeleteCriticalSection(& m_cs);
+}
+
+ExpansionTemplatePool& ExpansionTemplatePool::Instance()
+{
+    static ExpansionTemplatePool instance;
+    return instance;
+}
+
+const ExpansionTemplate * ExpansionTemplatePool::Intern(const std::wstring& source)
+{
+    if (source.empty())
+        return NULL;
+
+    const ExpansionTemplate * result = NULL;
+    ::EnterCriticalSection(& m_cs);
+    try
+    {
+        std::map<const std::wstring *, const ExpansionTemplate *, SourceLess>::const_iterator it = m_templates.find(& source);
+        if (it != m_templates.end())
+        {
+            m_hits++;
+            result = it->second;
+        }
+        else
+        {
+            if (m_used == block_size)
+            {
+                m_blocks.push_back(new ExpansionTemplate[block_size]);
+                m_used = 0;
+            }
+
+            ExpansionTemplate * value = m_blocks.back() + m_used;
+            value->Compile(source);
+            m_templates.insert(std::make_pair(& value->GetSource(), value));
+            m_used++;
+            m_misses++;
+            result = value;
+        }
+    }
+    catch(...)
+    {
+        ::LeaveCriticalSection(& m_cs);
+        throw;
+    }
+    ::LeaveCriticalSection(& m_cs);
+    return result;
+}
+
+size_t ExpansionTemplatePool::size()
+{
+    ::EnterCriticalSection(& m_cs);
+    size_t result = m_templates.size();
+    ::LeaveCriticalSection(& m_cs);
+    return result;
+}
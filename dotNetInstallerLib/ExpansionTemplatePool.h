@@ -0,0 +1,40 @@
+#pragma once
+
+#include "ExpansionTemplate.h"
+
+// compiled attribute values interned by source, each distinct value is tokenized and stored
+// once and shared by all attributes that hold it; values live as long as the process since
+// attributes are copied across configurations and sessions
+class ExpansionTemplatePool
+{
+private:
+	struct SourceLess
+	{
+		bool operator()(const std::wstring * lhs, const std::wstring * rhs) const { return * lhs < * rhs; }
+	};
+	// number of templates allocated at a time
+	static const size_t block_size = 256;
+	CRITICAL_SECTION m_cs;
+	// templates never move or get freed, the last block is filled up to m_used
+	std::vector<ExpansionTemplate *> m_blocks;
+	size_t m_used;
+	// templates by their source
+	std::map<const std::wstring *, const ExpansionTemplate *, SourceLess> m_templates;
+	LONG m_hits;
+	LONG m_misses;
+public:
+	ExpansionTemplatePool();
+	~ExpansionTemplatePool();
+	// returns the shared template for a value, NULL for an empty value
+	const ExpansionTemplate * Intern(const std::wstring& source);
+	// number of distinct values
+	size_t size();
+	// number of values returned from and added to the pool
+	LONG GetHits() const { return m_hits; }
+	LONG GetMisses() const { return m_misses; }
+	// process-wide instance
+	static ExpansionTemplatePool& Instance();
+private:
+	ExpansionTemplatePool(const ExpansionTemplatePool&);
+	ExpansionTemplatePool& operator=(const ExpansionTemplatePool&);
+};
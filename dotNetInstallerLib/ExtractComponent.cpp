@@ -101,8 +101,8 @@ BOOL ExtractComponent::OnBeforeCopyFile(Cabinet::CExtract::kCabinetFileInfo * k_
 
 std::vector<std::wstring> ExtractComponent::GetCabFiles() const
 {
-    std::vector<wchar_t> v_buffer = DVLib::LoadResourceData<wchar_t>(m_h, L"RES_CAB_LIST", L"CUSTOM");
-    std::wstring s_buffer(& * v_buffer.begin(), v_buffer.size());
+    DVLib::ResourceView<wchar_t> v_buffer = DVLib::GetResourceView<wchar_t>(m_h, L"RES_CAB_LIST", L"CUSTOM");
+    std::wstring s_buffer(v_buffer.data, v_buffer.size);
     return DVLib::split(s_buffer, L"\r\n");
 }
 
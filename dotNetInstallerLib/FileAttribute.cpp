@@ -9,13 +9,13 @@ FileAttribute::FileAttribute()
 
 }
 
-void FileAttribute::Load(tinyxml2::XMLElement * node)
+void FileAttribute::Load(const ConfigElement * node)
 {
     CHECK_BOOL(node != NULL,
         L"Expected 'fileattribute' node");
 
-    CHECK_BOOL(0 == strcmp(node->Value(), "fileattribute"),
-        L"Expected 'fileattribute' node, got '" << DVLib::string2wstring(node->Value()) << L"'");
+    CHECK_BOOL(0 == wcscmp(node->Value(), L"fileattribute"),
+        L"Expected 'fileattribute' node, got '" << node->Value() << L"'");
 
     name = node->Attribute("name");
     value = node->Attribute("value");
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "XmlAttribute.h"
-#include <tinyxml2.h>
+#include "ConfigElement.h"
 
 class FileAttribute
 {
@@ -10,6 +10,6 @@ public:
 	XmlAttribute value;
 public:
 	FileAttribute();
-	virtual void Load(tinyxml2::XMLElement * node);
+	virtual void Load(const ConfigElement * node);
 };
 
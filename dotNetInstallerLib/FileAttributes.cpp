@@ -11,22 +11,17 @@ FileAttributes::~FileAttributes()
 {
 }
 
-void FileAttributes::Load(tinyxml2::XMLElement * node)
+void FileAttributes::Load(const ConfigElement * node)
 {
     CHECK_BOOL(node != NULL,
         L"Expected 'fileattributes' node");
 
-    CHECK_BOOL(0 == strcmp(node->Value(), "fileattributes"),
-        L"Expected 'fileattributes' node, got '" << DVLib::string2wstring(node->Value()) << L"'");
+    CHECK_BOOL(0 == wcscmp(node->Value(), L"fileattributes"),
+        L"Expected 'fileattributes' node, got '" << node->Value() << L"'");
 
-    for (tinyxml2::XMLNode* child = node->FirstChildElement(); child; child = child->NextSibling())
+    for (const ConfigElement * child_element = node->FirstChildElement(); child_element; child_element = child_element->NextSiblingElement())
     {
-        tinyxml2::XMLElement * child_element = child->ToElement();
-
-        if (child_element == NULL)
-            continue;
-
-        if (strcmp(child_element->Value(), "fileattribute") == 0)
+        if (wcscmp(child_element->Value(), L"fileattribute") == 0)
         {
             FileAttributePtr fileattribute(new FileAttribute());
             fileattribute->Load(child_element);
@@ -35,18 +35,21 @@ show_progress_dialog(true),
 show_cab_dialog(true),
 disable_wow64_fs_redirection(false),
 cab_path_autodelete(false),
-administrator_required(false)
+administrator_required(false),
+max_concurrent_components(1),
+prefetch_extract_depth(0),
+prefetch_download_depth(0)
 {
 
 }
 
-void InstallConfiguration::Load(tinyxml2::XMLElement * node)
+void InstallConfiguration::Load(const ConfigElement * node)
 {
     CHECK_BOOL(node != NULL,
         L"Expected 'configuration' node");
 
-    CHECK_BOOL(0 == strcmp(node->Value(), "configuration"),
-        L"Expected 'configuration' node, got '" << DVLib::string2wstring(node->Value()) << L"'");
+    CHECK_BOOL(0 == wcscmp(node->Value(), L"configuration"),
+        L"Expected 'configuration' node, got '" << node->Value() << L"'");
 
     Configuration::Load(node);
 
@@ -55,15 +58,15 @@ void InstallConfiguration::Load(tinyxml2::XMLElement * node)
     InstallerSession::Instance->cabpath = cab_path.GetValue();
     cab_path_autodelete = XmlAttribute(node->Attribute("cab_path_autodelete")).GetBoolValue(true);
     // positions within the dialog
-    dialog_position.FromString(DVLib::UTF8string2wstring(node->Attribute("dialog_position")));
-    dialog_components_list_position.FromString(DVLib::UTF8string2wstring(node->Attribute("dialog_components_list_position")));
-    dialog_message_position.FromString(DVLib::UTF8string2wstring(node->Attribute("dialog_message_position")));
-    dialog_bitmap_position.FromString(DVLib::UTF8string2wstring(node->Attribute("dialog_bitmap_position")));
-    dialog_otherinfo_link_position.FromString(DVLib::UTF8string2wstring(node->Attribute("dialog_otherinfo_link_position")));
-    dialog_osinfo_position.FromString(DVLib::UTF8string2wstring(node->Attribute("dialog_osinfo_position")));
-    dialog_install_button_position.FromString(DVLib::UTF8string2wstring(node->Attribute("dialog_install_button_position")));
-    dialog_cancel_button_position.FromString(DVLib::UTF8string2wstring(node->Attribute("dialog_cancel_button_position")));
-    dialog_skip_button_position.FromString(DVLib::UTF8string2wstring(node->Attribute("dialog_skip_button_position")));
+    dialog_position.FromString(node->Attribute("dialog_position"));
+    dialog_components_list_position.FromString(node->Attribute("dialog_components_list_position"));
+    dialog_message_position.FromString(node->Attribute("dialog_message_position"));
+    dialog_bitmap_position.FromString(node->Attribute("dialog_bitmap_position"));
+    dialog_otherinfo_link_position.FromString(node->Attribute("dialog_otherinfo_link_position"));
+    dialog_osinfo_position.FromString(node->Attribute("dialog_osinfo_position"));
+    dialog_install_button_position.FromString(node->Attribute("dialog_install_button_position"));
+    dialog_cancel_button_position.FromString(node->Attribute("dialog_cancel_button_position"));
+    dialog_skip_button_position.FromString(node->Attribute("dialog_skip_button_position"));
     // other dialog options
     dialog_default_button = node->Attribute("dialog_default_button");
     cancel_caption = node->Attribute("cancel_caption");
@@ -116,14 +119,24 @@ void InstallConfiguration::Load(tinyxml2::XMLElement * node)
     // administrator required
     administrator_required = XmlAttribute(node->Attribute("administrator_required")).GetBoolValue(false);
     administrator_required_message = node->Attribute("administrator_required_message");
+    // concurrent component execution
+    std::wstring max_concurrent_components_value = XmlAttribute(node->Attribute("max_concurrent_components")).GetValue();
+    max_concurrent_components = max_concurrent_components_value.empty() ? 1 : DVLib::wstring2long(max_concurrent_components_value);
+    CHECK_BOOL(max_concurrent_components >= 1 && max_concurrent_components <= MAXIMUM_WAIT_OBJECTS,
+        L"Invalid max_concurrent_components: " << max_concurrent_components_value);
+    // prefetching of components that follow the one being installed
+    std::wstring prefetch_extract_depth_value = XmlAttribute(node->Attribute("prefetch_extract_depth")).GetValue();
+    prefetch_extract_depth = prefetch_extract_depth_value.empty() ? 0 : DVLib::wstring2long(prefetch_extract_depth_value);
+    CHECK_BOOL(prefetch_extract_depth >= 0,
+        L"Invalid prefetch_extract_depth: " << prefetch_extract_depth_value);
+    std::wstring prefetch_download_depth_value = XmlAttribute(node->Attribute("prefetch_download_depth")).GetValue();
+    prefetch_download_depth = prefetch_download_depth_value.empty() ? 0 : DVLib::wstring2long(prefetch_download_depth_value);
+    CHECK_BOOL(prefetch_download_depth >= 0,
+        L"Invalid prefetch_download_depth: " << prefetch_download_depth_value);
     // components
-    for ( tinyxml2::XMLNode* child = node->FirstChildElement("component"); child; child = child->NextSiblingElement("component") )
+    for (const ConfigElement * node_component = node->FirstChildElement("component"); node_component; node_component = node_component->NextSiblingElement("component"))
     {
-        tinyxml2::XMLElement * node_component = child->ToElement();
-        if (node_component == NULL)
-            continue;
-
-        std::wstring component_type = DVLib::UTF8string2wstring(node_component->Attribute("type"));
+        std::wstring component_type = node_component->Attribute("type");
 
         shared_any<Component *, close_delete> component;
         if (component_type == L"msi") component = shared_any<Component *, close_delete>(new MsiComponent());
@@ -142,13 +155,9 @@ void InstallConfiguration::Load(tinyxml2::XMLElement * node)
     }
 
     // controls
-    for ( tinyxml2::XMLNode* child = node->FirstChildElement("control"); child; child = child->NextSiblingElement("control") )
+    for (const ConfigElement * node_control = node->FirstChildElement("control"); node_control; node_control = node_control->NextSiblingElement("control"))
     {
-        tinyxml2::XMLElement * node_control = child->ToElement();
-        if (node_control == NULL)
-            continue;
-
-        std::wstring control_type = DVLib::UTF8string2wstring(node_control->Attribute("type"));
+        std::wstring control_type = node_control->Attribute("type");
 
         shared_any<Control *, close_delete> control;
         if (control_type == L"label") reset(control, new ControlLabel());
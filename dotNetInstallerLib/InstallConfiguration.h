@@ -88,9 +88,14 @@ public:
 	// administrator required
 	bool administrator_required;
 	XmlAttribute administrator_required_message;
+	// maximum number of components that execute at the same time
+	int max_concurrent_components;
+	// number of components ahead whose embedded CABs and downloads are prefetched
+	int prefetch_extract_depth;
+	int prefetch_download_depth;
 public:
 	InstallConfiguration();
-	virtual void Load(tinyxml2::XMLElement * node);
+	virtual void Load(const ConfigElement * node);
 	// returns components that match current platform and processor architecture
 	Components GetSupportedComponents(DVLib::LcidType lcidtype, InstallSequence sequence) const;
 	ComponentPtr GetComponentPtr(Component * pc) const;
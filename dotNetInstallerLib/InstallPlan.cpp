@@ -0,0 +1,94 @@
+#include "StdAfx.h"
+#include "InstallPlan.h"
+#include "InstallConfiguration.h"
+#include "InstallerSession.h"
+#include "InstallerLog.h"
+
+InstallPlan::InstallPlan()
+: configuration(0)
+, reference(false)
+{
+
+}
+
+void InstallPlan::Evaluate(const Configurations& config)
+{
+    machine = get(InstallerSession::Instance->GetMachine()) != NULL
+        ? InstallerSession::Instance->GetMachine()->name
+        : L"localhost";
+    configuration = 0;
+    reference = false;
+    components.clear();
+
+    std::vector<ConfigurationPtr> supported = config.GetSupportedConfigurations(
+        InstallerSession::Instance->languageid, InstallerSession::Instance->sequence);
+    if (supported.empty())
+        return;
+
+    for (size_t i = 0; i < config.size(); i++)
+    {
+        if (get(config[i]) == get(supported[0]))
+        {
+            configuration = static_cast<int>(i + 1);
+            break;
+        }
+    }
+
+    if (supported[0]->type != configuration_install)
+    {
+        // reference configurations are downloaded when the installer runs
+        reference = true;
+        return;
+    }
+
+    InstallConfiguration * p = reinterpret_cast<InstallConfiguration *>(get(supported[0]));
+    Components supported_components = p->GetSupportedComponents(
+        InstallerSession::Instance->lcidtype, InstallerSession::Instance->sequence);
+
+    DVLib::RegistrySnapshotScope registry_snapshot(InstallerSession::Instance->registry);
+    InstalledCheckMemoScope installed_checks(InstallerSession::Instance->installed_checks);
+    // check inputs recorded for another machine don't apply to this one
+    for each (const ComponentPtr& component in supported_components)
+    {
+        reset(component->installed_inputs);
+    }
+
+    supported_components.LoadInstalled();
+
+    for each (const ComponentPtr& component in supported_components)
+    {
+        PlannedComponent planned = { component->id, component->installed };
+        components.push_back(planned);
+    }
+}
+
+size_t InstallPlan::GetInstallCount() const
+{
+    size_t count = 0;
+    for each (const PlannedComponent& component in components)
+    {
+        if (! component.installed)
+            count++;
+    }
+    return count;
+}
+
+std::wstring InstallPlan::GetString() const
+{
+    std::wstringstream ss;
+    ss << machine << L"\t";
+    if (configuration == 0) ss << L"none";
+    else ss << configuration;
+    if (reference) ss << L" (reference)";
+    ss << L"\t" << components.size() << L"\t" << (components.size() - GetInstallCount()) << L"\t";
+    bool first = true;
+    for each (const PlannedComponent& component in components)
+    {
+        if (component.installed)
+            continue;
+        if (! first) ss << L",";
+        ss << component.id;
+        first = false;
+    }
+    return ss.str();
+}
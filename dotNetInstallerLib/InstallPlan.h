@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Configurations.h"
+
+// components that a configuration would install on a machine, evaluated without installing
+// anything; load a machine snapshot with InstallerSession::SetMachine to evaluate another machine
+class InstallPlan
+{
+public:
+	struct PlannedComponent
+	{
+		std::wstring id;
+		bool installed;
+	};
+	// machine snapshot name
+	std::wstring machine;
+	// 1-based index of the first supported configuration, 0 if none is supported
+	int configuration;
+	// true if the first supported configuration is a reference to another configuration file
+	bool reference;
+	// supported components of the configuration in install order
+	std::vector<PlannedComponent> components;
+public:
+	InstallPlan();
+	void Evaluate(const Configurations& config);
+	// number of supported components that aren't installed
+	size_t GetInstallCount() const;
+	// a single line, machine, configuration, number of supported and installed components and the
+	// ids of components to install, separated by tabs
+	std::wstring GetString() const;
+};
@@ -4,6 +4,9 @@
 #include "InstalledCheckFile.h"
 #include "InstalledCheckDirectory.h"
 #include "InstalledCheckProduct.h"
+#include "InstalledCheckProgram.h"
+#include "InstallerSession.h"
+#include "InstallerLog.h"
 
 InstalledCheck::InstalledCheck()
 {
@@ -15,6 +18,82 @@ InstalledCheck::~InstalledCheck()
 
 }
 
+bool InstalledCheck::Evaluate() const
+{
+    InstalledCheckMemo& memo = InstallerSession::Instance->installed_checks;
+    if (! memo.IsActive())
+        return EvaluateTimed();
+
+    std::wstring fingerprint = GetFingerprint();
+    if (fingerprint.empty())
+        return EvaluateTimed();
+
+    bool installed = false;
+    if (memo.Find(fingerprint, installed))
+        return installed;
+
+    // errors are not memoized, a check that fails is evaluated again
+    installed = EvaluateTimed();
+    memo.Add(fingerprint, installed);
+    return installed;
+}
+
+bool InstalledCheck::EvaluateTimed() const
+{
+    LARGE_INTEGER frequency = { 0 }, start = { 0 }, end = { 0 };
+    ::QueryPerformanceFrequency(& frequency);
+    ::QueryPerformanceCounter(& start);
+    bool installed = IsInstalled();
+    ::QueryPerformanceCounter(& end);
+    // operators include the time taken by their checks
+    LOG(L"Evaluated " << GetString() << L" (cost=" << GetCost() << L"): "
+        << (installed ? L"INSTALLED" : L"NOT INSTALLED") << L" in "
+        << ((end.QuadPart - start.QuadPart) * 1000000 / frequency.QuadPart) << L" us");
+    return installed;
+}
+
+void InstalledCheck::Compile(InstalledCheckProgram& program) const
+{
+    program.EmitCheck(installedcheck_op_check, this);
+}
+
+std::wstring InstalledCheck::GetString() const
+{
+    return L"installed check";
+}
+
+std::vector<InstalledCheckPtr> InstalledCheck::SortByCost(const std::vector<InstalledCheckPtr>& installedchecks)
+{
+    std::vector<installedcheck_cost> costs;
+    std::vector<InstalledCheckPtr> result;
+    costs.reserve(installedchecks.size());
+    result.reserve(installedchecks.size());
+    for each(const InstalledCheckPtr& installedcheck in installedchecks)
+    {
+        installedcheck_cost cost = installedcheck->GetCost();
+        // insert after all checks of the same or lower cost
+        size_t i = result.size();
+        while (i > 0 && costs[i - 1] > cost)
+            i--;
+        costs.insert(costs.begin() + i, cost);
+        result.insert(result.begin() + i, installedcheck);
+    }
+
+    return result;
+}
+
+std::wstring InstalledCheck::GetFingerprint() const
+{
+    return L"";
+}
+
+void InstalledCheck::AppendFingerprint(std::wstring& fingerprint, const std::wstring& value)
+{
+    fingerprint.append(DVLib::towstring(value.size()));
+    fingerprint.append(1, L':');
+    fingerprint.append(value);
+}
+
 InstalledCheckPtr InstalledCheck::Create(const std::wstring& installedcheck_type)
 {
     if (installedcheck_type == L"check_registry_value")
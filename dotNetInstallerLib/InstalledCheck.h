@@ -1,14 +1,49 @@
 #pragma once
-#include <tinyxml2.h>
+#include "ConfigElement.h"
+#include "ConfigNode.h"
+#include "ExpansionTemplate.h"
 
-class InstalledCheck
+// estimated cost of evaluating an installed check, cheaper checks are evaluated first
+enum installedcheck_cost
+{
+	installedcheck_cost_file_exists = 0, // file or directory attributes
+	installedcheck_cost_registry, // registry key or value
+	installedcheck_cost_file_version, // file version resource
+	installedcheck_cost_product, // installed MSI products
+};
+
+class InstalledCheck;
+class InstalledCheckInputs;
+class InstalledCheckProgram;
+typedef shared_any<InstalledCheck *, close_delete> InstalledCheckPtr;
+
+class InstalledCheck : public ConfigNode
 {
 public:
     InstalledCheck();
     virtual ~InstalledCheck();
 	virtual bool IsInstalled() const = 0;
-    virtual void Load(tinyxml2::XMLElement * node) = 0;
+    virtual void Load(const ConfigElement * node) = 0;
+	// IsInstalled, identical checks are evaluated once within an InstalledCheckMemoScope
+	bool Evaluate() const;
+	// identifies the check by its type and expanded attributes, empty if results can't be shared
+	virtual std::wstring GetFingerprint() const;
+	// estimated cost class, checks of unknown cost are evaluated last
+	virtual installedcheck_cost GetCost() const { return installedcheck_cost_product; }
+	// add the state the check reads, returns false if the check may read anything else
+	virtual bool GetInputs(InstalledCheckInputs& inputs) const { return false; }
+	// true if the result may change with the value of a variable, checks of unknown attributes may depend on any
+	virtual bool DependsOn(ExpansionTemplate::token_type type, const std::wstring& name) const { return true; }
+	// emit the instructions that evaluate the check, checks of unknown type are evaluated through Evaluate
+	virtual void Compile(InstalledCheckProgram& program) const;
+	virtual std::wstring GetString() const;
 	static shared_any<InstalledCheck *, close_delete> Create(const std::wstring& installedcheck_type);
+	// checks in order of cost, checks of the same cost keep their order
+	static std::vector<InstalledCheckPtr> SortByCost(const std::vector<InstalledCheckPtr>& installedchecks);
+protected:
+	// append a length-prefixed value, fingerprints of different values never collide
+	static void AppendFingerprint(std::wstring& fingerprint, const std::wstring& value);
+private:
+	// IsInstalled, logs the time taken
+	bool EvaluateTimed() const;
 };
-
-typedef shared_any<InstalledCheck *, close_delete> InstalledCheckPtr;
@@ -0,0 +1,72 @@
+#include "StdAfx.h"
+#include "InstalledCheckComparison.h"
+
+InstalledCheckComparison::InstalledCheckComparison()
+: m_type(installedcheck_comparison_none)
+{
+
+}
+
+InstalledCheckComparison& InstalledCheckComparison::operator=(const std::wstring& value)
+{
+    m_value = value;
+    m_type = m_value.IsLiteral() ? Parse(m_value.GetValue()) : installedcheck_comparison_invalid;
+    return * this;
+}
+
+InstalledCheckComparison& InstalledCheckComparison::operator=(const wchar_t * value)
+{
+    return operator=(std::wstring(value));
+}
+
+installedcheck_comparison InstalledCheckComparison::GetType() const
+{
+    return m_value.IsLiteral() ? m_type : Parse(m_value.GetValue());
+}
+
+bool InstalledCheckComparison::Test(int order) const
+{
+    installedcheck_comparison type = GetType();
+    switch(type)
+    {
+    case installedcheck_comparison_match:
+    case installedcheck_comparison_version_eq:
+        return order == 0;
+    case installedcheck_comparison_version:
+    case installedcheck_comparison_version_patch:
+    case installedcheck_comparison_version_ge:
+        return order >= 0;
+    case installedcheck_comparison_version_lt:
+        return order < 0;
+    case installedcheck_comparison_version_le:
+        return order <= 0;
+    case installedcheck_comparison_version_gt:
+        return order > 0;
+    default:
+        THROW_EX(L"Invalid comparison type: " << GetValue());
+    }
+}
+
+installedcheck_comparison InstalledCheckComparison::Parse(const std::wstring& name)
+{
+    if (name.empty()) return installedcheck_comparison_none;
+    else if (name == L"exists") return installedcheck_comparison_exists;
+    else if (name == L"key_exists") return installedcheck_comparison_key_exists;
+    else if (name == L"value_exists") return installedcheck_comparison_value_exists;
+    else if (name == L"match") return installedcheck_comparison_match;
+    else if (name == L"contains") return installedcheck_comparison_contains;
+    else if (name == L"version") return installedcheck_comparison_version;
+    else if (name == L"version_patch") return installedcheck_comparison_version_patch;
+    else if (name == L"version_eq") return installedcheck_comparison_version_eq;
+    else if (name == L"version_lt") return installedcheck_comparison_version_lt;
+    else if (name == L"version_le") return installedcheck_comparison_version_le;
+    else if (name == L"version_gt") return installedcheck_comparison_version_gt;
+    else if (name == L"version_ge") return installedcheck_comparison_version_ge;
+    else return installedcheck_comparison_invalid;
+}
+
+std::wostream& operator<<(std::wostream& os, const InstalledCheckComparison& comparison)
+{
+    os << comparison.GetValue();
+    return os;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "XmlAttribute.h"
+
+// comparison operators of installed checks
+enum installedcheck_comparison
+{
+	installedcheck_comparison_none = 0, // not set
+	installedcheck_comparison_invalid, // not one of the names below
+	installedcheck_comparison_exists, // exists
+	installedcheck_comparison_key_exists, // key_exists
+	installedcheck_comparison_value_exists, // value_exists
+	installedcheck_comparison_match, // match
+	installedcheck_comparison_contains, // contains
+	installedcheck_comparison_version, // version, greater or equal
+	installedcheck_comparison_version_patch, // version_patch, greater or equal
+	installedcheck_comparison_version_eq, // version_eq
+	installedcheck_comparison_version_lt, // version_lt
+	installedcheck_comparison_version_le, // version_le
+	installedcheck_comparison_version_gt, // version_gt
+	installedcheck_comparison_version_ge, // version_ge
+};
+
+// the comparison attribute of an installed check, parsed once when assigned unless it has variables
+class InstalledCheckComparison
+{
+private:
+	XmlAttribute m_value;
+	installedcheck_comparison m_type;
+public:
+	InstalledCheckComparison();
+	InstalledCheckComparison& operator=(const std::wstring&);
+	InstalledCheckComparison& operator=(const wchar_t *);
+	// comparison operator, values with variables are parsed each time
+	installedcheck_comparison GetType() const;
+	std::wstring GetValue() const { return m_value.GetValue(); }
+	bool empty() const { return m_value.empty(); }
+	bool IsLiteral() const { return m_value.IsLiteral(); }
+	bool DependsOn(ExpansionTemplate::token_type type, const std::wstring& name) const { return m_value.DependsOn(type, name); }
+	// version comparisons and match; order is negative, zero or positive as the installed
+	// value is lesser, equal or greater than the check value
+	bool Test(int order) const;
+	operator std::wstring() const { return GetValue(); }
+	static installedcheck_comparison Parse(const std::wstring& name);
+};
+
+std::wostream& operator<<(std::wostream& os, const InstalledCheckComparison& comparison);
@@ -1,5 +1,7 @@
 #include "StdAfx.h"
 #include "InstalledCheckDirectory.h"
+#include "InstalledCheckProgram.h"
+#include "InstalledCheckInputs.h"
 #include "InstallerLog.h"
 #include "InstallConfiguration.h"
 #include "InstallerSession.h"
@@ -8,13 +10,43 @@ InstalledCheckDirectory::InstalledCheckDirectory()
 {
 }
 
-void InstalledCheckDirectory::Load(tinyxml2::XMLElement * node)
+void InstalledCheckDirectory::Load(const ConfigElement * node)
 {
-    path = InstallerSession::Instance->ExpandVariables(DVLib::UTF8string2wstring(node->Attribute("path")));
+    path = node->Attribute("path");
     LOG(L"Loaded 'directory' installed check '" << path << L"'");
 }
 
 bool InstalledCheckDirectory::IsInstalled() const
 {
-    return DVLib::DirectoryExists(path);
+    return InstallerSession::Instance->file_versions.DirectoryExists(path);
+}
+
+std::wstring InstalledCheckDirectory::GetFingerprint() const
+{
+    std::wstring fingerprint(L"check_directory");
+    AppendFingerprint(fingerprint, path);
+    return fingerprint;
+}
+
+void InstalledCheckDirectory::Compile(InstalledCheckProgram& program) const
+{
+    program.EmitCheck(installedcheck_op_directory, this);
+}
+
+bool InstalledCheckDirectory::DependsOn(ExpansionTemplate::token_type type, const std::wstring& name) const
+{
+    return path.DependsOn(type, name);
+}
+
+bool InstalledCheckDirectory::GetInputs(InstalledCheckInputs& inputs) const
+{
+    inputs.AddFile(path);
+    return true;
+}
+
+std::wstring InstalledCheckDirectory::GetString() const
+{
+    std::wstringstream ss;
+    ss << L"'directory' installed check '" << path << L"'";
+    return ss.str();
 }
@@ -1,15 +1,22 @@
 #pragma once
 #include "InstalledCheck.h"
+#include "XmlAttribute.h"
 
 class InstalledCheckDirectory : public InstalledCheck
 {
 public:
 	// full path to the directory to check
-	std::wstring path;
+	XmlAttribute path;
 public:
     InstalledCheckDirectory();
-    void Load(tinyxml2::XMLElement * node);
+    void Load(const ConfigElement * node);
 	virtual bool IsInstalled() const;
+	std::wstring GetFingerprint() const;
+	installedcheck_cost GetCost() const { return installedcheck_cost_file_exists; }
+	bool GetInputs(InstalledCheckInputs& inputs) const;
+	bool DependsOn(ExpansionTemplate::token_type type, const std::wstring& name) const;
+	void Compile(InstalledCheckProgram& program) const;
+	std::wstring GetString() const;
 };
 
 typedef shared_any<InstalledCheckDirectory *, close_delete> InstalledCheckDirectoryPtr;
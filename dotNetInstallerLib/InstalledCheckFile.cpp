@@ -1,6 +1,8 @@
 #include "StdAfx.h"
 #include "XmlAttribute.h"
 #include "InstalledCheckFile.h"
+#include "InstalledCheckProgram.h"
+#include "InstalledCheckInputs.h"
 #include "InstallerLog.h"
 #include "InstallConfiguration.h"
 #include "InstallerSession.h"
@@ -11,13 +13,16 @@ InstalledCheckFile::InstalledCheckFile()
 {
 }
 
-void InstalledCheckFile::Load(tinyxml2::XMLElement * node)
+void InstalledCheckFile::Load(const ConfigElement * node)
 {
     filename = node->Attribute("filename");
     fileversion = node->Attribute("fileversion");
-    comparison = DVLib::UTF8string2wstring(node->Attribute("comparison"));
+    comparison = node->Attribute("comparison");
     defaultvalue = node->Attribute("defaultvalue");
     disableWow64FsRedirection = XmlAttribute(node->Attribute("disable_wow64_fs_redirection")).GetBoolValue(false);
+    // comparisons with variables are checked when evaluated
+    CHECK_BOOL(! comparison.IsLiteral() || IsSupported(comparison.GetType()),
+        L"Invalid comparison type \"" << comparison << L"\" in 'file' installed check '" << filename.GetSource() << L"'");
     LOG(L"Loaded 'file' installed check '" << filename << L"'");
 }
 
@@ -36,35 +41,46 @@ bool InstalledCheckFile::IsInstalled() const
     }
 }
 
+bool InstalledCheckFile::IsSupported(installedcheck_comparison comparison)
+{
+    switch(comparison)
+    {
+    case installedcheck_comparison_none:
+    case installedcheck_comparison_exists:
+    case installedcheck_comparison_match:
+    case installedcheck_comparison_version:
+    case installedcheck_comparison_version_eq:
+    case installedcheck_comparison_version_lt:
+    case installedcheck_comparison_version_le:
+    case installedcheck_comparison_version_gt:
+    case installedcheck_comparison_version_ge:
+        return true;
+    default:
+        return false;
+    }
+}
+
 bool InstalledCheckFile::IsInstalledInternal() const
 {
-    if (comparison == TEXT("exists"))
+    installedcheck_comparison comparison_type = comparison.GetType();
+    if (comparison_type == installedcheck_comparison_exists)
     {
-        return DVLib::FileExists(filename);
+        return InstallerSession::Instance->file_versions.FileExists(filename);
     }
 
     bool default_result = defaultvalue.GetBoolValue(false);
 
-    if (DVLib::FileExists(filename))
+    if (InstallerSession::Instance->file_versions.FileExists(filename))
     {
         if (!fileversion.empty())
         {
-            std::wstring fileversion_current = DVLib::GetFileVersion(filename);
-            LOG(L"File version: " << filename << L" - " << fileversion_current);
-            if (comparison == TEXT("match"))
-                return (fileversion == fileversion_current);
-            else if (comparison == TEXT("version"))
-                return (DVLib::CompareVersion(fileversion_current, fileversion) >= 0);
-            else if (comparison == TEXT("version_eq"))
-                return (DVLib::CompareVersion(fileversion_current, fileversion) == 0);
-            else if (comparison == TEXT("version_gt"))
-                return (DVLib::CompareVersion(fileversion_current, fileversion) > 0);
-            else if (comparison == TEXT("version_ge"))
-                return (DVLib::CompareVersion(fileversion_current, fileversion) >= 0);
-            else if (comparison == TEXT("version_lt"))
-                return (DVLib::CompareVersion(fileversion_current, fileversion) < 0);
-            else if (comparison == TEXT("version_le"))
-                return (DVLib::CompareVersion(fileversion_current, fileversion) <= 0);
+            // the same files are often checked by several components and on every refresh
+            DVLib::Version fileversion_current = InstallerSession::Instance->file_versions.GetVersion(filename);
+            LOG(L"File version: " << filename << L" - " << fileversion_current.ToString());
+            if (comparison_type == installedcheck_comparison_match)
+                return (fileversion == fileversion_current.ToString());
+            else if (comparison_type != installedcheck_comparison_none && IsSupported(comparison_type))
+                return comparison.Test(fileversion_current.Compare(fileversion.GetVersion()));
             else
             {
                 THROW_EX(L"Invalid comparison type \"" << comparison << L"\"");
@@ -81,4 +97,50 @@ bool InstalledCheckFile::IsInstalledInternal() const
     }
 
     return default_result;
+}
+
+std::wstring InstalledCheckFile::GetFingerprint() const
+{
+    std::wstring fingerprint(L"check_file");
+    AppendFingerprint(fingerprint, filename);
+    AppendFingerprint(fingerprint, fileversion);
+    AppendFingerprint(fingerprint, comparison);
+    AppendFingerprint(fingerprint, defaultvalue);
+    AppendFingerprint(fingerprint, disableWow64FsRedirection ? L"1" : L"0");
+    return fingerprint;
+}
+
+void InstalledCheckFile::Compile(InstalledCheckProgram& program) const
+{
+    program.EmitCheck(installedcheck_op_file, this);
+}
+
+bool InstalledCheckFile::DependsOn(ExpansionTemplate::token_type type, const std::wstring& name) const
+{
+    return filename.DependsOn(type, name)
+        || fileversion.DependsOn(type, name)
+        || comparison.DependsOn(type, name)
+        || defaultvalue.DependsOn(type, name);
+}
+
+installedcheck_cost InstalledCheckFile::GetCost() const
+{
+    // the version resource is only read when a version is compared
+    if (comparison.GetType() == installedcheck_comparison_exists || fileversion.empty())
+        return installedcheck_cost_file_exists;
+
+    return installedcheck_cost_file_version;
+}
+
+bool InstalledCheckFile::GetInputs(InstalledCheckInputs& inputs) const
+{
+    inputs.AddFile(filename, disableWow64FsRedirection);
+    return true;
+}
+
+std::wstring InstalledCheckFile::GetString() const
+{
+    std::wstringstream ss;
+    ss << L"'file' installed check '" << filename << L"'";
+    return ss.str();
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "XmlAttribute.h"
 #include "InstalledCheck.h"
+#include "InstalledCheckComparison.h"
+#include "VersionAttribute.h"
 
 class InstalledCheckFile : public InstalledCheck
 {
@@ -9,19 +11,26 @@ public:
 	// percorso del file da cercare
 	XmlAttribute filename;
 	// versione del file (se "" non viene verificata la versione ma solo la presenza del file)
-	XmlAttribute fileversion; 
+	VersionAttribute fileversion; 
 	// tipo di comparazione : match (verifica se le due stringhe sono uguali) version (che tratta le due stringhe come versioni e quindi se quella richiesta  minore bisogna installare altrimenti no)
-	XmlAttribute comparison; 
+	InstalledCheckComparison comparison; 
 	// default value when the file doesn't exist and the comparison is other than 'exists'
 	XmlAttribute defaultvalue; 
 	// wow64 fs redirection
 	bool disableWow64FsRedirection;
 public:
     InstalledCheckFile();
-    void Load(tinyxml2::XMLElement * node);
+    void Load(const ConfigElement * node);
 	virtual bool IsInstalled() const;
+	std::wstring GetFingerprint() const;
+	installedcheck_cost GetCost() const;
+	bool GetInputs(InstalledCheckInputs& inputs) const;
+	bool DependsOn(ExpansionTemplate::token_type type, const std::wstring& name) const;
+	void Compile(InstalledCheckProgram& program) const;
+	std::wstring GetString() const;
 private:
 	bool IsInstalledInternal() const;
+	static bool IsSupported(installedcheck_comparison comparison);
 };
 
 typedef shared_any<InstalledCheckFile *, close_delete> InstalledCheckFilePtr;
@@ -0,0 +1,182 @@
+#include "StdAfx.h"
+#include "InstalledCheckInputs.h"
+#include "InstallerSession.h"
+#include "Wow64NativeFS.h"
+
+// 64-bit FNV-1a
+static const ULONGLONG hash_offset_basis = 14695981039346656037ULL;
+static const ULONGLONG hash_prime = 1099511628211ULL;
+
+bool InstalledCheckInputs::Input::operator==(const Input& rhs) const
+{
+    return type == rhs.type && stamp == rhs.stamp && id == rhs.id;
+}
+
+ULONGLONG InstalledCheckInputs::Hash(ULONGLONG hash, const void * data, size_t size)
+{
+    const BYTE * bytes = reinterpret_cast<const BYTE *>(data);
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= hash_prime;
+    }
+
+    return hash;
+}
+
+ULONGLONG InstalledCheckInputs::Hash(ULONGLONG hash, const std::wstring& value)
+{
+    // length-prefixed, consecutive values never collide
+    size_t length = value.length();
+    hash = Hash(hash, & length, sizeof(length));
+    return Hash(hash, value.c_str(), length * sizeof(wchar_t));
+}
+
+void InstalledCheckInputs::Add(installedcheck_input type, const std::wstring& id, ULONGLONG stamp)
+{
+    Input input;
+    input.type = type;
+    input.id = id;
+    input.stamp = stamp;
+    m_inputs.push_back(input);
+}
+
+void InstalledCheckInputs::AddFingerprint(const std::wstring& fingerprint)
+{
+    m_fingerprint.append(DVLib::towstring(fingerprint.length()));
+    m_fingerprint.append(L":");
+    m_fingerprint.append(fingerprint);
+}
+
+void InstalledCheckInputs::AddRegistryKey(HKEY root, const std::wstring& key, DWORD ulFlags)
+{
+    // keys are read once per refresh, along with the checks that read them
+    DVLib::RegistryValues values;
+    ULONGLONG stamp = 0;
+    if (InstallerSession::Instance->registry.GetValues(root, key, ulFlags, values))
+    {
+        stamp = hash_offset_basis;
+        for each (const std::pair<std::wstring, DVLib::RegistryValue>& value in values)
+        {
+            stamp = Hash(stamp, value.first);
+            stamp = Hash(stamp, & value.second.type, sizeof(DWORD));
+            size_t size = value.second.data.size();
+            stamp = Hash(stamp, & size, sizeof(size));
+            if (size > 0) stamp = Hash(stamp, & * value.second.data.begin(), size);
+        }
+    }
+
+    Add(installedcheck_input_registry_key, DVLib::RegistrySnapshot::GetKeyId(root, key, ulFlags), stamp);
+}
+
+void InstalledCheckInputs::AddFile(const std::wstring& path, bool disable_wow64_fs_redirection)
+{
+    WIN32_FILE_ATTRIBUTE_DATA data = { 0 };
+    BOOL exists = FALSE;
+    if (disable_wow64_fs_redirection)
+    {
+        auto_any<Wow64NativeFS *, close_delete> wow64_native_fs(new Wow64NativeFS());
+        exists = ::GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, & data);
+    }
+    else
+    {
+        exists = ::GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, & data);
+    }
+
+    // the last access time changes when the file is read
+    ULONGLONG stamp = 0;
+    if (exists)
+    {
+        stamp = Hash(hash_offset_basis, & data.dwFileAttributes, sizeof(data.dwFileAttributes));
+        stamp = Hash(stamp, & data.ftCreationTime, sizeof(data.ftCreationTime));
+        stamp = Hash(stamp, & data.ftLastWriteTime, sizeof(data.ftLastWriteTime));
+        stamp = Hash(stamp, & data.nFileSizeHigh, sizeof(data.nFileSizeHigh));
+        stamp = Hash(stamp, & data.nFileSizeLow, sizeof(data.nFileSizeLow));
+    }
+
+    Add(installedcheck_input_file, DVLib::lowercase(path) + (disable_wow64_fs_redirection ? L" (native)" : L""), stamp);
+}
+
+ULONGLONG InstalledCheckInputs::HashProduct(ULONGLONG hash, GUID productcode, const std::wstring& property_name)
+{
+    hash = Hash(hash, & productcode, sizeof(GUID));
+    if (! property_name.empty())
+    {
+        try
+        {
+            hash = Hash(hash, InstallerSession::Instance->msi_products.GetProductProperty(productcode, property_name));
+        }
+        catch(std::exception&)
+        {
+            // the property can't be read, the check fails the same way as long as the product is unchanged
+            hash = Hash(hash, L"?");
+        }
+    }
+
+    return hash;
+}
+
+void InstalledCheckInputs::AddProduct(const std::wstring& productcode, const std::wstring& property_name)
+{
+    GUID guid = DVLib::string2guid(productcode);
+    ULONGLONG stamp = InstallerSession::Instance->msi_products.IsProductInstalled(guid)
+        ? HashProduct(hash_offset_basis, guid, property_name)
+        : 0;
+    Add(installedcheck_input_product, DVLib::guid2wstring(guid) + L"\\" + property_name, stamp);
+}
+
+void InstalledCheckInputs::AddUpgradeCode(const std::wstring& upgradecode, const std::wstring& property_name)
+{
+    GUID guid = DVLib::string2guid(upgradecode);
+    std::vector<GUID> products = InstallerSession::Instance->msi_products.GetRelatedProducts(guid);
+    ULONGLONG stamp = 0;
+    if (! products.empty())
+    {
+        stamp = hash_offset_basis;
+        for each (const GUID& product in products)
+        {
+            stamp = HashProduct(stamp, product, property_name);
+        }
+    }
+
+    Add(installedcheck_input_upgrade_code, DVLib::guid2wstring(guid) + L"\\" + property_name, stamp);
+}
+
+bool InstalledCheckInputs::operator==(const InstalledCheckInputs& rhs) const
+{
+    return m_inputs == rhs.m_inputs && m_fingerprint == rhs.m_fingerprint;
+}
+
+std::wstring InstalledCheckInputs::GetDescription(const Input& input)
+{
+    switch(input.type)
+    {
+    case installedcheck_input_registry_key:
+        return L"registry key " + input.id;
+    case installedcheck_input_file:
+        return L"file " + input.id;
+    case installedcheck_input_product:
+        return L"product " + input.id;
+    case installedcheck_input_upgrade_code:
+        return L"upgrade code " + input.id;
+    default:
+        return input.id;
+    }
+}
+
+std::wstring InstalledCheckInputs::GetDifference(const InstalledCheckInputs& rhs) const
+{
+    if (m_fingerprint != rhs.m_fingerprint || m_inputs.size() != rhs.m_inputs.size())
+        return L"installed checks or their attributes changed";
+
+    for (size_t i = 0; i < m_inputs.size(); i++)
+    {
+        if (m_inputs[i].type != rhs.m_inputs[i].type || m_inputs[i].id != rhs.m_inputs[i].id)
+            return L"installed checks or their attributes changed";
+
+        if (m_inputs[i].stamp != rhs.m_inputs[i].stamp)
+            return GetDescription(m_inputs[i]) + L" changed";
+    }
+
+    return L"";
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+// state read by installed checks
+enum installedcheck_input
+{
+	installedcheck_input_registry_key = 0, // a registry key and its values
+	installedcheck_input_file, // a file or directory
+	installedcheck_input_product, // an MSI product by product code
+	installedcheck_input_upgrade_code, // MSI products by upgrade code
+};
+
+// the fingerprints of installed checks and a stamp of each input they read, taken when the input
+// is added; checks whose inputs compare equal after a component has run evaluate the same
+class InstalledCheckInputs
+{
+private:
+	struct Input
+	{
+		installedcheck_input type;
+		// key id, lowercase path or product/upgrade code and property name
+		std::wstring id;
+		// hash of the state of the input, zero when the input doesn't exist
+		ULONGLONG stamp;
+		bool operator==(const Input& rhs) const;
+	};
+	std::wstring m_fingerprint;
+	std::vector<Input> m_inputs;
+public:
+	void AddFingerprint(const std::wstring& fingerprint);
+	void AddRegistryKey(HKEY root, const std::wstring& key, DWORD ulFlags);
+	void AddFile(const std::wstring& path, bool disable_wow64_fs_redirection = false);
+	// an installed product, property_name is the property compared, if any
+	void AddProduct(const std::wstring& productcode, const std::wstring& property_name);
+	// installed products related by upgrade code
+	void AddUpgradeCode(const std::wstring& upgradecode, const std::wstring& property_name);
+	size_t size() const { return m_inputs.size(); }
+	bool operator==(const InstalledCheckInputs& rhs) const;
+	// describes what differs from rhs, for logging
+	std::wstring GetDifference(const InstalledCheckInputs& rhs) const;
+private:
+	void Add(installedcheck_input type, const std::wstring& id, ULONGLONG stamp);
+	static ULONGLONG Hash(ULONGLONG hash, const void * data, size_t size);
+	static ULONGLONG Hash(ULONGLONG hash, const std::wstring& value);
+	static ULONGLONG HashProduct(ULONGLONG hash, GUID productcode, const std::wstring& property_name);
+	static std::wstring GetDescription(const Input& input);
+};
+
+typedef shared_any<InstalledCheckInputs *, close_delete> InstalledCheckInputsPtr;
@@ -0,0 +1,65 @@
+#include "StdAfx.h"
+#include "InstalledCheckMemo.h"
+
+InstalledCheckMemo::InstalledCheckMemo()
+: m_depth(0)
+, m_hits(0)
+, m_misses(0)
+{
+    ::InitializeCriticalSection(& m_cs);
+}
+
+InstalledCheckMemo::~InstalledCheckMemo()
+{
+    ::DeleteCriticalSection(& m_cs);
+}
+
+void InstalledCheckMemo::Begin()
+{
+    ::EnterCriticalSection(& m_cs);
+    m_depth++;
+    ::LeaveCriticalSection(& m_cs);
+}
+
+void InstalledCheckMemo::End()
+{
+    ::EnterCriticalSection(& m_cs);
+    if (m_depth > 0 && --m_depth == 0)
+    {
+        m_results.clear();
+    }
+    ::LeaveCriticalSection(& m_cs);
+}
+
+void InstalledCheckMemo::Clear()
+{
+    ::EnterCriticalSection(& m_cs);
+    m_results.clear();
+    ::LeaveCriticalSection(& m_cs);
+}
+
+bool InstalledCheckMemo::Find(const std::wstring& fingerprint, bool& installed)
+{
+    bool found = false;
+    ::EnterCriticalSection(& m_cs);
+    std::map<std::wstring, bool>::const_iterator result = m_results.find(fingerprint);
+    if (result != m_results.end())
+    {
+        installed = result->second;
+        m_hits++;
+        found = true;
+    }
+    ::LeaveCriticalSection(& m_cs);
+    return found;
+}
+
+void InstalledCheckMemo::Add(const std::wstring& fingerprint, bool installed)
+{
+    ::EnterCriticalSection(& m_cs);
+    // results evaluated outside of a scope are not kept
+    if (m_depth > 0 && m_results.insert(std::make_pair(fingerprint, installed)).second)
+    {
+        m_misses++;
+    }
+    ::LeaveCriticalSection(& m_cs);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+// results of installed checks by fingerprint, identical checks are evaluated once
+// between Begin() and End(), outside of that every check is evaluated again
+class InstalledCheckMemo
+{
+private:
+	CRITICAL_SECTION m_cs;
+	std::map<std::wstring, bool> m_results;
+	int m_depth;
+	LONG m_hits;
+	LONG m_misses;
+public:
+	InstalledCheckMemo();
+	~InstalledCheckMemo();
+	// keep results until the matching End(), calls may be nested
+	void Begin();
+	// discard results when the outermost Begin() ends
+	void End();
+	bool IsActive() const { return m_depth > 0; }
+	// discard results
+	void Clear();
+	// returns false if the check hasn't been evaluated in this scope
+	bool Find(const std::wstring& fingerprint, bool& installed);
+	void Add(const std::wstring& fingerprint, bool installed);
+	// number of results returned from and added to the memo
+	LONG GetHits() const { return m_hits; }
+	LONG GetMisses() const { return m_misses; }
+};
+
+// keeps installed check results within a scope
+class InstalledCheckMemoScope
+{
+private:
+	InstalledCheckMemo& m_memo;
+public:
+	InstalledCheckMemoScope(InstalledCheckMemo& memo) : m_memo(memo) { m_memo.Begin(); }
+	~InstalledCheckMemoScope() { m_memo.End(); }
+private:
+	InstalledCheckMemoScope(const InstalledCheckMemoScope&);
+	InstalledCheckMemoScope& operator=(const InstalledCheckMemoScope&);
+};
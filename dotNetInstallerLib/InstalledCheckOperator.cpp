@@ -2,6 +2,8 @@
 #include "InstallerSession.h"
 #include "XmlAttribute.h"
 #include "InstalledCheckOperator.h"
+#include "InstalledCheckInputs.h"
+#include "InstalledCheckProgram.h"
 #include "InstallerLog.h"
 
 InstalledCheckOperator::InstalledCheckOperator()
@@ -9,26 +11,24 @@ InstalledCheckOperator::InstalledCheckOperator()
 
 }
 
-void InstalledCheckOperator::Load(tinyxml2::XMLElement * node)
+void InstalledCheckOperator::Load(const ConfigElement * node)
 {
-    type = DVLib::UTF8string2wstring(node->Attribute("type"));
+    type = node->Attribute("type");
     description = node->Attribute("description");
+    // operators with variables are checked when evaluated
+    CHECK_BOOL(! type.IsLiteral() || type == L"And" || type == L"Or" || type == L"Not",
+        L"Invalid check operator \"" << type << L"\"");
     // child install checks
-    for (tinyxml2::XMLNode* child = node->FirstChildElement(); child; child = child->NextSibling())
+    for (const ConfigElement * child_element = node->FirstChildElement(); child_element; child_element = child_element->NextSiblingElement())
     {
-        tinyxml2::XMLElement * child_element = child->ToElement();
-
-        if (child_element == NULL)
-            continue;
-
-        if (strcmp(child_element->Value(), "installedcheck") == 0)
+        if (wcscmp(child_element->Value(), L"installedcheck") == 0)
         {
-            std::wstring installedcheck_type = DVLib::UTF8string2wstring(child_element->Attribute("type"));
+            std::wstring installedcheck_type = child_element->Attribute("type");
             InstalledCheckPtr installedcheck(InstalledCheck::Create(installedcheck_type));
             installedcheck->Load(child_element);
             installedchecks.push_back(installedcheck);
         }
-        else if (strcmp(child_element->Value(), "installedcheckoperator") == 0)
+        else if (wcscmp(child_element->Value(), L"installedcheckoperator") == 0)
         {
             InstalledCheckPtr installedcheckoperator(new InstalledCheckOperator());
             installedcheckoperator->Load(child_element);
@@ -45,44 +45,99 @@ void InstalledCheckOperator::Load(tinyxml2::XMLElement * node)
 
 bool InstalledCheckOperator::IsInstalled() const
 {
-    if (type == L"And")
+    // the type is known once expanded
+    InstalledCheckProgram program;
+    Compile(program, type);
+    return program.Run();
+}
+
+void InstalledCheckOperator::Compile(InstalledCheckProgram& program) const
+{
+    if (! type.IsLiteral())
     {
-        if (installedchecks.size() == 0)
-            return false;
+        InstalledCheck::Compile(program);
+        return;
+    }
 
-        for each(const InstalledCheckPtr& installedcheck in installedchecks)
-        {
-            if (! installedcheck->IsInstalled())
-                return false;
-        }
+    Compile(program, type);
+}
 
-        return true;
+void InstalledCheckOperator::Compile(InstalledCheckProgram& program, const std::wstring& operator_type) const
+{
+    if (operator_type == L"And")
+    {
+        program.EmitAll(installedchecks);
     }
-    else if (type == L"Or")
+    else if (operator_type == L"Or")
     {
-        for each(const InstalledCheckPtr& installedcheck in installedchecks)
-        {
-            if (installedcheck->IsInstalled())
-                return true;
-        }
+        program.EmitAny(installedchecks);
+    }
+    else if (operator_type == L"Not")
+    {
+        // none of the checks is installed
+        program.EmitAny(installedchecks);
+        program.EmitNot();
+    }
+    else
+    {
+        THROW_EX("Invalid check operator \"" << operator_type << L"\"");
+    }
+}
+
+std::wstring InstalledCheckOperator::GetFingerprint() const
+{
+    std::wstring fingerprint(L"installedcheckoperator");
+    AppendFingerprint(fingerprint, type);
+    for each(const InstalledCheckPtr& installedcheck in installedchecks)
+    {
+        std::wstring child = installedcheck->GetFingerprint();
+        if (child.empty())
+            return L"";
+        AppendFingerprint(fingerprint, child);
+    }
+    return fingerprint;
+}
 
-        return false;
+installedcheck_cost InstalledCheckOperator::GetCost() const
+{
+    installedcheck_cost cost = installedcheck_cost_file_exists;
+    for each(const InstalledCheckPtr& installedcheck in installedchecks)
+    {
+        installedcheck_cost check_cost = installedcheck->GetCost();
+        if (check_cost > cost) cost = check_cost;
     }
-    else if (type == L"Not")
+
+    return cost;
+}
+
+bool InstalledCheckOperator::GetInputs(InstalledCheckInputs& inputs) const
+{
+    for each(const InstalledCheckPtr& installedcheck in installedchecks)
     {
-        if (installedchecks.size() == 0)
-            return true;
+        if (! installedcheck->GetInputs(inputs))
+            return false;
+    }
 
-        for each(const InstalledCheckPtr& installedcheck in installedchecks)
-        {
-            if (installedcheck->IsInstalled())
-                return false;
-        }
+    return true;
+}
 
+bool InstalledCheckOperator::DependsOn(ExpansionTemplate::token_type variable_type, const std::wstring& name) const
+{
+    if (type.DependsOn(variable_type, name))
         return true;
-    }
-    else
+
+    for each(const InstalledCheckPtr& installedcheck in installedchecks)
     {
-        THROW_EX("Invalid check operator \"" << type << L"\"");
+        if (installedcheck->DependsOn(variable_type, name))
+            return true;
     }
+
+    return false;
+}
+
+std::wstring InstalledCheckOperator::GetString() const
+{
+    std::wstringstream ss;
+    ss << L"'" << type << L"' installed check operator";
+    return ss.str();
 }
@@ -13,7 +13,18 @@ public:
 public:	
     InstalledCheckOperator();
 	bool IsInstalled() const;
-    void Load(tinyxml2::XMLElement * node);
+	std::wstring GetFingerprint() const;
+	// the cost of the most expensive check
+	installedcheck_cost GetCost() const;
+	bool GetInputs(InstalledCheckInputs& inputs) const;
+	bool DependsOn(ExpansionTemplate::token_type type, const std::wstring& name) const;
+	// operators of a literal type are compiled inline, others are evaluated through Evaluate
+	void Compile(InstalledCheckProgram& program) const;
+	std::wstring GetString() const;
+    void Load(const ConfigElement * node);
+private:
+	// emit the instructions of an operator of a given type
+	void Compile(InstalledCheckProgram& program, const std::wstring& operator_type) const;
 };
 
 typedef shared_any<InstalledCheckOperator *, close_delete> InstalledCheckOperatorPtr;
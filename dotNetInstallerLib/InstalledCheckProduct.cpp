@@ -1,6 +1,8 @@
 #include "StdAfx.h"
 #include "XmlAttribute.h"
 #include "InstalledCheckProduct.h"
+#include "InstalledCheckProgram.h"
+#include "InstalledCheckInputs.h"
 #include "InstallerLog.h"
 #include "InstallConfiguration.h"
 #include "InstallerSession.h"
@@ -9,37 +11,41 @@ InstalledCheckProduct::InstalledCheckProduct()
 {
 }
 
-void InstalledCheckProduct::Load(tinyxml2::XMLElement * node)
+void InstalledCheckProduct::Load(const ConfigElement * node)
 {
-    id_type = DVLib::UTF8string2wstring(node->Attribute("id_type"));
+    id_type = node->Attribute("id_type");
     id = node->Attribute("id");
     propertyname = node->Attribute("propertyname");
-    comparison = DVLib::UTF8string2wstring(node->Attribute("comparison"));
+    comparison = node->Attribute("comparison");
     propertyvalue = node->Attribute("propertyvalue");
     defaultvalue = node->Attribute("defaultvalue");
+    // comparisons with variables and a missing comparison are checked when evaluated
+    CHECK_BOOL(! comparison.IsLiteral() || comparison.empty() || IsSupported(comparison.GetType()),
+        L"Invalid comparison \"" << comparison << L"\" in 'product' installed check '" << id.GetSource() << L"'");
     LOG(L"Loaded 'product' installed check '" << id << L"'");
 }
 
 bool InstalledCheckProduct::IsInstalled() const
 {
     GUID id_guid = DVLib::string2guid(id);
-    std::vector<DVLib::MsiProductInfo> products;
+    // installed products are shared by all checks in the session
+    DVLib::MsiProductInventory& inventory = InstallerSession::Instance->msi_products;
+    std::vector<GUID> products;
     if (id_type == L"productcode")
     {
-        if (DVLib::MsiIsProductInstalled(id_guid))
+        if (inventory.IsProductInstalled(id_guid))
         {
-            DVLib::MsiProductInfo pi(id_guid);
             try
             {
-                LOG(L"Product '" << pi.GetProductName() << L"', id=" << id << L", version=" << pi.GetVersionString() << L" is installed");
+                LOG(L"Product '" << inventory.GetProductName(id_guid) << L"', id=" << id << L", version=" << inventory.GetVersionString(id_guid) << L" is installed");
             }
             catch(std::exception& ex)
             {
-                LOG("Warning: product id=" << DVLib::guid2wstring(pi.product_id) << L"GetProductName/Version - " 
+                LOG("Warning: product id=" << DVLib::guid2wstring(id_guid) << L"GetProductName/Version - " 
                     << DVLib::string2wstring(ex.what()));
             }
 
-            products.push_back(pi);
+            products.push_back(id_guid);
         }
         else
         {
@@ -48,17 +54,17 @@ bool InstalledCheckProduct::IsInstalled() const
     }
     else if (id_type == L"upgradecode")
     {
-        products = DVLib::MsiGetRelatedProducts(id_guid);
-        for each(const DVLib::MsiProductInfo& pi in products)
+        products = inventory.GetRelatedProducts(id_guid);
+        for each(const GUID& product_id in products)
         {
             try
             {
-                LOG(L"Product '" << pi.GetProductName() << L"', id=" << DVLib::guid2wstring(pi.product_id)
-                    << L", upgradecode=" << id << L", version=" << pi.GetVersionString() << L" found");
+                LOG(L"Product '" << inventory.GetProductName(product_id) << L"', id=" << DVLib::guid2wstring(product_id)
+                    << L", upgradecode=" << id << L", version=" << inventory.GetVersionString(product_id) << L" found");
             }
             catch(std::exception& ex)
             {
-                LOG("Warning: product id=" << DVLib::guid2wstring(pi.product_id) << L"GetProductName/Version - " 
+                LOG("Warning: product id=" << DVLib::guid2wstring(product_id) << L"GetProductName/Version - " 
                     << DVLib::string2wstring(ex.what()));
             }
         }
@@ -69,7 +75,7 @@ bool InstalledCheckProduct::IsInstalled() const
     }
 
     // the product/upgrade code exists
-    if (comparison == L"exists")
+    if (comparison.GetType() == installedcheck_comparison_exists)
         return products.size() > 0;
 
     // match, version or contains
@@ -81,22 +87,23 @@ bool InstalledCheckProduct::IsInstalled() const
     }
 
     std::vector<std::wstring> pi_propertyvalues;
-    for each(const DVLib::MsiProductInfo& pi in products)
+    for each(const GUID& product_id in products)
     {
         try
         {
-            std::wstring pi_propertyvalue = pi.GetProperty(propertyname);
-            LOG(L"Product '" << pi.GetProductName() << L"', " << propertyname << L"='" << pi_propertyvalue << L"'");
+            std::wstring pi_propertyvalue = inventory.GetProductProperty(product_id, propertyname);
+            LOG(L"Product '" << inventory.GetProductName(product_id) << L"', " << propertyname << L"='" << pi_propertyvalue << L"'");
             pi_propertyvalues.push_back(pi_propertyvalue);
         }
         catch(std::exception& ex)
         {
-            LOG("Warning: product id=" << DVLib::guid2wstring(pi.product_id) << L"GetProperty(" << propertyname << L") - " 
+            LOG("Warning: product id=" << DVLib::guid2wstring(product_id) << L"GetProperty(" << propertyname << L") - " 
                 << DVLib::string2wstring(ex.what()));
         }
     }
 
-    if (comparison == L"match")
+    installedcheck_comparison comparison_type = comparison.GetType();
+    if (comparison_type == installedcheck_comparison_match)
     {
         for each(const std::wstring& pi_propertyvalue in pi_propertyvalues)
         {
@@ -113,7 +120,7 @@ bool InstalledCheckProduct::IsInstalled() const
 
         return true;
     }
-    else if (comparison == L"contains")
+    else if (comparison_type == installedcheck_comparison_contains)
     {
         for each(const std::wstring& pi_propertyvalue in pi_propertyvalues)
         {
@@ -130,110 +137,99 @@ bool InstalledCheckProduct::IsInstalled() const
 
         return false;
     }
-    else if (comparison == L"version")
+    else if (IsSupported(comparison_type) && comparison_type != installedcheck_comparison_exists)
     {
-        for each(const std::wstring& pi_propertyvalue in pi_propertyvalues)
-        {
-            if (DVLib::CompareVersion(pi_propertyvalue, propertyvalue) >= 0) 
-            {
-                LOG(L"Check value '" << propertyvalue << L"' version matches '" << pi_propertyvalue << L"'");
-                return true;
-            }
-            else
-            {
-                LOG(L"Check value '" << propertyvalue << L"' version doesn't match '" << pi_propertyvalue << L"'");
-            }
-        }
+        if (pi_propertyvalues.empty())
+            return false;
 
-        return false;
-    }
-    else if (comparison == L"version_eq")
-    {
+        // the check value is parsed once, when loaded
+        DVLib::Version check_version = propertyvalue.GetVersion();
         for each(const std::wstring& pi_propertyvalue in pi_propertyvalues)
         {
-            if (DVLib::CompareVersion(pi_propertyvalue, propertyvalue) == 0) 
+            if (comparison.Test(DVLib::Version(pi_propertyvalue).Compare(check_version)))
             {
-                LOG(L"Check value '" << propertyvalue << L"' version is equal to '" << pi_propertyvalue << L"'");
+                LOG(L"Check value '" << propertyvalue << L"' " << comparison << L" matches '" << pi_propertyvalue << L"'");
                 return true;
             }
             else
             {
-                LOG(L"Check value '" << propertyvalue << L"' version is not equal to '" << pi_propertyvalue << L"'");
+                LOG(L"Check value '" << propertyvalue << L"' " << comparison << L" doesn't match '" << pi_propertyvalue << L"'");
             }
         }
 
         return false;
     }
-    else if (comparison == L"version_lt")
+    else
     {
-        for each(const std::wstring& pi_propertyvalue in pi_propertyvalues)
-        {
-            if (DVLib::CompareVersion(pi_propertyvalue, propertyvalue) < 0)
-            {
-                LOG(L"Check value '" << propertyvalue << L"' version lesser match with '" << pi_propertyvalue << L"'");
-                return true;
-            }
-            else
-            {
-                LOG(L"Check value '" << propertyvalue << L"' version no lesser match to '" << pi_propertyvalue << L"'");
-            }
-        }
-
-        return false;
+        THROW_EX(L"Invalid comparison: " << comparison);
     }
-    else if (comparison == L"version_le")
-    {
-        for each(const std::wstring& pi_propertyvalue in pi_propertyvalues)
-        {
-            if (DVLib::CompareVersion(pi_propertyvalue, propertyvalue) <= 0)
-            {
-                LOG(L"Check value '" << propertyvalue << L"' version lesser or equal than '" << pi_propertyvalue << L"'");
-                return true;
-            }
-            else
-            {
-                LOG(L"Check value '" << propertyvalue << L"' version no lesser or equal match to '" << pi_propertyvalue << L"'");
-            }
-        }
+}
 
-        return false;
-    }
-    else if (comparison == L"version_gt")
+bool InstalledCheckProduct::IsSupported(installedcheck_comparison comparison)
+{
+    switch(comparison)
     {
-        for each(const std::wstring& pi_propertyvalue in pi_propertyvalues)
-        {
-            if (DVLib::CompareVersion(pi_propertyvalue, propertyvalue) > 0) 
-            {
-                LOG(L"Check value '" << propertyvalue << L"' version greater match to '" << pi_propertyvalue << L"'");
-                return true;
-            }
-            else
-            {
-                LOG(L"Check value '" << propertyvalue << L"' version no greater match to '" << pi_propertyvalue << L"'");
-            }
-        }
-
+    case installedcheck_comparison_exists:
+    case installedcheck_comparison_match:
+    case installedcheck_comparison_contains:
+    case installedcheck_comparison_version:
+    case installedcheck_comparison_version_eq:
+    case installedcheck_comparison_version_lt:
+    case installedcheck_comparison_version_le:
+    case installedcheck_comparison_version_gt:
+    case installedcheck_comparison_version_ge:
+        return true;
+    default:
         return false;
     }
-    else if (comparison == L"version_ge")
-    {
-        for each(const std::wstring& pi_propertyvalue in pi_propertyvalues)
-        {
-            if (DVLib::CompareVersion(pi_propertyvalue, propertyvalue) >= 0) 
-            {
-                LOG(L"Check value '" << propertyvalue << L"' version greater or equal match to '" << pi_propertyvalue << L"'");
-                return true;
-            }
-            else
-            {
-                LOG(L"Check value '" << propertyvalue << L"' version no greater or equal match to '" << pi_propertyvalue << L"'");
-            }
-        }
+}
 
-        return false;
-    }
+std::wstring InstalledCheckProduct::GetFingerprint() const
+{
+    std::wstring fingerprint(L"check_product");
+    AppendFingerprint(fingerprint, id_type);
+    AppendFingerprint(fingerprint, id);
+    AppendFingerprint(fingerprint, propertyname);
+    AppendFingerprint(fingerprint, comparison);
+    AppendFingerprint(fingerprint, propertyvalue);
+    AppendFingerprint(fingerprint, defaultvalue);
+    return fingerprint;
+}
+
+void InstalledCheckProduct::Compile(InstalledCheckProgram& program) const
+{
+    program.EmitCheck(installedcheck_op_product, this);
+}
+
+bool InstalledCheckProduct::DependsOn(ExpansionTemplate::token_type type, const std::wstring& name) const
+{
+    return id_type.DependsOn(type, name)
+        || id.DependsOn(type, name)
+        || propertyname.DependsOn(type, name)
+        || comparison.DependsOn(type, name)
+        || propertyvalue.DependsOn(type, name)
+        || defaultvalue.DependsOn(type, name);
+}
+
+bool InstalledCheckProduct::GetInputs(InstalledCheckInputs& inputs) const
+{
+    // 'exists' doesn't read product properties
+    std::wstring property_name = (comparison.GetType() == installedcheck_comparison_exists)
+        ? L"" : propertyname.GetValue();
+
+    if (id_type == L"productcode")
+        inputs.AddProduct(id, property_name);
+    else if (id_type == L"upgradecode")
+        inputs.AddUpgradeCode(id, property_name);
     else
-    {
-        THROW_EX(L"Invalid comparison: " << comparison);
-    }
+        return false;
+
+    return true;
+}
+
+std::wstring InstalledCheckProduct::GetString() const
+{
+    std::wstringstream ss;
+    ss << L"'product' installed check '" << id << L"'";
+    return ss.str();
 }
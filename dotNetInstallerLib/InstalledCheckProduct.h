@@ -1,6 +1,8 @@
 #pragma once
 
 #include "InstalledCheck.h"
+#include "InstalledCheckComparison.h"
+#include "VersionAttribute.h"
 #include "XmlAttribute.h"
 
 class InstalledCheckProduct : public InstalledCheck
@@ -13,15 +15,23 @@ public:
 	// product property to check
 	XmlAttribute propertyname;
 	// one of version, match, etc.
-	std::wstring comparison;
+	InstalledCheckComparison comparison;
 	// property value to match
-	XmlAttribute propertyvalue;
+	VersionAttribute propertyvalue;
 	// default value for 'match', 'version' and 'contains' operators
 	XmlAttribute defaultvalue;
 public:
     InstalledCheckProduct();
-    void Load(tinyxml2::XMLElement * node);
+    void Load(const ConfigElement * node);
 	virtual bool IsInstalled() const;
+	std::wstring GetFingerprint() const;
+	installedcheck_cost GetCost() const { return installedcheck_cost_product; }
+	bool GetInputs(InstalledCheckInputs& inputs) const;
+	bool DependsOn(ExpansionTemplate::token_type type, const std::wstring& name) const;
+	void Compile(InstalledCheckProgram& program) const;
+	std::wstring GetString() const;
+private:
+	static bool IsSupported(installedcheck_comparison comparison);
 };
 
 typedef shared_any<InstalledCheckProduct *, close_delete> InstalledCheckProductPtr;
@@ -0,0 +1,187 @@
+#include "StdAfx.h"
+#include "InstalledCheckProgram.h"
+#include "InstalledCheckRegistry.h"
+#include "InstalledCheckFile.h"
+#include "InstalledCheckDirectory.h"
+#include "InstalledCheckProduct.h"
+#include "InstalledCheckMemo.h"
+#include "InstallerSession.h"
+
+// evaluates a check of a known type, qualified calls aren't virtual
+template<class T>
+static bool EvaluateCheck(const InstalledCheck * installedcheck)
+{
+    const T * p = static_cast<const T *>(installedcheck);
+    InstalledCheckMemo& memo = InstallerSession::Instance->installed_checks;
+    std::wstring fingerprint = memo.IsActive() ? p->T::GetFingerprint() : L"";
+    bool installed = false;
+    if (! fingerprint.empty() && memo.Find(fingerprint, installed))
+        return installed;
+
+    // errors are not memoized, a check that fails is evaluated again
+    installed = p->T::IsInstalled();
+    if (! fingerprint.empty())
+        memo.Add(fingerprint, installed);
+    return installed;
+}
+
+InstalledCheckProgram::InstalledCheckProgram()
+{
+
+}
+
+void InstalledCheckProgram::Compile(const std::vector<InstalledCheckPtr>& installedchecks)
+{
+    m_instructions.clear();
+    m_installedchecks.clear();
+    for each(const InstalledCheckPtr& installedcheck in installedchecks)
+        m_installedchecks.push_back(get(installedcheck));
+
+    EmitAll(installedchecks);
+}
+
+bool InstalledCheckProgram::IsCompiledFrom(const std::vector<InstalledCheckPtr>& installedchecks) const
+{
+    if (m_instructions.empty() || installedchecks.size() != m_installedchecks.size())
+        return false;
+
+    for (size_t i = 0; i < installedchecks.size(); i++)
+    {
+        if (get(installedchecks[i]) != m_installedchecks[i])
+            return false;
+    }
+
+    return true;
+}
+
+void InstalledCheckProgram::EmitConstant(bool value)
+{
+    EmitCheck(value ? installedcheck_op_true : installedcheck_op_false, NULL);
+}
+
+void InstalledCheckProgram::EmitCheck(installedcheck_opcode opcode, const InstalledCheck * check)
+{
+    InstalledCheckInstruction instruction = { opcode, check, 0 };
+    m_instructions.push_back(instruction);
+}
+
+void InstalledCheckProgram::EmitNot()
+{
+    EmitCheck(installedcheck_op_not, NULL);
+}
+
+void InstalledCheckProgram::EmitAll(const std::vector<InstalledCheckPtr>& installedchecks)
+{
+    EmitJumps(installedchecks, installedcheck_op_jump_if_false);
+}
+
+void InstalledCheckProgram::EmitAny(const std::vector<InstalledCheckPtr>& installedchecks)
+{
+    EmitJumps(installedchecks, installedcheck_op_jump_if_true);
+}
+
+void InstalledCheckProgram::EmitJumps(const std::vector<InstalledCheckPtr>& installedchecks, installedcheck_opcode jump)
+{
+    if (installedchecks.empty())
+    {
+        EmitConstant(false);
+        return;
+    }
+
+    // the result doesn't depend on the order of checks, the cheapest ones may settle it
+    std::vector<InstalledCheckPtr> sorted_installedchecks = InstalledCheck::SortByCost(installedchecks);
+    std::vector<size_t> jumps;
+    for (size_t i = 0; i < sorted_installedchecks.size(); i++)
+    {
+        sorted_installedchecks[i]->Compile(* this);
+        if (i + 1 < sorted_installedchecks.size())
+        {
+            jumps.push_back(m_instructions.size());
+            EmitCheck(jump, NULL);
+        }
+    }
+
+    // a settled result skips the remaining checks
+    for each(size_t i in jumps)
+        m_instructions[i].target = m_instructions.size();
+}
+
+bool InstalledCheckProgram::Run() const
+{
+    bool result = false;
+    size_t i = 0;
+    while (i < m_instructions.size())
+    {
+        const InstalledCheckInstruction& instruction = m_instructions[i++];
+        switch(instruction.opcode)
+        {
+        case installedcheck_op_false:
+            result = false;
+            break;
+        case installedcheck_op_true:
+            result = true;
+            break;
+        case installedcheck_op_registry:
+            result = EvaluateCheck<InstalledCheckRegistry>(instruction.check);
+            break;
+        case installedcheck_op_file:
+            result = EvaluateCheck<InstalledCheckFile>(instruction.check);
+            break;
+        case installedcheck_op_directory:
+            result = EvaluateCheck<InstalledCheckDirectory>(instruction.check);
+            break;
+        case installedcheck_op_product:
+            result = EvaluateCheck<InstalledCheckProduct>(instruction.check);
+            break;
+        case installedcheck_op_check:
+            result = instruction.check->Evaluate();
+            break;
+        case installedcheck_op_not:
+            result = ! result;
+            break;
+        case installedcheck_op_jump_if_false:
+            if (! result) i = instruction.target;
+            break;
+        case installedcheck_op_jump_if_true:
+            if (result) i = instruction.target;
+            break;
+        default:
+            THROW_EX(L"Invalid installed check instruction " << instruction.opcode << L" at " << (i - 1));
+        }
+    }
+
+    return result;
+}
+
+std::wstring InstalledCheckProgram::GetString() const
+{
+    std::wstringstream ss;
+    for (size_t i = 0; i < m_instructions.size(); i++)
+    {
+        const InstalledCheckInstruction& instruction = m_instructions[i];
+        ss << i << L": ";
+        switch(instruction.opcode)
+        {
+        case installedcheck_op_false:
+            ss << L"false";
+            break;
+        case installedcheck_op_true:
+            ss << L"true";
+            break;
+        case installedcheck_op_not:
+            ss << L"not";
+            break;
+        case installedcheck_op_jump_if_false:
+            ss << L"jump_if_false " << instruction.target;
+            break;
+        case installedcheck_op_jump_if_true:
+            ss << L"jump_if_true " << instruction.target;
+            break;
+        default:
+            ss << instruction.check->GetString();
+            break;
+        }
+        ss << std::endl;
+    }
+    return ss.str();
+}
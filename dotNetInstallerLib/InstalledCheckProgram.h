@@ -0,0 +1,59 @@
+#pragma once
+#include "InstalledCheck.h"
+
+// instructions of an InstalledCheckProgram
+enum installedcheck_opcode
+{
+	installedcheck_op_false = 0, // result = false
+	installedcheck_op_true, // result = true
+	installedcheck_op_registry, // result = InstalledCheckRegistry
+	installedcheck_op_file, // result = InstalledCheckFile
+	installedcheck_op_directory, // result = InstalledCheckDirectory
+	installedcheck_op_product, // result = InstalledCheckProduct
+	installedcheck_op_check, // result = any other check, through InstalledCheck::Evaluate
+	installedcheck_op_not, // result = ! result
+	installedcheck_op_jump_if_false, // continue at target if result is false
+	installedcheck_op_jump_if_true, // continue at target if result is true
+};
+
+struct InstalledCheckInstruction
+{
+	installedcheck_opcode opcode;
+	// the check evaluated by a check instruction
+	const InstalledCheck * check;
+	// the next instruction of a jump
+	size_t target;
+};
+
+// a tree of installed checks compiled into a flat program, operators become conditional jumps
+// in order of cost and checks are evaluated by their type without virtual calls; the program
+// references the checks it was compiled from
+class InstalledCheckProgram
+{
+private:
+	std::vector<InstalledCheckInstruction> m_instructions;
+	// checks the program was compiled from by Compile
+	std::vector<const InstalledCheck *> m_installedchecks;
+public:
+	InstalledCheckProgram();
+	// compile checks that must all be installed
+	void Compile(const std::vector<InstalledCheckPtr>& installedchecks);
+	// true if Compile was called with the same checks
+	bool IsCompiledFrom(const std::vector<InstalledCheckPtr>& installedchecks) const;
+	// evaluate the program, identical checks are evaluated once within an InstalledCheckMemoScope
+	bool Run() const;
+	// emit instructions, see InstalledCheck::Compile
+	void EmitConstant(bool value);
+	void EmitCheck(installedcheck_opcode opcode, const InstalledCheck * check);
+	// true if all checks are installed, false without checks
+	void EmitAll(const std::vector<InstalledCheckPtr>& installedchecks);
+	// true if any check is installed, false without checks
+	void EmitAny(const std::vector<InstalledCheckPtr>& installedchecks);
+	void EmitNot();
+	size_t GetSize() const { return m_instructions.size(); }
+	const InstalledCheckInstruction& operator[](size_t index) const { return m_instructions[index]; }
+	// one instruction per line
+	std::wstring GetString() const;
+private:
+	void EmitJumps(const std::vector<InstalledCheckPtr>& installedchecks, installedcheck_opcode jump);
+};
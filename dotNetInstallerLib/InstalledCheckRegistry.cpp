@@ -2,6 +2,8 @@
 #include "InstallerSession.h"
 #include "XmlAttribute.h"
 #include "InstalledCheckRegistry.h"
+#include "InstalledCheckProgram.h"
+#include "InstalledCheckInputs.h"
 #include "InstallerLog.h"
 
 InstalledCheckRegistry::InstalledCheckRegistry()
@@ -9,31 +11,37 @@ InstalledCheckRegistry::InstalledCheckRegistry()
 
 }
 
-void InstalledCheckRegistry::Load(tinyxml2::XMLElement * node)
+void InstalledCheckRegistry::Load(const ConfigElement * node)
 {
     fieldname = node->Attribute("fieldname");
-    fieldtype = DVLib::UTF8string2wstring(node->Attribute("fieldtype"));
+    fieldtype = node->Attribute("fieldtype");
     fieldvalue = node->Attribute("fieldvalue");
     path = node->Attribute("path");
-    comparison = DVLib::UTF8string2wstring(node->Attribute("comparison"));
-    rootkey = DVLib::UTF8string2wstring(node->Attribute("rootkey"));
-    wowoption = DVLib::UTF8string2wstring(node->Attribute("wowoption"));
+    comparison = node->Attribute("comparison");
+    rootkey = node->Attribute("rootkey");
+    wowoption = node->Attribute("wowoption");
     defaultvalue = node->Attribute("defaultvalue");
+    // comparisons and types with variables are checked when evaluated
+    if (comparison.IsLiteral() && ! comparison.empty())
+    {
+        DWORD type = fieldtype.IsLiteral() ? fieldtype.GetType() : REG_NONE;
+        CHECK_BOOL(IsSupported(comparison.GetType(), type),
+            L"Invalid comparison type \"" << comparison << L"\" for " << fieldtype.GetSource() << L" in 'registry' installed check '" << path.GetSource() << L"'");
+    }
     LOG(L"Loaded 'registry' installed check '" << rootkey << L"\\" << path << L"\\" << fieldname << L"'");
 }
 
-bool InstalledCheckRegistry::IsInstalledValue() const
+bool InstalledCheckRegistry::IsInstalledValue(HKEY root, const std::wstring& key, const std::wstring& name, DWORD dwKeyOption) const
 {
     std::wstring keypath = GetKeyPath();
-    DWORD dwKeyOption = GetKeyOption();
 
-    if (! DVLib::RegistryKeyExists(DVLib::wstring2HKEY(rootkey), path, dwKeyOption))
+    if (! InstallerSession::Instance->registry.KeyExists(root, key, dwKeyOption))
     {
         bool default_result = defaultvalue.GetBoolValue(false);
         LOG(L"*** No registry key found: " << keypath << L", default value: " << (default_result ? L"true" : L"false"));
         return default_result;
     }
-    else if (! DVLib::RegistryValueExists(DVLib::wstring2HKEY(rootkey), path, fieldname, dwKeyOption))
+    else if (! InstallerSession::Instance->registry.ValueExists(root, key, name, dwKeyOption))
     {
         bool default_result = defaultvalue.GetBoolValue(false);
         LOG(L"*** No registry value found: " << keypath << L", default value: " << (default_result ? L"true" : L"false"));
@@ -45,141 +53,124 @@ bool InstalledCheckRegistry::IsInstalledValue() const
         THROW_EX("Missing registry type for " << keypath);
     }
 
-    if (fieldtype == L"REG_DWORD")
+    installedcheck_comparison comparison_type = comparison.GetType();
+    switch(fieldtype.GetType())
     {
-        if (fieldvalue.empty())
+    case REG_DWORD:
         {
-            THROW_EX("Missing fieldvalue number for " << keypath);
-        }
+            if (fieldvalue.empty())
+            {
+                THROW_EX("Missing fieldvalue number for " << keypath);
+            }
 
-        DWORD regfieldvalue = DVLib::RegistryGetDWORDValue(
-            DVLib::wstring2HKEY(rootkey), path, fieldname, dwKeyOption);
-        LOG(L"Registry value: " << regfieldvalue);
-
-        DWORD checkvalue = static_cast<DWORD>(DVLib::wstring2long(fieldvalue));
-        LOG(L"Check value: " << checkvalue);
-
-        if (comparison == L"match")
-            return (regfieldvalue == checkvalue);
-        else if (comparison == L"version")
-            return (regfieldvalue >= checkvalue);
-        // EXPERIMENTAL
-        else if (comparison == L"version_patch")
-            return (regfieldvalue >= checkvalue);
-        // EXPERIMENTAL
-        else if (comparison == L"version_eq")
-            return (regfieldvalue == checkvalue);
-        else if (comparison == L"version_lt")
-            return (regfieldvalue < checkvalue);
-        else if (comparison == L"version_le")
-            return (regfieldvalue <= checkvalue);
-        else if (comparison == L"version_gt")
-            return (regfieldvalue > checkvalue);
-        else if (comparison == L"version_ge")
-            return (regfieldvalue >= checkvalue);
-        else
-        {
-            THROW_EX("Invalid comparison type: " << comparison);
+            DWORD regfieldvalue = InstallerSession::Instance->registry.GetDWORDValue(
+                root, key, name, dwKeyOption);
+            LOG(L"Registry value: " << regfieldvalue);
+
+            DWORD checkvalue = static_cast<DWORD>(DVLib::wstring2long(fieldvalue));
+            LOG(L"Check value: " << checkvalue);
+
+            CHECK_BOOL(IsSupported(comparison_type, REG_DWORD),
+                L"Invalid comparison type: " << comparison);
+            return comparison.Test(regfieldvalue < checkvalue ? -1 : (regfieldvalue > checkvalue ? 1 : 0));
         }
-    }
-    else if (fieldtype == TEXT("REG_SZ"))
-    {
-        std::wstring regfieldvalue = DVLib::RegistryGetStringValue(
-            DVLib::wstring2HKEY(rootkey), path, fieldname, dwKeyOption);
-        LOG(L"Registry value: " << regfieldvalue);
-
-        if (comparison == TEXT("match"))
-            return (fieldvalue == regfieldvalue);
-        else if (comparison == TEXT("version"))
-            return (DVLib::CompareVersion(regfieldvalue, fieldvalue) >= 0);
-        // EXPERIMENTAL
-        else if (comparison == TEXT("version_patch"))
-            return (DVLib::CompareVersion(regfieldvalue, fieldvalue) >= 0);
-        // EXPERIMENTAL
-        else if (comparison == TEXT("version_eq"))
-            return (DVLib::CompareVersion(regfieldvalue, fieldvalue) == 0);
-        else if (comparison == TEXT("version_lt"))
-            return (DVLib::CompareVersion(regfieldvalue, fieldvalue) < 0);
-        else if (comparison == TEXT("version_le"))
-            return (DVLib::CompareVersion(regfieldvalue, fieldvalue) <= 0);
-        else if (comparison == TEXT("version_gt"))
-            return (DVLib::CompareVersion(regfieldvalue, fieldvalue) > 0);
-        else if (comparison == TEXT("version_ge"))
-            return (DVLib::CompareVersion(regfieldvalue, fieldvalue) >= 0);
-        else if (comparison == TEXT("contains"))
-            return (regfieldvalue.find(fieldvalue.GetValue()) != regfieldvalue.npos);
-        else
+    case REG_SZ:
         {
-            THROW_EX("Invalid comparison type: " << comparison);
-        }
-    }
-    else if (fieldtype == TEXT("REG_MULTI_SZ"))
-    {
-        std::vector<std::wstring> regfieldvalues = DVLib::RegistryGetMultiStringValue(
-            DVLib::wstring2HKEY(rootkey), path, fieldname, dwKeyOption);
-        LOG(L"Registry value: " << regfieldvalues.size() << L" string(s)");
-        std::vector<std::wstring> fieldvalues = DVLib::split(fieldvalue, L",");
+            std::wstring regfieldvalue = InstallerSession::Instance->registry.GetStringValue(
+                root, key, name, dwKeyOption);
+            LOG(L"Registry value: " << regfieldvalue);
 
-        if (comparison == TEXT("match"))
-        {
-            return (fieldvalues == regfieldvalues);
+            CHECK_BOOL(IsSupported(comparison_type, REG_SZ),
+                L"Invalid comparison type: " << comparison);
+
+            if (comparison_type == installedcheck_comparison_match)
+                return (fieldvalue == regfieldvalue);
+            else if (comparison_type == installedcheck_comparison_contains)
+                return (regfieldvalue.find(fieldvalue.GetValue()) != regfieldvalue.npos);
+            else
+                return comparison.Test(DVLib::Version(regfieldvalue).Compare(fieldvalue.GetVersion()));
         }
-        else if (comparison == TEXT("contains"))
+    case REG_MULTI_SZ:
         {
-            for each (const std::wstring& currentfieldvalue in fieldvalues)
+            std::vector<std::wstring> regfieldvalues = InstallerSession::Instance->registry.GetMultiStringValue(
+                root, key, name, dwKeyOption);
+            LOG(L"Registry value: " << regfieldvalues.size() << L" string(s)");
+            std::vector<std::wstring> fieldvalues = DVLib::split(fieldvalue, L",");
+
+            if (comparison_type == installedcheck_comparison_match)
+            {
+                return (fieldvalues == regfieldvalues);
+            }
+            else if (comparison_type == installedcheck_comparison_contains)
             {
-                bool found = false;
-                for each (const std::wstring& regfieldvalue in regfieldvalues)
+                for each (const std::wstring& currentfieldvalue in fieldvalues)
                 {
-                    if (regfieldvalue == currentfieldvalue)
+                    bool found = false;
+                    for each (const std::wstring& regfieldvalue in regfieldvalues)
                     {
-                        found = true;
-                        break;
+                        if (regfieldvalue == currentfieldvalue)
+                        {
+                            found = true;
+                            break;
+                        }
                     }
+
+                    if (! found) 
+                        return false;
                 }
 
-                if (! found) 
-                    return false;
+                return true;
+            }
+            else
+            {
+                THROW_EX("Invalid comparison type for REG_MULTI_SZ: " << comparison);
             }
-
-            return true;
-        }
-        else
-        {
-            THROW_EX("Invalid comparison type for REG_MULTI_SZ: " << comparison);
         }
+    default:
+        THROW_EX("Unsupported registry type: " << fieldtype);
     }
-    else
+}
+
+bool InstalledCheckRegistry::IsSupported(installedcheck_comparison comparison, DWORD type)
+{
+    switch(comparison)
     {
-        THROW_EX("Unsupported registry type: " << fieldtype);
+    case installedcheck_comparison_exists:
+    case installedcheck_comparison_key_exists:
+    case installedcheck_comparison_value_exists:
+    case installedcheck_comparison_match:
+        return true;
+    case installedcheck_comparison_contains:
+        return type != REG_DWORD;
+    case installedcheck_comparison_version:
+    case installedcheck_comparison_version_patch:
+    case installedcheck_comparison_version_eq:
+    case installedcheck_comparison_version_lt:
+    case installedcheck_comparison_version_le:
+    case installedcheck_comparison_version_gt:
+    case installedcheck_comparison_version_ge:
+        return type != REG_MULTI_SZ;
+    default:
+        return false;
     }
 }
 
-bool InstalledCheckRegistry::IsInstalledKeyExists() const 
+bool InstalledCheckRegistry::IsInstalledKeyExists(HKEY root, const std::wstring& key, DWORD dwKeyOption) const 
 {
     std::wstring keypath = GetKeyPath();
-    DWORD dwKeyOption = GetKeyOption();
-    bool exists = DVLib::RegistryKeyExists(DVLib::wstring2HKEY(rootkey), path, dwKeyOption);
+    bool exists = InstallerSession::Instance->registry.KeyExists(root, key, dwKeyOption);
     LOG(L"Registry key '" << keypath << L"' " << (exists ? L"found" : L"not found"));
     return exists;
 }
 
-bool InstalledCheckRegistry::IsInstalledValueExists() const 
+bool InstalledCheckRegistry::IsInstalledValueExists(HKEY root, const std::wstring& key, const std::wstring& name, DWORD dwKeyOption) const 
 {
     std::wstring keypath = GetKeyPath();
-    DWORD dwKeyOption = GetKeyOption();
-    bool exists = DVLib::RegistryValueExists(DVLib::wstring2HKEY(rootkey), path, fieldname, dwKeyOption);
+    bool exists = InstallerSession::Instance->registry.ValueExists(root, key, name, dwKeyOption);
     LOG(L"Registry value '" << keypath << L"' " << (exists ? L"found" : L"not found"));
     return exists;
 }
 
-bool InstalledCheckRegistry::IsInstalledExists() const 
-{
-    return fieldname.empty()
-        ? IsInstalledKeyExists()
-        : IsInstalledValueExists();
-}
-
 std::wstring InstalledCheckRegistry::GetKeyPath() const
 {
     std::wstring keypath = path.GetValue();
@@ -198,32 +189,23 @@ std::wstring InstalledCheckRegistry::GetKeyPath() const
 
 DWORD InstalledCheckRegistry::GetKeyOption() const
 {
-    DVLib::OperatingSystem type = DVLib::GetOperatingSystemVersion();
+    DVLib::OperatingSystem type = InstallerSession::Instance->GetOperatingSystemVersion();
     DWORD dwKeyOption = KEY_READ;
 
     // alternate registry view is available from Windows XP onwards for 64 bit systems
     if (type >= DVLib::winXP && ! wowoption.empty())
     {
-        // indicates that an application on 64-bit Windows should operate on the 64-bit registry view
-        if (_wcsicmp(wowoption.GetValue().c_str(), L"WOW64_64") == 0)
+        DWORD option = wowoption.GetOption();
+        if (option == KEY_WOW64_64KEY)
         {	
             LOG(L"Opening 64-bit registry view (KEY_WOW64_64KEY)");
-            dwKeyOption |= KEY_WOW64_64KEY;
         }
-        //Indicates that an application on 64-bit Windows should operate on the 32-bit registry view.
-        else if (_wcsicmp(wowoption.GetValue().c_str(), L"WOW64_32") == 0)
+        else if (option == KEY_WOW64_32KEY)
         {
             LOG(L"Opening 32-bit registry view (KEY_WOW64_32KEY)");
-            dwKeyOption |= KEY_WOW64_32KEY;
-        }
-        else if (_wcsicmp(wowoption.GetValue().c_str(), L"NONE") == 0)
-        {
-            // ignore
-        }
-        else
-        {
-            THROW_EX(L"Invalid WOW option '" << wowoption << L"'");
         }
+
+        dwKeyOption |= option;
     }
 
     return dwKeyOption;
@@ -231,12 +213,68 @@ DWORD InstalledCheckRegistry::GetKeyOption() const
 
 bool InstalledCheckRegistry::IsInstalled() const
 {
-    if (comparison == L"exists")
-        return IsInstalledExists();
-    else if (comparison == L"key_exists")
-        return IsInstalledKeyExists();
-    else if (comparison == L"value_exists")
-        return IsInstalledValueExists();
-    else 
-        return IsInstalledValue();
+    // attributes are resolved once, literals were parsed when loaded
+    HKEY root = rootkey.GetKey();
+    DWORD dwKeyOption = GetKeyOption();
+    std::wstring key = path;
+    std::wstring name = fieldname;
+
+    switch(comparison.GetType())
+    {
+    case installedcheck_comparison_exists:
+        return name.empty()
+            ? IsInstalledKeyExists(root, key, dwKeyOption)
+            : IsInstalledValueExists(root, key, name, dwKeyOption);
+    case installedcheck_comparison_key_exists:
+        return IsInstalledKeyExists(root, key, dwKeyOption);
+    case installedcheck_comparison_value_exists:
+        return IsInstalledValueExists(root, key, name, dwKeyOption);
+    default:
+        return IsInstalledValue(root, key, name, dwKeyOption);
+    }
+}
+
+std::wstring InstalledCheckRegistry::GetFingerprint() const
+{
+    std::wstring fingerprint(L"check_registry_value");
+    AppendFingerprint(fingerprint, rootkey);
+    AppendFingerprint(fingerprint, wowoption);
+    AppendFingerprint(fingerprint, path);
+    AppendFingerprint(fingerprint, fieldname);
+    AppendFingerprint(fingerprint, fieldtype);
+    AppendFingerprint(fingerprint, fieldvalue);
+    AppendFingerprint(fingerprint, comparison);
+    AppendFingerprint(fingerprint, defaultvalue);
+    return fingerprint;
+}
+
+void InstalledCheckRegistry::Compile(InstalledCheckProgram& program) const
+{
+    program.EmitCheck(installedcheck_op_registry, this);
+}
+
+bool InstalledCheckRegistry::DependsOn(ExpansionTemplate::token_type type, const std::wstring& name) const
+{
+    return rootkey.DependsOn(type, name)
+        || wowoption.DependsOn(type, name)
+        || path.DependsOn(type, name)
+        || fieldname.DependsOn(type, name)
+        || fieldtype.DependsOn(type, name)
+        || fieldvalue.DependsOn(type, name)
+        || comparison.DependsOn(type, name)
+        || defaultvalue.DependsOn(type, name);
+}
+
+bool InstalledCheckRegistry::GetInputs(InstalledCheckInputs& inputs) const
+{
+    // all comparisons read a single key
+    inputs.AddRegistryKey(rootkey.GetKey(), path, GetKeyOption());
+    return true;
+}
+
+std::wstring InstalledCheckRegistry::GetString() const
+{
+    std::wstringstream ss;
+    ss << L"'registry' installed check '" << rootkey << L"\\" << path << L"\\" << fieldname << L"'";
+    return ss.str();
 }
@@ -2,6 +2,11 @@
 
 #include "XmlAttribute.h"
 #include "InstalledCheck.h"
+#include "InstalledCheckComparison.h"
+#include "VersionAttribute.h"
+#include "RegistryTypeAttribute.h"
+#include "RegistryKeyAttribute.h"
+#include "WowOptionAttribute.h"
 
 class InstalledCheckRegistry : public InstalledCheck
 {
@@ -11,27 +16,35 @@ public:
 	// nome del campo del registry
 	XmlAttribute fieldname; 
 	// valore del registry bisogna convertirlo in base al tipo
-	XmlAttribute fieldvalue;
+	VersionAttribute fieldvalue;
 	// tipo del campo nel registry : REG_DWORD (long) o REG_SZ (string)
-	XmlAttribute fieldtype; 
+	RegistryTypeAttribute fieldtype; 
 	// tipo di comparazione : match (verifica se le due stringhe sono uguali) version (che tratta le due stringhe come versioni e quindi se quella richiesta  minore bisogna installare altrimenti no)
-	XmlAttribute comparison;
-	XmlAttribute rootkey;
+	InstalledCheckComparison comparison;
+	RegistryKeyAttribute rootkey;
 	// support for KEY_WOW64_32KEY and KEY_WOW64_64KEY
-	XmlAttribute wowoption; 
+	WowOptionAttribute wowoption; 
 	// default value when the registry key is not found
 	XmlAttribute defaultvalue;
 public:
     InstalledCheckRegistry();
-    void Load(tinyxml2::XMLElement * node);
+    void Load(const ConfigElement * node);
 	bool IsInstalled() const;
+	std::wstring GetFingerprint() const;
+	installedcheck_cost GetCost() const { return installedcheck_cost_registry; }
+	bool GetInputs(InstalledCheckInputs& inputs) const;
+	bool DependsOn(ExpansionTemplate::token_type type, const std::wstring& name) const;
+	void Compile(InstalledCheckProgram& program) const;
+	std::wstring GetString() const;
 private:
 	DWORD GetKeyOption() const;
 	std::wstring GetKeyPath() const;
-	bool IsInstalledExists() const;
-	bool IsInstalledValue() const;
-	bool IsInstalledKeyExists() const;
-	bool IsInstalledValueExists() const;
+	// the root key, key path and value name are resolved once per evaluation
+	bool IsInstalledValue(HKEY root, const std::wstring& key, const std::wstring& name, DWORD dwKeyOption) const;
+	bool IsInstalledKeyExists(HKEY root, const std::wstring& key, DWORD dwKeyOption) const;
+	bool IsInstalledValueExists(HKEY root, const std::wstring& key, const std::wstring& name, DWORD dwKeyOption) const;
+	// REG_NONE allows any comparison supported by one of the types
+	static bool IsSupported(installedcheck_comparison comparison, DWORD type);
 };
 
 typedef shared_any<InstalledCheckRegistry *, close_delete> InstalledCheckRegistryPtr;
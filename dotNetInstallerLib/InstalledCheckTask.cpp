@@ -0,0 +1,28 @@
+#include "StdAfx.h"
+#include "InstalledCheckTask.h"
+
+InstalledCheckTask::InstalledCheckTask(const ComponentPtr& component)
+: m_component(component)
+, m_installed(false)
+{
+
+}
+
+InstalledCheckTask::~InstalledCheckTask()
+{
+    Cancel();
+    Wait();
+}
+
+bool InstalledCheckTask::IsInstalled()
+{
+    Wait();
+    CHECK_BOOL(m_error.empty(), m_error);
+    return m_installed;
+}
+
+int InstalledCheckTask::ExecOnThread()
+{
+    m_installed = m_component->RefreshInstalled(m_inputs);
+    return 0;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "WorkerPool.h"
+#include "Component.h"
+
+// refreshes the installed state of a component on the process-wide worker pool
+class InstalledCheckTask : public WorkerTask
+{
+private:
+	ComponentPtr m_component;
+	bool m_installed;
+	InstalledCheckInputsPtr m_inputs;
+public:
+	InstalledCheckTask(const ComponentPtr& component);
+	virtual ~InstalledCheckTask();
+	const ComponentPtr& GetComponent() const { return m_component; }
+	// waits for the result, throws the error of a failed check
+	bool IsInstalled();
+	// inputs the result was evaluated from, see Component::RefreshInstalled
+	const InstalledCheckInputsPtr& GetInputs() const { return m_inputs; }
+protected:
+	int ExecOnThread();
+};
+
+typedef shared_any<InstalledCheckTask *, close_delete> InstalledCheckTaskPtr;
@@ -7,7 +7,12 @@ shared_any<InstallerLog *, close_delete> InstallerLog::Instance;
 InstallerLog::InstallerLog(void)
 : m_enabled(false)
 {
+    ::InitializeCriticalSection(& m_cs);
+}
 
+InstallerLog::~InstallerLog()
+{
+    ::DeleteCriticalSection(& m_cs);
 }
 
 void InstallerLog::Write(const std::wstring& message)
@@ -15,6 +20,21 @@ void InstallerLog::Write(const std::wstring& message)
     if (! IsEnabled() || message.empty())
         return;
 
+    ::EnterCriticalSection(& m_cs);
+    try
+    {
+        WriteLine(message);
+    }
+    catch(...)
+    {
+        ::LeaveCriticalSection(& m_cs);
+        throw;
+    }
+    ::LeaveCriticalSection(& m_cs);
+}
+
+void InstallerLog::WriteLine(const std::wstring& message)
+{
     if (get(m_hFile) == INVALID_HANDLE_VALUE)
     {
         if (m_logfile.empty())
@@ -50,5 +70,7 @@ void InstallerLog::SetLogFile(const std::wstring& filename)
 
 void InstallerLog::CloseLog()
 { 
+    ::EnterCriticalSection(& m_cs);
     reset(m_hFile);
+    ::LeaveCriticalSection(& m_cs);
 }
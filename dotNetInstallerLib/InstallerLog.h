@@ -4,6 +4,7 @@ class InstallerLog
 {
 public:
 	InstallerLog();
+	~InstallerLog();
 	void DisableLog() { m_enabled = false; }
 	bool IsEnabled() const { return m_enabled; }
     void EnableLog() { m_enabled = true; }
@@ -17,6 +18,9 @@ private:
 	bool m_enabled;
 	std::wstring m_logfile;
     auto_hfile m_hFile;
+	// installed checks may log from worker threads
+	CRITICAL_SECTION m_cs;
+	void WriteLine(const std::wstring& message);
 };
 
 #define LOG( message ) \
@@ -3,6 +3,7 @@
 #include "InstallerLog.h"
 #include "InstallerLauncher.h"
 #include "InstallUILevel.h"
+#include "VariableExpander.h"
 
 #define REGISTRY_CURRENTVERSION_RUN L"SOFTWARE\\Microsoft\\Windows\\CurrentVersion\\Run"
 
@@ -13,28 +14,47 @@ InstallerSession::InstallerSession()
 , guid(DVLib::GenerateGUIDStringW())
 , sequence(SequenceInstall)
 , lcidtype(DVLib::LcidUserExe)
+, m_variables_generation(0)
+, m_variables_hits(0)
+, m_variables_misses(0)
 {
+    ::InitializeCriticalSection(& m_variables_cs);
+    m_variables_state = GetVariablesState();
+}
 
+InstallerSession::~InstallerSession()
+{
+    ::DeleteCriticalSection(& m_variables_cs);
 }
 
 std::wstring InstallerSession::GetSessionCabPath(bool returnonly)
 {
+    // installed checks may expand #CABPATH on several threads
+    ::EnterCriticalSection(& m_variables_cs);
     if (cabpath.empty() && ! returnonly)
     {
         cabpath = DVLib::DirectoryCombine(DVLib::GetTemporaryDirectoryW(), guid);
         DVLib::DirectoryCreate(cabpath);
     }
+    std::wstring path = cabpath;
+    ::LeaveCriticalSection(& m_variables_cs);
+
+    return ExpandVariables(path);
+}
 
-    return ExpandVariables(cabpath);
+std::wstring InstallerSession::GetUserVariable(const std::wstring& name)
+{
+    ::EnterCriticalSection(& m_variables_cs);
+    // undefined variables are added with an empty value
+    std::wstring value = AdditionalControlArgs[name];
+    ::LeaveCriticalSection(& m_variables_cs);
+    return value;
 }
 
 std::wstring InstallerSession::ExpandVariables(const std::wstring& value)
 {
-    std::wstring result = DVLib::ExpandEnvironmentVariables(value);
-    result = ExpandPathVariables(result);
-    result = ExpandRegistryVariables(result);
-    result = ExpandUserVariables(result);
-    return result;
+    VariableExpander expander(* this);
+    return expander.Expand(value);
 }
 
 std::wstring InstallerSession::ExpandUserVariables(const std::wstring& s_in)
@@ -54,12 +74,15 @@ std::wstring InstallerSession::ExpandUserVariables(const std::wstring& s_in)
                 s.erase(current++, closeBracketEscapeSize - 1);
             } else if (open == s.npos) {
                 open = current++;
+            } else {
+                // a bracket within a variable name is part of the name
+                ++current;
             }
         } else if (open != s.npos) {
             if (open + 1 == current) {
                 ++current;
             } else {
-                std::wstring value = AdditionalControlArgs[s.substr(open + 1, current - open - 1)];			
+                std::wstring value = GetUserVariable(s.substr(open + 1, current - open - 1));			
                 s.replace(open, current - open + 1, value);
                 current = open + value.size();
             }
@@ -76,7 +99,7 @@ std::wstring InstallerSession::ExpandPathVariables(const std::wstring& path)
 {
     std::wstring s(path);
     std::wstring::size_type i = 0, j = 0;	
-    while ((i = s.find(L"#", i)) != s.npos && j != s.size())
+    while ((i = s.find(L"#", i)) != s.npos)
     {
         j = i + 1;
         while(j != s.size() && isalpha(s[j]))
@@ -86,39 +109,7 @@ std::wstring InstallerSession::ExpandPathVariables(const std::wstring& path)
         {
             std::wstring name = s.substr(i + 1, j - i - 1);
             std::wstring value;
-            if (name == L"CABPATH")
-                value = GetSessionCabPath();
-            else if (name == L"APPPATH")
-                value = DVLib::GetModuleDirectoryW();
-            else if (name == L"SYSTEMPATH")
-                value = DVLib::GetSystemDirectoryW();
-            else if (name == L"WINDOWSPATH")
-                value = DVLib::GetWindowsDirectoryW();
-            else if (name == L"SYSTEMWINDOWSPATH")
-                value = DVLib::GetSystemWindowsDirectory();
-            else if (name == L"TEMPPATH")
-                value = DVLib::GetTemporaryDirectoryW();
-            else if (name == L"GUID")
-                value = guid;
-            else if (name == L"PID")
-                value = DVLib::towstring(::GetCurrentProcessId());
-            else if (name == L"UILEVEL")
-                value = InstallUILevelSetting::ToString(InstallUILevelSetting::Instance->GetUILevel());
-            else if (name == L"LANGID")
-                value = DVLib::towstring(languageid);
-            else if (name == L"LANGUAGE")
-                value = language;
-            else if (name == L"STARTPATH")
-                value = DVLib::GetModuleDirectoryW();
-            else if (name == L"STARTEXE")
-                value = DVLib::GetModuleFileNameW();
-            else if (name == L"STARTFILENAME")
-                value = DVLib::GetFileNameW(DVLib::GetModuleFileNameW());
-            else if (name == L"OSLANGID")
-                value = DVLib::towstring(DVLib::GetOperatingSystemLCID(InstallerSession::Instance->lcidtype));
-            else if (name == L"OSLOCALE")
-                value = DVLib::GetISOLocale(DVLib::GetOperatingSystemLCID(InstallerSession::Instance->lcidtype));
-            else
+            if (! GetPathVariable(name, value))
             {
                 THROW_EX(L"Invalid variable #" << name << L" in '" << path << L"'");
             }
@@ -145,6 +136,59 @@ std::wstring InstallerSession::ExpandPathVariables(const std::wstring& path)
     return s;
 }
 
+bool InstallerSession::GetPathVariable(const std::wstring& name, std::wstring& value)
+{
+    LONG generation = 0;
+    if (FindVariable(m_path_variables, name, value, generation))
+        return true;
+
+    if (! ResolvePathVariable(name, value))
+        return false;
+
+    AddVariable(m_path_variables, name, value, generation);
+    return true;
+}
+
+bool InstallerSession::ResolvePathVariable(const std::wstring& name, std::wstring& value)
+{
+    if (name == L"CABPATH")
+        value = GetSessionCabPath();
+    else if (name == L"APPPATH")
+        value = DVLib::GetModuleDirectoryW();
+    else if (name == L"SYSTEMPATH")
+        value = DVLib::GetSystemDirectoryW();
+    else if (name == L"WINDOWSPATH")
+        value = DVLib::GetWindowsDirectoryW();
+    else if (name == L"SYSTEMWINDOWSPATH")
+        value = DVLib::GetSystemWindowsDirectory();
+    else if (name == L"TEMPPATH")
+        value = DVLib::GetTemporaryDirectoryW();
+    else if (name == L"GUID")
+        value = guid;
+    else if (name == L"PID")
+        value = DVLib::towstring(::GetCurrentProcessId());
+    else if (name == L"UILEVEL")
+        value = InstallUILevelSetting::ToString(InstallUILevelSetting::Instance->GetUILevel());
+    else if (name == L"LANGID")
+        value = DVLib::towstring(languageid);
+    else if (name == L"LANGUAGE")
+        value = language;
+    else if (name == L"STARTPATH")
+        value = DVLib::GetModuleDirectoryW();
+    else if (name == L"STARTEXE")
+        value = DVLib::GetModuleFileNameW();
+    else if (name == L"STARTFILENAME")
+        value = DVLib::GetFileNameW(DVLib::GetModuleFileNameW());
+    else if (name == L"OSLANGID")
+        value = DVLib::towstring(GetOperatingSystemLCID(lcidtype));
+    else if (name == L"OSLOCALE")
+        value = DVLib::GetISOLocale(GetOperatingSystemLCID(lcidtype));
+    else
+        return false;
+
+    return true;
+}
+
 bool InstallerSession::ExpandRegistryVariable(const std::wstring& variable, std::wstring& value)
 {
     std::vector<std::wstring> parts = DVLib::split(variable, L"\\");
@@ -153,7 +197,7 @@ bool InstallerSession::ExpandRegistryVariable(const std::wstring& variable, std:
     ULONG ulFlags = 0;
     std::vector<std::wstring> hkey_parts = DVLib::split(parts[0], L":", 2);
     HKEY hkey = DVLib::wstring2HKEY(hkey_parts[0]);
-    DVLib::OperatingSystem type = DVLib::GetOperatingSystemVersion();
+    DVLib::OperatingSystem type = GetOperatingSystemVersion();
     if (type >= DVLib::winXP)
     {
         if (hkey_parts.size() > 1)
@@ -174,22 +218,22 @@ bool InstallerSession::ExpandRegistryVariable(const std::wstring& variable, std:
     // path
     std::wstring key_path = DVLib::join(parts, L"\\");
 
-    if (! DVLib::RegistryValueExists(hkey, key_path, key_name, ulFlags))
+    if (! registry.ValueExists(hkey, key_path, key_name, ulFlags))
     {
         return false;
     }
 
-    DWORD dwType = DVLib::RegistryGetValueType(hkey, key_path, key_name, ulFlags);
+    DWORD dwType = registry.GetValueType(hkey, key_path, key_name, ulFlags);
     switch(dwType)
     {
     case REG_SZ:
-        value = DVLib::RegistryGetStringValue(hkey, key_path, key_name, ulFlags);
+        value = registry.GetStringValue(hkey, key_path, key_name, ulFlags);
         break;
     case REG_DWORD:
-        value = DVLib::towstring(DVLib::RegistryGetDWORDValue(hkey, key_path, key_name, ulFlags));
+        value = DVLib::towstring(registry.GetDWORDValue(hkey, key_path, key_name, ulFlags));
         break;
     case REG_MULTI_SZ:
-        value = DVLib::join(DVLib::RegistryGetMultiStringValue(hkey, key_path, key_name, ulFlags), L",");
+        value = DVLib::join(registry.GetMultiStringValue(hkey, key_path, key_name, ulFlags), L",");
         break;
     default:
         THROW_EX(L"Registry value '" << key_path << L"\\" << key_name << L"' is of unsupported type " << dwType);
@@ -206,31 +250,7 @@ std::wstring InstallerSession::ExpandRegistryVariables(const std::wstring& s_in)
     {
         if (i + 2 != j)
         {
-            std::wstring name = s.substr(i + 2, j - i - 2);
-            std::vector<std::wstring> value_parts = DVLib::split(name, L",", 2);
-            std::vector<std::wstring> registry_parts = DVLib::split(value_parts[0], L"|");
-
-            std::wstring value;
-            bool resolved = false;
-
-            for (unsigned int r = 0; r < registry_parts.size(); r++)
-            {
-                if (ExpandRegistryVariable(registry_parts[r], value))
-                {
-                    resolved = true;
-                    break;
-                }
-            }
-
-            if (! resolved)
-            {
-                if (value_parts.size() > 1) 
-                {
-                    // default to the contents of the last value
-                    value = value_parts[1];
-                }
-            }
-
+            std::wstring value = GetRegistryVariable(s.substr(i + 2, j - i - 2));
             s.replace(i, j - i + 1, value);
             i += value.length();
         }
@@ -242,6 +262,157 @@ std::wstring InstallerSession::ExpandRegistryVariables(const std::wstring& s_in)
     return s;
 }
 
+std::wstring InstallerSession::GetRegistryVariable(const std::wstring& name)
+{
+    std::wstring value;
+    LONG generation = 0;
+    if (FindVariable(m_registry_variables, name, value, generation))
+        return value;
+
+    value = ResolveRegistryVariable(name);
+    AddVariable(m_registry_variables, name, value, generation);
+    return value;
+}
+
+std::wstring InstallerSession::ResolveRegistryVariable(const std::wstring& name)
+{
+    std::vector<std::wstring> value_parts = DVLib::split(name, L",", 2);
+    std::vector<std::wstring> registry_parts = DVLib::split(value_parts[0], L"|");
+
+    std::wstring value;
+    for (unsigned int r = 0; r < registry_parts.size(); r++)
+    {
+        if (ExpandRegistryVariable(registry_parts[r], value))
+            return value;
+    }
+
+    // default to the contents of the last value
+    if (value_parts.size() > 1)
+    {
+        value = value_parts[1];
+    }
+
+    return value;
+}
+
+InstallerSession::VariablesState InstallerSession::GetVariablesState() const
+{
+    VariablesState state;
+    state.languageid = languageid;
+    state.language = language;
+    state.cabpath = cabpath;
+    state.lcidtype = lcidtype;
+    state.uilevel = get(InstallUILevelSetting::Instance) != NULL
+        ? InstallUILevelSetting::Instance->GetUILevel()
+        : InstallUILevelNotSet;
+    return state;
+}
+
+void InstallerSession::SetMachine(const DVLib::MachineSnapshotPtr& machine)
+{
+    m_machine = machine;
+    if (get(machine) != NULL)
+    {
+        registry.SetReader(machine->registry);
+        msi_products.SetReader(machine->msi_products);
+        file_versions.SetReader(machine->files);
+    }
+    else
+    {
+        registry.SetReader(DVLib::RegistryReaderPtr(new DVLib::SystemRegistryReader()));
+        msi_products.SetReader(DVLib::MsiProductReaderPtr(new DVLib::SystemMsiProductReader()));
+        file_versions.SetReader(DVLib::FileReaderPtr());
+    }
+
+    // registry and OS variables read the machine
+    InvalidateVariables();
+}
+
+DVLib::OperatingSystem InstallerSession::GetOperatingSystemVersion() const
+{
+    return get(m_machine) != NULL
+        ? m_machine->os
+        : DVLib::GetOperatingSystemVersion();
+}
+
+WORD InstallerSession::GetProcessorArchitecture() const
+{
+    return get(m_machine) != NULL
+        ? m_machine->processor_architecture
+        : DVLib::GetProcessorArchitecture();
+}
+
+LCID InstallerSession::GetOperatingSystemLCID(DVLib::LcidType lcidtype) const
+{
+    return get(m_machine) != NULL
+        ? m_machine->lcid
+        : DVLib::GetOperatingSystemLCID(lcidtype);
+}
+
+void InstallerSession::InvalidateVariables()
+{
+    ::EnterCriticalSection(& m_variables_cs);
+    m_path_variables.clear();
+    m_registry_variables.clear();
+    m_variables_generation++;
+    ::LeaveCriticalSection(& m_variables_cs);
+}
+
+void InstallerSession::InvalidateMachineState()
+{
+    // a component may have changed registry values referenced by variables, installed products or files
+    InvalidateVariables();
+    msi_products.Invalidate();
+    file_versions.Invalidate();
+}
+
+bool InstallerSession::FindVariable(const std::map<std::wstring, std::wstring>& variables, const std::wstring& name, std::wstring& value, LONG& generation)
+{
+    bool found = false;
+
+    ::EnterCriticalSection(& m_variables_cs);
+    VariablesState state = GetVariablesState();
+
+    if (state.languageid != m_variables_state.languageid
+        || state.language != m_variables_state.language
+        || state.cabpath != m_variables_state.cabpath
+        || state.lcidtype != m_variables_state.lcidtype
+        || state.uilevel != m_variables_state.uilevel)
+    {
+        m_variables_state = state;
+        m_path_variables.clear();
+        m_registry_variables.clear();
+        m_variables_generation++;
+    }
+
+    std::map<std::wstring, std::wstring>::const_iterator variable = variables.find(name);
+    if (variable != variables.end())
+    {
+        value = variable->second;
+        m_variables_hits++;
+        found = true;
+    }
+    else
+    {
+        m_variables_misses++;
+    }
+
+    generation = m_variables_generation;
+    ::LeaveCriticalSection(& m_variables_cs);
+    return found;
+}
+
+void InstallerSession::AddVariable(std::map<std::wstring, std::wstring>& variables, const std::wstring& name, const std::wstring& value, LONG generation)
+{
+    ::EnterCriticalSection(& m_variables_cs);
+    // values resolved while the cache was invalidated are stale
+    if (generation == m_variables_generation)
+    {
+        variables[name] = value;
+    }
+    ::LeaveCriticalSection(& m_variables_cs);
+}
+
 std::wstring InstallerSession::GetRebootCmd(const std::wstring& add) const
 {
     std::wstringstream reboot_cmd;
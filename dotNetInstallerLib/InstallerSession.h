@@ -1,11 +1,34 @@
 #pragma once
 
 #include "InstallSequence.h"
+#include "InstallUILevel.h"
+#include "InstalledCheckMemo.h"
 
 class InstallerSession
 {
+private:
+	// session state that variable values depend on
+	struct VariablesState
+	{
+		DWORD languageid;
+		std::wstring language;
+		std::wstring cabpath;
+		DVLib::LcidType lcidtype;
+		InstallUILevel uilevel;
+	};
+	// memoized path and registry variable values, valid within one generation
+	CRITICAL_SECTION m_variables_cs;
+	VariablesState m_variables_state;
+	std::map<std::wstring, std::wstring> m_path_variables;
+	std::map<std::wstring, std::wstring> m_registry_variables;
+	LONG m_variables_generation;
+	LONG m_variables_hits;
+	LONG m_variables_misses;
+	// machine snapshot filters and installed checks are evaluated for
+	DVLib::MachineSnapshotPtr m_machine;
 public:
 	InstallerSession();
+	~InstallerSession();
 	// unique session ID
 	std::wstring guid;
 	// session locale
@@ -18,6 +41,14 @@ public:
 	std::map<std::wstring, std::wstring> AdditionalCmdLineArgs;
 	// additional user-defined variables
 	std::map<std::wstring, std::wstring> AdditionalControlArgs;
+	// registry reads for installed checks and registry variables
+	DVLib::RegistrySnapshot registry;
+	// installed MSI products for product installed checks
+	DVLib::MsiProductInventory msi_products;
+	// version information of files for file installed checks
+	DVLib::FileVersionCache file_versions;
+	// results of identical installed checks
+	InstalledCheckMemo installed_checks;
     // get a unique temporary directory for CAB files in this session
     std::wstring GetSessionCabPath(bool returnonly = false);
 	// expand variables
@@ -26,6 +57,28 @@ public:
 	bool ExpandRegistryVariable(const std::wstring& variable, std::wstring& value);
 	std::wstring ExpandPathVariables(const std::wstring& path);
 	std::wstring ExpandUserVariables(const std::wstring& value);
+	// value of a [name] user variable, safe to call from multiple threads
+	std::wstring GetUserVariable(const std::wstring& name);
+	// value of a #NAME path variable, returns false if the variable doesn't exist
+	bool GetPathVariable(const std::wstring& name, std::wstring& value);
+	// value of a @[key|key,default] registry variable
+	std::wstring GetRegistryVariable(const std::wstring& name);
+	// discard memoized variable values, eg. when AdditionalControlArgs or the registry change
+	void InvalidateVariables();
+	// incremented each time memoized variable values are discarded
+	LONG GetVariablesGeneration() const { return m_variables_generation; }
+	// number of variable values returned from and added to the cache
+	LONG GetVariablesHits() const { return m_variables_hits; }
+	LONG GetVariablesMisses() const { return m_variables_misses; }
+	// discard variables, installed products and file versions read before a component has run
+	void InvalidateMachineState();
+	// evaluate filters and installed checks for a machine snapshot instead of this machine, NULL for this machine
+	void SetMachine(const DVLib::MachineSnapshotPtr& machine);
+	const DVLib::MachineSnapshotPtr& GetMachine() const { return m_machine; }
+	// operating system, processor architecture and locale filters are evaluated for
+	DVLib::OperatingSystem GetOperatingSystemVersion() const;
+	WORD GetProcessorArchitecture() const;
+	LCID GetOperatingSystemLCID(DVLib::LcidType lcidtype) const;
 	// sequence
 	InstallSequence sequence;
 	// lcid type
@@ -40,6 +93,13 @@ public:
 	std::wstring GetRebootCmd(const std::wstring& additional) const;
 	// returns the restart command line
 	std::wstring GetRestartCommandLine(const std::wstring& additional) const;
+private:
+	bool ResolvePathVariable(const std::wstring& name, std::wstring& value);
+	std::wstring ResolveRegistryVariable(const std::wstring& name);
+	// returns a cached variable value, discards all values first if the session state has changed
+	bool FindVariable(const std::map<std::wstring, std::wstring>& variables, const std::wstring& name, std::wstring& value, LONG& generation);
+	void AddVariable(std::map<std::wstring, std::wstring>& variables, const std::wstring& name, const std::wstring& value, LONG generation);
+	VariablesState GetVariablesState() const;
 };
 
 
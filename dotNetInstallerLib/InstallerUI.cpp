@@ -97,6 +97,36 @@ void InstallerUI::LoadComponents()
     }
 }
 
+bool InstallerUI::OnVariableChanged(ExpansionTemplate::token_type type, const std::wstring& name)
+{
+    InstallConfiguration * p_configuration = reinterpret_cast<InstallConfiguration *>(get(m_configuration));
+    if (p_configuration == NULL)
+        return false;
+
+    if (p_configuration->status_installed.DependsOn(type, name)
+        || p_configuration->status_notinstalled.DependsOn(type, name))
+    {
+        LOG(L"Components status depends on '" << name << L"', reloading components");
+        m_install_status = LoadComponentsList(false);
+        return true;
+    }
+
+    Components components_list = p_configuration->GetSupportedComponents(
+        InstallerSession::Instance->lcidtype, InstallerSession::Instance->sequence);
+
+    for each(const ComponentPtr& component in components_list)
+    {
+        if (component->DependsOn(type, name))
+        {
+            LOG(L"Component '" << component->id << L"' depends on '" << name << L"', reloading components");
+            m_install_status = LoadComponentsList(false);
+            return true;
+        }
+    }
+
+    return false;
+}
+
 ComponentsStatus InstallerUI::LoadComponentsList(bool autoSetChecked)
 {
     ComponentsStatus rc;
@@ -109,10 +139,25 @@ ComponentsStatus InstallerUI::LoadComponentsList(bool autoSetChecked)
     Components components_list = pConfiguration->GetSupportedComponents(
         InstallerSession::Instance->lcidtype, InstallerSession::Instance->sequence);
 
+    // installed checks that query the same keys read each key once
+    DVLib::RegistrySnapshotScope registry_snapshot(InstallerSession::Instance->registry);
+    LONG registry_hits = InstallerSession::Instance->registry.GetHits();
+    LONG registry_misses = InstallerSession::Instance->registry.GetMisses();
+    LONG msi_products_misses = InstallerSession::Instance->msi_products.GetMisses();
+    LONG file_versions_hits = InstallerSession::Instance->file_versions.GetHits();
+    LONG file_versions_misses = InstallerSession::Instance->file_versions.GetMisses();
+    // identical installed checks are evaluated once per refresh, results don't outlive the
+    // refresh since installing a component or switching the sequence changes them
+    InstalledCheckMemoScope installed_checks(InstallerSession::Instance->installed_checks);
+    LONG installed_checks_hits = InstallerSession::Instance->installed_checks.GetHits();
+    LONG installed_checks_misses = InstallerSession::Instance->installed_checks.GetMisses();
+
+    // installed checks are independent of one another, all are evaluated before the list is populated
+    components_list.LoadInstalled();
+
     for (size_t i = 0; i < components_list.size(); i++)
     {
         ComponentPtr component(components_list[i]);
-        component->installed = component->IsInstalled();
 
         LOG(L"-- " << component->id << L" (" << component->GetDisplayName() << L"): " 
             << (component->installed ? L"INSTALLED" : L"NOT INSTALLED"));		
@@ -221,6 +266,14 @@ ComponentsStatus InstallerUI::LoadComponentsList(bool autoSetChecked)
         AddComponent(component);
     }
 
+    LOG(L"Registry: " << (InstallerSession::Instance->registry.GetMisses() - registry_misses) << L" key(s) read, "
+        << (InstallerSession::Instance->registry.GetHits() - registry_hits) << L" read(s) served from memory");
+    LOG(L"MSI products: " << (InstallerSession::Instance->msi_products.GetMisses() - msi_products_misses) << L" enumeration(s) and property read(s)");
+    LOG(L"File versions: " << (InstallerSession::Instance->file_versions.GetMisses() - file_versions_misses) << L" read, "
+        << (InstallerSession::Instance->file_versions.GetHits() - file_versions_hits) << L" served from memory");
+    LOG(L"Installed checks: " << (InstallerSession::Instance->installed_checks.GetMisses() - installed_checks_misses) << L" evaluated, "
+        << (InstallerSession::Instance->installed_checks.GetHits() - installed_checks_hits) << L" identical check(s) reused");
+
     LOG(L"All required components " 
         << (InstallerSession::Instance->sequence == SequenceInstall ? L"installed: " : L"uninstalled: ") 
         << (rc.all_required() ? L"yes" : L"no"));
@@ -576,12 +629,32 @@ bool InstallerUI::ComponentExecBegin(const ComponentPtr& component)
     InstallConfiguration * p_configuration = reinterpret_cast<InstallConfiguration *>(get(m_configuration));
     CHECK_BOOL(p_configuration != NULL, L"Invalid configuration");
 
-    ExtractCab(component->id, p_configuration->show_cab_dialog && component->show_cab_dialog);
+    bool extracted = false;
+    bool downloaded = false;
+
+    if (get(m_pipeline))
+    {
+        extracted = m_pipeline->EndExtract(component);
+        // without UI there's no progress to show, wait for a download in progress, with UI the download dialog follows it
+        downloaded = m_pipeline->EndDownload(component, ! InstallUILevelSetting::Instance->IsAnyUI());
+        m_pipeline->Advance(component);
+    }
+
+    if (! extracted)
+    {
+        ExtractCab(component->id, p_configuration->show_cab_dialog && component->show_cab_dialog);
+    }
 
     // download?
-    if (get(component->downloaddialog))
+    if (get(component->downloaddialog) && ! downloaded)
     {
-        if (! RunDownloadConfiguration(component->downloaddialog))
+        bool download_completed = RunDownloadConfiguration(component->downloaddialog);
+
+        // a download handed to the dialog by the pipeline must have completed as well
+        if (get(m_pipeline) && ! m_pipeline->ReleaseDownload(component))
+            download_completed = false;
+
+        if (! download_completed)
         {
             LOG(L"*** Component '" << component->id << L" (" << component->GetDisplayName() << L"): ERROR ON DOWNLOAD");
             THROW_EX(L"Error downloading '" << component->id << L" (" << component->GetDisplayName() << L")");
@@ -591,6 +664,54 @@ bool InstallerUI::ComponentExecBegin(const ComponentPtr& component)
     return true;
 }
 
+bool InstallerUI::IsComponentExecModal(const Components& /* components */) const
+{
+    return false;
+}
+
+int InstallerUI::ExecComponents(Components& components, IExecuteCallback * callback)
+{
+    InstallConfiguration * p_configuration = reinterpret_cast<InstallConfiguration *>(get(m_configuration));
+    CHECK_BOOL(p_configuration != NULL, L"Invalid configuration");
+
+    if (p_configuration->prefetch_extract_depth > 0 || p_configuration->prefetch_download_depth > 0)
+    {
+        reset(m_pipeline, new ComponentsPipeline(GetInstance(), components,
+            p_configuration->prefetch_extract_depth, p_configuration->prefetch_download_depth));
+        m_pipeline->cab_path = p_configuration->cab_path;
+        m_pipeline->cab_cancelled_message = p_configuration->cab_cancelled_message;
+        m_pipeline->Start();
+    }
+
+    int max_concurrency = p_configuration->max_concurrent_components;
+    if (max_concurrency > 1 && IsComponentExecModal(components))
+    {
+        // a modal progress dialog blocks the scheduler until its component completes
+        LOG(L"Progress dialogs are shown, executing one component at a time (max_concurrent_components=" << max_concurrency << L")");
+        max_concurrency = 1;
+    }
+
+    int rc = 0;
+
+    try
+    {
+        rc = components.Exec(callback, max_concurrency);
+    }
+    catch(std::exception&)
+    {
+        reset(m_pipeline);
+        throw;
+    }
+
+    reset(m_pipeline);
+
+    LOG(L"Variables: " << InstallerSession::Instance->GetVariablesHits() << L" cached, "
+        << InstallerSession::Instance->GetVariablesMisses() << L" resolved, generation "
+        << InstallerSession::Instance->GetVariablesGeneration());
+
+    return rc;
+}
+
 void InstallerUI::Terminate()
 {
     try
@@ -8,6 +8,7 @@
 #include "ControlHyperlink.h"
 #include "ControlImage.h"
 #include "ComponentsStatus.h"
+#include "ComponentsPipeline.h"
 
 class InstallerUI
 {
@@ -19,6 +20,7 @@ protected:
 	bool m_additional_config;
 	ComponentsStatus m_install_status;
 	ConfigurationPtr m_configuration;
+	ComponentsPipelinePtr m_pipeline;
 public:
 	InstallerUI();
 	virtual ~InstallerUI();
@@ -39,6 +41,9 @@ protected:
 	// (depending on configuration, current install sequence, install state), or leaved as it was previously set by a user.
 	// Returns install state of the components relative to current install sequence.
 	virtual ComponentsStatus LoadComponentsList(bool autoSetChecked);
+	// a variable has changed, reloads the components list if a supported component depends on it
+	// keeping the checked state; components whose installed check inputs haven't changed aren't evaluated again
+	bool OnVariableChanged(ExpansionTemplate::token_type type, const std::wstring& name);
 	virtual void ExecuteCompleteCode(bool components_installed);
 	virtual void ShowMessage(const std::wstring& message, int flags = 0);
 	virtual bool Run() = 0;
@@ -55,6 +60,10 @@ protected:
 	bool ComponentExecError(const ComponentPtr& component, std::exception& ex);
 	bool ComponentExecSuccess(const ComponentPtr& component);
 	bool ComponentExecBegin(const ComponentPtr& component);
+	// returns true when the UI blocks in OnComponentExecWait until the component completes
+	virtual bool IsComponentExecModal(const Components& components) const;
+	// executes components, prefetching embedded CABs and downloads of the components that follow
+	int ExecComponents(Components& components, IExecuteCallback * callback);
 	void Terminate();
 	void AfterInstall(int rc);
 	// user-defined controls
@@ -70,7 +70,7 @@ void MsiComponent::Exec()
     ProcessComponent::ExecCmd(command, DVLib::CemCreateProcess, disable_wow64_fs_redirection);
 }
 
-void MsiComponent::Load(tinyxml2::XMLElement * node)
+void MsiComponent::Load(const ConfigElement * node)
 {
     package = node->Attribute("package");
     cmdparameters = node->Attribute("cmdparameters");
@@ -88,6 +88,9 @@ void MsiComponent::Wait(DWORD tt)
 {
     ProcessComponent::Wait(tt);
 
+    // products were installed or removed, also when the package has failed
+    InstallerSession::Instance->msi_products.Invalidate();
+
     DWORD exitcode = ProcessComponent::GetProcessExitCode();
 
     LOG(L"Component '" << id << "' return code " << exitcode 
@@ -19,7 +19,7 @@ public:
 	bool disable_wow64_fs_redirection; 
 	void Exec();
 	void Wait(DWORD tt = INFINITE);
-	void Load(tinyxml2::XMLElement * node);
+	void Load(const ConfigElement * node);
 	bool IsRebootRequired() const;
 };
 
@@ -90,7 +90,7 @@ void MspComponent::Exec()
     ProcessComponent::ExecCmd(command, DVLib::CemCreateProcess, disable_wow64_fs_redirection);
 }
 
-void MspComponent::Load(tinyxml2::XMLElement * node)
+void MspComponent::Load(const ConfigElement * node)
 {
     patch = node->Attribute("patch");
     package = node->Attribute("package");
@@ -110,6 +110,9 @@ void MspComponent::Wait(DWORD tt)
 {
     ProcessComponent::Wait(tt);
 
+    // products were installed or removed, also when the package has failed
+    InstallerSession::Instance->msi_products.Invalidate();
+
     DWORD exitcode = ProcessComponent::GetProcessExitCode();
 
     LOG(L"Component '" << id << "' return code " << exitcode 
@@ -54,7 +54,7 @@ void MsuComponent::Exec()
     ProcessComponent::ExecCmd(l_command, execution_method, disable_wow64_fs_redirection);
 }
 
-void MsuComponent::Load(tinyxml2::XMLElement * node)
+void MsuComponent::Load(const ConfigElement * node)
 {
     package = node->Attribute("package");
     cmdparameters = node->Attribute("cmdparameters");
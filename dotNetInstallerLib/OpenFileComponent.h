@@ -13,7 +13,7 @@ public:
 	bool disable_wow64_fs_redirection; 
 	void Exec();
 	bool IsExecuting() const;
-	void Load(tinyxml2::XMLElement * node);
+	void Load(const ConfigElement * node);
 	int GetExitCode() const;
 };
 
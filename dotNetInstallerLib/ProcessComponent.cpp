@@ -42,8 +42,7 @@ void ProcessComponent::Wait(DWORD tt)
 {
     CHECK_BOOL(m_process_handle != NULL, L"Invalid process handle")
 
-    CHECK_WIN32_BOOL(WAIT_OBJECT_0 == WaitForSingleObject(m_process_handle, tt),
-        L"WaitForSingleObject");
+    Component::Wait(tt);
 }
 
 void ProcessComponent::ExecCmd(const std::wstring& command, DVLib::CommandExecutionMethod executionMethod, bool disableWow64FsRedirection, const std::wstring& working_directory, int nShow)
@@ -10,6 +10,8 @@ public:
 	bool IsExecuting() const;
 	DWORD GetProcessExitCode() const;
 	void Wait(DWORD tt = INFINITE);
+	// the process handle is signaled when the process exits
+	HANDLE GetCompletionHandle() const { return m_process_handle; }
 	int GetExitCode() const;
 protected:
 	void ExecCmd(const std::wstring& command, DVLib::CommandExecutionMethod executionMethod, bool disableWow64FsRedirection, const std::wstring& working_directory = L"", int nShow = SW_SHOWNORMAL);
@@ -0,0 +1,67 @@
+#include "StdAfx.h"
+#include "ReferenceCacheTask.h"
+#include "ReferenceConfiguration.h"
+#include "InstallerLog.h"
+
+ReferenceCacheTask::ReferenceCacheTask(const ConfigurationPtr& configuration)
+: m_configuration(configuration)
+, m_cached(false)
+{
+
+}
+
+ReferenceCacheTask::~ReferenceCacheTask()
+{
+    Cancel();
+    Wait();
+}
+
+void ReferenceCacheTask::Start()
+{
+    if (get(WorkerPool::Instance) != NULL)
+    {
+        WorkerPool::Instance->Submit(this);
+        return;
+    }
+
+    try
+    {
+        m_rc = ExecOnThread();
+    }
+    catch(std::exception& ex)
+    {
+        m_error = DVLib::string2wstring(ex.what());
+        m_rc = -1;
+    }
+}
+
+bool ReferenceCacheTask::IsCached()
+{
+    Wait();
+    return m_error.empty() && m_cached;
+}
+
+const std::wstring& ReferenceCacheTask::GetSources()
+{
+    Wait();
+    return m_sources;
+}
+
+int ReferenceCacheTask::ExecOnThread()
+{
+    ReferenceConfiguration * p = reinterpret_cast<ReferenceConfiguration *>(get(m_configuration));
+
+    try
+    {
+        m_cached = p->ValidateCache(m_sources);
+    }
+    catch(std::exception& ex)
+    {
+        // fetched and not cached
+        LOG(L"Error checking cache of '" << p->filename << L"': " << DVLib::string2wstring(ex.what()));
+        m_cached = false;
+        m_sources.clear();
+    }
+
+    return 0;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "WorkerPool.h"
+#include "Configuration.h"
+
+// checks the sources of a cached reference configuration on the process-wide worker pool,
+// each source is a round-trip to its server
+class ReferenceCacheTask : public WorkerTask
+{
+private:
+	ConfigurationPtr m_configuration;
+	bool m_cached;
+	std::wstring m_sources;
+public:
+	ReferenceCacheTask(const ConfigurationPtr& configuration);
+	virtual ~ReferenceCacheTask();
+	// submit to the worker pool, runs on this thread when there's none
+	void Start();
+	// waits for the check, false when the file must be fetched or the check failed
+	bool IsCached();
+	// state of the sources, empty if they can't be checked, see ReferenceConfiguration::ValidateCache
+	const std::wstring& GetSources();
+protected:
+	int ExecOnThread();
+};
+
+typedef shared_any<ReferenceCacheTask *, close_delete> ReferenceCacheTaskPtr;
@@ -16,20 +16,15 @@ ReferenceConfiguration::~ReferenceConfiguration()
 
 }
 
-void ReferenceConfiguration::Load(tinyxml2::XMLElement * node)
+void ReferenceConfiguration::Load(const ConfigElement * node)
 {
-    for (tinyxml2::XMLNode* child = node->FirstChildElement(); child; child = child->NextSibling())
+    for (const ConfigElement * child_element = node->FirstChildElement(); child_element; child_element = child_element->NextSiblingElement())
     {
-        tinyxml2::XMLElement * child_element = child->ToElement();
-
-        if (child_element == NULL)
-            continue;
-
-        if (strcmp(child_element->Value(), "configfile") == 0)
+        if (wcscmp(child_element->Value(), L"configfile") == 0)
         {
             filename = child_element->Attribute("filename");
         }
-        else if (strcmp(child_element->Value(), "downloaddialog") == 0)
+        else if (wcscmp(child_element->Value(), L"downloaddialog") == 0)
         {
             auto_any<DownloadDialog *, close_delete> newdownloaddialog(
                 new DownloadDialog(filename));
@@ -54,6 +49,107 @@ void ReferenceConfiguration::Exec()
     }
 }
 
+std::wstring ReferenceConfiguration::GetCacheFileName() const
+{
+    return filename.GetValue() + L".cache";
+}
+
+bool ReferenceConfiguration::GetSources(std::wstring& sources) const
+{
+    std::wstringstream ss;
+    for each(const DownloadFilePtr& downloadfile in downloaddialog->downloadfiles)
+    {
+        std::wstring version = downloadfile->GetSourceVersion();
+        if (version.empty())
+            return false;
+
+        ss << downloadfile->sourceurl << L"|" << downloadfile->sourcepath << L"|" << version << L";";
+    }
+
+    sources = ss.str();
+    return true;
+}
+
+std::wstring ReferenceConfiguration::GetCacheValue(const std::wstring& key) const
+{
+    // maximum length of a profile string
+    std::vector<wchar_t> value(32767);
+    ::GetPrivateProfileString(L"reference", key.c_str(), L"", & * value.begin(), value.size(), GetCacheFileName().c_str());
+    return & * value.begin();
+}
+
+bool ReferenceConfiguration::IsCacheable() const
+{
+    if (! get(downloaddialog) || downloaddialog->downloadfiles.empty())
+        return false;
+
+    bool fetched = false;
+    std::wstring file = DVLib::lowercase(filename);
+    for each(const DownloadFilePtr& downloadfile in downloaddialog->downloadfiles)
+    {
+        // fetched every time
+        if (downloadfile->clear_cache)
+            return false;
+
+        if (DVLib::lowercase(downloadfile->GetDestinationFileName()) == file)
+            fetched = true;
+    }
+
+    return fetched;
+}
+
+bool ReferenceConfiguration::ValidateCache(std::wstring& sources)
+{
+    sources.clear();
+    if (! IsCacheable())
+        return false;
+
+    std::wstring file = filename;
+    std::wstring cachefile = GetCacheFileName();
+    if (! GetSources(sources))
+    {
+        LOG(L"Reference configuration '" << file << L"' sources can't be checked, ignoring '" << cachefile << L"'");
+        sources.clear();
+        return false;
+    }
+
+    if (! DVLib::FileExists(file) || ! DVLib::FileExists(cachefile))
+        return false;
+
+    if (GetCacheValue(L"size") != DVLib::towstring(DVLib::GetFileSize(file))
+        || GetCacheValue(L"hash") != DVLib::GetFileHash(file))
+    {
+        // modified after it was fetched, left to the download rules
+        LOG(L"Reference configuration '" << file << L"' was modified, deleting '" << cachefile << L"'");
+        DVLib::FileDelete(cachefile);
+        return false;
+    }
+
+    if (GetCacheValue(L"sources") != sources)
+    {
+        // the file is the one that was fetched, an existing file is never fetched again otherwise
+        LOG(L"Reference configuration '" << file << L"' is out of date, deleting '" << file << L"' and '" << cachefile << L"'");
+        DVLib::FileDelete(file);
+        DVLib::FileDelete(cachefile);
+        return false;
+    }
+
+    LOG(L"Reference configuration '" << file << L"' is cached in '" << cachefile << L"'");
+    return true;
+}
+
+void ReferenceConfiguration::Cache(const std::wstring& sources) const
+{
+    std::wstring file = filename;
+    std::wstring cachefile = GetCacheFileName();
+    CHECK_WIN32_BOOL(::WritePrivateProfileString(L"reference", L"sources", sources.c_str(), cachefile.c_str()),
+        L"Error writing '" << cachefile << L"'");
+    CHECK_WIN32_BOOL(::WritePrivateProfileString(L"reference", L"size", DVLib::towstring(DVLib::GetFileSize(file)).c_str(), cachefile.c_str()),
+        L"Error writing '" << cachefile << L"'");
+    CHECK_WIN32_BOOL(::WritePrivateProfileString(L"reference", L"hash", DVLib::GetFileHash(file).c_str(), cachefile.c_str()),
+        L"Error writing '" << cachefile << L"'");
+}
+
 std::wstring ReferenceConfiguration::GetString(int indent) const
 {
     std::wstringstream ss;
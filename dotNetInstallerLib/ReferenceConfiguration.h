@@ -11,8 +11,22 @@ public:
 public:
 	ReferenceConfiguration();
 	~ReferenceConfiguration();
-	virtual void Load(tinyxml2::XMLElement * node);
+	virtual void Load(const ConfigElement * node);
 	void Exec();
+	// true if the file is fetched by the download dialog without clear_cache, a file that the
+	// bootstrapper doesn't fetch is never cached
+	bool IsCacheable() const;
+	// true if the file was fetched before and neither its sources nor the file itself have changed
+	// since, returns the current state of the sources, empty if they can't be checked; deletes a
+	// fetched and unmodified file whose sources have changed, so that it's fetched again
+	bool ValidateCache(std::wstring& sources);
+	// record the state of the sources, size and hash of the fetched file next to it, see ValidateCache
+	void Cache(const std::wstring& sources) const;
 	std::wstring GetString(int indent = 0) const;
+private:
+	std::wstring GetCacheFileName() const;
+	// returns false when the state of a source can't be determined, eg. the server is unreachable
+	bool GetSources(std::wstring& sources) const;
+	std::wstring GetCacheValue(const std::wstring& key) const;
 };
 
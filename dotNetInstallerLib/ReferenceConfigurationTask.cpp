@@ -0,0 +1,74 @@
+#include "StdAfx.h"
+#include "ReferenceConfigurationTask.h"
+#include "ReferenceConfiguration.h"
+#include "InstallerLog.h"
+
+ReferenceConfigurationTask::ReferenceConfigurationTask(const ConfigurationPtr& configuration, bool download,
+    const std::wstring& sources, const std::wstring& file_version)
+: m_configuration(configuration)
+, m_download(download)
+, m_sources(sources)
+, m_file_version(file_version)
+{
+
+}
+
+ReferenceConfigurationTask::~ReferenceConfigurationTask()
+{
+    Cancel();
+    Wait();
+}
+
+void ReferenceConfigurationTask::Start()
+{
+    if (get(WorkerPool::Instance) != NULL)
+    {
+        WorkerPool::Instance->Submit(this);
+        return;
+    }
+
+    try
+    {
+        m_rc = ExecOnThread();
+    }
+    catch(std::exception& ex)
+    {
+        m_error = DVLib::string2wstring(ex.what());
+        m_rc = -1;
+    }
+}
+
+ConfigFile& ReferenceConfigurationTask::GetConfigFile()
+{
+    Wait();
+    CHECK_BOOL(m_error.empty(), m_error);
+    return m_config;
+}
+
+int ReferenceConfigurationTask::ExecOnThread()
+{
+    ReferenceConfiguration * p = reinterpret_cast<ReferenceConfiguration *>(get(m_configuration));
+
+    if (m_download)
+    {
+        p->Exec();
+    }
+
+    m_config.LoadFile(p->filename);
+
+    // a file that existed and wasn't fetched again may have been written by the user
+    if (! m_sources.empty() && (m_file_version.empty() || m_file_version != DownloadFile::GetSourceFileVersion(p->filename)))
+    {
+        // a reference that cannot be cached is downloaded again next time
+        try
+        {
+            p->Cache(m_sources);
+        }
+        catch(std::exception& ex)
+        {
+            LOG(L"Error caching '" << p->filename << L"': " << DVLib::string2wstring(ex.what()));
+        }
+    }
+
+    return 0;
+}
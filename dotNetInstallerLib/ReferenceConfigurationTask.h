@@ -0,0 +1,32 @@
+#pragma once
+
+#include "WorkerPool.h"
+#include "ConfigFile.h"
+
+// downloads and loads the file of a reference configuration on the process-wide worker pool
+class ReferenceConfigurationTask : public WorkerTask
+{
+private:
+	ConfigurationPtr m_configuration;
+	// download the file, false when already downloaded or cached
+	bool m_download;
+	// state of the sources recorded in the cache once loaded, empty not to cache the file
+	std::wstring m_sources;
+	// size and modification time of the file before it was fetched, a file that the download
+	// dialog skips isn't cached
+	std::wstring m_file_version;
+	ConfigFile m_config;
+public:
+	ReferenceConfigurationTask(const ConfigurationPtr& configuration, bool download,
+		const std::wstring& sources, const std::wstring& file_version);
+	virtual ~ReferenceConfigurationTask();
+	const ConfigurationPtr& GetConfiguration() const { return m_configuration; }
+	// submit to the worker pool, runs on this thread when there's none
+	void Start();
+	// waits for the file to load, throws the error of a failed download or load
+	ConfigFile& GetConfigFile();
+protected:
+	int ExecOnThread();
+};
+
+typedef shared_any<ReferenceConfigurationTask *, close_delete> ReferenceConfigurationTaskPtr;
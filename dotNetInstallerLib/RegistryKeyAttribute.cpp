@@ -0,0 +1,47 @@
+#include "StdAfx.h"
+#include "RegistryKeyAttribute.h"
+
+RegistryKeyAttribute::RegistryKeyAttribute()
+: m_key(NULL)
+, m_parsed(false)
+{
+
+}
+
+RegistryKeyAttribute& RegistryKeyAttribute::operator=(const std::wstring& value)
+{
+    m_value = value;
+    m_key = NULL;
+    m_parsed = false;
+
+    if (m_value.IsLiteral())
+    {
+        // literals that aren't root key names throw in GetKey, when the check is evaluated
+        try
+        {
+            m_key = DVLib::wstring2HKEY(m_value.GetValue());
+            m_parsed = true;
+        }
+        catch(std::exception&)
+        {
+        }
+    }
+
+    return * this;
+}
+
+RegistryKeyAttribute& RegistryKeyAttribute::operator=(const wchar_t * value)
+{
+    return operator=(std::wstring(value));
+}
+
+HKEY RegistryKeyAttribute::GetKey() const
+{
+    return m_parsed ? m_key : DVLib::wstring2HKEY(m_value.GetValue());
+}
+
+std::wostream& operator<<(std::wostream& os, const RegistryKeyAttribute& attr)
+{
+    os << attr.GetValue();
+    return os;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "XmlAttribute.h"
+
+// a registry root key name, resolved once when assigned unless it has variables
+class RegistryKeyAttribute
+{
+private:
+	XmlAttribute m_value;
+	HKEY m_key;
+	// false when the value has variables or isn't a root key name
+	bool m_parsed;
+public:
+	RegistryKeyAttribute();
+	RegistryKeyAttribute& operator=(const std::wstring&);
+	RegistryKeyAttribute& operator=(const wchar_t *);
+	// the root key, values with variables are resolved each time, throws if the value isn't a root key name
+	HKEY GetKey() const;
+	std::wstring GetValue() const { return m_value.GetValue(); }
+	const std::wstring& GetSource() const { return m_value.GetSource(); }
+	bool empty() const { return m_value.empty(); }
+	bool IsLiteral() const { return m_value.IsLiteral(); }
+	bool DependsOn(ExpansionTemplate::token_type type, const std::wstring& name) const { return m_value.DependsOn(type, name); }
+	operator std::wstring() const { return GetValue(); }
+};
+
+std::wostream& operator<<(std::wostream& os, const RegistryKeyAttribute& attr);
@@ -0,0 +1,39 @@
+#include "StdAfx.h"
+#include "RegistryTypeAttribute.h"
+
+RegistryTypeAttribute::RegistryTypeAttribute()
+: m_type(REG_NONE)
+{
+
+}
+
+RegistryTypeAttribute& RegistryTypeAttribute::operator=(const std::wstring& value)
+{
+    m_value = value;
+    m_type = m_value.IsLiteral() ? Parse(m_value.GetValue()) : REG_NONE;
+    return * this;
+}
+
+RegistryTypeAttribute& RegistryTypeAttribute::operator=(const wchar_t * value)
+{
+    return operator=(std::wstring(value));
+}
+
+DWORD RegistryTypeAttribute::GetType() const
+{
+    return m_value.IsLiteral() ? m_type : Parse(m_value.GetValue());
+}
+
+DWORD RegistryTypeAttribute::Parse(const std::wstring& name)
+{
+    if (name == L"REG_DWORD") return REG_DWORD;
+    else if (name == L"REG_SZ") return REG_SZ;
+    else if (name == L"REG_MULTI_SZ") return REG_MULTI_SZ;
+    else return REG_NONE;
+}
+
+std::wostream& operator<<(std::wostream& os, const RegistryTypeAttribute& attr)
+{
+    os << attr.GetValue();
+    return os;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "XmlAttribute.h"
+
+// the type of a registry value check, parsed once when assigned unless it has variables
+class RegistryTypeAttribute
+{
+private:
+	XmlAttribute m_value;
+	DWORD m_type;
+public:
+	RegistryTypeAttribute();
+	RegistryTypeAttribute& operator=(const std::wstring&);
+	RegistryTypeAttribute& operator=(const wchar_t *);
+	// REG_DWORD, REG_SZ, REG_MULTI_SZ or REG_NONE if the type isn't supported, values with variables are parsed each time
+	DWORD GetType() const;
+	std::wstring GetValue() const { return m_value.GetValue(); }
+	const std::wstring& GetSource() const { return m_value.GetSource(); }
+	bool empty() const { return m_value.empty(); }
+	bool IsLiteral() const { return m_value.IsLiteral(); }
+	bool DependsOn(ExpansionTemplate::token_type type, const std::wstring& name) const { return m_value.DependsOn(type, name); }
+	operator std::wstring() const { return GetValue(); }
+	static DWORD Parse(const std::wstring& name);
+};
+
+std::wostream& operator<<(std::wostream& os, const RegistryTypeAttribute& attr);
@@ -9,16 +9,16 @@ Schema::Schema()
 
 }
 
-void Schema::Load(tinyxml2::XMLElement * node)
+void Schema::Load(const ConfigElement * node)
 {
     CHECK_BOOL(node != NULL,
         L"Expected 'schema' node");
 
-    CHECK_BOOL(0 == strcmp(node->Value(), "schema"),
-        L"Expected 'schema' node, got '" << DVLib::string2wstring(node->Value()) << L"'");
+    CHECK_BOOL(0 == wcscmp(node->Value(), L"schema"),
+        L"Expected 'schema' node, got '" << node->Value() << L"'");
 
-    version = DVLib::UTF8string2wstring(node->Attribute("version"));
-    generator = DVLib::UTF8string2wstring(node->Attribute("generator"));
+    version = node->Attribute("version");
+    generator = node->Attribute("generator");
 
     LOG(L"Loaded schema: version=" << version << L", generator=" << generator);
 }
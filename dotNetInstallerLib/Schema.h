@@ -1,5 +1,5 @@
 #pragma once
-#include <tinyxml2.h>
+#include "ConfigElement.h"
 
 class Schema
 {
@@ -8,6 +8,6 @@ public:
 	std::wstring generator;
 public:
 	Schema();
-	virtual void Load(tinyxml2::XMLElement * node);
+	virtual void Load(const ConfigElement * node);
 };
 
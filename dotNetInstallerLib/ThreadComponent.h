@@ -1,8 +1,9 @@
 #pragma once
 
-typedef shared_any<CWinThread *, close_delete> ThreadPtr;
+#include "WorkerPool.h"
 
-class ThreadComponent
+// a component that executes ExecOnThread in the background on the process-wide worker pool
+class ThreadComponent : public WorkerTask
 {
 public:
     ThreadComponent();
@@ -13,13 +14,4 @@ public:
     void Exec();
 	void BeginExec();
 	void EndExec();
-protected:
-    ThreadPtr m_pThread;
-    std::wstring m_error;
-	int m_rc;
-    virtual int ExecOnThread() = 0;
-private:
-    static UINT ExecuteThread(LPVOID pParam);
-	int GetExitCode() const { return m_rc; }
-	void WaitForCompletion();
 };
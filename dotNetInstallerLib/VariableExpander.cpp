@@ -0,0 +1,289 @@
+#include "StdAfx.h"
+#include "VariableExpander.h"
+#include "InstallerSession.h"
+
+static wchar_t const openBracketEscape[] = L"[\\[]";
+static wchar_t const closeBracketEscape[] = L"[\\]]";
+
+VariableExpander::VariableExpander(InstallerSession& session)
+: m_session(session)
+, m_source(NULL)
+, m_path_open(false)
+, m_registry_state(registry_none)
+, m_user_open(false)
+{
+
+}
+
+std::wstring VariableExpander::Expand(const std::wstring& value)
+{
+    m_source = & value;
+    m_result.clear();
+    m_result.reserve(value.size());
+    m_path_open = false;
+    m_registry_state = registry_none;
+    m_user_open = false;
+    m_user_escape.clear();
+
+    // environment variables, values are passed to subsequent stages
+    std::wstring::size_type i = 0, j = 0, last = 0;
+    while (((i = value.find(L'%', i)) != value.npos) && ((j = value.find(L'%', i + 1)) != value.npos))
+    {
+        for (; last < i; last++)
+            PutPath(value[last]);
+
+        std::wstring env;
+        if (i + 1 != j)
+        {
+            env = DVLib::GetEnvironmentVariable(value.substr(i + 1, j - i - 1));
+        }
+
+        // if it's not an environment variable, just ignore it and let the command interpreter handle it
+        if (env.empty())
+        {
+            env = value.substr(i, j - i + 1);
+        }
+
+        for (size_t k = 0; k < env.size(); k++)
+            PutPath(env[k]);
+
+        last = i = j + 1;
+    }
+
+    for (; last < value.size(); last++)
+        PutPath(value[last]);
+
+    EndPath();
+    m_source = NULL;
+    return m_result;
+}
+
+void VariableExpander::PutPath(wchar_t c)
+{
+    if (m_path_open)
+    {
+        if (isalpha(c))
+        {
+            m_path_name.append(1, c);
+            return;
+        }
+
+        // don't introduce double-backslashes for paths, bug 4378
+        ResolvePath(c == L'\\');
+    }
+
+    if (c == L'#')
+    {
+        m_path_open = true;
+        m_path_name.clear();
+        return;
+    }
+
+    PutRegistry(c);
+}
+
+void VariableExpander::ResolvePath(bool trim_backslash)
+{
+    m_path_open = false;
+
+    if (m_path_name.empty())
+    {
+        PutRegistry(L'#');
+        return;
+    }
+
+    std::wstring value;
+    CHECK_BOOL(m_session.GetPathVariable(m_path_name, value),
+        L"Invalid variable #" << m_path_name << L" in '" << * m_source << L"'");
+
+    if (trim_backslash)
+        value = DVLib::trimright(value, L"\\");
+
+    for (size_t k = 0; k < value.size(); k++)
+        PutRegistry(value[k]);
+}
+
+void VariableExpander::EndPath()
+{
+    if (m_path_open)
+    {
+        ResolvePath(false);
+    }
+
+    EndRegistry();
+}
+
+void VariableExpander::PutRegistry(wchar_t c)
+{
+    switch(m_registry_state)
+    {
+    case registry_open:
+        if (c != L']')
+        {
+            m_registry_name.append(1, c);
+        }
+        else if (m_registry_name.empty())
+        {
+            PutUser(L'@');
+            PutUser(L'[');
+            PutUser(L']');
+            m_registry_state = registry_skip;
+        }
+        else
+        {
+            std::wstring value = m_session.GetRegistryVariable(m_registry_name);
+            for (size_t k = 0; k < value.size(); k++)
+                PutUser(value[k]);
+            m_registry_state = registry_none;
+        }
+        return;
+    case registry_at:
+        if (c == L'[')
+        {
+            m_registry_state = registry_open;
+            m_registry_name.clear();
+            return;
+        }
+        m_registry_state = registry_none;
+        PutUser(L'@');
+        break;
+    case registry_skip:
+        m_registry_state = registry_none;
+        PutUser(c);
+        return;
+    }
+
+    if (c == L'@')
+    {
+        m_registry_state = registry_at;
+        return;
+    }
+
+    PutUser(c);
+}
+
+void VariableExpander::EndRegistry()
+{
+    switch(m_registry_state)
+    {
+    case registry_at:
+        PutUser(L'@');
+        break;
+    case registry_open:
+        // no closing bracket, left as is
+        PutUser(L'@');
+        PutUser(L'[');
+        for (size_t k = 0; k < m_registry_name.size(); k++)
+            PutUser(m_registry_name[k]);
+        break;
+    }
+
+    m_registry_state = registry_none;
+    EndUser();
+}
+
+void VariableExpander::PutUser(wchar_t c)
+{
+    if (! m_user_escape.empty())
+    {
+        m_user_escape.append(1, c);
+
+        if (m_user_escape == openBracketEscape)
+        {
+            m_user_escape.clear();
+            PutUserChar(L'[');
+            return;
+        }
+
+        if (m_user_escape == closeBracketEscape)
+        {
+            m_user_escape.clear();
+            PutUserChar(L']');
+            return;
+        }
+
+        if (m_user_escape.compare(0, m_user_escape.size(), openBracketEscape, m_user_escape.size()) == 0
+            || m_user_escape.compare(0, m_user_escape.size(), closeBracketEscape, m_user_escape.size()) == 0)
+            return;
+
+        // not an escape, the bracket opens a variable and the characters that follow are scanned again
+        std::wstring pending = m_user_escape.substr(1);
+        m_user_escape.clear();
+        OpenUser();
+        for (size_t k = 0; k < pending.size(); k++)
+            PutUser(pending[k]);
+        return;
+    }
+
+    switch(c)
+    {
+    case L'[':
+        m_user_escape = L"[";
+        break;
+    case L']':
+        if (! m_user_open)
+        {
+            m_result.append(1, c);
+        }
+        else if (m_user_name.empty())
+        {
+            m_result.append(L"[]");
+            m_user_open = false;
+        }
+        else
+        {
+            m_result.append(m_session.GetUserVariable(m_user_name));
+            m_user_open = false;
+        }
+        break;
+    default:
+        PutUserChar(c);
+        break;
+    }
+}
+
+void VariableExpander::OpenUser()
+{
+    // a bracket within a variable name is part of the name
+    if (m_user_open)
+    {
+        m_user_name.append(1, L'[');
+    }
+    else
+    {
+        m_user_open = true;
+        m_user_name.clear();
+    }
+}
+
+void VariableExpander::PutUserChar(wchar_t c)
+{
+    if (m_user_open)
+    {
+        m_user_name.append(1, c);
+    }
+    else
+    {
+        m_result.append(1, c);
+    }
+}
+
+void VariableExpander::EndUser()
+{
+    while (! m_user_escape.empty())
+    {
+        std::wstring pending = m_user_escape.substr(1);
+        m_user_escape.clear();
+        OpenUser();
+        for (size_t k = 0; k < pending.size(); k++)
+            PutUser(pending[k]);
+    }
+
+    // no closing bracket, left as is
+    if (m_user_open)
+    {
+        m_result.append(1, L'[');
+        m_result.append(m_user_name);
+        m_user_open = false;
+    }
+}
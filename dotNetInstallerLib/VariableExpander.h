@@ -0,0 +1,45 @@
+#pragma once
+
+class InstallerSession;
+
+// Expands %ENV%, #NAME, @[registry,default] and [user] variables in a single left-to-right scan.
+// Each kind of variable is recognized by a stage that receives the output of the previous one,
+// so that substituted values are expanded by subsequent stages exactly as with separate passes.
+class VariableExpander
+{
+private:
+	InstallerSession& m_session;
+	// the value being expanded, for error messages
+	const std::wstring * m_source;
+	std::wstring m_result;
+	// path stage: collecting a #NAME
+	bool m_path_open;
+	std::wstring m_path_name;
+	// registry stage
+	enum registry_state
+	{
+		registry_none = 0, // looking for @[
+		registry_at, // @ seen
+		registry_open, // within @[...]
+		registry_skip, // following @[], next character never starts a variable
+	};
+	registry_state m_registry_state;
+	std::wstring m_registry_name;
+	// user stage
+	bool m_user_open;
+	std::wstring m_user_name;
+	std::wstring m_user_escape;
+public:
+	VariableExpander(InstallerSession& session);
+	std::wstring Expand(const std::wstring& value);
+private:
+	void PutPath(wchar_t c);
+	void EndPath();
+	void ResolvePath(bool trim_backslash);
+	void PutRegistry(wchar_t c);
+	void EndRegistry();
+	void PutUser(wchar_t c);
+	void OpenUser();
+	void PutUserChar(wchar_t c);
+	void EndUser();
+};
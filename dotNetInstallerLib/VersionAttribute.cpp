@@ -0,0 +1,38 @@
+#include "StdAfx.h"
+#include "VersionAttribute.h"
+
+VersionAttribute::VersionAttribute()
+: m_parsed(false)
+{
+
+}
+
+VersionAttribute& VersionAttribute::operator=(const XmlAttribute& value)
+{
+    m_value = value;
+    m_version = DVLib::Version();
+    m_parsed = m_value.IsLiteral() && DVLib::Version::TryParse(m_value.GetValue(), m_version);
+    return * this;
+}
+
+VersionAttribute& VersionAttribute::operator=(const std::wstring& value)
+{
+    return operator=(XmlAttribute(value));
+}
+
+VersionAttribute& VersionAttribute::operator=(const wchar_t * value)
+{
+    return operator=(XmlAttribute(value));
+}
+
+DVLib::Version VersionAttribute::GetVersion() const
+{
+    // literals that aren't versions throw here, when compared as one
+    return m_parsed ? m_version : DVLib::Version(m_value.GetValue());
+}
+
+std::wostream& operator<<(std::wostream& os, const VersionAttribute& attr)
+{
+    os << attr.GetValue();
+    return os;
+}
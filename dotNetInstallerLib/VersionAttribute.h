@@ -0,0 +1,29 @@
+#pragma once
+
+#include "XmlAttribute.h"
+
+// an attribute that may be compared as a version, parsed once when assigned unless it has variables
+class VersionAttribute
+{
+private:
+	XmlAttribute m_value;
+	DVLib::Version m_version;
+	// false when the value has variables or isn't a version, eg. the value of a match
+	bool m_parsed;
+public:
+	VersionAttribute();
+	VersionAttribute& operator=(const XmlAttribute&);
+	VersionAttribute& operator=(const std::wstring&);
+	VersionAttribute& operator=(const wchar_t *);
+	// the value as a version, values with variables are parsed each time, throws if the value isn't a version
+	DVLib::Version GetVersion() const;
+	std::wstring GetValue() const { return m_value.GetValue(); }
+	const std::wstring& GetSource() const { return m_value.GetSource(); }
+	bool empty() const { return m_value.empty(); }
+	bool IsLiteral() const { return m_value.IsLiteral(); }
+	bool DependsOn(ExpansionTemplate::token_type type, const std::wstring& name) const { return m_value.DependsOn(type, name); }
+	bool operator==(const std::wstring& rhs) const { return m_value == rhs; }
+	operator std::wstring() const { return GetValue(); }
+};
+
+std::wostream& operator<<(std::wostream& os, const VersionAttribute& attr);
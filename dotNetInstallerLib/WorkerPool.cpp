@@ -0,0 +1,145 @@
+#include "StdAfx.h"
+#include "WorkerPool.h"
+
+shared_any<WorkerPool *, close_delete> WorkerPool::Instance;
+
+WorkerPool::WorkerPool(int max_threads)
+: m_queued(::CreateSemaphore(NULL, 0, LONG_MAX, NULL))
+, m_max_threads(max_threads > 0 ? max_threads : GetDefaultMaxThreads())
+, m_idle(0)
+, m_shutdown(false)
+{
+    CHECK_WIN32_BOOL(get(m_queued) != NULL,
+        L"CreateSemaphore");
+
+    ::InitializeCriticalSection(& m_cs);
+}
+
+WorkerPool::~WorkerPool()
+{
+    ::EnterCriticalSection(& m_cs);
+    m_shutdown = true;
+    ::LeaveCriticalSection(& m_cs);
+
+    // wake up every worker, each one exits once the queue is drained
+    ::ReleaseSemaphore(get(m_queued), m_threads.size(), NULL);
+
+    for each(const ThreadPtr& thread in m_threads)
+    {
+        ::WaitForSingleObject(thread->m_hThread, INFINITE);
+    }
+
+    m_threads.clear();
+    ::DeleteCriticalSection(& m_cs);
+}
+
+int WorkerPool::GetDefaultMaxThreads()
+{
+    // background work is mostly blocked on I/O or child processes, allow some oversubscription
+    SYSTEM_INFO si = { 0 };
+    ::GetSystemInfo(& si);
+    int max_threads = static_cast<int>(si.dwNumberOfProcessors) * 2;
+    return max_threads < 4 ? 4 : max_threads;
+}
+
+int WorkerPool::GetThreadCount() const
+{
+    ::EnterCriticalSection(const_cast<CRITICAL_SECTION *>(& m_cs));
+    int count = m_threads.size();
+    ::LeaveCriticalSection(const_cast<CRITICAL_SECTION *>(& m_cs));
+    return count;
+}
+
+void WorkerPool::Submit(WorkerTask * task)
+{
+    CHECK_BOOL(task != NULL, L"Invalid task");
+    CHECK_BOOL(task->IsComplete(), L"Task is already executing");
+
+    ::EnterCriticalSection(& m_cs);
+
+    try
+    {
+        CHECK_BOOL(! m_shutdown, L"Worker pool is shutting down");
+
+        task->OnSubmit(this);
+        m_queue.push_back(task);
+
+        if (static_cast<int>(m_queue.size()) > m_idle && static_cast<int>(m_threads.size()) < m_max_threads)
+        {
+            StartThread();
+        }
+    }
+    catch(...)
+    {
+        m_queue.remove(task);
+        ::LeaveCriticalSection(& m_cs);
+        throw;
+    }
+
+    ::LeaveCriticalSection(& m_cs);
+
+    CHECK_WIN32_BOOL(::ReleaseSemaphore(get(m_queued), 1, NULL),
+        L"ReleaseSemaphore");
+}
+
+bool WorkerPool::Remove(WorkerTask * task)
+{
+    ::EnterCriticalSection(& m_cs);
+    std::list<WorkerTask *>::iterator it = std::find(m_queue.begin(), m_queue.end(), task);
+    bool removed = (it != m_queue.end());
+    if (removed) m_queue.erase(it);
+    ::LeaveCriticalSection(& m_cs);
+    return removed;
+}
+
+void WorkerPool::StartThread()
+{
+    ThreadPtr thread(AfxBeginThread(WorkerThread, this, THREAD_PRIORITY_NORMAL, 0, CREATE_SUSPENDED));
+
+    CHECK_WIN32_BOOL(get(thread) != NULL,
+        L"AfxBeginThread");
+
+    thread->m_bAutoDelete = false;
+    m_threads.push_back(thread);
+    m_idle++;
+    thread->ResumeThread();
+}
+
+UINT WorkerPool::WorkerThread(LPVOID pParam)
+{
+    static_cast<WorkerPool *>(pParam)->WorkerLoop();
+    return 0;
+}
+
+void WorkerPool::WorkerLoop()
+{
+    while (true)
+    {
+        ::WaitForSingleObject(get(m_queued), INFINITE);
+
+        WorkerTask * task = NULL;
+
+        ::EnterCriticalSection(& m_cs);
+        if (! m_queue.empty())
+        {
+            task = m_queue.front();
+            m_queue.pop_front();
+            m_idle--;
+        }
+        bool shutdown = m_shutdown;
+        ::LeaveCriticalSection(& m_cs);
+
+        if (task == NULL)
+        {
+            // the task was cancelled or picked up by a waiter
+            if (shutdown) break;
+            continue;
+        }
+
+        task->Execute();
+
+        ::EnterCriticalSection(& m_cs);
+        m_idle++;
+        ::LeaveCriticalSection(& m_cs);
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "WorkerTask.h"
+
+typedef shared_any<CWinThread *, close_delete> ThreadPtr;
+
+// a process-wide, bounded pool of worker threads executing WorkerTask instances,
+// threads are started on demand and reused until the pool is destroyed
+class WorkerPool
+{
+	friend class WorkerTask;
+public:
+	static shared_any<WorkerPool *, close_delete> Instance;
+	// max_threads = 0 picks a default based on the number of processors
+	WorkerPool(int max_threads = 0);
+	~WorkerPool();
+	// queue a task for execution, the caller owns the task and keeps it alive until it completes
+	void Submit(WorkerTask * task);
+	int GetMaxThreads() const { return m_max_threads; }
+	int GetThreadCount() const;
+	static int GetDefaultMaxThreads();
+private:
+	CRITICAL_SECTION m_cs;
+	shared_semaphore m_queued;
+	std::list<WorkerTask *> m_queue;
+	std::vector<ThreadPtr> m_threads;
+	int m_max_threads;
+	int m_idle;
+	bool m_shutdown;
+	// removes a task that hasn't been picked up by a worker, returns false if it's no longer queued
+	bool Remove(WorkerTask * task);
+	void StartThread();
+	static UINT WorkerThread(LPVOID pParam);
+	void WorkerLoop();
+};
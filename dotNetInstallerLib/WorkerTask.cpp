@@ -0,0 +1,135 @@
+#include "StdAfx.h"
+#include "WorkerTask.h"
+#include "WorkerPool.h"
+
+WorkerTask::WorkerTask()
+: m_rc(0)
+, m_cancelled(0)
+, m_pool(NULL)
+, m_completed(false)
+, m_submitted_ticks(0)
+, m_started_ticks(0)
+, m_completed_ticks(0)
+{
+    ::InitializeCriticalSection(& m_cs);
+}
+
+WorkerTask::~WorkerTask()
+{
+    Cancel();
+    m_completion.Wait();
+    ::DeleteCriticalSection(& m_cs);
+}
+
+void WorkerTask::OnSubmit(WorkerPool * pool)
+{
+    m_pool = pool;
+    m_completed = false;
+    m_error.clear();
+    m_rc = 0;
+    ::InterlockedExchange(& m_cancelled, 0);
+    m_submitted_ticks = m_started_ticks = m_completed_ticks = ::GetTickCount();
+    m_completion.Reset();
+}
+
+void WorkerTask::Execute()
+{
+    m_started_ticks = ::GetTickCount();
+
+    if (IsCancelled())
+    {
+        m_error = L"Cancelled";
+        m_rc = -1;
+    }
+    else
+    {
+        try
+        {
+            m_rc = ExecOnThread();
+        }
+        catch(std::exception& ex)
+        {
+            m_error = DVLib::string2wstring(ex.what());
+            m_rc = -1;
+        }
+    }
+
+    m_completed_ticks = ::GetTickCount();
+
+    std::vector<WorkerTask *> continuations;
+    ::EnterCriticalSection(& m_cs);
+    continuations.swap(m_continuations);
+    WorkerPool * pool = m_pool;
+    // the pool is drained before it's destroyed, a completed task no longer references it
+    m_pool = NULL;
+    m_completed = true;
+    ::LeaveCriticalSection(& m_cs);
+
+    for each(WorkerTask * continuation in continuations)
+    {
+        if (pool != NULL)
+        {
+            try
+            {
+                pool->Submit(continuation);
+                continue;
+            }
+            catch(std::exception&)
+            {
+                // the pool is shutting down, run the continuation here so that its waiters are released
+            }
+        }
+
+        continuation->OnSubmit(NULL);
+        continuation->Execute();
+    }
+
+    // the task may be destroyed by a waiter as soon as it's signaled, don't touch members below
+    m_completion.Signal();
+}
+
+bool WorkerTask::Remove()
+{
+    ::EnterCriticalSection(& m_cs);
+    bool removed = (m_pool != NULL && m_pool->Remove(this));
+    ::LeaveCriticalSection(& m_cs);
+    return removed;
+}
+
+bool WorkerTask::Wait(DWORD dwTimeout)
+{
+    if (dwTimeout == INFINITE && Remove())
+    {
+        // a worker would have to be freed first to run this task, which may never happen when
+        // the caller is itself a worker, run it here instead
+        Execute();
+    }
+
+    return m_completion.Wait(dwTimeout);
+}
+
+void WorkerTask::Cancel()
+{
+    ::InterlockedExchange(& m_cancelled, 1);
+
+    if (Remove())
+    {
+        Execute();
+    }
+}
+
+void WorkerTask::ContinueWith(WorkerTask * continuation)
+{
+    CHECK_BOOL(continuation != NULL, L"Invalid continuation");
+
+    ::EnterCriticalSection(& m_cs);
+    bool completed = m_completed;
+    if (! completed) m_continuations.push_back(continuation);
+    ::LeaveCriticalSection(& m_cs);
+
+    if (completed)
+    {
+        continuation->OnSubmit(NULL);
+        continuation->Execute();
+    }
+}
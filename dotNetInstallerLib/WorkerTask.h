@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CompletionEvent.h"
+
+class WorkerPool;
+
+// a unit of work executed by a WorkerPool, doubles as the future of its result
+class WorkerTask
+{
+	friend class WorkerPool;
+public:
+	WorkerTask();
+	virtual ~WorkerTask();
+public:
+	// signaled when the task has completed, was cancelled or was never submitted
+	HANDLE GetCompletionHandle() const { return m_completion.GetHandle(); }
+	// returns true if the task completes within the timeout, never runs the task
+	bool IsComplete(DWORD dwTimeout = 0) const { return m_completion.Wait(dwTimeout); }
+	// waits for the task to complete, returns false on timeout; an infinite
+	// wait runs a task that no worker has picked up yet on the calling thread
+	bool Wait(DWORD dwTimeout = INFINITE);
+	// removes a task that hasn't started from the pool, a running task can check IsCancelled
+	void Cancel();
+	bool IsCancelled() const { return m_cancelled != 0; }
+	// submit a task to the same pool once this task completes, runs it
+	// on the calling thread when this task has already completed
+	void ContinueWith(WorkerTask * continuation);
+	int GetResult() const { return m_rc; }
+	// time spent in the queue and executing, in milliseconds
+	DWORD GetQueuedTime() const { return m_started_ticks - m_submitted_ticks; }
+	DWORD GetRunTime() const { return m_completed_ticks - m_started_ticks; }
+protected:
+	std::wstring m_error;
+	int m_rc;
+	virtual int ExecOnThread() = 0;
+private:
+	CompletionEvent m_completion;
+	CRITICAL_SECTION m_cs;
+	volatile LONG m_cancelled;
+	// the pool is only referenced while the task is queued or running
+	WorkerPool * m_pool;
+	bool m_completed;
+	std::vector<WorkerTask *> m_continuations;
+	DWORD m_submitted_ticks;
+	DWORD m_started_ticks;
+	DWORD m_completed_ticks;
+	void OnSubmit(WorkerPool * pool);
+	void Execute();
+	// removes the task from its pool's queue, false if no worker can pick it up anymore
+	bool Remove();
+};
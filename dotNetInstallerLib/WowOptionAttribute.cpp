@@ -0,0 +1,51 @@
+#include "StdAfx.h"
+#include "WowOptionAttribute.h"
+
+WowOptionAttribute::WowOptionAttribute()
+: m_option(0)
+, m_parsed(true)
+{
+
+}
+
+WowOptionAttribute& WowOptionAttribute::operator=(const std::wstring& value)
+{
+    m_value = value;
+    m_option = 0;
+    // invalid literals throw in GetOption, when the check is evaluated
+    m_parsed = m_value.IsLiteral() && TryParse(m_value.GetValue(), m_option);
+    return * this;
+}
+
+WowOptionAttribute& WowOptionAttribute::operator=(const wchar_t * value)
+{
+    return operator=(std::wstring(value));
+}
+
+DWORD WowOptionAttribute::GetOption() const
+{
+    if (m_parsed)
+        return m_option;
+
+    DWORD option = 0;
+    CHECK_BOOL(TryParse(m_value.GetValue(), option),
+        L"Invalid WOW option '" << m_value.GetValue() << L"'");
+    return option;
+}
+
+bool WowOptionAttribute::TryParse(const std::wstring& name, DWORD& option)
+{
+    // indicates that an application on 64-bit Windows should operate on the 64-bit registry view
+    if (_wcsicmp(name.c_str(), L"WOW64_64") == 0) option = KEY_WOW64_64KEY;
+    // indicates that an application on 64-bit Windows should operate on the 32-bit registry view
+    else if (_wcsicmp(name.c_str(), L"WOW64_32") == 0) option = KEY_WOW64_32KEY;
+    else if (name.empty() || _wcsicmp(name.c_str(), L"NONE") == 0) option = 0;
+    else return false;
+    return true;
+}
+
+std::wostream& operator<<(std::wostream& os, const WowOptionAttribute& attr)
+{
+    os << attr.GetValue();
+    return os;
+}
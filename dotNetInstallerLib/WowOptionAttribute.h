@@ -0,0 +1,28 @@
+#pragma once
+
+#include "XmlAttribute.h"
+
+// a registry view option (WOW64_64, WOW64_32 or NONE), parsed once when assigned unless it has variables
+class WowOptionAttribute
+{
+private:
+	XmlAttribute m_value;
+	DWORD m_option;
+	// false when the value has variables or isn't a valid option
+	bool m_parsed;
+public:
+	WowOptionAttribute();
+	WowOptionAttribute& operator=(const std::wstring&);
+	WowOptionAttribute& operator=(const wchar_t *);
+	// KEY_WOW64_64KEY, KEY_WOW64_32KEY or 0, values with variables are parsed each time, throws if the option is invalid
+	DWORD GetOption() const;
+	std::wstring GetValue() const { return m_value.GetValue(); }
+	const std::wstring& GetSource() const { return m_value.GetSource(); }
+	bool empty() const { return m_value.empty(); }
+	bool IsLiteral() const { return m_value.IsLiteral(); }
+	bool DependsOn(ExpansionTemplate::token_type type, const std::wstring& name) const { return m_value.DependsOn(type, name); }
+	operator std::wstring() const { return GetValue(); }
+	static bool TryParse(const std::wstring& name, DWORD& option);
+};
+
+std::wostream& operator<<(std::wostream& os, const WowOptionAttribute& attr);
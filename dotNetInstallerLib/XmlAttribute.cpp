@@ -1,68 +1,76 @@
 #include "StdAfx.h"
 #include "XmlAttribute.h"
 #include "InstallerSession.h"
+#include "ExpansionTemplatePool.h"
+
+const ExpansionTemplate XmlAttribute::empty_value;
 
 XmlAttribute::XmlAttribute()
+: m_value(NULL)
 {
 }
 
 XmlAttribute::XmlAttribute(const std::string& s)
+: m_value(NULL)
 {
     operator=(s);
 }
 
 std::wstring XmlAttribute::GetValue() const
 {
-    return InstallerSession::Instance->ExpandVariables(value);
+    return GetTemplate().Expand();
 }
 
 XmlAttribute::XmlAttribute(const XmlAttribute& rhs)
+: m_value(rhs.m_value)
 {
-    operator=(rhs);
 }
 
 XmlAttribute::XmlAttribute(const std::wstring& s)
+: m_value(NULL)
 {
     operator=(s);
 }
 
 XmlAttribute::XmlAttribute(const char * psz)
+: m_value(NULL)
 {
     operator=(psz);
 }
 
 XmlAttribute::XmlAttribute(const wchar_t * psz)
+: m_value(NULL)
 {
     operator=(psz);
 }
 
 XmlAttribute& XmlAttribute::operator=(const XmlAttribute& rhs)
 {
-    value = rhs.value;
+    m_value = rhs.m_value;
     return * this;
 }
 
 XmlAttribute& XmlAttribute::operator=(const char * rhs)
 {
-    value = DVLib::UTF8string2wstring(rhs);
+    m_value = ExpansionTemplatePool::Instance().Intern(DVLib::UTF8string2wstring(rhs));
     return * this;
 }
 
 XmlAttribute& XmlAttribute::operator=(const wchar_t * rhs)
 {
-    value = rhs;
+    m_value = ExpansionTemplatePool::Instance().Intern(rhs);
     return * this;
 }
 
 XmlAttribute& XmlAttribute::operator=(const std::string& s)
 {
-    value = DVLib::UTF8string2wstring(s);
+    m_value = ExpansionTemplatePool::Instance().Intern(DVLib::UTF8string2wstring(s));
     return * this;
 }
 
 XmlAttribute& XmlAttribute::operator=(const std::wstring& s)
 {
-    value = s;
+    m_value = ExpansionTemplatePool::Instance().Intern(s);
     return * this;
 }
 
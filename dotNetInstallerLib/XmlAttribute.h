@@ -1,9 +1,15 @@
 #pragma once
 
+#include "ExpansionTemplate.h"
+
+// an attribute value, copies share one interned template tokenized when the value was assigned
 class XmlAttribute
 {
 private:
-	std::wstring value;
+	// NULL for an empty value
+	const ExpansionTemplate * m_value;
+	static const ExpansionTemplate empty_value;
+	const ExpansionTemplate& GetTemplate() const { return m_value ? * m_value : empty_value; }
 public:
 	std::wstring GetValue() const;
 	bool GetBoolValue(bool defaultvalue) const { return DVLib::wstring2bool(GetValue(), defaultvalue); }
@@ -19,7 +25,15 @@ public:
 	XmlAttribute& operator=(const std::string&);
 	XmlAttribute& operator=(const char *);
 	XmlAttribute& operator=(const wchar_t *);
-	bool empty() const { return value.empty(); }
+	// value before variables are expanded
+	const std::wstring& GetSource() const { return GetTemplate().GetSource(); }
+	bool empty() const { return m_value == NULL; }
+	// true when both attributes hold the same value before variables are expanded
+	bool IsSameSource(const XmlAttribute& rhs) const { return m_value == rhs.m_value; }
+	// true when the value has no variables and never changes
+	bool IsLiteral() const { return GetTemplate().IsLiteral(); }
+	// true if the value may change with the value of a variable
+	bool DependsOn(ExpansionTemplate::token_type type, const std::wstring& name) const { return GetTemplate().DependsOn(type, name); }
 	bool operator==(const std::wstring& rhs) const { return GetValue() == rhs; }
 	bool operator==(const wchar_t * rhs) const { return GetValue() == rhs; }
 	bool operator!=(const std::wstring& rhs) const { return GetValue() != rhs; }
@@ -1,19 +1,39 @@
 #pragma once
 
+#include "ExpansionTemplate.h"
+#include "ExpansionTemplatePool.h"
+#include "VariableExpander.h"
 #include "XmlAttribute.h"
+#include "ConfigElement.h"
+#include "ConfigArena.h"
+#include "ConfigNode.h"
+#include "AttributeCallback.h"
+#include "AttributeBindings.h"
 #include "Component.h"
 #include "Components.h"
+#include "CompletionEvent.h"
+#include "ComponentsScheduler.h"
+#include "ComponentsPipeline.h"
 #include "CmdComponent.h"
 #include "dotNetInstallerLib.h"
 #include "DownloadCallback.h"
+#include "DownloadPrefetch.h"
 #include "DownloadFile.h"
 #include "DownloadDialog.h"
 #include "InstalledCheck.h"
+#include "InstalledCheckComparison.h"
+#include "VersionAttribute.h"
+#include "RegistryTypeAttribute.h"
+#include "RegistryKeyAttribute.h"
+#include "WowOptionAttribute.h"
 #include "InstalledCheckFile.h"
 #include "InstalledCheckDirectory.h"
 #include "InstalledCheckOperator.h"
 #include "InstalledCheckRegistry.h"
 #include "InstalledCheckProduct.h"
+#include "InstalledCheckMemo.h"
+#include "InstalledCheckInputs.h"
+#include "InstalledCheckProgram.h"
 #include "InstallerLog.h"
 #include "Configuration.h"
 #include "InstallUILevel.h"
@@ -23,8 +43,12 @@
 #include "ExeComponent.h"
 #include "OpenFileComponent.h"
 #include "ProcessComponent.h"
+#include "WorkerTask.h"
+#include "WorkerPool.h"
 #include "ThreadComponent.h"
+#include "InstalledCheckTask.h"
 #include "WidgetPosition.h"
+#include "ConfigImage.h"
 #include "ConfigFile.h"
 #include "Configurations.h"
 #include "FileAttribute.h"
@@ -33,6 +57,8 @@
 #include "EmbedFolder.h"
 #include "FileAttributes.h"
 #include "ReferenceConfiguration.h"
+#include "ReferenceConfigurationTask.h"
+#include "ReferenceCacheTask.h"
 #include "InstallerSession.h"
 #include "ExtractComponent.h"
 #include "InstallConfiguration.h"
@@ -59,4 +85,5 @@
 #include "DisableWnd.h"
 #include "ComponentsStatus.h"
 #include "InstallerUI.h"
+#include "InstallPlan.h"
 #include "Wow64NativeFS.h"
\ No newline at end of file
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "FileUtil.h"
+
+namespace DVLib
+{
+	// reads files for installed checks in place of the file system
+	class IFileReader
+	{
+	public:
+		virtual bool FileExists(const std::wstring& filename) = 0;
+		virtual bool DirectoryExists(const std::wstring& path) = 0;
+		// version information of an executable file, throws if the file doesn't have any
+		virtual FileVersionInfo GetFileVersionInfo(const std::wstring& filename) = 0;
+		virtual ~IFileReader() { }
+	};
+
+	typedef shared_any<IFileReader *, close_delete> FileReaderPtr;
+}
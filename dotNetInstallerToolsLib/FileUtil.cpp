@@ -5,6 +5,10 @@
 #include "ErrorUtil.h"
 #include "PathUtil.h"
 #include "FormatUtil.h"
+#include "VersionResource.h"
+#include "Version.h"
+#include "MappedFile.h"
+#include <wincrypt.h>
 
 bool DVLib::FileExists(const std::string& filename)
 {
@@ -134,6 +138,38 @@ std::vector<char> DVLib::FileReadToEnd(const std::wstring& filename)
     return data;
 }
 
+std::wstring DVLib::GetFileHash(const std::wstring& filename)
+{
+    MappedFile file(filename);
+
+    HCRYPTPROV hProv = NULL;
+    CHECK_WIN32_BOOL(::CryptAcquireContext(& hProv, NULL, NULL, PROV_RSA_FULL, CRYPT_VERIFYCONTEXT),
+        L"Error acquiring a cryptographic context to hash \"" << filename << L"\"");
+
+    HCRYPTHASH hHash = NULL;
+    BYTE hash[20] = { 0 };
+    DWORD hash_size = sizeof(hash);
+    BOOL rc = ::CryptCreateHash(hProv, CALG_SHA1, 0, 0, & hHash)
+        && (file.GetSize() == 0 || ::CryptHashData(hHash, reinterpret_cast<const BYTE *>(file.GetData()), file.GetSize(), 0))
+        && ::CryptGetHashParam(hHash, HP_HASHVAL, hash, & hash_size, 0);
+    DWORD dwErr = ::GetLastError();
+    if (hHash != NULL) ::CryptDestroyHash(hHash);
+    ::CryptReleaseContext(hProv, 0);
+    ::SetLastError(dwErr);
+    CHECK_WIN32_BOOL(rc,
+        L"Error hashing \"" << filename << L"\"");
+
+    static const wchar_t digits[] = L"0123456789abcdef";
+    std::wstring result;
+    result.reserve(hash_size * 2);
+    for (DWORD i = 0; i < hash_size; i++)
+    {
+        result.append(1, digits[hash[i] >> 4]);
+        result.append(1, digits[hash[i] & 0x0F]);
+    }
+    return result;
+}
+
 void DVLib::FileWrite(
                       const std::wstring& filename, 
                       const std::vector<char>& data,
@@ -184,6 +220,9 @@ DVLib::FileVersionInfo DVLib::GetFileVersionInfo(const std::wstring& filename)
     dwVerInfoSize = versioninfo_data.size();
     CHECK_WIN32_BOOL(::GetFileVersionInfo(filename.c_str(), dwVerHnd, dwVerInfoSize, & * versioninfo_data.begin()),
         L"GetFileVersionInfo(" << filename << L")");
+    // Unicode resources are read directly, VerQueryValue handles all others
+    if (ParseVersionResource(& * versioninfo_data.begin(), versioninfo_data.size(), result))
+        return result;
     // VS_FIXEDFILEINFO
     UINT fixed_len = 0;
     VS_FIXEDFILEINFO * lpvi = NULL;
@@ -249,9 +288,11 @@ std::wstring DVLib::fileversion2wstring(const FileVersion& version)
 
 int DVLib::CompareVersion(const std::wstring& l, const std::wstring& r)
 {
-    FileVersion l_v = wstring2fileversion(l);
-    FileVersion r_v = wstring2fileversion(r);
+    return Version(l).Compare(Version(r));
+}
 
+int DVLib::CompareVersion(const FileVersion& l_v, const FileVersion& r_v)
+{
     if (l_v.major < r_v.major)
         return -1;
     else if (l_v.major > r_v.major)
@@ -36,6 +36,8 @@ namespace DVLib
         DWORD dwFlagsAndAttributes = FILE_ATTRIBUTE_NORMAL);
 	// read contents of a file
 	std::vector<char> FileReadToEnd(const std::wstring& filename);
+	// SHA-1 hash of the contents of a file as a lowercase hex string
+	std::wstring GetFileHash(const std::wstring& filename);
 	
 	struct TranslationInfo 
 	{
@@ -60,6 +62,19 @@ namespace DVLib
 	template<class T>
 	std::vector<T> LoadResourceData(HMODULE h, const std::wstring& resource, const std::wstring& type);
 
+	// resource data in place in a loaded module, valid while the module stays loaded
+	template<class T>
+	struct ResourceView
+	{
+		const T * data;
+		// number of elements
+		size_t size;
+	};
+
+	// find resource data without copying it
+	template<class T>
+	ResourceView<T> GetResourceView(HMODULE h, const std::wstring& resource, const std::wstring& type);
+
 	// 4-part file version
 	struct FileVersion
 	{
@@ -71,6 +86,7 @@ namespace DVLib
 
 	FileVersion wstring2fileversion(std::wstring version);
 	std::wstring fileversion2wstring(const FileVersion& version);
-	// compare a Windows-specific 4-part version
+	// compare versions, see DVLib::Version to compare a version more than once
 	int CompareVersion(const std::wstring& l, const std::wstring& r);
+	int CompareVersion(const FileVersion& l, const FileVersion& r);
 }
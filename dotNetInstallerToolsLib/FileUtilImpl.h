@@ -1,7 +1,7 @@
 #pragma once
 
 template<class T>
-std::vector<T> DVLib::LoadResourceData(HMODULE h, const std::wstring& resource, const std::wstring& type)
+DVLib::ResourceView<T> DVLib::GetResourceView(HMODULE h, const std::wstring& resource, const std::wstring& type)
 {
 	HRSRC res = ::FindResource(h, resource.c_str(), type.c_str());
 	CHECK_WIN32_BOOL(res != NULL, L"Invalid " << type << " resource: " << resource);
@@ -10,8 +10,13 @@ std::vector<T> DVLib::LoadResourceData(HMODULE h, const std::wstring& resource,
 	DWORD size = SizeofResource(h, res);
 	LPVOID buffer = LockResource(hgl);
 	CHECK_WIN32_BOOL(buffer != NULL, L"Cannot lock " << type << " resource: " << resource);
-	std::vector<T> data;
-	data.resize(size / sizeof(T));
-	memcpy(& * data.begin(), buffer, data.size() * sizeof(T));
-	return data;
+	ResourceView<T> view = { static_cast<const T *>(buffer), size / sizeof(T) };
+	return view;
+}
+
+template<class T>
+std::vector<T> DVLib::LoadResourceData(HMODULE h, const std::wstring& resource, const std::wstring& type)
+{
+	ResourceView<T> view = GetResourceView<T>(h, resource, type);
+	return std::vector<T>(view.data, view.data + view.size);
 }
@@ -0,0 +1,127 @@
+#include "StdAfx.h"
+#include "FileVersionCache.h"
+#include "ExceptionMacros.h"
+#include "ErrorUtil.h"
+#include "StringUtil.h"
+
+bool DVLib::FileVersionCache::FileStamp::operator==(const FileStamp& rhs) const
+{
+    return volume == rhs.volume
+        && index == rhs.index
+        && size == rhs.size
+        && modified == rhs.modified;
+}
+
+DVLib::FileVersionCache::FileVersionCache()
+: m_generation(0)
+, m_hits(0)
+, m_misses(0)
+{
+    ::InitializeCriticalSection(& m_cs);
+}
+
+DVLib::FileVersionCache::~FileVersionCache()
+{
+    ::DeleteCriticalSection(& m_cs);
+}
+
+void DVLib::FileVersionCache::Invalidate()
+{
+    ::EnterCriticalSection(& m_cs);
+    m_entries.clear();
+    m_generation++;
+    ::LeaveCriticalSection(& m_cs);
+}
+
+void DVLib::FileVersionCache::SetReader(const FileReaderPtr& reader)
+{
+    ::EnterCriticalSection(& m_cs);
+    m_reader = reader;
+    m_entries.clear();
+    m_generation++;
+    ::LeaveCriticalSection(& m_cs);
+}
+
+bool DVLib::FileVersionCache::FileExists(const std::wstring& filename)
+{
+    return get(m_reader) != NULL
+        ? m_reader->FileExists(filename)
+        : DVLib::FileExists(filename);
+}
+
+bool DVLib::FileVersionCache::DirectoryExists(const std::wstring& path)
+{
+    return get(m_reader) != NULL
+        ? m_reader->DirectoryExists(path)
+        : DVLib::DirectoryExists(path);
+}
+
+DVLib::FileVersionCache::FileStamp DVLib::FileVersionCache::GetFileStamp(const std::wstring& filename)
+{
+    // the file index tells apart files behind the same path, eg. with WOW64 file system redirection
+    auto_hfile file(::CreateFile(filename.c_str(), FILE_READ_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL));
+    CHECK_WIN32_BOOL(get(file) != INVALID_HANDLE_VALUE,
+        L"Error opening " << filename);
+
+    BY_HANDLE_FILE_INFORMATION file_information = { 0 };
+    CHECK_WIN32_BOOL(::GetFileInformationByHandle(get(file), & file_information),
+        L"Error reading attributes of " << filename);
+
+    FileStamp stamp;
+    stamp.volume = file_information.dwVolumeSerialNumber;
+    stamp.index = (static_cast<ULONGLONG>(file_information.nFileIndexHigh) << 32) | file_information.nFileIndexLow;
+    stamp.size = (static_cast<ULONGLONG>(file_information.nFileSizeHigh) << 32) | file_information.nFileSizeLow;
+    stamp.modified = (static_cast<ULONGLONG>(file_information.ftLastWriteTime.dwHighDateTime) << 32) | file_information.ftLastWriteTime.dwLowDateTime;
+    return stamp;
+}
+
+DVLib::FileVersionInfo DVLib::FileVersionCache::GetFileVersionInfo(const std::wstring& filename)
+{
+    if (get(m_reader) != NULL)
+    {
+        return m_reader->GetFileVersionInfo(filename);
+    }
+
+    wchar_t full_path[MAX_PATH] = { 0 };
+    DWORD full_path_len = ::GetFullPathNameW(filename.c_str(), ARRAYSIZE(full_path), full_path, NULL);
+    std::wstring id = lowercase((full_path_len > 0 && full_path_len < ARRAYSIZE(full_path)) ? full_path : filename);
+    FileStamp stamp = GetFileStamp(filename);
+
+    ::EnterCriticalSection(& m_cs);
+    std::map<std::wstring, Entry>::const_iterator iter = m_entries.find(id);
+    if (iter != m_entries.end() && iter->second.stamp == stamp)
+    {
+        FileVersionInfo info = iter->second.info;
+        m_hits++;
+        ::LeaveCriticalSection(& m_cs);
+        return info;
+    }
+    LONG generation = m_generation;
+    ::LeaveCriticalSection(& m_cs);
+
+    // read outside of the lock, version resources of different files are read concurrently
+    Entry entry;
+    entry.stamp = stamp;
+    entry.info = DVLib::GetFileVersionInfo(filename);
+
+    ::EnterCriticalSection(& m_cs);
+    // versions read while the cache was invalidated may be stale
+    if (generation == m_generation)
+    {
+        m_entries[id] = entry;
+    }
+    m_misses++;
+    ::LeaveCriticalSection(& m_cs);
+    return entry.info;
+}
+
+std::wstring DVLib::FileVersionCache::GetFileVersion(const std::wstring& filename)
+{
+    return GetVersion(filename).ToString();
+}
+
+DVLib::Version DVLib::FileVersionCache::GetVersion(const std::wstring& filename)
+{
+    return Version(GetFileVersionInfo(filename).fixed_info);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "FileUtil.h"
+#include "FileReader.h"
+#include "Version.h"
+
+namespace DVLib
+{
+	// version information of files by full path, an entry is used for as long as the
+	// file it was read from keeps its identity, size and last write time
+	class FileVersionCache
+	{
+	private:
+		struct FileStamp
+		{
+			DWORD volume;
+			ULONGLONG index;
+			ULONGLONG size;
+			ULONGLONG modified;
+			bool operator==(const FileStamp& rhs) const;
+		};
+		struct Entry
+		{
+			FileStamp stamp;
+			FileVersionInfo info;
+		};
+		CRITICAL_SECTION m_cs;
+		// in-memory files, NULL for the file system
+		FileReaderPtr m_reader;
+		// entries by lowercase full path
+		std::map<std::wstring, Entry> m_entries;
+		LONG m_generation;
+		LONG m_hits;
+		LONG m_misses;
+	public:
+		FileVersionCache();
+		~FileVersionCache();
+		// discard all entries, eg. after a component has run
+		void Invalidate();
+		// replace the file system, eg. with the files of a machine snapshot, NULL reads files
+		// from disk; versions of files that aren't on disk aren't cached
+		void SetReader(const FileReaderPtr& reader);
+		bool FileExists(const std::wstring& filename);
+		bool DirectoryExists(const std::wstring& path);
+		FileVersionInfo GetFileVersionInfo(const std::wstring& filename);
+		// version string, as DVLib::GetFileVersion
+		std::wstring GetFileVersion(const std::wstring& filename);
+		// file version, packed for comparisons
+		Version GetVersion(const std::wstring& filename);
+		// incremented each time the cache is invalidated
+		LONG GetGeneration() const { return m_generation; }
+		// number of lookups served from and added to the cache
+		LONG GetHits() const { return m_hits; }
+		LONG GetMisses() const { return m_misses; }
+	private:
+		static FileStamp GetFileStamp(const std::wstring& filename);
+	};
+}
@@ -0,0 +1,138 @@
+#include "StdAfx.h"
+#include "MachineSnapshot.h"
+#include "ExceptionMacros.h"
+#include "StringUtil.h"
+#include "GuidUtil.h"
+#include "RegistryUtil.h"
+
+DVLib::MachineSnapshot::MachineSnapshot()
+: m_registry(new MemoryRegistryReader())
+, m_msi_products(new MemoryMsiProductReader())
+, m_files(new MemoryFileReader())
+, os(winMax)
+, processor_architecture(PROCESSOR_ARCHITECTURE_INTEL)
+, lcid(1033)
+, registry(m_registry)
+, msi_products(m_msi_products)
+, files(m_files)
+{
+
+}
+
+void DVLib::MachineSnapshot::Load(const std::wstring& filename)
+{
+    std::vector<char> data = FileReadToEnd(filename);
+    name = filename;
+    Parse(data.empty() ? L"" : UTF8string2wstring(std::string(data.begin(), data.end())));
+}
+
+void DVLib::MachineSnapshot::Parse(const std::wstring& data)
+{
+    std::vector<std::wstring> lines = split(data, L"\n");
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+        std::wstring line = trimright(lines[i], L"\r");
+        if (line.empty() || line[0] == L'#')
+            continue;
+
+        try
+        {
+            ParseLine(split(line, L"\t"));
+        }
+        catch(std::exception& ex)
+        {
+            THROW_EX(string2wstring(ex.what()) << L" (" << name << L", line " << (i + 1) << L")");
+        }
+    }
+}
+
+void DVLib::MachineSnapshot::ParseLine(const std::vector<std::wstring>& fields)
+{
+    const std::wstring& type = fields[0];
+    if (type == L"os" && fields.size() == 2)
+    {
+        os = oscode2os(fields[1]);
+    }
+    else if (type == L"pa" && fields.size() == 2)
+    {
+        processor_architecture = wstring2pa(fields[1]);
+    }
+    else if (type == L"lcid" && fields.size() == 2)
+    {
+        lcid = wstring2ulong(fields[1]);
+    }
+    else if (type == L"key" && fields.size() == 2)
+    {
+        std::wstring path;
+        DWORD ulFlags = 0;
+        HKEY root = ParseKey(fields[1], path, ulFlags);
+        m_registry->CreateKey(root, path, ulFlags);
+    }
+    else if (type == L"value" && fields.size() >= 4)
+    {
+        std::wstring path;
+        DWORD ulFlags = 0;
+        HKEY root = ParseKey(fields[1], path, ulFlags);
+        const std::wstring& value_name = fields[2];
+        const std::wstring& value_type = fields[3];
+        if (value_type == L"REG_SZ" && fields.size() == 5)
+        {
+            m_registry->SetStringValue(root, path, value_name, fields[4], ulFlags);
+        }
+        else if (value_type == L"REG_EXPAND_SZ" && fields.size() == 5)
+        {
+            m_registry->SetValue(root, path, value_name, REG_EXPAND_SZ, fields[4].c_str(), (fields[4].length() + 1) * sizeof(WCHAR), ulFlags);
+        }
+        else if (value_type == L"REG_DWORD" && fields.size() == 5)
+        {
+            m_registry->SetDWORDValue(root, path, value_name, wstring2ulong(fields[4]), ulFlags);
+        }
+        else if (value_type == L"REG_MULTI_SZ")
+        {
+            m_registry->SetMultiStringValue(root, path, value_name, std::vector<std::wstring>(fields.begin() + 4, fields.end()), ulFlags);
+        }
+        else
+        {
+            THROW_EX(L"Unsupported registry value type '" << value_type << L"' of " << fields[1] << L"\\" << value_name);
+        }
+    }
+    else if (type == L"product" && fields.size() == 5)
+    {
+        m_msi_products->AddProduct(string2guid(fields[1]), string2guid(fields[2]), fields[3], fields[4]);
+    }
+    else if (type == L"property" && fields.size() == 4)
+    {
+        m_msi_products->SetProductProperty(string2guid(fields[1]), fields[2], fields[3]);
+    }
+    else if (type == L"file" && (fields.size() == 2 || fields.size() == 3))
+    {
+        m_files->AddFile(fields[1], fields.size() == 3 ? fields[2] : L"");
+    }
+    else if (type == L"directory" && fields.size() == 2)
+    {
+        m_files->AddDirectory(fields[1]);
+    }
+    else
+    {
+        THROW_EX(L"Invalid machine snapshot entry '" << join(fields, L"\t") << L"'");
+    }
+}
+
+HKEY DVLib::MachineSnapshot::ParseKey(const std::wstring& key, std::wstring& path, DWORD& ulFlags)
+{
+    // HKEY_LOCAL_MACHINE[:WOW64_64|:WOW64_32]\path, as in @[...] registry variables
+    std::vector<std::wstring> parts = split(key, L"\\", 2);
+    CHECK_BOOL(parts.size() == 2 && ! parts[1].empty(),
+        L"Invalid registry key '" << key << L"'");
+    std::vector<std::wstring> hkey_parts = split(parts[0], L":", 2);
+    ulFlags = 0;
+    if (hkey_parts.size() > 1)
+    {
+        if (hkey_parts[1] == L"WOW64_64") ulFlags |= KEY_WOW64_64KEY;
+        else if (hkey_parts[1] == L"WOW64_32") ulFlags |= KEY_WOW64_32KEY;
+        else THROW_EX(L"Invalid WOW option '" << hkey_parts[1] << L"' in '" << key << L"'");
+    }
+
+    path = parts[1];
+    return wstring2HKEY(hkey_parts[0]);
+}
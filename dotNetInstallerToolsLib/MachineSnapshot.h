@@ -0,0 +1,51 @@
+#pragma once
+
+#include "OsUtil.h"
+#include "MemoryRegistryReader.h"
+#include "MemoryMsiProductReader.h"
+#include "MemoryFileReader.h"
+
+namespace DVLib
+{
+	// the state of a machine that filters and installed checks read, loaded from a UTF-8 text file
+	// with one tab-separated entry per line, eg.
+	//  os	win7sp1
+	//  pa	x64
+	//  lcid	1033
+	//  key	HKEY_LOCAL_MACHINE\SOFTWARE\Vendor
+	//  value	HKEY_LOCAL_MACHINE:WOW64_64\SOFTWARE\Vendor	Version	REG_SZ	1.0
+	//  product	{product code}	{upgrade code}	name	version
+	//  property	{product code}	name	value
+	//  file	C:\Windows\System32\msi.dll	5.0.7601.17514
+	//  directory	C:\Program Files\Vendor
+	// empty lines and lines that start with # are ignored
+	class MachineSnapshot
+	{
+	private:
+		MemoryRegistryReader * m_registry;
+		MemoryMsiProductReader * m_msi_products;
+		MemoryFileReader * m_files;
+	public:
+		// file name of the snapshot
+		std::wstring name;
+		OperatingSystem os;
+		WORD processor_architecture;
+		// all LCID types
+		LCID lcid;
+		RegistryReaderPtr registry;
+		MsiProductReaderPtr msi_products;
+		FileReaderPtr files;
+	public:
+		MachineSnapshot();
+		void Load(const std::wstring& filename);
+		void Parse(const std::wstring& data);
+		MemoryRegistryReader& GetRegistry() { return * m_registry; }
+		MemoryMsiProductReader& GetMsiProducts() { return * m_msi_products; }
+		MemoryFileReader& GetFiles() { return * m_files; }
+	private:
+		void ParseLine(const std::vector<std::wstring>& fields);
+		static HKEY ParseKey(const std::wstring& key, std::wstring& path, DWORD& ulFlags);
+	};
+
+	typedef shared_any<MachineSnapshot *, close_delete> MachineSnapshotPtr;
+}
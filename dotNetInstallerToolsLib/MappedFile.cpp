@@ -0,0 +1,34 @@
+#include "StdAfx.h"
+#include "MappedFile.h"
+#include "ExceptionMacros.h"
+#include "ErrorUtil.h"
+#include "FileUtil.h"
+
+DVLib::MappedFile::MappedFile(const std::wstring& filename)
+    : m_size(0)
+{
+    reset(m_file, ::CreateFile(filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+        NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL));
+    CHECK_WIN32_BOOL(get(m_file) != INVALID_HANDLE_VALUE,
+        L"Error opening \"" << filename << L"\"");
+
+    LARGE_INTEGER size = { 0 };
+    CHECK_WIN32_BOOL(::GetFileSizeEx(get(m_file), & size),
+        L"Error getting size of \"" << filename << L"\"");
+    CHECK_BOOL(0 == size.HighPart,
+        L"File " << filename << L" is > 2GB (" << size.HighPart << ")");
+
+    m_size = static_cast<long>(size.LowPart);
+
+    // an empty file cannot be mapped
+    if (m_size == 0)
+        return;
+
+    reset(m_mapping, ::CreateFileMapping(get(m_file), NULL, PAGE_READONLY, 0, 0, NULL));
+    CHECK_WIN32_BOOL(get(m_mapping) != NULL,
+        L"Error mapping \"" << filename << L"\"");
+
+    reset(m_view, ::MapViewOfFile(get(m_mapping), FILE_MAP_READ, 0, 0, 0));
+    CHECK_WIN32_BOOL(get(m_view) != NULL,
+        L"Error mapping a view of \"" << filename << L"\"");
+}
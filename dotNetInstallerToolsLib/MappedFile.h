@@ -0,0 +1,21 @@
+#pragma once
+
+namespace DVLib
+{
+	// a file mapped read-only into memory, the data is valid for the lifetime of the object
+	class MappedFile
+	{
+	private:
+		auto_hfile m_file;
+		auto_file_mapping m_mapping;
+		auto_file_view m_view;
+		long m_size;
+		MappedFile(const MappedFile&);
+		MappedFile& operator=(const MappedFile&);
+	public:
+		MappedFile(const std::wstring& filename);
+		// file contents, not null-terminated, NULL for an empty file
+		const char * GetData() const { return static_cast<const char *>(get(m_view)); }
+		long GetSize() const { return m_size; }
+	};
+}
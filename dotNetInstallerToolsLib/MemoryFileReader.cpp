@@ -0,0 +1,71 @@
+#include "StdAfx.h"
+#include "MemoryFileReader.h"
+#include "ExceptionMacros.h"
+#include "StringUtil.h"
+
+bool DVLib::MemoryFileReader::FileExists(const std::wstring& filename)
+{
+    return m_files.find(lowercase(filename)) != m_files.end();
+}
+
+bool DVLib::MemoryFileReader::DirectoryExists(const std::wstring& path)
+{
+    std::wstring id = lowercase(trimright(path, L"\\"));
+    if (id.empty())
+        return false;
+
+    if (m_directories.find(id) != m_directories.end())
+        return true;
+
+    // files are sorted by path, the first file under the directory follows its prefix
+    std::wstring prefix = id + L"\\";
+    std::set<std::wstring>::const_iterator directory = m_directories.lower_bound(prefix);
+    if (directory != m_directories.end() && startswith(* directory, prefix))
+        return true;
+
+    std::map<std::wstring, File>::const_iterator file = m_files.lower_bound(prefix);
+    return file != m_files.end() && startswith(file->first, prefix);
+}
+
+DVLib::FileVersionInfo DVLib::MemoryFileReader::GetFileVersionInfo(const std::wstring& filename)
+{
+    std::map<std::wstring, File>::const_iterator iter = m_files.find(lowercase(filename));
+    CHECK_BOOL(iter != m_files.end(),
+        L"Error opening " << filename);
+    CHECK_BOOL(iter->second.has_version,
+        L"Missing version information in " << filename);
+    return iter->second.info;
+}
+
+void DVLib::MemoryFileReader::AddFile(const std::wstring& filename, const std::wstring& version)
+{
+    File file = { 0 };
+    file.has_version = ! version.empty();
+    if (file.has_version)
+    {
+        Version parsed(version);
+        CHECK_BOOL(parsed.IsPacked(),
+            L"Invalid file version '" << version << L"' of " << filename);
+        file.info.fixed_info.dwSignature = VS_FFI_SIGNATURE;
+        file.info.fixed_info.dwStrucVersion = VS_FFI_STRUCVERSION;
+        file.info.fixed_info.dwFileVersionMS = static_cast<DWORD>(parsed.GetPacked() >> 32);
+        file.info.fixed_info.dwFileVersionLS = static_cast<DWORD>(parsed.GetPacked());
+        file.info.fixed_info.dwProductVersionMS = file.info.fixed_info.dwFileVersionMS;
+        file.info.fixed_info.dwProductVersionLS = file.info.fixed_info.dwFileVersionLS;
+    }
+
+    m_files[lowercase(filename)] = file;
+}
+
+void DVLib::MemoryFileReader::RemoveFile(const std::wstring& filename)
+{
+    m_files.erase(lowercase(filename));
+}
+
+void DVLib::MemoryFileReader::AddDirectory(const std::wstring& path)
+{
+    std::wstring id = lowercase(trimright(path, L"\\"));
+    CHECK_BOOL(! id.empty(),
+        L"Invalid directory '" << path << L"'");
+    m_directories.insert(id);
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "FileReader.h"
+#include "Version.h"
+
+namespace DVLib
+{
+	// an in-memory list of files, their versions and directories
+	class MemoryFileReader : public IFileReader
+	{
+	private:
+		struct File
+		{
+			bool has_version;
+			FileVersionInfo info;
+		};
+		// files by lowercase path
+		std::map<std::wstring, File> m_files;
+		// directories by lowercase path, without a trailing backslash
+		std::set<std::wstring> m_directories;
+	public:
+		bool FileExists(const std::wstring& filename);
+		// a directory that was added or that contains a file
+		bool DirectoryExists(const std::wstring& path);
+		FileVersionInfo GetFileVersionInfo(const std::wstring& filename);
+		// add a file, with a version resource unless the version is empty
+		void AddFile(const std::wstring& filename, const std::wstring& version = L"");
+		void RemoveFile(const std::wstring& filename);
+		void AddDirectory(const std::wstring& path);
+	};
+}
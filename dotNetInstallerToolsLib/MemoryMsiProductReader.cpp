@@ -0,0 +1,85 @@
+#include "StdAfx.h"
+#include "MemoryMsiProductReader.h"
+#include "ExceptionMacros.h"
+#include "GuidUtil.h"
+
+DVLib::MemoryMsiProductReader::MemoryMsiProductReader()
+: m_enumerations(0)
+, m_property_reads(0)
+{
+
+}
+
+std::vector<GUID> DVLib::MemoryMsiProductReader::GetInstalledProducts()
+{
+    ::InterlockedIncrement(& m_enumerations);
+    std::vector<GUID> result;
+    for each(const Product& product in m_products)
+        result.push_back(product.productcode);
+    return result;
+}
+
+std::vector<GUID> DVLib::MemoryMsiProductReader::GetRelatedProducts(GUID upgradecode)
+{
+    ::InterlockedIncrement(& m_enumerations);
+    std::vector<GUID> result;
+    for each(const Product& product in m_products)
+    {
+        if (product.upgradecode == upgradecode)
+            result.push_back(product.productcode);
+    }
+    return result;
+}
+
+std::wstring DVLib::MemoryMsiProductReader::GetProductProperty(GUID productcode, const std::wstring& property_name)
+{
+    ::InterlockedIncrement(& m_property_reads);
+    Product * product = FindProduct(productcode);
+    CHECK_BOOL(product != NULL,
+        L"MsiGetProductInfo (" << guid2wstring(productcode) << L", " << property_name << L"): unknown product");
+    std::map<std::wstring, std::wstring>::const_iterator iter = product->properties.find(property_name);
+    CHECK_BOOL(iter != product->properties.end(),
+        L"MsiGetProductInfo (" << guid2wstring(productcode) << L", " << property_name << L"): unknown property");
+    return iter->second;
+}
+
+void DVLib::MemoryMsiProductReader::AddProduct(GUID productcode, GUID upgradecode, const std::wstring& name, const std::wstring& version)
+{
+    RemoveProduct(productcode);
+    Product product;
+    product.productcode = productcode;
+    product.upgradecode = upgradecode;
+    product.properties[INSTALLPROPERTY_PRODUCTNAME] = name;
+    product.properties[INSTALLPROPERTY_VERSIONSTRING] = version;
+    m_products.push_back(product);
+}
+
+void DVLib::MemoryMsiProductReader::SetProductProperty(GUID productcode, const std::wstring& property_name, const std::wstring& value)
+{
+    Product * product = FindProduct(productcode);
+    CHECK_BOOL(product != NULL, L"Unknown product " << guid2wstring(productcode));
+    product->properties[property_name] = value;
+}
+
+void DVLib::MemoryMsiProductReader::RemoveProduct(GUID productcode)
+{
+    for (size_t i = 0; i < m_products.size(); i++)
+    {
+        if (m_products[i].productcode == productcode)
+        {
+            m_products.erase(m_products.begin() + i);
+            return;
+        }
+    }
+}
+
+DVLib::MemoryMsiProductReader::Product * DVLib::MemoryMsiProductReader::FindProduct(GUID productcode)
+{
+    for (size_t i = 0; i < m_products.size(); i++)
+    {
+        if (m_products[i].productcode == productcode)
+            return & m_products[i];
+    }
+
+    return NULL;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "MsiProductReader.h"
+
+namespace DVLib
+{
+	// an in-memory list of installed products
+	class MemoryMsiProductReader : public IMsiProductReader
+	{
+	private:
+		struct Product
+		{
+			GUID productcode;
+			GUID upgradecode;
+			std::map<std::wstring, std::wstring> properties;
+		};
+		std::vector<Product> m_products;
+		LONG m_enumerations;
+		LONG m_property_reads;
+	public:
+		MemoryMsiProductReader();
+		std::vector<GUID> GetInstalledProducts();
+		std::vector<GUID> GetRelatedProducts(GUID upgradecode);
+		std::wstring GetProductProperty(GUID productcode, const std::wstring& property_name);
+		void AddProduct(GUID productcode, GUID upgradecode, const std::wstring& name, const std::wstring& version);
+		void SetProductProperty(GUID productcode, const std::wstring& property_name, const std::wstring& value);
+		void RemoveProduct(GUID productcode);
+		// number of times all products or products with an upgrade code were enumerated
+		LONG GetEnumerations() const { return m_enumerations; }
+		LONG GetPropertyReads() const { return m_property_reads; }
+	private:
+		Product * FindProduct(GUID productcode);
+	};
+}
@@ -0,0 +1,78 @@
+#include "StdAfx.h"
+#include "MemoryRegistryReader.h"
+#include "RegistrySnapshot.h"
+#include "StringUtil.h"
+
+DVLib::MemoryRegistryReader::MemoryRegistryReader()
+: m_reads(0)
+{
+
+}
+
+bool DVLib::MemoryRegistryReader::ReadKey(HKEY root, const std::wstring& key, DWORD ulFlags, RegistryValues& values)
+{
+    ::InterlockedIncrement(& m_reads);
+    std::map<std::wstring, RegistryValues>::const_iterator iter = m_keys.find(RegistrySnapshot::GetKeyId(root, key, ulFlags));
+    if (iter == m_keys.end())
+        return false;
+
+    values = iter->second;
+    return true;
+}
+
+void DVLib::MemoryRegistryReader::CreateKey(HKEY root, const std::wstring& key, DWORD ulFlags)
+{
+    std::vector<std::wstring> parts = split(key, L"\\");
+    std::wstring path;
+    for each (const std::wstring& part in parts)
+    {
+        if (! path.empty()) path.append(L"\\");
+        path.append(part);
+        m_keys[RegistrySnapshot::GetKeyId(root, path, ulFlags)];
+    }
+}
+
+void DVLib::MemoryRegistryReader::DeleteKey(HKEY root, const std::wstring& key, DWORD ulFlags)
+{
+    std::wstring id = RegistrySnapshot::GetKeyId(root, key, ulFlags);
+    std::map<std::wstring, RegistryValues>::iterator iter = m_keys.begin();
+    while (iter != m_keys.end())
+    {
+        // the key and all its subkeys
+        if (iter->first == id || startswith(iter->first, id + L"\\"))
+            iter = m_keys.erase(iter);
+        else
+            ++iter;
+    }
+}
+
+void DVLib::MemoryRegistryReader::SetValue(HKEY root, const std::wstring& key, const std::wstring& name, DWORD type, const void * data, DWORD size, DWORD ulFlags)
+{
+    CreateKey(root, key, ulFlags);
+    RegistryValue& value = m_keys[RegistrySnapshot::GetKeyId(root, key, ulFlags)][lowercase(name)];
+    value.type = type;
+    value.data.assign(reinterpret_cast<const BYTE *>(data), reinterpret_cast<const BYTE *>(data) + size);
+}
+
+void DVLib::MemoryRegistryReader::SetStringValue(HKEY root, const std::wstring& key, const std::wstring& name, const std::wstring& value, DWORD ulFlags)
+{
+    SetValue(root, key, name, REG_SZ, value.c_str(), (value.length() + 1) * sizeof(WCHAR), ulFlags);
+}
+
+void DVLib::MemoryRegistryReader::SetDWORDValue(HKEY root, const std::wstring& key, const std::wstring& name, DWORD value, DWORD ulFlags)
+{
+    SetValue(root, key, name, REG_DWORD, & value, sizeof(DWORD), ulFlags);
+}
+
+void DVLib::MemoryRegistryReader::SetMultiStringValue(HKEY root, const std::wstring& key, const std::wstring& name, const std::vector<std::wstring>& value, DWORD ulFlags)
+{
+    std::vector<wchar_t> data;
+    for (size_t i = 0; i < value.size(); i++)
+    {
+        data.insert(data.end(), value[i].begin(), value[i].end());
+        data.push_back(0);
+    }
+    data.push_back(0);
+
+    SetValue(root, key, name, REG_MULTI_SZ, & * data.begin(), data.size() * sizeof(WCHAR), ulFlags);
+}
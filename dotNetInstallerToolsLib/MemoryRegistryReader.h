@@ -0,0 +1,25 @@
+#pragma once
+
+#include "RegistryReader.h"
+
+namespace DVLib
+{
+	// an in-memory registry, keys are created with their parents
+	class MemoryRegistryReader : public IRegistryReader
+	{
+	private:
+		std::map<std::wstring, RegistryValues> m_keys;
+		LONG m_reads;
+	public:
+		MemoryRegistryReader();
+		bool ReadKey(HKEY root, const std::wstring& key, DWORD ulFlags, RegistryValues& values);
+		void CreateKey(HKEY root, const std::wstring& key, DWORD ulFlags = 0);
+		void DeleteKey(HKEY root, const std::wstring& key, DWORD ulFlags = 0);
+		void SetValue(HKEY root, const std::wstring& key, const std::wstring& name, DWORD type, const void * data, DWORD size, DWORD ulFlags = 0);
+		void SetStringValue(HKEY root, const std::wstring& key, const std::wstring& name, const std::wstring& value = L"", DWORD ulFlags = 0);
+		void SetDWORDValue(HKEY root, const std::wstring& key, const std::wstring& name, DWORD value, DWORD ulFlags = 0);
+		void SetMultiStringValue(HKEY root, const std::wstring& key, const std::wstring& name, const std::vector<std::wstring>& value, DWORD ulFlags = 0);
+		// number of keys read
+		LONG GetReads() const { return m_reads; }
+	};
+}
@@ -0,0 +1,145 @@
+#include "StdAfx.h"
+#include "MsiProductInventory.h"
+#include "SystemMsiProductReader.h"
+
+size_t DVLib::MsiProductInventory::GuidHash::operator()(const GUID& guid) const
+{
+    // FNV-1a
+    const BYTE * data = reinterpret_cast<const BYTE *>(& guid);
+    size_t hash = 2166136261U;
+    for (size_t i = 0; i < sizeof(GUID); i++)
+    {
+        hash ^= data[i];
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+DVLib::MsiProductInventory::MsiProductInventory()
+: m_reader(new SystemMsiProductReader())
+, m_loaded(false)
+, m_generation(0)
+, m_hits(0)
+, m_misses(0)
+{
+    ::InitializeCriticalSection(& m_cs);
+}
+
+DVLib::MsiProductInventory::MsiProductInventory(const MsiProductReaderPtr& reader)
+: m_reader(reader)
+, m_loaded(false)
+, m_generation(0)
+, m_hits(0)
+, m_misses(0)
+{
+    ::InitializeCriticalSection(& m_cs);
+}
+
+DVLib::MsiProductInventory::~MsiProductInventory()
+{
+    ::DeleteCriticalSection(& m_cs);
+}
+
+void DVLib::MsiProductInventory::SetReader(const MsiProductReaderPtr& reader)
+{
+    ::EnterCriticalSection(& m_cs);
+    m_reader = reader;
+    ::LeaveCriticalSection(& m_cs);
+    Invalidate();
+}
+
+void DVLib::MsiProductInventory::Invalidate()
+{
+    ::EnterCriticalSection(& m_cs);
+    m_loaded = false;
+    m_products.clear();
+    m_related_products.clear();
+    m_properties.clear();
+    m_generation++;
+    ::LeaveCriticalSection(& m_cs);
+}
+
+bool DVLib::MsiProductInventory::IsProductInstalled(GUID productcode)
+{
+    ::EnterCriticalSection(& m_cs);
+    try
+    {
+        if (m_loaded)
+        {
+            m_hits++;
+        }
+        else
+        {
+            std::vector<GUID> products = m_reader->GetInstalledProducts();
+            m_products.clear();
+            m_products.insert(products.begin(), products.end());
+            m_loaded = true;
+            m_misses++;
+        }
+
+        bool result = (m_products.find(productcode) != m_products.end());
+        ::LeaveCriticalSection(& m_cs);
+        return result;
+    }
+    catch(...)
+    {
+        ::LeaveCriticalSection(& m_cs);
+        throw;
+    }
+}
+
+std::vector<GUID> DVLib::MsiProductInventory::GetRelatedProducts(GUID upgradecode)
+{
+    ::EnterCriticalSection(& m_cs);
+    try
+    {
+        std::unordered_map<GUID, std::vector<GUID>, GuidHash>::const_iterator iter = m_related_products.find(upgradecode);
+        if (iter != m_related_products.end())
+        {
+            m_hits++;
+        }
+        else
+        {
+            iter = m_related_products.insert(std::make_pair(upgradecode, m_reader->GetRelatedProducts(upgradecode))).first;
+            m_misses++;
+        }
+
+        std::vector<GUID> result = iter->second;
+        ::LeaveCriticalSection(& m_cs);
+        return result;
+    }
+    catch(...)
+    {
+        ::LeaveCriticalSection(& m_cs);
+        throw;
+    }
+}
+
+std::wstring DVLib::MsiProductInventory::GetProductProperty(GUID productcode, const std::wstring& property_name)
+{
+    ::EnterCriticalSection(& m_cs);
+    try
+    {
+        ProductProperties& properties = m_properties[productcode];
+        ProductProperties::const_iterator iter = properties.find(property_name);
+        if (iter != properties.end())
+        {
+            m_hits++;
+        }
+        else
+        {
+            // errors are not remembered, the property is read again on next use
+            iter = properties.insert(std::make_pair(property_name, m_reader->GetProductProperty(productcode, property_name))).first;
+            m_misses++;
+        }
+
+        std::wstring result = iter->second;
+        ::LeaveCriticalSection(& m_cs);
+        return result;
+    }
+    catch(...)
+    {
+        ::LeaveCriticalSection(& m_cs);
+        throw;
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <unordered_set>
+#include <unordered_map>
+#include "MsiProductReader.h"
+
+namespace DVLib
+{
+	// installed MSI products indexed by product and upgrade code, built on first use
+	// and kept until invalidated, eg. after a component has installed or removed products
+	class MsiProductInventory
+	{
+	private:
+		struct GuidHash
+		{
+			size_t operator()(const GUID& guid) const;
+		};
+		typedef std::map<std::wstring, std::wstring> ProductProperties;
+		CRITICAL_SECTION m_cs;
+		MsiProductReaderPtr m_reader;
+		// installed product codes, valid when m_loaded
+		bool m_loaded;
+		std::unordered_set<GUID, GuidHash> m_products;
+		// product codes by upgrade code
+		std::unordered_map<GUID, std::vector<GUID>, GuidHash> m_related_products;
+		// properties read by product code, eg. versions
+		std::unordered_map<GUID, ProductProperties, GuidHash> m_properties;
+		LONG m_generation;
+		LONG m_hits;
+		LONG m_misses;
+	public:
+		MsiProductInventory();
+		MsiProductInventory(const MsiProductReaderPtr& reader);
+		~MsiProductInventory();
+		// replace the reader, eg. with an in-memory list of products, invalidates the inventory
+		void SetReader(const MsiProductReaderPtr& reader);
+		// discard all products, the inventory is built again on next use
+		void Invalidate();
+		bool IsProductInstalled(GUID productcode);
+		// installed products with an upgrade code
+		std::vector<GUID> GetRelatedProducts(GUID upgradecode);
+		// a property of an installed product, eg. INSTALLPROPERTY_VERSIONSTRING
+		std::wstring GetProductProperty(GUID productcode, const std::wstring& property_name);
+		std::wstring GetProductName(GUID productcode) { return GetProductProperty(productcode, INSTALLPROPERTY_PRODUCTNAME); }
+		std::wstring GetVersionString(GUID productcode) { return GetProductProperty(productcode, INSTALLPROPERTY_VERSIONSTRING); }
+		// incremented each time the inventory is invalidated
+		LONG GetGeneration() const { return m_generation; }
+		// number of lookups served from and added to the inventory
+		LONG GetHits() const { return m_hits; }
+		LONG GetMisses() const { return m_misses; }
+	};
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+namespace DVLib
+{
+	// reads installed MSI products
+	class IMsiProductReader
+	{
+	public:
+		// product codes of all installed products
+		virtual std::vector<GUID> GetInstalledProducts() = 0;
+		// product codes of installed products with an upgrade code
+		virtual std::vector<GUID> GetRelatedProducts(GUID upgradecode) = 0;
+		// a property of an installed product, eg. INSTALLPROPERTY_VERSIONSTRING
+		virtual std::wstring GetProductProperty(GUID productcode, const std::wstring& property_name) = 0;
+		virtual ~IMsiProductReader() { }
+	};
+
+	typedef shared_any<IMsiProductReader *, close_delete> MsiProductReaderPtr;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "RegistryUtil.h"
+
+namespace DVLib
+{
+	// reads registry keys into memory
+	class IRegistryReader
+	{
+	public:
+		// read all values of a key, returns false if the key doesn't exist
+		virtual bool ReadKey(HKEY root, const std::wstring& key, DWORD ulFlags, RegistryValues& values) = 0;
+		virtual ~IRegistryReader() { }
+	};
+
+	typedef shared_any<IRegistryReader *, close_delete> RegistryReaderPtr;
+}
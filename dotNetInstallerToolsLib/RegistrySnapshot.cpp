@@ -0,0 +1,202 @@
+#include "StdAfx.h"
+#include "RegistrySnapshot.h"
+#include "SystemRegistryReader.h"
+#include "ExceptionMacros.h"
+#include "StringUtil.h"
+
+DVLib::RegistrySnapshot::RegistrySnapshot()
+: m_reader(new SystemRegistryReader())
+, m_depth(0)
+, m_hits(0)
+, m_misses(0)
+{
+    ::InitializeCriticalSection(& m_cs);
+}
+
+DVLib::RegistrySnapshot::RegistrySnapshot(const RegistryReaderPtr& reader)
+: m_reader(reader)
+, m_depth(0)
+, m_hits(0)
+, m_misses(0)
+{
+    ::InitializeCriticalSection(& m_cs);
+}
+
+DVLib::RegistrySnapshot::~RegistrySnapshot()
+{
+    ::DeleteCriticalSection(& m_cs);
+}
+
+void DVLib::RegistrySnapshot::SetReader(const RegistryReaderPtr& reader)
+{
+    ::EnterCriticalSection(& m_cs);
+    m_reader = reader;
+    m_keys.clear();
+    ::LeaveCriticalSection(& m_cs);
+}
+
+void DVLib::RegistrySnapshot::Begin()
+{
+    ::EnterCriticalSection(& m_cs);
+    m_depth++;
+    ::LeaveCriticalSection(& m_cs);
+}
+
+void DVLib::RegistrySnapshot::End()
+{
+    ::EnterCriticalSection(& m_cs);
+    if (m_depth > 0 && --m_depth == 0)
+    {
+        m_keys.clear();
+    }
+    ::LeaveCriticalSection(& m_cs);
+}
+
+void DVLib::RegistrySnapshot::Clear()
+{
+    ::EnterCriticalSection(& m_cs);
+    m_keys.clear();
+    ::LeaveCriticalSection(& m_cs);
+}
+
+std::wstring DVLib::RegistrySnapshot::GetKeyId(HKEY root, const std::wstring& key, DWORD ulFlags)
+{
+    std::wstringstream ss;
+    ss << HKEY2wstring(root);
+    if (ulFlags & KEY_WOW64_64KEY) ss << L":WOW64_64";
+    else if (ulFlags & KEY_WOW64_32KEY) ss << L":WOW64_32";
+    ss << L"\\" << lowercase(trim(key, L"\\"));
+    return ss.str();
+}
+
+DVLib::RegistrySnapshot::query_result DVLib::RegistrySnapshot::Query(HKEY root, const std::wstring& key, const std::wstring& name, DWORD ulFlags, RegistryValue& value)
+{
+    std::wstring id = GetKeyId(root, key, ulFlags);
+    std::wstring value_name = lowercase(name);
+
+    ::EnterCriticalSection(& m_cs);
+    std::map<std::wstring, Key>::const_iterator iter = m_keys.find(id);
+    if (iter != m_keys.end())
+    {
+        query_result result = query_key_missing;
+        if (iter->second.exists)
+        {
+            RegistryValues::const_iterator value_iter = iter->second.values.find(value_name);
+            result = (value_iter == iter->second.values.end()) ? query_value_missing : query_value_found;
+            if (result == query_value_found) value = value_iter->second;
+        }
+        m_hits++;
+        ::LeaveCriticalSection(& m_cs);
+        return result;
+    }
+    RegistryReaderPtr reader(m_reader);
+    ::LeaveCriticalSection(& m_cs);
+
+    // read outside of the lock, concurrent reads of the same key are harmless
+    Key data;
+    data.exists = reader->ReadKey(root, key, ulFlags, data.values);
+
+    query_result result = query_key_missing;
+    if (data.exists)
+    {
+        RegistryValues::const_iterator value_iter = data.values.find(value_name);
+        result = (value_iter == data.values.end()) ? query_value_missing : query_value_found;
+        if (result == query_value_found) value = value_iter->second;
+    }
+
+    ::EnterCriticalSection(& m_cs);
+    if (m_depth > 0)
+    {
+        m_keys[id] = data;
+    }
+    m_misses++;
+    ::LeaveCriticalSection(& m_cs);
+    return result;
+}
+
+bool DVLib::RegistrySnapshot::KeyExists(HKEY root, const std::wstring& key, DWORD ulFlags)
+{
+    RegistryValue value;
+    return Query(root, key, L"", ulFlags, value) != query_key_missing;
+}
+
+bool DVLib::RegistrySnapshot::GetValues(HKEY root, const std::wstring& key, DWORD ulFlags, RegistryValues& values)
+{
+    std::wstring id = GetKeyId(root, key, ulFlags);
+
+    ::EnterCriticalSection(& m_cs);
+    std::map<std::wstring, Key>::const_iterator iter = m_keys.find(id);
+    if (iter != m_keys.end())
+    {
+        bool exists = iter->second.exists;
+        values = iter->second.values;
+        m_hits++;
+        ::LeaveCriticalSection(& m_cs);
+        return exists;
+    }
+    RegistryReaderPtr reader(m_reader);
+    ::LeaveCriticalSection(& m_cs);
+
+    Key data;
+    data.exists = reader->ReadKey(root, key, ulFlags, data.values);
+
+    ::EnterCriticalSection(& m_cs);
+    if (m_depth > 0)
+    {
+        m_keys[id] = data;
+    }
+    m_misses++;
+    ::LeaveCriticalSection(& m_cs);
+
+    values = data.values;
+    return data.exists;
+}
+
+bool DVLib::RegistrySnapshot::ValueExists(HKEY root, const std::wstring& key, const std::wstring& name, DWORD ulFlags)
+{
+    RegistryValue value;
+    return Query(root, key, name, ulFlags, value) == query_value_found;
+}
+
+DVLib::RegistryValue DVLib::RegistrySnapshot::GetValue(HKEY root, const std::wstring& key, const std::wstring& name, DWORD ulFlags)
+{
+    RegistryValue value;
+    switch(Query(root, key, name, ulFlags, value))
+    {
+    case query_key_missing:
+        THROW_EX(L"Error opening '" << HKEY2wstring(root) << L"\\" << key << L"': key not found");
+    case query_value_missing:
+        THROW_EX(L"Error quering '" << HKEY2wstring(root) << L"\\" << key << L"\\" << name << L"': value not found");
+    }
+
+    return value;
+}
+
+DWORD DVLib::RegistrySnapshot::GetValueType(HKEY root, const std::wstring& key, const std::wstring& name, DWORD ulFlags)
+{
+    return GetValue(root, key, name, ulFlags).type;
+}
+
+std::wstring DVLib::RegistrySnapshot::GetStringValue(HKEY root, const std::wstring& key, const std::wstring& name, DWORD ulFlags)
+{
+    RegistryValue value = GetValue(root, key, name, ulFlags);
+    CHECK_BOOL(value.type == REG_SZ || value.type == REG_EXPAND_SZ,
+        L"Error quering '" << HKEY2wstring(root) << L"\\" << key << L"\\" << name << L"' value, unexpected type " << value.type);
+    return RegistryValue2wstring(value);
+}
+
+DWORD DVLib::RegistrySnapshot::GetDWORDValue(HKEY root, const std::wstring& key, const std::wstring& name, DWORD ulFlags)
+{
+    RegistryValue value = GetValue(root, key, name, ulFlags);
+    CHECK_BOOL(value.type == REG_DWORD && value.data.size() == sizeof(DWORD),
+        L"Error quering '" << HKEY2wstring(root) << L"\\" << key << L"\\" << name << L"', unexpected type");
+    return * reinterpret_cast<const DWORD *>(& * value.data.begin());
+}
+
+std::vector<std::wstring> DVLib::RegistrySnapshot::GetMultiStringValue(HKEY root, const std::wstring& key, const std::wstring& name, DWORD ulFlags)
+{
+    RegistryValue value = GetValue(root, key, name, ulFlags);
+    CHECK_BOOL(value.type == REG_MULTI_SZ,
+        L"Error quering '" << HKEY2wstring(root) << L"\\" << key << L"\\" << name << L"' value, unexpected type " << value.type);
+    return RegistryValue2multistring(value);
+}
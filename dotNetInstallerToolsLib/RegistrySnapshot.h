@@ -0,0 +1,73 @@
+#pragma once
+
+#include "RegistryReader.h"
+
+namespace DVLib
+{
+	// serves registry queries from keys read into memory, each key is read once with all its values
+	// between Begin() and End(), outside of that every query reads the key again
+	class RegistrySnapshot
+	{
+	private:
+		struct Key
+		{
+			bool exists;
+			RegistryValues values;
+		};
+		enum query_result
+		{
+			query_key_missing = 0,
+			query_value_missing,
+			query_value_found,
+		};
+		CRITICAL_SECTION m_cs;
+		RegistryReaderPtr m_reader;
+		// keys by hive, view and lowercase path
+		std::map<std::wstring, Key> m_keys;
+		int m_depth;
+		LONG m_hits;
+		LONG m_misses;
+	public:
+		RegistrySnapshot();
+		RegistrySnapshot(const RegistryReaderPtr& reader);
+		~RegistrySnapshot();
+		// replace the reader, eg. with an in-memory registry, discards keys read
+		void SetReader(const RegistryReaderPtr& reader);
+		// keep keys read in memory until the matching End(), calls may be nested
+		void Begin();
+		// discard keys read when the outermost Begin() ends
+		void End();
+		bool IsActive() const { return m_depth > 0; }
+		// discard keys read
+		void Clear();
+		bool KeyExists(HKEY root, const std::wstring& key, DWORD ulFlags = 0);
+		// all values of a key, returns false if the key doesn't exist
+		bool GetValues(HKEY root, const std::wstring& key, DWORD ulFlags, RegistryValues& values);
+		bool ValueExists(HKEY root, const std::wstring& key, const std::wstring& name, DWORD ulFlags = 0);
+		DWORD GetValueType(HKEY root, const std::wstring& key, const std::wstring& name, DWORD ulFlags = 0);
+		std::wstring GetStringValue(HKEY root, const std::wstring& key, const std::wstring& name = L"", DWORD ulFlags = 0);
+		DWORD GetDWORDValue(HKEY root, const std::wstring& key, const std::wstring& name = L"", DWORD ulFlags = 0);
+		std::vector<std::wstring> GetMultiStringValue(HKEY root, const std::wstring& key, const std::wstring& name = L"", DWORD ulFlags = 0);
+		// number of queries served from and keys added to memory
+		LONG GetHits() const { return m_hits; }
+		LONG GetMisses() const { return m_misses; }
+		// identifies a key by hive, WOW64 view and case-insensitive path
+		static std::wstring GetKeyId(HKEY root, const std::wstring& key, DWORD ulFlags);
+	private:
+		query_result Query(HKEY root, const std::wstring& key, const std::wstring& name, DWORD ulFlags, RegistryValue& value);
+		RegistryValue GetValue(HKEY root, const std::wstring& key, const std::wstring& name, DWORD ulFlags);
+	};
+
+	// keeps registry keys in memory within a scope
+	class RegistrySnapshotScope
+	{
+	private:
+		RegistrySnapshot& m_snapshot;
+	public:
+		RegistrySnapshotScope(RegistrySnapshot& snapshot) : m_snapshot(snapshot) { m_snapshot.Begin(); }
+		~RegistrySnapshotScope() { m_snapshot.End(); }
+	private:
+		RegistrySnapshotScope(const RegistrySnapshotScope&);
+		RegistrySnapshotScope& operator=(const RegistrySnapshotScope&);
+	};
+}
@@ -317,3 +317,94 @@ void DVLib::RegistrySetMultiStringValue(HKEY root, const std::wstring& key, cons
         reinterpret_cast<const byte *>(& * data.begin()), data.size() * sizeof(WCHAR)),
         L"Error setting '" << HKEY2wstring(root) << L"\\" << key << L"'" << name << L"' value");
 }
+
+bool DVLib::RegistryGetValues(HKEY root, const std::wstring& key, RegistryValues& values, DWORD ulFlags)
+{
+    HKEY reg = NULL;
+    DWORD dwErr = ::RegOpenKeyEx(root, key.c_str(), 0, ulFlags | KEY_READ, & reg);
+    auto_hkey reg_ptr(reg);
+
+    switch(dwErr)
+    {
+    case ERROR_SUCCESS:
+        break;
+    case ERROR_FILE_NOT_FOUND:
+        return false;
+    default:
+        CHECK_WIN32_DWORD(dwErr,
+            L"Error opening '" << HKEY2wstring(root) << L"\\" << key << L"'");
+        break;
+    }
+
+    DWORD count = 0, maxnamesize = 0, maxdatasize = 0;
+    CHECK_WIN32_DWORD(::RegQueryInfoKey(reg, NULL, NULL, NULL, NULL, NULL, NULL, & count, & maxnamesize, & maxdatasize, NULL, NULL),
+        L"Error quering '" << HKEY2wstring(root) << L"\\" << key << L"' for values");
+
+    values.clear();
+    std::vector<wchar_t> name(maxnamesize + 1);
+    std::vector<BYTE> data(maxdatasize);
+    for (DWORD i = 0; i < count; i++)
+    {
+        DWORD namesize = name.size();
+        DWORD datasize = data.size();
+        DWORD dwType = 0;
+        dwErr = ::RegEnumValue(reg, i, & * name.begin(), & namesize, NULL, & dwType, data.empty() ? NULL : & * data.begin(), & datasize);
+
+        // values may be added or removed while enumerating
+        if (dwErr == ERROR_NO_MORE_ITEMS)
+            break;
+
+        CHECK_WIN32_DWORD(dwErr,
+            L"Error enumerating '" << HKEY2wstring(root) << L"\\" << key << L"' values");
+
+        RegistryValue& value = values[lowercase(std::wstring(& * name.begin(), namesize))];
+        value.type = dwType;
+        value.data.assign(data.begin(), data.begin() + datasize);
+    }
+
+    return true;
+}
+
+std::wstring DVLib::RegistryValue2wstring(const RegistryValue& value)
+{
+    CHECK_BOOL(value.type == REG_SZ || value.type == REG_EXPAND_SZ,
+        L"Unexpected registry value type " << value.type);
+
+    // value data includes the terminating null
+    std::wstring result;
+    if (value.data.size() >= sizeof(WCHAR))
+    {
+        result.assign(reinterpret_cast<const wchar_t *>(& * value.data.begin()), (value.data.size() - 1) / sizeof(WCHAR));
+    }
+
+    return result;
+}
+
+std::vector<std::wstring> DVLib::RegistryValue2multistring(const RegistryValue& value)
+{
+    CHECK_BOOL(value.type == REG_MULTI_SZ,
+        L"Unexpected registry value type " << value.type);
+
+    std::vector<std::wstring> result;
+    if (value.data.size() >= sizeof(WCHAR))
+    {
+        const wchar_t * data = reinterpret_cast<const wchar_t *>(& * value.data.begin());
+        std::vector<wchar_t> chars(data, data + (value.data.size() - 1) / sizeof(WCHAR));
+        std::vector<wchar_t>::iterator l = chars.begin();
+        std::vector<wchar_t>::iterator r = chars.begin();
+        while(r != chars.end())
+        {
+            if (* r == 0)
+            {
+                if (l == r) 
+                    result.push_back(L"");
+                else 
+                    result.push_back(std::wstring(l, r));
+                l = r + 1;
+            }
+            r++;
+        }
+    }
+
+    return result;
+}
@@ -45,4 +45,21 @@ namespace DVLib
 	void RegistrySetMultiStringValue(HKEY root, const std::wstring& key, const std::wstring& name, const std::vector<std::wstring>& value, DWORD ulFlags = 0);
 	// get registry value type
 	DWORD RegistryGetValueType(HKEY root, const std::wstring& key, const std::wstring& name, DWORD ulFlags = 0);
+
+	// a registry value read into memory
+	struct RegistryValue
+	{
+		DWORD type;
+		std::vector<BYTE> data;
+	};
+
+	// registry values by lowercase name, the default value has an empty name
+	typedef std::map<std::wstring, RegistryValue> RegistryValues;
+
+	// read all values of a registry key, returns false if the key doesn't exist
+	bool RegistryGetValues(HKEY root, const std::wstring& key, RegistryValues& values, DWORD ulFlags = 0);
+	// convert a REG_SZ or REG_EXPAND_SZ value read into memory to a string
+	std::wstring RegistryValue2wstring(const RegistryValue& value);
+	// convert a REG_MULTI_SZ value read into memory to a vector of strings
+	std::vector<std::wstring> RegistryValue2multistring(const RegistryValue& value);
 }
\ No newline at end of file
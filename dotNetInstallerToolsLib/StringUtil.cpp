@@ -71,6 +71,25 @@ std::string DVLib::UTF8string2string(const char * s)
     return wstring2string(UTF8string2wstring(s));
 }
 
+std::string DVLib::wstring2UTF8string(const std::wstring& s)
+{
+    return wstring2UTF8string(s.c_str());
+}
+
+std::string DVLib::wstring2UTF8string(const wchar_t * s)
+{
+    if (s == NULL) return "";
+    int req = ::WideCharToMultiByte(CP_UTF8, 0, s, -1, NULL, 0, NULL, NULL);
+    CHECK_WIN32_BOOL(0 != req, "WideCharToMultiByte");
+    std::vector<char> result;
+    result.resize(req);
+    req = WideCharToMultiByte(CP_UTF8, 0, s, -1, & * result.begin(), result.size(), NULL, NULL);
+    CHECK_WIN32_BOOL(0 != req, "WideCharToMultiByte");
+    std::string to;
+    to.assign(& * result.begin(), req - 1);
+    return to;
+}
+
 bool DVLib::string2bool(const std::string& s, bool defaultValue)
 {
     return string2bool(s.c_str(), defaultValue);
@@ -127,6 +146,16 @@ std::wstring DVLib::trimright(const std::wstring& s, const std::wstring& whitesp
     return StringUtilImpl<wchar_t>::trimright(s, whitespaces);
 }
 
+std::wstring DVLib::lowercase(const std::wstring& s)
+{
+    std::wstring result(s);
+    if (! result.empty())
+    {
+        ::CharLowerBuffW(& * result.begin(), result.size());
+    }
+    return result;
+}
+
 long DVLib::string2long(const std::string& s, int base)
 {
     if (s.empty()) throw std::exception("Missing number");
@@ -14,6 +14,9 @@ namespace DVLib
 	// convert UTF8 to ASCII
 	std::string UTF8string2string(const char * s);
 	std::string UTF8string2string(const std::string& s);
+	// convert UNICODE to UTF8
+	std::string wstring2UTF8string(const wchar_t * s);
+	std::string wstring2UTF8string(const std::wstring& s);
 
 	// convert a string representation of boolean
 	bool string2bool(const char *, bool defaultvalue = false);
@@ -63,6 +66,9 @@ namespace DVLib
     bool endswith(const std::string& ss, const std::string& what);
     bool endswith(const std::wstring& ss, const std::wstring& what);
 
+    // convert a string to lowercase
+    std::wstring lowercase(const std::wstring& s);
+
     // convert any streamable data into a UNICODE string
     template<class T>
     std::wstring towstring(const T& t)
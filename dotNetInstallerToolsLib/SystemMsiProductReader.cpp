@@ -0,0 +1,26 @@
+#include "StdAfx.h"
+#include "SystemMsiProductReader.h"
+#include "MsiUtil.h"
+
+std::vector<GUID> DVLib::SystemMsiProductReader::GetInstalledProducts()
+{
+    std::vector<GUID> result;
+    std::vector<MsiProductInfo> products = MsiGetInstalledProducts();
+    for each(const MsiProductInfo& pi in products)
+        result.push_back(pi.product_id);
+    return result;
+}
+
+std::vector<GUID> DVLib::SystemMsiProductReader::GetRelatedProducts(GUID upgradecode)
+{
+    std::vector<GUID> result;
+    std::vector<MsiProductInfo> products = MsiGetRelatedProducts(upgradecode);
+    for each(const MsiProductInfo& pi in products)
+        result.push_back(pi.product_id);
+    return result;
+}
+
+std::wstring DVLib::SystemMsiProductReader::GetProductProperty(GUID productcode, const std::wstring& property_name)
+{
+    return MsiProductInfo(productcode).GetProperty(property_name);
+}
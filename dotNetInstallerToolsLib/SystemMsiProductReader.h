@@ -0,0 +1,15 @@
+#pragma once
+
+#include "MsiProductReader.h"
+
+namespace DVLib
+{
+	// reads products installed on the system with the Windows Installer API
+	class SystemMsiProductReader : public IMsiProductReader
+	{
+	public:
+		std::vector<GUID> GetInstalledProducts();
+		std::vector<GUID> GetRelatedProducts(GUID upgradecode);
+		std::wstring GetProductProperty(GUID productcode, const std::wstring& property_name);
+	};
+}
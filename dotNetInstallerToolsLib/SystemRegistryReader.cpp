@@ -0,0 +1,7 @@
+#include "StdAfx.h"
+#include "SystemRegistryReader.h"
+
+bool DVLib::SystemRegistryReader::ReadKey(HKEY root, const std::wstring& key, DWORD ulFlags, RegistryValues& values)
+{
+    return RegistryGetValues(root, key, values, ulFlags);
+}
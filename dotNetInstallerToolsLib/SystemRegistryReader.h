@@ -0,0 +1,13 @@
+#pragma once
+
+#include "RegistryReader.h"
+
+namespace DVLib
+{
+	// reads keys from the system registry
+	class SystemRegistryReader : public IRegistryReader
+	{
+	public:
+		bool ReadKey(HKEY root, const std::wstring& key, DWORD ulFlags, RegistryValues& values);
+	};
+}
@@ -6,13 +6,28 @@
 #include "GuidUtil.h"
 #include "ShellUtil.h"
 #include "FileUtil.h"
+#include "MappedFile.h"
+#include "Version.h"
 #include "FormatUtil.h"
 #include "ImageUtil.h"
 #include "OsUtil.h"
 #include "DirectoryUtil.h"
 #include "PathUtil.h"
 #include "RegistryUtil.h"
+#include "RegistryReader.h"
+#include "SystemRegistryReader.h"
+#include "MemoryRegistryReader.h"
+#include "RegistrySnapshot.h"
 #include "FileUtilImpl.h"
+#include "VersionResource.h"
+#include "FileReader.h"
+#include "MemoryFileReader.h"
+#include "FileVersionCache.h"
 #include "MsiUtil.h"
+#include "MsiProductReader.h"
+#include "SystemMsiProductReader.h"
+#include "MemoryMsiProductReader.h"
+#include "MsiProductInventory.h"
+#include "MachineSnapshot.h"
 #include "FunctionUtil.h"
 #include "UACElevation.h"
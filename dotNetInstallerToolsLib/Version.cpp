@@ -0,0 +1,211 @@
+#include "StdAfx.h"
+#include "Version.h"
+#include "ExceptionMacros.h"
+#include "StringUtil.h"
+
+DVLib::Version::Version()
+    : m_packed(0)
+    , m_is_packed(true)
+{
+
+}
+
+DVLib::Version::Version(const std::wstring& version)
+    : m_packed(0)
+    , m_is_packed(true)
+{
+    CHECK_BOOL(TryParse(version, * this),
+        L"Invalid version format: '" << version << L"'");
+}
+
+DVLib::Version::Version(const VS_FIXEDFILEINFO& info)
+    : m_packed((static_cast<ULONGLONG>(info.dwFileVersionMS) << 32) | info.dwFileVersionLS)
+    , m_is_packed(true)
+{
+
+}
+
+bool DVLib::Version::TryParse(const std::wstring& version, Version& result)
+{
+    std::vector<DWORD> parts;
+    std::wstring prerelease;
+    size_t i = 0;
+
+    if (! version.empty() && (version[0] == L'v' || version[0] == L'V'))
+        i++;
+
+    while (i < version.size())
+    {
+        // each part is a number, 1..2 or 1. aren't versions
+        if (! iswdigit(version[i]))
+            return false;
+
+        ULONGLONG part = 0;
+        for (; i < version.size() && iswdigit(version[i]); i++)
+        {
+            part = part * 10 + (version[i] - L'0');
+            if (part > MAXDWORD)
+                return false;
+        }
+
+        parts.push_back(static_cast<DWORD>(part));
+
+        if (i == version.size())
+            break;
+
+        if (version[i] == L'.')
+        {
+            if (++i == version.size())
+                return false;
+            continue;
+        }
+
+        // 1.2.3-beta.2+build
+        std::wstring::size_type plus = version.find(L'+', i);
+        if (version[i] == L'-')
+        {
+            prerelease = version.substr(i + 1, plus == version.npos ? version.npos : plus - i - 1);
+            if (! IsIdentifiers(prerelease))
+                return false;
+        }
+        else if (plus != i)
+        {
+            return false;
+        }
+
+        if (plus != version.npos && ! IsIdentifiers(version.substr(plus + 1)))
+            return false;
+
+        break;
+    }
+
+    bool packed = (parts.size() <= 4 && prerelease.empty());
+    ULONGLONG key = 0;
+    for (size_t part = 0; part < 4 && packed; part++)
+    {
+        DWORD value = part < parts.size() ? parts[part] : 0;
+        packed = (value <= MAXWORD);
+        key = (key << 16) | value;
+    }
+
+    result.m_is_packed = packed;
+    result.m_packed = packed ? key : 0;
+    result.m_parts = packed ? std::vector<DWORD>() : parts;
+    result.m_prerelease = prerelease;
+    return true;
+}
+
+bool DVLib::Version::IsIdentifiers(const std::wstring& s)
+{
+    // dot-separated, non-empty identifiers of [0-9A-Za-z-]
+    if (s.empty() || s[0] == L'.' || s[s.size() - 1] == L'.')
+        return false;
+
+    for (size_t i = 0; i < s.size(); i++)
+    {
+        if (s[i] == L'.')
+        {
+            if (s[i - 1] == L'.')
+                return false;
+        }
+        else if (! (s[i] < 0x80 && (iswalnum(s[i]) || s[i] == L'-')))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+DWORD DVLib::Version::GetPart(size_t index) const
+{
+    if (m_is_packed)
+        return index < 4 ? static_cast<DWORD>((m_packed >> (48 - 16 * index)) & 0xFFFF) : 0;
+
+    return index < m_parts.size() ? m_parts[index] : 0;
+}
+
+int DVLib::Version::Compare(const Version& rhs) const
+{
+    // the common case, two file versions, compares keys without branching on each part
+    if (m_is_packed & rhs.m_is_packed)
+        return static_cast<int>(m_packed > rhs.m_packed) - static_cast<int>(m_packed < rhs.m_packed);
+
+    return CompareParts(rhs);
+}
+
+int DVLib::Version::CompareParts(const Version& rhs) const
+{
+    size_t count = GetPartCount() > rhs.GetPartCount() ? GetPartCount() : rhs.GetPartCount();
+    for (size_t i = 0; i < count; i++)
+    {
+        DWORD l = GetPart(i);
+        DWORD r = rhs.GetPart(i);
+        if (l != r)
+            return l < r ? -1 : 1;
+    }
+
+    // 1.2.3-beta precedes 1.2.3
+    if (m_prerelease.empty() != rhs.m_prerelease.empty())
+        return m_prerelease.empty() ? 1 : -1;
+
+    return ComparePrerelease(m_prerelease, rhs.m_prerelease);
+}
+
+// Pre-release identifiers are compared left to right, numeric identifiers numerically and
+// before alphanumeric ones, others ordinally; a shorter list of equal identifiers comes first.
+int DVLib::Version::ComparePrerelease(const std::wstring& l, const std::wstring& r)
+{
+    std::vector<std::wstring> l_ids = l.empty() ? std::vector<std::wstring>() : DVLib::split(l, L".");
+    std::vector<std::wstring> r_ids = r.empty() ? std::vector<std::wstring>() : DVLib::split(r, L".");
+    for (size_t i = 0; i < l_ids.size() && i < r_ids.size(); i++)
+    {
+        const std::wstring& l_id = l_ids[i];
+        const std::wstring& r_id = r_ids[i];
+        bool l_numeric = (l_id.find_first_not_of(L"0123456789") == l_id.npos);
+        bool r_numeric = (r_id.find_first_not_of(L"0123456789") == r_id.npos);
+        if (l_numeric != r_numeric)
+            return l_numeric ? -1 : 1;
+
+        int cmp = 0;
+        if (l_numeric)
+        {
+            // numbers of any length, leading zeros don't count
+            std::wstring::size_type l_start = l_id.find_first_not_of(L'0');
+            std::wstring::size_type r_start = r_id.find_first_not_of(L'0');
+            std::wstring l_number = (l_start == l_id.npos) ? L"" : l_id.substr(l_start);
+            std::wstring r_number = (r_start == r_id.npos) ? L"" : r_id.substr(r_start);
+            cmp = (l_number.size() != r_number.size())
+                ? (l_number.size() < r_number.size() ? -1 : 1)
+                : l_number.compare(r_number);
+        }
+        else
+        {
+            cmp = l_id.compare(r_id);
+        }
+
+        if (cmp != 0)
+            return cmp < 0 ? -1 : 1;
+    }
+
+    if (l_ids.size() != r_ids.size())
+        return l_ids.size() < r_ids.size() ? -1 : 1;
+
+    return 0;
+}
+
+std::wstring DVLib::Version::ToString() const
+{
+    std::wstringstream version;
+    size_t count = GetPartCount();
+    for (size_t i = 0; i < count; i++)
+    {
+        if (i > 0) version << L".";
+        version << GetPart(i);
+    }
+
+    if (! m_prerelease.empty())
+        version << L"-" << m_prerelease;
+
+    return version.str();
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "FileUtil.h"
+
+namespace DVLib
+{
+	// a version parsed once for repeated comparisons, eg. 1.2, v10.0.19041.1 or 1.2.3-beta.2+build;
+	// versions of up to four parts of 0-65535 without a pre-release suffix are packed into a
+	// single 64-bit key, longer versions, larger parts and pre-release versions are compared
+	// part by part, missing parts are zero
+	class Version
+	{
+	private:
+		// major.minor.build.rev, 16 bits each, most significant first
+		ULONGLONG m_packed;
+		bool m_is_packed;
+		// numeric parts of a version that can't be packed
+		std::vector<DWORD> m_parts;
+		// pre-release identifiers, eg. beta.2 in 1.2.3-beta.2, build metadata is ignored
+		std::wstring m_prerelease;
+	public:
+		Version();
+		// throws if the value isn't a version
+		explicit Version(const std::wstring& version);
+		explicit Version(const VS_FIXEDFILEINFO& info);
+		// returns false if the value isn't a version, the result is then unchanged
+		static bool TryParse(const std::wstring& version, Version& result);
+		// negative, zero or positive as this version is lesser, equal or greater than rhs
+		int Compare(const Version& rhs) const;
+		bool operator==(const Version& rhs) const { return Compare(rhs) == 0; }
+		bool operator<(const Version& rhs) const { return Compare(rhs) < 0; }
+		bool IsPacked() const { return m_is_packed; }
+		ULONGLONG GetPacked() const { return m_packed; }
+		const std::wstring& GetPrerelease() const { return m_prerelease; }
+		// number of numeric parts, four for packed versions
+		size_t GetPartCount() const { return m_is_packed ? 4 : m_parts.size(); }
+		// a numeric part, zero past the last part
+		DWORD GetPart(size_t index) const;
+		// normalized version string, eg. 1.2.0.0 for a packed 1.2
+		std::wstring ToString() const;
+	private:
+		int CompareParts(const Version& rhs) const;
+		static int ComparePrerelease(const std::wstring& l, const std::wstring& r);
+		static bool IsIdentifiers(const std::wstring& s);
+	};
+}
@@ -0,0 +1,232 @@
+#include "StdAfx.h"
+#include "VersionResource.h"
+
+namespace DVLib
+{
+    static const DWORD fixed_file_info_signature = 0xFEEF04BD;
+    static const DWORD resource_type_version = 16;
+
+    static WORD ReadWord(const BYTE * p)
+    {
+        return static_cast<WORD>(p[0] | (p[1] << 8));
+    }
+
+    static DWORD ReadDWord(const BYTE * p)
+    {
+        return static_cast<DWORD>(p[0]) | (static_cast<DWORD>(p[1]) << 8)
+            | (static_cast<DWORD>(p[2]) << 16) | (static_cast<DWORD>(p[3]) << 24);
+    }
+
+    static size_t Align4(size_t offset)
+    {
+        return (offset + 3) & ~static_cast<size_t>(3);
+    }
+
+    // maps a virtual address to a file offset using the section table
+    static bool RvaToOffset(const BYTE * image, size_t sections, size_t sections_count, DWORD rva, size_t& result)
+    {
+        for (size_t i = 0; i < sections_count; i++)
+        {
+            const BYTE * section = image + sections + i * 40;
+            DWORD virtual_size = ReadDWord(section + 8);
+            DWORD virtual_address = ReadDWord(section + 12);
+            DWORD raw_size = ReadDWord(section + 16);
+            DWORD raw_offset = ReadDWord(section + 20);
+            DWORD section_size = virtual_size > raw_size ? virtual_size : raw_size;
+            if (rva >= virtual_address && rva - virtual_address < section_size)
+            {
+                result = raw_offset + (rva - virtual_address);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // a version resource block: WORD length, WORD value length, WORD type, key, value, children
+    struct VersionBlock
+    {
+        size_t end;
+        size_t value;
+        size_t value_size;
+        size_t children;
+        std::wstring key;
+    };
+
+    static bool ReadVersionBlock(const BYTE * data, size_t size, size_t offset, VersionBlock& block)
+    {
+        if (offset + 6 > size)
+            return false;
+
+        size_t length = ReadWord(data + offset);
+        size_t value_length = ReadWord(data + offset + 2);
+        WORD type = ReadWord(data + offset + 4);
+        if (length < 6 || offset + length > size)
+            return false;
+
+        block.end = offset + length;
+        block.key.clear();
+        size_t p = offset + 6;
+        for (; p + 2 <= block.end; p += 2)
+        {
+            wchar_t c = static_cast<wchar_t>(ReadWord(data + p));
+            if (c == 0) break;
+            block.key.append(1, c);
+        }
+
+        if (p + 2 > block.end)
+            return false;
+
+        block.value = Align4(p + 2);
+        // text values are measured in characters
+        block.value_size = (type == 1) ? value_length * 2 : value_length;
+        if (block.value + block.value_size > block.end)
+        {
+            block.value = block.end;
+            block.value_size = 0;
+        }
+
+        block.children = Align4(block.value + block.value_size);
+        return true;
+    }
+}
+
+bool DVLib::ParseVersionResource(const BYTE * data, size_t size, FileVersionInfo& info)
+{
+    VersionBlock root;
+    if (! ReadVersionBlock(data, size, 0, root) || root.key != L"VS_VERSION_INFO")
+        return false;
+
+    if (root.value_size < sizeof(VS_FIXEDFILEINFO) || ReadDWord(data + root.value) != fixed_file_info_signature)
+        return false;
+
+    memcpy(& info.fixed_info, data + root.value, sizeof(VS_FIXEDFILEINFO));
+
+    // \VarFileInfo\Translation
+    for (size_t child_offset = root.children; child_offset < root.end; )
+    {
+        VersionBlock child;
+        if (! ReadVersionBlock(data, root.end, child_offset, child))
+            return false;
+
+        if (child.key == L"VarFileInfo")
+        {
+            for (size_t var_offset = child.children; var_offset < child.end; )
+            {
+                VersionBlock var;
+                if (! ReadVersionBlock(data, child.end, var_offset, var))
+                    return false;
+
+                if (var.key == L"Translation" && var.value_size >= 4)
+                {
+                    info.translation_info.wLanguage = ReadWord(data + var.value);
+                    info.translation_info.wCodePage = ReadWord(data + var.value + 2);
+                    return true;
+                }
+
+                var_offset = Align4(var.end);
+            }
+        }
+
+        child_offset = Align4(child.end);
+    }
+
+    return false;
+}
+
+bool DVLib::FindVersionResource(const BYTE * image, size_t size, size_t& offset, size_t& length)
+{
+    // DOS header, PE signature and file header
+    if (size < 0x40 || image[0] != 'M' || image[1] != 'Z')
+        return false;
+
+    size_t pe = ReadDWord(image + 0x3C);
+    if (pe + 24 > size || ReadDWord(image + pe) != 0x00004550)
+        return false;
+
+    size_t sections_count = ReadWord(image + pe + 6);
+    size_t optional_header = pe + 24;
+    size_t optional_header_size = ReadWord(image + pe + 20);
+    if (optional_header + optional_header_size > size || optional_header_size < 2)
+        return false;
+
+    // the resource directory is the third data directory
+    size_t data_directories = 0, data_directories_count = 0;
+    switch(ReadWord(image + optional_header))
+    {
+    case 0x10B: // PE32
+        data_directories = optional_header + 96;
+        data_directories_count = (optional_header_size >= 96) ? ReadDWord(image + optional_header + 92) : 0;
+        break;
+    case 0x20B: // PE32+
+        data_directories = optional_header + 112;
+        data_directories_count = (optional_header_size >= 112) ? ReadDWord(image + optional_header + 108) : 0;
+        break;
+    default:
+        return false;
+    }
+
+    if (data_directories_count < 3 || data_directories + 3 * 8 > optional_header + optional_header_size)
+        return false;
+
+    DWORD resources_rva = ReadDWord(image + data_directories + 2 * 8);
+    if (resources_rva == 0)
+        return false;
+
+    size_t sections = optional_header + optional_header_size;
+    if (sections + sections_count * 40 > size)
+        return false;
+
+    size_t resources = 0;
+    if (! RvaToOffset(image, sections, sections_count, resources_rva, resources))
+        return false;
+
+    // type, name and language directories, the first name and language of RT_VERSION
+    size_t directory = resources;
+    for (int level = 0; level < 3; level++)
+    {
+        if (directory + 16 > size)
+            return false;
+
+        size_t entries_count = ReadWord(image + directory + 12) + ReadWord(image + directory + 14);
+        size_t entry = directory + 16;
+        if (entry + entries_count * 8 > size)
+            return false;
+
+        bool found = false;
+        for (size_t i = 0; i < entries_count; i++, entry += 8)
+        {
+            // named types are never RT_VERSION
+            found = (level > 0 || ReadDWord(image + entry) == resource_type_version);
+            if (found) break;
+        }
+
+        if (! found)
+            return false;
+
+        DWORD entry_offset = ReadDWord(image + entry + 4);
+        bool subdirectory = (entry_offset & 0x80000000) != 0;
+        directory = resources + (entry_offset & 0x7FFFFFFF);
+        if (subdirectory != (level < 2))
+            return false;
+    }
+
+    // data entry
+    if (directory + 8 > size)
+        return false;
+
+    DWORD data_rva = ReadDWord(image + directory);
+    DWORD data_size = ReadDWord(image + directory + 4);
+    if (! RvaToOffset(image, sections, sections_count, data_rva, offset) || offset + data_size > size)
+        return false;
+
+    length = data_size;
+    return true;
+}
+
+bool DVLib::ParseImageVersionInfo(const BYTE * image, size_t size, FileVersionInfo& info)
+{
+    size_t offset = 0, length = 0;
+    return FindVersionResource(image, size, offset, length)
+        && ParseVersionResource(image + offset, length, info);
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "FileUtil.h"
+
+namespace DVLib
+{
+	// Reads VS_VERSIONINFO resources and locates them in PE images by walking the raw bytes,
+	// without loader or version APIs, so that the same code runs on any little-endian platform.
+
+	// parse a VS_VERSIONINFO block, returns false if the block is malformed or has no translation
+	bool ParseVersionResource(const BYTE * data, size_t size, FileVersionInfo& info);
+	// find the first RT_VERSION resource in a PE image read from disk, returns false if there's none
+	bool FindVersionResource(const BYTE * image, size_t size, size_t& offset, size_t& length);
+	// version information of a PE image read from disk
+	bool ParseImageVersionInfo(const BYTE * image, size_t size, FileVersionInfo& info);
+}
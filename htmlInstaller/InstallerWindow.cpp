@@ -219,17 +219,10 @@ BOOL InstallerWindow::on_mouse_dclick(HELEMENT /* he */, HELEMENT target,
                         {
                             // doesn't have to be thread-safe, running on UI thread
 
-                            if (m_running_component == NULL)
+                            if (m_running_component == NULL && ! IsExecuting())
                             {
                                 m_running_component = p_component;
-
-                                reset(m_pThread, AfxBeginThread(RunComponentOnThread, this, THREAD_PRIORITY_NORMAL, 0, CREATE_SUSPENDED));
-
-                                CHECK_WIN32_BOOL(get(m_pThread) != NULL,
-                                    L"AfxBeginThread");
-
-                                m_pThread->m_bAutoDelete = false;
-                                m_pThread->ResumeThread();
+                                BeginExec();
                             }
                         }
 
@@ -243,25 +236,23 @@ BOOL InstallerWindow::on_mouse_dclick(HELEMENT /* he */, HELEMENT target,
     return FALSE;
 }
 
-UINT InstallerWindow::RunComponentOnThread(LPVOID pParam)
+int InstallerWindow::RunComponentOnThread()
 {
-    InstallerWindow * p_window = static_cast<InstallerWindow*>(pParam);
-
     try
     {
-        InstallConfiguration * p_configuration = reinterpret_cast<InstallConfiguration *>(get(p_window->m_configuration));
+        InstallConfiguration * p_configuration = reinterpret_cast<InstallConfiguration *>(get(m_configuration));
         CHECK_BOOL(p_configuration != NULL, L"Invalid configuration");	
 
-        p_window->RunComponent(p_configuration->components.GetComponentPtr(p_window->m_running_component));
+        RunComponent(p_configuration->components.GetComponentPtr(m_running_component));
     }
     catch(std::exception& ex)
     {
-        p_window->m_error = DVLib::string2wstring(ex.what());
-        p_window->m_rc = -1;
+        m_error = DVLib::string2wstring(ex.what());
+        m_rc = -1;
     }
 
-    p_window->m_running_component = NULL;
-    return 0;
+    m_running_component = NULL;
+    return m_rc;
 }
 
 void InstallerWindow::RunComponent(const ComponentPtr& component)
@@ -274,6 +265,7 @@ void InstallerWindow::RunComponent(const ComponentPtr& component)
 
         component->Exec();
         component->Wait();
+        InstallerSession::Instance->InvalidateMachineState();
 
         LOG(L"*** Component '" << component->id << L"' (" << component->GetDisplayName() << L"): SUCCESS");
 
@@ -282,6 +274,8 @@ void InstallerWindow::RunComponent(const ComponentPtr& component)
     }
     catch(std::exception& ex)
     {
+        InstallerSession::Instance->InvalidateMachineState();
+
         LOG(L"*** Component '" << component->id << L"' (" << component->GetDisplayName() << L"): ERROR - " 
             << DVLib::string2wstring(ex.what()));
 
@@ -404,7 +398,6 @@ void InstallerWindow::OnExecBegin()
 
 bool InstallerWindow::OnComponentExecBegin(const ComponentPtr& component)
 {
-    m_running_component = get(component);
     return InstallerUI::ComponentExecBegin(component);
 }
 
@@ -416,14 +409,12 @@ bool InstallerWindow::OnComponentExecWait(const ComponentPtr& component)
 
 bool InstallerWindow::OnComponentExecSuccess(const ComponentPtr& component)
 {
-    m_running_component = NULL;
     SetProgress(m_recorded_progress + 1);
     return InstallerUI::ComponentExecSuccess(component);
 }
 
 bool InstallerWindow::OnComponentExecError(const ComponentPtr& component, std::exception& ex)
 {
-    m_running_component = NULL;
     SetProgress(m_recorded_progress + 1);
     return InstallerUI::ComponentExecError(component, ex);
 }
@@ -466,6 +457,10 @@ int InstallerWindow::OnMessage(UINT message, WPARAM wParam, LPARAM lParam)
 
 int InstallerWindow::ExecOnThread()
 {
+    // a single component was ctrl-clicked
+    if (m_running_component != NULL)
+        return RunComponentOnThread();
+
     try
     {
         auto_any<htmlayout::dom::element *, html_disabled> btn_install(& button_install);
@@ -490,7 +485,7 @@ int InstallerWindow::ExecOnThread()
 
         SetProgressTotal(components.size() * 2);
 
-        int rc = components.Exec(this);
+        int rc = ExecComponents(components, this);
         InstallerUI::AfterInstall(rc);
         return 0;
     }
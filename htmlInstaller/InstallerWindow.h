@@ -57,7 +57,7 @@ protected:
 	static std::wstring GetPositionStyle(const WidgetPosition& position);
 	static std::wstring GetControlStyle(const ControlText& control);
 	void RunComponent(const ComponentPtr& component);
-	static UINT RunComponentOnThread(LPVOID pParam);
+	int RunComponentOnThread();
 public:
 	bool RunDownloadConfiguration(const DownloadDialogPtr& p_Configuration);
 	void Create(int x, int y, int width, int height, const wchar_t * caption = 0);
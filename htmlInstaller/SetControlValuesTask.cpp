@@ -108,6 +108,9 @@ void SetControlValuesTask::exec()
         }
     }
 
+    // user-defined values have changed
+    InstallerSession::Instance->InvalidateVariables();
+
     CHECK_WIN32_BOOL(SetEvent(m_event),
         L"SetEvent");
 }
@@ -30,6 +30,7 @@ BOOL CHtmlInstallerApp::InitInstance()
         reset(InstallerLog::Instance, new InstallerLog());
         reset(InstallerSession::Instance, new InstallerSession());
         reset(InstallUILevelSetting::Instance, new InstallUILevelSetting());
+        reset(WorkerPool::Instance, new WorkerPool());
         reset(HtmLayoutDll::Instance, new HtmLayoutDll());
 
         HtmlWindow::RegisterClass(m_hInstance);
@@ -56,6 +57,7 @@ BOOL CHtmlInstallerApp::InitInstance()
         // propagate command line arguments during execution
         InstallerSession::Instance->AdditionalCmdLineArgs = InstallerCommandLineInfo::Instance->componentCmdArgs;
         InstallerSession::Instance->AdditionalControlArgs = InstallerCommandLineInfo::Instance->controlCmdArgs;
+        InstallerSession::Instance->InvalidateVariables();
 
         if (InstallerCommandLineInfo::Instance->DisplayHelp())
         {
@@ -102,6 +104,7 @@ int CHtmlInstallerApp::ExitInstance()
 {
     TRYLOG(L"htmlInstaller finished, return code: " << m_rc << DVLib::FormatMessage(L" (0x%x)", m_rc));
 
+    reset(WorkerPool::Instance);
     reset(HtmLayoutDll::Instance);
     reset(InstallerCommandLineInfo::Instance);
     reset(InstallerLauncher::Instance);